@@ -1,11 +1,13 @@
 #pragma once
 
 #include "EntityID.h"
+#include "SpatialIndex.h"
 #include "core/util/Log.h"
 #include "core/util/Assert.h"
 
 #include <entt/entt.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 namespace godsim {
@@ -30,12 +32,36 @@ public:
         return eid;
     }
 
+    /// Bring back an entity under the ID it had when a snapshot was taken.
+    /// Leaves next_id() alone; restore that from the snapshot too.
+    void restore_entity(EntityID eid) {
+        GODSIM_ASSERT(!is_alive(eid), "Entity {} already exists", eid.value);
+        auto entt_handle = registry_.create();
+        id_to_entt_[eid] = entt_handle;
+        entt_to_id_[entt_handle] = eid;
+    }
+
+    /// Bring a layer's entities from `current` to the set a snapshot
+    /// stored: those no longer in it are destroyed and those missing are
+    /// restored. Entities in both are left alive with their components, so
+    /// switching between similar states doesn't recreate them.
+    void restore_entities(const std::vector<EntityID>& current, const std::vector<EntityID>& stored) {
+        std::unordered_set<EntityID> keep(stored.begin(), stored.end());
+        for (EntityID eid : current) {
+            if (!keep.contains(eid)) destroy_entity(eid);
+        }
+        for (EntityID eid : stored) {
+            if (!is_alive(eid)) restore_entity(eid);
+        }
+    }
+
     void destroy_entity(EntityID eid) {
         auto it = id_to_entt_.find(eid);
         if (it == id_to_entt_.end()) {
             LOG_WARN("Attempted to destroy non-existent entity {}", eid.value);
             return;
         }
+        spatial_.remove(eid);
         entt_to_id_.erase(it->second);
         registry_.destroy(it->second);
         id_to_entt_.erase(it);
@@ -52,6 +78,11 @@ public:
         return registry_.emplace<T>(resolve(eid), std::forward<Args>(args)...);
     }
 
+    template<typename T, typename... Args>
+    T& add_or_replace_component(EntityID eid, Args&&... args) {
+        return registry_.emplace_or_replace<T>(resolve(eid), std::forward<Args>(args)...);
+    }
+
     template<typename T>
     T& get_component(EntityID eid) {
         return registry_.get<T>(resolve(eid));
@@ -106,6 +137,43 @@ public:
         return result;
     }
 
+    // ─── Spatial Index ───
+    // Entities with a CellLocation are indexed by planet cell. Move them
+    // with set_location() so the index follows; writing the component
+    // directly leaves the index stale.
+
+    /// Size the index for the planet grid and index every located entity.
+    void configure_spatial(u32 width, u32 height, u32 bucket_size = SpatialIndex::DEFAULT_BUCKET) {
+        spatial_.reset(width, height, bucket_size);
+        auto view = registry_.view<CellLocation>();
+        for (auto entt_handle : view) {
+            auto it = entt_to_id_.find(entt_handle);
+            if (it == entt_to_id_.end()) continue;
+            const auto& loc = view.get<CellLocation>(entt_handle);
+            spatial_.place(it->second, loc.x, loc.y);
+        }
+    }
+
+    void set_location(EntityID eid, f32 x, f32 y) {
+        registry_.emplace_or_replace<CellLocation>(resolve(eid), CellLocation{x, y});
+        spatial_.place(eid, x, y);
+    }
+
+    void clear_location(EntityID eid) {
+        registry_.remove<CellLocation>(resolve(eid));
+        spatial_.remove(eid);
+    }
+
+    const SpatialIndex& spatial() const { return spatial_; }
+
+    // ─── Snapshots ───
+    // Components belong to the layers, which store and restore their own
+    // entities. The ID counter is kept so entities created after a restore
+    // get the IDs they had the first time round.
+
+    u64  next_id() const { return next_id_; }
+    void set_next_id(u64 next) { next_id_ = next; }
+
     // ─── Statistics ───
 
     size_t entity_count() const { return id_to_entt_.size(); }
@@ -137,6 +205,7 @@ private:
     entt::registry registry_;
     std::unordered_map<EntityID, entt::entity> id_to_entt_;
     std::unordered_map<entt::entity, EntityID> entt_to_id_;
+    SpatialIndex spatial_;
     u64 next_id_ = 1;
 };
 
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "EntityID.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+/// Where an entity stands on the planet grid, in cells (fractional).
+/// x is longitude and wraps at the grid width; y runs pole to pole.
+struct CellLocation {
+    f32 x = 0.0f;
+    f32 y = 0.0f;
+};
+
+/// Uniform bucket grid over planet cells for located entities. Each
+/// bucket covers bucket_size × bucket_size cells and holds its entries
+/// inline, so queries touch only the buckets overlapping their area.
+/// Distances are measured in cell space with longitude wrap; they are
+/// not great-circle distances, so cells near the poles count as wide as
+/// those at the equator.
+class SpatialIndex {
+public:
+    static constexpr u32 DEFAULT_BUCKET = 16;
+
+    struct Entry {
+        EntityID id;
+        f32 x, y;
+    };
+
+    /// Size the index for a width × height grid and drop all entries.
+    void reset(u32 width, u32 height, u32 bucket_size = DEFAULT_BUCKET) {
+        width_ = width;
+        height_ = height;
+        bucket_ = std::max(bucket_size, 1u);
+        buckets_x_ = (width + bucket_ - 1) / bucket_;
+        buckets_y_ = (height + bucket_ - 1) / bucket_;
+        buckets_.assign(static_cast<size_t>(buckets_x_) * buckets_y_, {});
+        slots_.clear();
+    }
+
+    bool configured() const { return !buckets_.empty(); }
+    u32 width() const { return width_; }
+    u32 height() const { return height_; }
+    size_t size() const { return slots_.size(); }
+    bool contains(EntityID id) const { return slots_.count(id) != 0; }
+
+    /// Insert the entity, or move it if already present. Ignored until reset().
+    void place(EntityID id, f32 x, f32 y) {
+        if (!configured()) return;
+        x = wrap_x(x);
+        y = std::clamp(y, 0.0f, std::nextafter(static_cast<f32>(height_), 0.0f));
+        u32 bucket = bucket_of(x, y);
+
+        auto it = slots_.find(id);
+        if (it != slots_.end()) {
+            Slot& slot = it->second;
+            if (slot.bucket == bucket) {
+                buckets_[bucket][slot.index] = {id, x, y};
+                return;
+            }
+            erase(slot);
+            slot = {bucket, static_cast<u32>(buckets_[bucket].size())};
+        } else {
+            slots_[id] = {bucket, static_cast<u32>(buckets_[bucket].size())};
+        }
+        buckets_[bucket].push_back({id, x, y});
+    }
+
+    bool remove(EntityID id) {
+        auto it = slots_.find(id);
+        if (it == slots_.end()) return false;
+        erase(it->second);
+        slots_.erase(it);
+        return true;
+    }
+
+    /// Stored (wrapped) location of an indexed entity.
+    bool location(EntityID id, CellLocation& out) const {
+        auto it = slots_.find(id);
+        if (it == slots_.end()) return false;
+        const Entry& e = buckets_[it->second.bucket][it->second.index];
+        out = {e.x, e.y};
+        return true;
+    }
+
+    /// Cell-space distance with longitude wrap.
+    f32 distance(f32 ax, f32 ay, f32 bx, f32 by) const {
+        return std::sqrt(distance_sq(ax, ay, bx, by));
+    }
+
+    // ─── Queries ───
+
+    /// Call fn(const Entry&) for entries with x in [x0, x1) (wrapping; x0
+    /// may be negative or x1 past the width) and y in [y0, y1).
+    template<typename Fn>
+    void for_each_in_rect(f32 x0, f32 y0, f32 x1, f32 y1, Fn&& fn) const {
+        if (!configured() || x1 <= x0 || y1 <= y0) return;
+        const f32 w = static_cast<f32>(width_);
+        const bool all = x1 - x0 >= w;
+        const f32 span = x1 - x0;
+        x0 = wrap_x(x0);
+        const u32 by0 = bucket_row(std::max(y0, 0.0f));
+        const u32 by1 = bucket_row(std::min(y1, static_cast<f32>(height_)));
+
+        auto visit = [&](u32 bx_first, u32 bx_last) {
+            for (u32 by = by0; by <= by1; by++) {
+                for (u32 bx = bx_first; bx <= bx_last; bx++) {
+                    for (const Entry& e : buckets_[by * buckets_x_ + bx]) {
+                        f32 dx = e.x - x0;
+                        if (dx < 0.0f) dx += w;
+                        if ((all || dx < span) && e.y >= y0 && e.y < y1) fn(e);
+                    }
+                }
+            }
+        };
+        const u32 first = bucket_column(x0);
+        if (all || (first == 0 && x0 + span >= w)) {
+            visit(0, buckets_x_ - 1);
+        } else if (x0 + span <= w) {
+            visit(first, bucket_column(x0 + span));
+        } else {
+            // Crosses the seam: up to the last column, then on from the first
+            visit(first, buckets_x_ - 1);
+            visit(0, std::min(bucket_column(x0 + span - w), first - 1));
+        }
+    }
+
+    /// Call fn(const Entry&) for entries within `radius` cells of (cx, cy).
+    template<typename Fn>
+    void for_each_in_radius(f32 cx, f32 cy, f32 radius, Fn&& fn) const {
+        f32 r2 = radius * radius;
+        for_each_in_rect(cx - radius, cy - radius, cx + radius + 1e-3f, cy + radius + 1e-3f,
+                         [&](const Entry& e) {
+            if (distance_sq(cx, cy, e.x, e.y) <= r2) fn(e);
+        });
+    }
+
+    std::vector<EntityID> query_rect(f32 x0, f32 y0, f32 x1, f32 y1) const {
+        std::vector<EntityID> result;
+        for_each_in_rect(x0, y0, x1, y1, [&](const Entry& e) { result.push_back(e.id); });
+        return result;
+    }
+
+    std::vector<EntityID> query_radius(f32 cx, f32 cy, f32 radius) const {
+        std::vector<EntityID> result;
+        for_each_in_radius(cx, cy, radius, [&](const Entry& e) { result.push_back(e.id); });
+        return result;
+    }
+
+    /// Closest entry to (cx, cy) within `max_radius` that passes `accept`,
+    /// or null. Searches rings of buckets outward and stops once no
+    /// unvisited bucket can be closer than the best so far.
+    template<typename Pred>
+    EntityID nearest_if(f32 cx, f32 cy, f32 max_radius, Pred&& accept) const {
+        EntityID best = EntityID::null();
+        if (!configured() || slots_.empty()) return best;
+        cx = wrap_x(cx);
+        cy = std::clamp(cy, 0.0f, static_cast<f32>(height_));
+        i32 bx = static_cast<i32>(bucket_column(cx));
+        i32 by = static_cast<i32>(bucket_row(cy));
+
+        // Column offsets that reach each bucket column exactly once
+        const i32 lo = -static_cast<i32>(buckets_x_ / 2);
+        const i32 hi = static_cast<i32>(buckets_x_) - 1 + lo;
+        const i32 rings = std::max({hi, -lo, by, static_cast<i32>(buckets_y_) - 1 - by});
+
+        // Every bucket in ring k or beyond is k or more columns or rows
+        // away, so the nearest such column or row bounds how close it can
+        // be. Columns are measured to their real edges, as the one before
+        // the seam is narrower when the width isn't a multiple of the bucket.
+        constexpr f32 FAR = std::numeric_limits<f32>::infinity();
+        std::vector<f32> column_reach(static_cast<size_t>(rings) + 2, FAR);
+        for (i32 dx = lo; dx <= hi; dx++) {
+            u32 column = static_cast<u32>((bx + dx + static_cast<i32>(buckets_x_)) % static_cast<i32>(buckets_x_));
+            f32& reach = column_reach[static_cast<size_t>(std::abs(dx))];
+            reach = std::min(reach, column_distance(cx, column));
+        }
+        for (i32 k = rings; k >= 0; k--) {
+            column_reach[k] = std::min(column_reach[k], column_reach[k + 1]);
+        }
+        auto row_reach = [&](i32 k) {
+            if (k == 0) return 0.0f;
+            f32 reach = FAR;
+            if (by - k >= 0) reach = cy - static_cast<f32>((by - k + 1) * static_cast<i32>(bucket_));
+            if (by + k < static_cast<i32>(buckets_y_)) {
+                reach = std::min(reach, static_cast<f32>((by + k) * static_cast<i32>(bucket_)) - cy);
+            }
+            return reach;
+        };
+
+        f32 best_d2 = std::min(max_radius * max_radius, std::numeric_limits<f32>::max());
+        bool found = false;
+        for (i32 k = 0; k <= rings; k++) {
+            f32 reach = std::min(column_reach[k], row_reach(k));
+            if (reach * reach > best_d2) break;
+            for (i32 dy = -k; dy <= k; dy++) {
+                i32 y = by + dy;
+                if (y < 0 || y >= static_cast<i32>(buckets_y_)) continue;
+                auto visit = [&](i32 dx) {
+                    i32 x = ((bx + dx) % static_cast<i32>(buckets_x_) +
+                             static_cast<i32>(buckets_x_)) % static_cast<i32>(buckets_x_);
+                    for (const Entry& e : buckets_[static_cast<size_t>(y) * buckets_x_ + x]) {
+                        f32 d2 = distance_sq(cx, cy, e.x, e.y);
+                        // Ties go to the lowest id, so results don't depend on insertion order
+                        if (d2 > best_d2 || (found && d2 == best_d2 && !(e.id < best))) continue;
+                        if (!accept(e)) continue;
+                        best_d2 = d2;
+                        best = e.id;
+                        found = true;
+                    }
+                };
+                if (dy == -k || dy == k) {
+                    for (i32 dx = std::max(-k, lo); dx <= std::min(k, hi); dx++) visit(dx);
+                } else {
+                    if (-k >= lo) visit(-k);
+                    if (k <= hi) visit(k);
+                }
+            }
+        }
+        return best;
+    }
+
+    EntityID nearest(f32 cx, f32 cy,
+                     f32 max_radius = std::numeric_limits<f32>::infinity()) const {
+        return nearest_if(cx, cy, max_radius, [](const Entry&) { return true; });
+    }
+
+private:
+    struct Slot {
+        u32 bucket;
+        u32 index;
+    };
+
+    f32 wrap_x(f32 x) const {
+        f32 w = static_cast<f32>(width_);
+        x -= w * std::floor(x / w);
+        return x < w ? x : 0.0f; // Rounding can land exactly on w
+    }
+
+    f32 distance_sq(f32 ax, f32 ay, f32 bx, f32 by) const {
+        f32 dx = std::abs(ax - bx);
+        dx = std::min(dx, static_cast<f32>(width_) - dx);
+        f32 dy = ay - by;
+        return dx * dx + dy * dy;
+    }
+
+    /// Wrapped distance along x from `x` to the nearest cell of a bucket column.
+    f32 column_distance(f32 x, u32 column) const {
+        f32 w = static_cast<f32>(width_);
+        f32 x0 = static_cast<f32>(column * bucket_);
+        f32 x1 = static_cast<f32>(std::min((column + 1) * bucket_, width_));
+        if (x >= x0 && x < x1) return 0.0f;
+        f32 before = x < x0 ? x0 - x : x0 + w - x; // Going east to the column
+        f32 after = x >= x1 ? x - x1 : x + w - x1; // Going west
+        return std::min(before, after);
+    }
+
+    u32 bucket_row(f32 y) const {
+        return std::min(static_cast<u32>(y / bucket_), buckets_y_ - 1);
+    }
+
+    u32 bucket_column(f32 x) const {
+        return std::min(static_cast<u32>(x / bucket_), buckets_x_ - 1);
+    }
+
+    u32 bucket_of(f32 x, f32 y) const { return bucket_row(y) * buckets_x_ + bucket_column(x); }
+
+    /// Swap-remove the entry, fixing the slot of the one moved into its place.
+    void erase(const Slot& slot) {
+        auto& bucket = buckets_[slot.bucket];
+        if (slot.index + 1 != bucket.size()) {
+            bucket[slot.index] = bucket.back();
+            slots_[bucket[slot.index].id].index = slot.index;
+        }
+        bucket.pop_back();
+    }
+
+    u32 width_ = 0, height_ = 0;
+    u32 bucket_ = DEFAULT_BUCKET;
+    u32 buckets_x_ = 0, buckets_y_ = 0;
+    std::vector<std::vector<Entry>> buckets_; // Row-major
+    std::unordered_map<EntityID, Slot> slots_;
+};
+
+} // namespace godsim
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "core/ecs/EntityID.h"
+#include "core/serialise/BinaryStream.h"
 #include "core/time/SimTime.h"
+#include "core/time/TimerWheel.h"
 #include "core/util/Types.h"
 #include "core/util/Log.h"
 
@@ -13,6 +15,9 @@
 #include <algorithm>
 #include <string>
 #include <mutex>
+#include <iterator>
+#include <memory>
+#include <type_traits>
 
 namespace godsim {
 
@@ -70,17 +75,110 @@ struct Event {
     EventPayload payload;
 };
 
+// ─── Event Serialisation ───
+// Payloads are written as their variant index then their fields; a new
+// payload type needs a case in both functions.
+
+static_assert(std::variant_size_v<EventPayload> == 4, "write_event/read_event need the new payload");
+
+inline void write_event(BinaryWriter& writer, const Event& event) {
+    writer.write_u64(event.id);
+    writer.write_i64(event.timestamp.ticks);
+    writer.write_u64(event.source.value);
+    writer.write_u8(event.target);
+    writer.write_u8(static_cast<u8>(event.propagation));
+    writer.write_u8(static_cast<u8>(event.payload.index()));
+    std::visit([&](const auto& p) {
+        using T = std::decay_t<decltype(p)>;
+        if constexpr (std::is_same_v<T, DebugEvent>) {
+            writer.write_string(p.message);
+        } else if constexpr (std::is_same_v<T, LayerTickedEvent>) {
+            writer.write_u8(static_cast<u8>(p.layer));
+            writer.write_i64(p.time.ticks);
+            writer.write_i64(p.delta.ticks);
+        } else {
+            writer.write_u64(p.entity.value);
+            writer.write_u8(static_cast<u8>(p.layer));
+        }
+    }, event.payload);
+}
+
+inline Event read_event(BinaryReader& reader) {
+    Event event;
+    event.id = reader.read_u64();
+    event.timestamp = SimTime{reader.read_i64()};
+    event.source = EntityID{reader.read_u64()};
+    event.target = reader.read_u8();
+    event.propagation = static_cast<Propagation>(reader.read_u8());
+    switch (reader.read_u8()) {
+        case 0:
+            event.payload = DebugEvent{reader.read_string()};
+            break;
+        case 1: {
+            LayerTickedEvent p;
+            p.layer = static_cast<LayerID>(reader.read_u8());
+            p.time = SimTime{reader.read_i64()};
+            p.delta = SimTime{reader.read_i64()};
+            event.payload = p;
+            break;
+        }
+        case 2: {
+            EntityCreatedEvent p;
+            p.entity = EntityID{reader.read_u64()};
+            p.layer = static_cast<LayerID>(reader.read_u8());
+            event.payload = p;
+            break;
+        }
+        default: {
+            EntityDestroyedEvent p;
+            p.entity = EntityID{reader.read_u64()};
+            p.layer = static_cast<LayerID>(reader.read_u8());
+            event.payload = p;
+            break;
+        }
+    }
+    return event;
+}
+
 // ─── Event Log ───
-// Append-only log of all events for replay and history.
+// Append-only log of all events for replay and history. Stored as chunks
+// of CHUNK events; full chunks are immutable and shared between copies,
+// so copying a log (to branch a timeline) costs one open chunk and a
+// pointer per full one.
 class EventLog {
 public:
+    static constexpr size_t CHUNK = 1024;
+    using Chunk = std::vector<Event>;
+
+    class const_iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Event;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const Event*;
+        using reference = const Event&;
+
+        const_iterator(const EventLog* log, size_t index) : log_(log), index_(index) {}
+        const Event& operator*() const { return (*log_)[index_]; }
+        const Event* operator->() const { return &(*log_)[index_]; }
+        const_iterator& operator++() { index_++; return *this; }
+        const_iterator operator++(int) { auto old = *this; index_++; return old; }
+        bool operator==(const const_iterator& o) const { return index_ == o.index_; }
+        bool operator!=(const const_iterator& o) const { return index_ != o.index_; }
+
+    private:
+        const EventLog* log_;
+        size_t index_;
+    };
+
     void append(const Event& event) {
-        events_.push_back(event);
+        open_.push_back(event);
+        if (open_.size() == CHUNK) seal();
     }
 
     std::vector<const Event*> query(SimTime from, SimTime to) const {
         std::vector<const Event*> result;
-        for (const auto& e : events_) {
+        for (const auto& e : *this) {
             if (e.timestamp >= from && e.timestamp <= to) {
                 result.push_back(&e);
             }
@@ -89,22 +187,66 @@ public:
     }
 
     void truncate_after(SimTime time) {
-        events_.erase(
-            std::remove_if(events_.begin(), events_.end(),
-                           [time](const Event& e) { return e.timestamp > time; }),
-            events_.end());
+        // Chunks before the first late event stay shared; the rest are
+        // rebuilt without the late events
+        size_t first = 0;
+        while (first < sealed_.size() &&
+               std::none_of(sealed_[first]->begin(), sealed_[first]->end(),
+                            [time](const Event& e) { return e.timestamp > time; })) {
+            first++;
+        }
+        std::vector<Event> kept;
+        for (size_t c = first; c < sealed_.size(); c++) {
+            for (const auto& e : *sealed_[c]) if (e.timestamp <= time) kept.push_back(e);
+        }
+        for (const auto& e : open_) if (e.timestamp <= time) kept.push_back(e);
+        sealed_.resize(first);
+        open_.clear();
+        for (const auto& e : kept) append(e);
     }
 
-    size_t size() const { return events_.size(); }
-    const std::vector<Event>& events() const { return events_; }
-    void clear() { events_.clear(); }
+    /// Keep only the first `count` events.
+    void truncate_to(size_t count) {
+        if (count >= size()) return;
+        size_t full = count / CHUNK;
+        if (full < sealed_.size()) {
+            open_.assign(sealed_[full]->begin(), sealed_[full]->begin() + static_cast<std::ptrdiff_t>(count % CHUNK));
+            sealed_.resize(full);
+        } else {
+            open_.resize(count % CHUNK);
+        }
+    }
+
+    const Event& operator[](size_t i) const {
+        return i / CHUNK < sealed_.size() ? (*sealed_[i / CHUNK])[i % CHUNK] : open_[i % CHUNK];
+    }
+
+    const Event& back() const { return (*this)[size() - 1]; }
+    const_iterator begin() const { return {this, 0}; }
+    const_iterator end() const { return {this, size()}; }
+
+    size_t size() const { return sealed_.size() * CHUNK + open_.size(); }
+    bool empty() const { return size() == 0; }
+    void clear() { sealed_.clear(); open_.clear(); }
+
+    /// Full chunks, in order. Logs copied from one another share them.
+    const std::vector<std::shared_ptr<const Chunk>>& sealed_chunks() const { return sealed_; }
 
 private:
-    std::vector<Event> events_;
+    void seal() {
+        sealed_.push_back(std::make_shared<const Chunk>(std::move(open_)));
+        open_.clear();
+        open_.reserve(CHUNK);
+    }
+
+    std::vector<std::shared_ptr<const Chunk>> sealed_;
+    Chunk open_;
 };
 
 // ─── Event Bus ───
-// Routes events from emitters to layer-specific handlers.
+// Routes events from emitters to layer-specific handlers. Events can also
+// be scheduled for a future SimTime: they wait in a timer wheel until the
+// TickScheduler releases them, at the end of the tick that reaches them.
 class EventBus {
 public:
     /// Emit an event. It will be delivered on the next dispatch() call.
@@ -127,6 +269,57 @@ public:
         pending_.push_back(std::move(e));
     }
 
+    // ─── Scheduled Events ───
+
+    /// Deliver an event at `when` instead of the next dispatch. It is
+    /// stamped with `when` and keeps the id it is given now.
+    void schedule(Event event, SimTime when) {
+        event.id = next_event_id_++;
+        event.timestamp = when;
+        scheduled_.schedule(when, std::move(event));
+    }
+
+    template<typename T>
+    void schedule(T payload, SimTime when, LayerMask target = ALL_LAYERS,
+                  Propagation prop = Propagation::Broadcast, EntityID source = EntityID::null()) {
+        Event e;
+        e.source = source;
+        e.target = target;
+        e.propagation = prop;
+        e.payload = std::move(payload);
+        schedule(std::move(e), when);
+    }
+
+    /// Queue every scheduled event due by `now` for the next dispatch.
+    /// Returns how many.
+    size_t release_due(SimTime now) {
+        return scheduled_.advance(now, [&](SimTime, Event& event) { pending_.push_back(std::move(event)); });
+    }
+
+    size_t scheduled_count() const { return scheduled_.size(); }
+
+    /// Scheduled events are part of the simulation state; the log and
+    /// handlers are not.
+    void serialise(BinaryWriter& writer) const {
+        writer.write_u64(next_event_id_);
+        writer.write_i64(scheduled_.now().ticks);
+        writer.write_u64(scheduled_.size());
+        scheduled_.for_each([&](SimTime, const Event& event) { write_event(writer, event); });
+    }
+
+    /// Events still pending belong to the state being replaced and are
+    /// dropped.
+    void deserialise(BinaryReader& reader) {
+        pending_.clear();
+        next_event_id_ = reader.read_u64();
+        scheduled_.reset(SimTime{reader.read_i64()});
+        u64 count = reader.read_u64();
+        for (u64 i = 0; i < count; i++) {
+            Event event = read_event(reader);
+            scheduled_.schedule(event.timestamp, std::move(event));
+        }
+    }
+
     /// Subscribe a handler for a specific event payload type.
     /// The handler is called only if the event targets the given layer.
     template<typename T>
@@ -143,8 +336,9 @@ public:
     /// Deliver all pending events to their subscribed handlers
     /// and log them to the event log.
     void dispatch() {
-        // Sort pending events by timestamp for ordering guarantee
-        std::sort(pending_.begin(), pending_.end(),
+        // Sort pending events by timestamp for ordering guarantee; ties
+        // keep emission order
+        std::stable_sort(pending_.begin(), pending_.end(),
                   [](const Event& a, const Event& b) { return a.timestamp < b.timestamp; });
 
         for (const auto& event : pending_) {
@@ -182,6 +376,7 @@ public:
         pending_.clear();
         log_.clear();
         handlers_.clear();
+        scheduled_.reset();
         next_event_id_ = 0;
     }
 
@@ -192,6 +387,7 @@ private:
     };
 
     std::vector<Event> pending_;
+    TimerWheel<Event> scheduled_;
     EventLog log_;
     std::unordered_map<std::type_index, std::vector<HandlerEntry>> handlers_;
     u64 next_event_id_ = 0;
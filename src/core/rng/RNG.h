@@ -1,9 +1,11 @@
 #pragma once
 
 #include "core/util/Types.h"
+#include "core/serialise/BinaryStream.h"
 #include <pcg_random.hpp>
 #include <random>
 #include <cmath>
+#include <sstream>
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -77,6 +79,22 @@ public:
         }
     }
 
+    /// Exact generator state, so a restored simulation draws the same
+    /// numbers the original would have from that point on.
+    void serialise(BinaryWriter& writer) const {
+        std::ostringstream out;
+        out << engine_;
+        writer.write_u64(initial_seed_);
+        writer.write_string(out.str());
+    }
+
+    void deserialise(BinaryReader& reader) {
+        initial_seed_ = reader.read_u64();
+        std::istringstream in(reader.read_string());
+        in >> engine_;
+        advance_count_ = 0;
+    }
+
 private:
     pcg32 engine_;
     u64 initial_seed_;
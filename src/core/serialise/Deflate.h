@@ -0,0 +1,245 @@
+#pragma once
+
+#include "core/util/Types.h"
+#include "core/util/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cstring>
+
+namespace godsim {
+
+/// Self-contained zlib (RFC 1950/1951) compressor.
+/// Greedy LZ77 with hash chains, emitted as fixed-Huffman blocks. Large inputs
+/// are split into independent chunks that compress in parallel; each chunk is
+/// terminated with a sync flush (empty stored block) so the byte-aligned
+/// pieces concatenate into one valid deflate stream, the same trick pigz uses.
+/// Ratio is below zlib's dynamic-Huffman output but needs no dependency.
+class Deflate {
+public:
+    /// Bytes of input compressed per parallel chunk.
+    static constexpr size_t CHUNK_SIZE = 256 * 1024;
+
+    /// Incremental zlib stream: feed data in any number of pieces and
+    /// collect the compressed bytes as they are produced. Each piece is
+    /// compressed independently (in parallel chunks), so callers can stream
+    /// row bands without ever holding the whole input.
+    class ZlibStream {
+    public:
+        /// Two-byte zlib header. Must precede the first compressed piece.
+        void begin(std::vector<u8>& out) {
+            out.push_back(0x78); // CMF: deflate, 32K window
+            out.push_back(0x01); // FLG: fastest, check bits valid
+        }
+
+        /// Compress `size` bytes and append them to `out`.
+        void write(const u8* data, size_t size, std::vector<u8>& out) {
+            if (size == 0) return;
+            size_t num_chunks = (size + CHUNK_SIZE - 1) / CHUNK_SIZE;
+            std::vector<std::vector<u8>> chunks(num_chunks);
+
+            parallel_for(0, static_cast<u32>(num_chunks), [&](u32 lo, u32 hi) {
+                for (u32 c = lo; c < hi; c++) {
+                    size_t begin = static_cast<size_t>(c) * CHUNK_SIZE;
+                    size_t end = std::min(size, begin + CHUNK_SIZE);
+                    chunks[c] = compress_chunk(data + begin, end - begin);
+                }
+            });
+
+            for (const auto& c : chunks) out.insert(out.end(), c.begin(), c.end());
+            adler_ = adler32(data, size, adler_);
+        }
+
+        /// Terminate the stream and append the Adler-32 trailer.
+        void finish(std::vector<u8>& out) {
+            // Final empty fixed-Huffman block: BFINAL=1, BTYPE=01, EOB (7 zero bits)
+            out.push_back(0x03);
+            out.push_back(0x00);
+            out.push_back(static_cast<u8>(adler_ >> 24));
+            out.push_back(static_cast<u8>(adler_ >> 16));
+            out.push_back(static_cast<u8>(adler_ >> 8));
+            out.push_back(static_cast<u8>(adler_));
+        }
+
+    private:
+        u32 adler_ = 1;
+    };
+
+    /// Compress `size` bytes into a complete zlib stream.
+    static std::vector<u8> zlib_compress(const u8* data, size_t size) {
+        std::vector<u8> out;
+        out.reserve(size / 2 + 16);
+        ZlibStream stream;
+        stream.begin(out);
+        stream.write(data, size, out);
+        stream.finish(out);
+        return out;
+    }
+
+    /// Running Adler-32; pass the previous result to continue a checksum.
+    static u32 adler32(const u8* data, size_t size, u32 adler = 1) {
+        u32 a = adler & 0xFFFF, b = adler >> 16;
+        while (size > 0) {
+            size_t n = std::min<size_t>(size, 5552); // Largest run without u32 overflow
+            size -= n;
+            while (n--) {
+                a += *data++;
+                b += a;
+            }
+            a %= 65521;
+            b %= 65521;
+        }
+        return (b << 16) | a;
+    }
+
+private:
+    static constexpr u32 WINDOW     = 32768;
+    static constexpr u32 MIN_MATCH  = 3;
+    static constexpr u32 MAX_MATCH  = 258;
+    static constexpr u32 HASH_BITS  = 15;
+    static constexpr u32 MAX_CHAIN  = 32;
+
+    /// LSB-first bit packer as required by deflate.
+    class BitWriter {
+    public:
+        explicit BitWriter(std::vector<u8>& out) : out_(out) {}
+
+        void put(u32 bits, u32 count) {
+            acc_ |= static_cast<u64>(bits) << filled_;
+            filled_ += count;
+            while (filled_ >= 8) {
+                out_.push_back(static_cast<u8>(acc_));
+                acc_ >>= 8;
+                filled_ -= 8;
+            }
+        }
+
+        /// Huffman codes are defined MSB-first, so reverse before packing.
+        void put_code(u32 code, u32 length) {
+            u32 rev = 0;
+            for (u32 i = 0; i < length; i++) rev |= ((code >> i) & 1u) << (length - 1 - i);
+            put(rev, length);
+        }
+
+        void align() {
+            if (filled_ > 0) put(0, 8 - filled_);
+        }
+
+    private:
+        std::vector<u8>& out_;
+        u64 acc_ = 0;
+        u32 filled_ = 0;
+    };
+
+    static constexpr std::array<u16, 29> LENGTH_BASE = {
+        3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+        35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+    static constexpr std::array<u8, 29> LENGTH_EXTRA = {
+        0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+        3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+    static constexpr std::array<u16, 30> DIST_BASE = {
+        1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+        257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+    static constexpr std::array<u8, 30> DIST_EXTRA = {
+        0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+    /// Emit a literal/length symbol with the fixed Huffman table.
+    static void put_litlen(BitWriter& bw, u32 sym) {
+        if (sym < 144)      bw.put_code(0x30 + sym, 8);
+        else if (sym < 256) bw.put_code(0x190 + (sym - 144), 9);
+        else if (sym < 280) bw.put_code(sym - 256, 7);
+        else                bw.put_code(0xC0 + (sym - 280), 8);
+    }
+
+    static void put_match(BitWriter& bw, u32 length, u32 distance) {
+        u32 li = 28;
+        while (LENGTH_BASE[li] > length) li--;
+        put_litlen(bw, 257 + li);
+        if (LENGTH_EXTRA[li]) bw.put(length - LENGTH_BASE[li], LENGTH_EXTRA[li]);
+
+        u32 di = 29;
+        while (DIST_BASE[di] > distance) di--;
+        bw.put_code(di, 5);
+        if (DIST_EXTRA[di]) bw.put(distance - DIST_BASE[di], DIST_EXTRA[di]);
+    }
+
+    static u32 hash3(const u8* p) {
+        u32 v = static_cast<u32>(p[0]) | (static_cast<u32>(p[1]) << 8) | (static_cast<u32>(p[2]) << 16);
+        return (v * 2654435761u) >> (32 - HASH_BITS);
+    }
+
+    /// Compress one chunk as non-final fixed blocks followed by a sync flush.
+    /// Matches never reach outside the chunk, so chunks are independent.
+    static std::vector<u8> compress_chunk(const u8* data, size_t size) {
+        std::vector<u8> out;
+        out.reserve(size / 2 + 16);
+        BitWriter bw(out);
+
+        bw.put(0, 1); // BFINAL = 0
+        bw.put(1, 2); // BTYPE = fixed Huffman
+
+        std::vector<i32> head(1u << HASH_BITS, -1);
+        std::vector<i32> prev(WINDOW, -1);
+
+        size_t pos = 0;
+        auto insert = [&](size_t p) {
+            if (p + MIN_MATCH > size) return;
+            u32 h = hash3(data + p);
+            prev[p & (WINDOW - 1)] = head[h];
+            head[h] = static_cast<i32>(p);
+        };
+
+        while (pos < size) {
+            u32 best_len = 0, best_dist = 0;
+            if (pos + MIN_MATCH <= size) {
+                u32 max_len = static_cast<u32>(std::min<size_t>(MAX_MATCH, size - pos));
+                i32 cand = head[hash3(data + pos)];
+                u32 chain = MAX_CHAIN;
+                while (cand >= 0 && chain-- > 0) {
+                    size_t dist = pos - static_cast<size_t>(cand);
+                    if (dist > WINDOW - 1) break;
+                    const u8* a = data + cand;
+                    const u8* b = data + pos;
+                    if (a[best_len] == b[best_len]) {
+                        u32 len = 0;
+                        while (len < max_len && a[len] == b[len]) len++;
+                        if (len > best_len) {
+                            best_len = len;
+                            best_dist = static_cast<u32>(dist);
+                            if (len == max_len) break;
+                        }
+                    }
+                    i32 next = prev[static_cast<size_t>(cand) & (WINDOW - 1)];
+                    if (next >= cand) break; // Slot was recycled by a newer position
+                    cand = next;
+                }
+            }
+
+            if (best_len >= MIN_MATCH) {
+                put_match(bw, best_len, best_dist);
+                for (u32 i = 0; i < best_len; i++) insert(pos + i);
+                pos += best_len;
+            } else {
+                put_litlen(bw, data[pos]);
+                insert(pos);
+                pos++;
+            }
+        }
+
+        put_litlen(bw, 256); // End of block
+
+        // Sync flush: empty stored block leaves the stream byte aligned.
+        bw.put(0, 1);
+        bw.put(0, 2);
+        bw.align();
+        out.push_back(0x00);
+        out.push_back(0x00);
+        out.push_back(0xFF);
+        out.push_back(0xFF);
+        return out;
+    }
+};
+
+} // namespace godsim
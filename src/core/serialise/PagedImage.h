@@ -0,0 +1,138 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace godsim {
+
+/// Random 64-bit value per byte (splitmix64) for PagedImage's rolling
+/// hash, fixed at compile time so page boundaries are the same every run.
+inline constexpr std::array<u64, 256> PAGE_GEAR = [] {
+    std::array<u64, 256> table{};
+    u64 x = 0x9E3779B97F4A7C15ull;
+    for (auto& v : table) {
+        x += 0x9E3779B97F4A7C15ull;
+        u64 z = x;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        v = z ^ (z >> 31);
+    }
+    return table;
+}();
+
+/// A serialised state image cut into immutable pages that are shared,
+/// copy-on-write, with the image it was built against: a page whose bytes
+/// the base already holds is the base's page, so an image of a mostly
+/// unchanged state costs only the pages that changed.
+///
+/// Page boundaries are content-defined (a gear rolling hash, as in
+/// FastCDC) rather than at fixed offsets, so a change that shifts the
+/// bytes after it, like a settlement being founded or an event scheduled,
+/// only disturbs the pages around it and the rest still match.
+class PagedImage {
+public:
+    static constexpr size_t MIN_PAGE = 16 * 1024;
+    static constexpr size_t MAX_PAGE = 256 * 1024;
+    // Top 16 bits of the hash, which depend on the last 64 bytes: ~64 KiB
+    // on average past MIN_PAGE
+    static constexpr u64 BOUNDARY_MASK = ~u64{0} << 48;
+
+    using Page = std::shared_ptr<const std::vector<u8>>;
+
+    PagedImage() = default;
+
+    /// Page `data`, reusing `base`'s pages wherever the bytes match.
+    static PagedImage build(const std::vector<u8>& data, const PagedImage* base = nullptr) {
+        std::unordered_map<u64, std::vector<const Page*>> known;
+        if (base) {
+            for (const auto& page : base->pages_) known[hash(page->data(), page->size())].push_back(&page);
+        }
+
+        PagedImage image;
+        image.size_ = data.size();
+        size_t pos = 0;
+        while (pos < data.size()) {
+            size_t len = cut(data.data() + pos, data.size() - pos);
+            const u8* bytes = data.data() + pos;
+            Page page;
+            auto it = known.find(hash(bytes, len));
+            if (it != known.end()) {
+                for (const Page* candidate : it->second) {
+                    if ((*candidate)->size() == len && std::memcmp((*candidate)->data(), bytes, len) == 0) {
+                        page = *candidate;
+                        break;
+                    }
+                }
+            }
+            if (!page) page = std::make_shared<const std::vector<u8>>(bytes, bytes + len);
+            image.pages_.push_back(std::move(page));
+            pos += len;
+        }
+        return image;
+    }
+
+    /// The image's bytes, contiguous again.
+    std::vector<u8> assemble() const {
+        std::vector<u8> data;
+        data.reserve(size_);
+        for (const auto& page : pages_) data.insert(data.end(), page->begin(), page->end());
+        return data;
+    }
+
+    size_t size() const { return size_; }
+    size_t page_count() const { return pages_.size(); }
+    const std::vector<Page>& pages() const { return pages_; }
+
+    /// Pages shared with `other`.
+    size_t shared_pages(const PagedImage& other) const {
+        std::unordered_set<const std::vector<u8>*> theirs;
+        for (const auto& page : other.pages_) theirs.insert(page.get());
+        size_t shared = 0;
+        for (const auto& page : pages_) shared += theirs.count(page.get());
+        return shared;
+    }
+
+    /// Bytes actually held by a set of images, counting each shared page
+    /// once.
+    static size_t resident_bytes(const std::vector<const PagedImage*>& images) {
+        std::unordered_set<const std::vector<u8>*> seen;
+        size_t total = 0;
+        for (const PagedImage* image : images) {
+            for (const auto& page : image->pages_) {
+                if (seen.insert(page.get()).second) total += page->size();
+            }
+        }
+        return total;
+    }
+
+private:
+    /// Length of the next page: the first rolling-hash boundary past
+    /// MIN_PAGE, or MAX_PAGE, or the rest of the data.
+    static size_t cut(const u8* data, size_t size) {
+        if (size <= MIN_PAGE) return size;
+        size_t limit = std::min(size, MAX_PAGE);
+        u64 h = 0;
+        for (size_t i = MIN_PAGE; i < limit; i++) {
+            h = (h << 1) + PAGE_GEAR[data[i]];
+            if ((h & BOUNDARY_MASK) == 0) return i + 1;
+        }
+        return limit;
+    }
+
+    static u64 hash(const u8* data, size_t size) {
+        return std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(data), size));
+    }
+
+    std::vector<Page> pages_;
+    size_t size_ = 0;
+};
+
+} // namespace godsim
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+namespace godsim {
+
+/// Format of snapshot files and in-memory keyframes. Bump it whenever
+/// anything written by Simulation::write_state() changes, and gate reads
+/// of the new fields on the version so older snapshots still load.
+///
+/// 1: tick counts only from the Biological, Civilisation and Cosmological layers.
+/// 2: region hydration state after the header; population grid, settlements and
+///    N-body system in their layers.
+/// 3: scheduled events after the regions; divine effects in their layer.
+/// 4: full RNG state in place of the seed.
+/// 5: registry ID counter after the events; settlement and body entity IDs in
+///    their layers.
+/// 6: rivers and lakes after the planet's biome map.
+/// 7: seasonal cycle after the rivers and lakes.
+inline constexpr u32 SNAPSHOT_VERSION = 7;
+
+} // namespace godsim
@@ -4,6 +4,7 @@
 #include "core/ecs/EntityID.h"
 #include "core/events/EventBus.h"
 #include "core/util/Log.h"
+#include "core/util/Profiler.h"
 #include "layers/Layer.h"
 
 #include <vector>
@@ -35,6 +36,7 @@ public:
 
     void register_layer(Layer* layer) {
         layers_.push_back(layer);
+        tick_sections_.push_back(layer->name() + ".tick");
     }
 
     /// Set up the default tick hierarchy for the god simulation.
@@ -62,9 +64,11 @@ public:
         SimTime delta = level.duration;
 
         // Tick each registered layer if it's active at this level
-        for (auto* layer : layers_) {
+        for (size_t i = 0; i < layers_.size(); i++) {
+            Layer* layer = layers_[i];
             u8 layer_bit = LAYER_BIT(layer->id());
             if (level.active_layers & layer_bit) {
+                ProfileScope scope(tick_sections_[i]);
                 layer->tick(current_time_, delta);
             }
         }
@@ -78,6 +82,9 @@ public:
             current_time_
         );
 
+        // Scheduled events that came due during this tick join them
+        event_bus_.release_due(current_time_);
+
         // Dispatch all events generated during this tick
         event_bus_.dispatch();
 
@@ -118,6 +125,7 @@ private:
     EventBus& event_bus_;
     std::vector<TickLevel> levels_;
     std::vector<Layer*> layers_;
+    std::vector<std::string> tick_sections_; // Profiler section per layer, "<name>.tick"
     SimTime current_time_ = {};
     size_t active_level_ = 0;
     f32 speed_ = 1.0f;
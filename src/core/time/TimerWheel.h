@@ -0,0 +1,188 @@
+#pragma once
+
+#include "core/time/SimTime.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <limits>
+#include <vector>
+
+namespace godsim {
+
+/// Hierarchical timer wheel: values scheduled for a future SimTime and
+/// released, in time order, as time advances.
+///
+/// LEVELS wheels of SLOTS slots each; level L slots are SLOTS^L days
+/// wide, so the wheels together span about twelve billion years at
+/// one-day resolution. A timer sits on the level of the highest 6-bit
+/// digit in which its due day differs from now, and drops a level each
+/// time now enters its slot, so it is moved at most LEVELS times:
+/// scheduling and releasing are O(1) amortised. Advancing jumps straight
+/// to the next occupied slot (one bitmask scan per level), so a
+/// megayear step over an empty stretch costs no more than a day.
+///
+/// Timers due on the same day are released in the order they were
+/// scheduled. Callbacks may schedule more timers, including ones already
+/// due, which are released in the same advance().
+template<typename T>
+class TimerWheel {
+public:
+    static constexpr u32 SLOT_BITS = 6;
+    static constexpr u32 SLOTS = 1u << SLOT_BITS;
+    static constexpr u32 LEVELS = 7;
+
+    explicit TimerWheel(SimTime start = {}) : now_(start.ticks) {}
+
+    /// Time up to which timers have been released.
+    SimTime now() const { return {now_}; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void schedule(SimTime due, T value) {
+        insert({due.ticks, sequence_++, std::move(value)});
+        size_++;
+    }
+
+    /// Release every timer due at or before `to`, calling fn(due, value)
+    /// in due order, and move now() to `to`. Returns how many fired.
+    template<typename Fn>
+    size_t advance(SimTime to, Fn&& fn) {
+        size_t fired = release(fn);
+        while (size_ > ready_.size()) {
+            i64 next = next_slot();
+            if (next > to.ticks) break;
+            now_ = next;
+            cascade();
+            fired += release(fn);
+        }
+        now_ = std::max(now_, to.ticks);
+        return fired;
+    }
+
+    /// Start of the earliest occupied slot: no timer is due before it.
+    /// SimTime::ticks' maximum if the wheel is empty.
+    SimTime next_due() const {
+        if (!ready_.empty()) return {now_};
+        return {size_ > 0 ? next_slot() : std::numeric_limits<i64>::max()};
+    }
+
+    /// Visit every pending timer as fn(due, value), in release order.
+    template<typename Fn>
+    void for_each(Fn&& fn) const {
+        std::vector<const Entry*> all;
+        all.reserve(size_);
+        for (const auto& e : ready_) all.push_back(&e);
+        for (const auto& level : slots_)
+            for (const auto& slot : level)
+                for (const auto& e : slot) all.push_back(&e);
+        for (const auto& e : overflow_) all.push_back(&e);
+        std::sort(all.begin(), all.end(), [](const Entry* a, const Entry* b) { return a->before(*b); });
+        for (const Entry* e : all) fn(SimTime{e->due}, e->value);
+    }
+
+    /// Drop every timer and restart at `start`.
+    void reset(SimTime start = {}) {
+        for (auto& level : slots_)
+            for (auto& slot : level) slot.clear();
+        masks_.fill(0);
+        ready_.clear();
+        overflow_.clear();
+        size_ = 0;
+        sequence_ = 0;
+        now_ = start.ticks;
+    }
+
+private:
+    struct Entry {
+        i64 due;
+        u64 sequence;
+        T value;
+
+        bool before(const Entry& o) const {
+            return due != o.due ? due < o.due : sequence < o.sequence;
+        }
+    };
+
+    static constexpr u32 shift(u32 level) { return level * SLOT_BITS; }
+
+    void insert(Entry e) {
+        if (e.due <= now_) {
+            ready_.push_back(std::move(e));
+            return;
+        }
+        u64 differ = static_cast<u64>(e.due) ^ static_cast<u64>(now_);
+        u32 level = (63u - static_cast<u32>(std::countl_zero(differ))) / SLOT_BITS;
+        if (level >= LEVELS) {
+            overflow_.push_back(std::move(e));
+            return;
+        }
+        u32 slot = static_cast<u32>(static_cast<u64>(e.due) >> shift(level)) & (SLOTS - 1);
+        slots_[level][slot].push_back(std::move(e));
+        masks_[level] |= u64{1} << slot;
+    }
+
+    /// Occupied slots on each level lie strictly ahead of now's digit
+    /// there, so the earliest is the lowest set bit.
+    i64 next_slot() const {
+        u64 best = ~u64{0};
+        u64 now = static_cast<u64>(now_);
+        for (u32 level = 0; level < LEVELS; level++) {
+            if (!masks_[level]) continue;
+            u32 slot = static_cast<u32>(std::countr_zero(masks_[level]));
+            u64 base = (now >> shift(level + 1)) << shift(level + 1);
+            best = std::min(best, base | (static_cast<u64>(slot) << shift(level)));
+        }
+        for (const auto& e : overflow_) {
+            best = std::min(best, (static_cast<u64>(e.due) >> shift(LEVELS)) << shift(LEVELS));
+        }
+        return static_cast<i64>(best);
+    }
+
+    /// Now has entered some slots: re-file their timers a level down (or
+    /// into ready_, if due).
+    void cascade() {
+        u64 now = static_cast<u64>(now_);
+        if (!overflow_.empty() && (now & ((u64{1} << shift(LEVELS)) - 1)) == 0) {
+            std::vector<Entry> entries = std::move(overflow_);
+            overflow_.clear();
+            for (auto& e : entries) insert(std::move(e));
+        }
+        for (u32 level = LEVELS; level-- > 0;) {
+            if (level > 0 && (now & ((u64{1} << shift(level)) - 1)) != 0) continue;
+            u32 slot = static_cast<u32>(now >> shift(level)) & (SLOTS - 1);
+            if (!(masks_[level] >> slot & 1)) continue;
+            std::vector<Entry> entries = std::move(slots_[level][slot]);
+            slots_[level][slot].clear();
+            masks_[level] &= ~(u64{1} << slot);
+            for (auto& e : entries) insert(std::move(e));
+        }
+    }
+
+    template<typename Fn>
+    size_t release(Fn& fn) {
+        size_t fired = 0;
+        while (!ready_.empty()) {
+            std::vector<Entry> due = std::move(ready_);
+            ready_.clear();
+            std::sort(due.begin(), due.end(), [](const Entry& a, const Entry& b) { return a.before(b); });
+            for (auto& e : due) {
+                size_--;
+                fired++;
+                fn(SimTime{e.due}, e.value);
+            }
+        }
+        return fired;
+    }
+
+    i64 now_ = 0;
+    size_t size_ = 0;
+    u64 sequence_ = 0;
+    std::array<std::array<std::vector<Entry>, SLOTS>, LEVELS> slots_;
+    std::array<u64, LEVELS> masks_{};
+    std::vector<Entry> ready_;    // Due at or before now_
+    std::vector<Entry> overflow_; // Beyond the top level
+};
+
+} // namespace godsim
@@ -0,0 +1,161 @@
+#pragma once
+
+#include "Types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace godsim {
+
+/// Persistent worker pool for data-parallel passes over grids.
+/// Work is submitted as a batch of indexed tasks; the calling thread
+/// participates and run() returns once every task has finished.
+/// Nested calls from inside a task run serially on the calling thread.
+class ThreadPool {
+public:
+    explicit ThreadPool(u32 num_threads = 0) {
+        if (num_threads == 0) {
+            num_threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        // The caller is one of the workers, so spawn one fewer.
+        for (u32 i = 1; i < num_threads; i++) {
+            workers_.emplace_back([this] { worker_loop(); });
+        }
+    }
+
+    ~ThreadPool() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (auto& t : workers_) t.join();
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Shared pool sized to the hardware.
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    /// Total threads that execute tasks (workers + caller).
+    u32 size() const { return static_cast<u32>(workers_.size()) + 1; }
+
+    /// Run task(i) for i in [0, num_tasks). Blocks until all are done.
+    void run(u32 num_tasks, const std::function<void(u32)>& task) {
+        if (num_tasks == 0) return;
+        if (num_tasks == 1 || workers_.empty() || in_task()) {
+            for (u32 i = 0; i < num_tasks; i++) task(i);
+            return;
+        }
+
+        std::lock_guard submit(submit_mutex_); // One batch at a time
+        {
+            std::lock_guard lock(mutex_);
+            task_ = &task;
+            num_tasks_ = num_tasks;
+            next_task_.store(0);
+            remaining_ = num_tasks;
+            generation_++;
+        }
+        wake_.notify_all();
+
+        drain();
+
+        std::unique_lock lock(mutex_);
+        done_.wait(lock, [this] { return remaining_ == 0 && active_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    static bool& in_task() {
+        thread_local bool flag = false;
+        return flag;
+    }
+
+    void worker_loop() {
+        u64 seen = 0;
+        for (;;) {
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+            }
+            drain();
+        }
+    }
+
+    /// Claim and execute tasks until the batch is exhausted.
+    void drain() {
+        const std::function<void(u32)>* task;
+        u32 count;
+        {
+            std::lock_guard lock(mutex_);
+            if (!task_) return;
+            task = task_;
+            count = num_tasks_;
+            active_++; // Keeps run() from retiring the batch under us
+        }
+
+        u32 finished = 0;
+        in_task() = true;
+        for (;;) {
+            u32 i = next_task_.fetch_add(1);
+            if (i >= count) break;
+            (*task)(i);
+            finished++;
+        }
+        in_task() = false;
+
+        std::lock_guard lock(mutex_);
+        remaining_ -= finished;
+        active_--;
+        if (remaining_ == 0 && active_ == 0) done_.notify_all();
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex submit_mutex_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const std::function<void(u32)>* task_ = nullptr;
+    u32 num_tasks_ = 0;
+    std::atomic<u32> next_task_{0};
+    u32 remaining_ = 0;
+    u32 active_ = 0;
+    u64 generation_ = 0;
+    bool stopping_ = false;
+};
+
+/// Split [begin, end) into contiguous bands and call fn(band_begin, band_end)
+/// on the shared pool. Bands are at least `grain` items long; a few bands per
+/// thread keeps load balanced when rows cost different amounts.
+template<typename Fn>
+void parallel_for(u32 begin, u32 end, Fn&& fn, u32 grain = 1) {
+    if (end <= begin) return;
+    u32 count = end - begin;
+    auto& pool = ThreadPool::instance();
+    u32 max_bands = (count + std::max(grain, 1u) - 1) / std::max(grain, 1u);
+    u32 bands = std::min(max_bands, pool.size() * 4);
+    if (bands <= 1) {
+        fn(begin, end);
+        return;
+    }
+    u32 per_band = (count + bands - 1) / bands;
+    pool.run(bands, [&](u32 band) {
+        u32 lo = begin + band * per_band;
+        u32 hi = std::min(end, lo + per_band);
+        if (lo < hi) fn(lo, hi);
+    });
+}
+
+} // namespace godsim
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Log.h"
+#include "Types.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace godsim {
+
+/// Accumulated wall-clock cost of one named section.
+struct ProfileSection {
+    std::string name;
+    u64 calls = 0;
+    f64 total_ms = 0.0;
+    f64 last_ms = 0.0;
+    f64 max_ms = 0.0;
+
+    f64 mean_ms() const { return calls ? total_ms / calls : 0.0; }
+};
+
+/// Process-wide timing of simulation work: layer ticks and the systems
+/// inside them record named sections, summarised at shutdown. Recording
+/// takes a lock, so time whole passes rather than per-item work.
+class Profiler {
+public:
+    static Profiler& instance() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void record(std::string_view name, f64 ms) {
+        std::lock_guard lock(mutex_);
+        auto it = sections_.find(name);
+        if (it == sections_.end()) {
+            it = sections_.emplace(std::string(name), ProfileSection{std::string(name)}).first;
+        }
+        ProfileSection& s = it->second;
+        s.calls++;
+        s.total_ms += ms;
+        s.last_ms = ms;
+        s.max_ms = std::max(s.max_ms, ms);
+    }
+
+    /// Copy of one section; calls == 0 if it was never recorded.
+    ProfileSection section(const std::string& name) const {
+        std::lock_guard lock(mutex_);
+        auto it = sections_.find(name);
+        return it != sections_.end() ? it->second : ProfileSection{name};
+    }
+
+    std::vector<ProfileSection> sections() const {
+        std::lock_guard lock(mutex_);
+        std::vector<ProfileSection> out;
+        for (const auto& [_, s] : sections_) out.push_back(s);
+        return out;
+    }
+
+    void reset() {
+        std::lock_guard lock(mutex_);
+        sections_.clear();
+    }
+
+    void log_report() const {
+        auto all = sections();
+        if (all.empty()) return;
+        LOG_INFO("Profile (per call):");
+        for (const auto& s : all) {
+            LOG_INFO("  {:<28} {:>8} calls  mean {:8.3f}  max {:8.3f}  total {:10.1f} ms",
+                     s.name, s.calls, s.mean_ms(), s.max_ms, s.total_ms);
+        }
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, ProfileSection, std::less<>> sections_; // Sorted for the report
+};
+
+/// Records the time from construction to destruction under `name`, which
+/// must outlive the scope (a literal, or a name built once and kept).
+class ProfileScope {
+public:
+    explicit ProfileScope(std::string_view name)
+        : name_(name), start_(std::chrono::steady_clock::now()) {}
+
+    ~ProfileScope() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        Profiler::instance().record(name_, std::chrono::duration<f64, std::milli>(elapsed).count());
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    std::string_view name_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace godsim
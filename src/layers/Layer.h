@@ -6,6 +6,7 @@
 #include "core/time/SimTime.h"
 #include "core/rng/RNG.h"
 #include "core/serialise/BinaryStream.h"
+#include "layers/planetary/DirtyRegion.h"
 
 #include <string>
 
@@ -33,9 +34,21 @@ public:
     /// Called by the tick scheduler at this layer's temporal resolution.
     virtual void tick(SimTime current_time, SimTime delta_time) = 0;
 
+    // ─── Level of Detail ───
+    /// Called by RegionLOD when a region comes under observation: rebuild
+    /// full detail there from the layer's coarse state. Totals (population,
+    /// mass, wealth) must come through unchanged. Layers without per-region
+    /// state ignore it.
+    virtual void hydrate_region(const CellRect& /*region*/) {}
+
+    /// The reverse, once nobody is watching: fold the region's detail into
+    /// coarse aggregates and run it simplified from then on.
+    virtual void dehydrate_region(const CellRect& /*region*/) {}
+
     // ─── Serialisation ───
     virtual void serialise(BinaryWriter& writer) const = 0;
-    virtual void deserialise(BinaryReader& reader) = 0;
+    /// `version` is the SNAPSHOT_VERSION the state was written with.
+    virtual void deserialise(BinaryReader& reader, u32 version) = 0;
 
     // ─── Statistics ───
     u64 tick_count() const { return tick_count_; }
@@ -1,11 +1,19 @@
 #pragma once
 
 #include "layers/Layer.h"
+#include "layers/planetary/PlanetData.h"
+#include "PopulationGrid.h"
+#include "core/util/Assert.h"
 
 namespace godsim {
 
+/// The Biological layer simulates species living on the planet grid.
+/// Populations spread and grow by reaction–diffusion (PopulationGrid),
+/// limited by how well each biome suits each species.
 class BiologicalLayer : public Layer {
 public:
+    static constexpr u32 DEFAULT_SPECIES = 32;
+
     LayerID     id()   const override { return LayerID::Biological; }
     std::string name() const override { return "Biological"; }
 
@@ -20,8 +28,61 @@ public:
         LOG_INFO("BiologicalLayer shutdown (ticked {} times)", tick_count_);
     }
 
+    /// Create `species_count` random species on the planet's biome grid,
+    /// each seeded at a suitable spot.
+    void populate(const PlanetData& planet, u32 species_count = DEFAULT_SPECIES) {
+        planet_ = &planet;
+        populations_.reset(planet.width, planet.height);
+        populations_.set_biomes(planet.biome_map);
+        if (planet.width == 0 || planet.height == 0) return;
+
+        for (u32 i = 0; i < species_count; i++) {
+            u32 s = populations_.add_species(random_species(i));
+
+            // Best of a handful of random cells
+            u32 best_x = 0, best_y = 0;
+            f32 best = -1.0f;
+            for (int attempt = 0; attempt < 32; attempt++) {
+                u32 x = static_cast<u32>(rng_->next_int(0, static_cast<i32>(planet.width) - 1));
+                u32 y = static_cast<u32>(rng_->next_int(0, static_cast<i32>(planet.height) - 1));
+                f32 k = populations_.capacity_at(s, x, y);
+                if (k > best) {
+                    best = k;
+                    best_x = x;
+                    best_y = y;
+                }
+            }
+            populations_.seed(s, best_x, best_y, 2, 0.5f);
+        }
+        LOG_INFO("  Seeded {} species on {}x{} grid", species_count, planet.width, planet.height);
+    }
+
+    /// Re-read habitat after the planet's biomes change.
+    void update_habitat(const PlanetData& planet) { populations_.set_biomes(planet.biome_map); }
+
+    /// Temperature and moisture of a cell on the day `time` falls on, for
+    /// anything that lives by the seasons. The planet's annual values if it
+    /// has no seasonal cycle.
+    SeasonSample season_at(u32 x, u32 y, SimTime time) const {
+        GODSIM_ASSERT(planet_, "season_at() before populate()");
+        return planet_->season_at(x, y, time);
+    }
+
+    /// Population tiles follow RegionLOD: regions are whole tiles.
+    void hydrate_region(const CellRect& region) override {
+        for_tiles(region, [&](u32 tile) { populations_.hydrate_tile(tile); });
+    }
+
+    void dehydrate_region(const CellRect& region) override {
+        for_tiles(region, [&](u32 tile) { populations_.dehydrate_tile(tile); });
+    }
+
+    PopulationGrid& populations() { return populations_; }
+    const PopulationGrid& populations() const { return populations_; }
+
     void tick(SimTime current_time, SimTime delta_time) override {
         increment_tick();
+        populations_.step(static_cast<f32>(delta_time.years()));
         bus_->emit(
             LayerTickedEvent{LayerID::Biological, current_time, delta_time},
             current_time, ALL_LAYERS
@@ -30,16 +91,52 @@ public:
 
     void serialise(BinaryWriter& writer) const override {
         writer.write_u64(tick_count_);
+        populations_.serialise(writer);
     }
 
-    void deserialise(BinaryReader& reader) override {
+    void deserialise(BinaryReader& reader, u32 version) override {
         tick_count_ = reader.read_u64();
+        if (version >= 2) populations_.deserialise(reader);
     }
 
 private:
+    template<typename Fn>
+    void for_tiles(const CellRect& region, Fn&& fn) {
+        constexpr u32 T = PopulationGrid::TILE;
+        u32 tx1 = std::min((region.x1 + T - 1) / T, populations_.tiles_x());
+        u32 ty1 = std::min((region.y1 + T - 1) / T, populations_.tiles_y());
+        for (u32 ty = region.y0 / T; ty < ty1; ty++) {
+            for (u32 tx = region.x0 / T; tx < tx1; tx++) fn(ty * populations_.tiles_x() + tx);
+        }
+    }
+
+    /// Aquatic species live in water and wetlands; land species take a
+    /// random liking to each land biome.
+    SpeciesTraits random_species(u32 index) {
+        SpeciesTraits traits;
+        traits.name = "Species " + std::to_string(index);
+        traits.growth_rate = rng_->next_float(0.02f, 0.3f);
+        traits.diffusion = rng_->next_float(0.0005f, 0.01f);
+
+        bool aquatic = rng_->next_float() < 0.2f;
+        for (size_t b = 0; b < BIOME_COUNT; b++) {
+            auto biome = static_cast<BiomeType>(b);
+            bool water = biome == BiomeType::Ocean || biome == BiomeType::DeepOcean;
+            f32 liking = rng_->next_float();
+            if (aquatic) {
+                traits.capacity[b] = water || biome == BiomeType::Wetland ? liking : 0.0f;
+            } else {
+                traits.capacity[b] = water || biome == BiomeType::Ice ? 0.0f : liking * liking;
+            }
+        }
+        return traits;
+    }
+
     Registry* registry_ = nullptr;
     EventBus* bus_ = nullptr;
     RNG* rng_ = nullptr;
+    const PlanetData* planet_ = nullptr;
+    PopulationGrid populations_;
 };
 
 } // namespace godsim
@@ -0,0 +1,619 @@
+#pragma once
+
+#include "layers/planetary/Biome.h"
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+constexpr size_t BIOME_COUNT = static_cast<size_t>(BiomeType::COUNT);
+
+/// What a species needs from the land. Densities are in units of a
+/// fully stocked cell, so capacities are fractions of one.
+struct SpeciesTraits {
+    std::string name;
+    f32 growth_rate = 0.1f;  // Intrinsic logistic rate, per year
+    f32 diffusion = 0.01f;   // Dispersal, cells² per year
+    std::array<f32, BIOME_COUNT> capacity{}; // Carrying capacity by biome
+};
+
+/// Densities below this are an extinct remnant and are set to zero, so
+/// populations have an edge and empty tiles stay empty.
+constexpr f32 EXTINCT = 1e-9f;
+
+/// One reaction–diffusion update of cells [x0, x1) of a grid row: a
+/// five-point diffusion step followed by the exact logistic solution over
+/// the same interval,
+///
+///   m  = n + d · (n_left + n_right + n_up + n_down − 4n)
+///   n' = m·e / (1 + m·(e − 1)/K),   e = exp(r·dt)
+///
+/// so growth is stable at any step length and only diffusion limits it.
+/// Row pointers are to the start of the full row; `inv_capacity` holds
+/// 1/K for the span only. Longitude wraps at the row ends. Kept free of
+/// branches and aliasing so the interior vectorises.
+inline void reaction_diffusion_span(const f32* __restrict up, const f32* __restrict mid,
+                                    const f32* __restrict down,
+                                    const f32* __restrict inv_capacity, f32* __restrict out,
+                                    u32 width, u32 x0, u32 x1, f32 d, f32 e) {
+    const f32 keep = 1.0f - 4.0f * d;
+    const f32 g = e - 1.0f;
+    auto cell = [&](size_t x, f32 left, f32 right) {
+        f32 m = keep * mid[x] + d * (left + right + up[x] + down[x]);
+        f32 n = m * e / (1.0f + m * inv_capacity[x - x0] * g);
+        out[x] = n < EXTINCT ? 0.0f : n;
+    };
+    size_t x = x0;
+    if (x == 0 && x1 > 0) {
+        cell(0, mid[width - 1], mid[width > 1 ? 1 : 0]);
+        x = 1;
+    }
+    size_t end = std::min<size_t>(x1, width - 1); // Last column wraps
+    for (; x < end; x++) {
+        f32 m = keep * mid[x] + d * (mid[x - 1] + mid[x + 1] + up[x] + down[x]);
+        f32 n = m * e / (1.0f + m * inv_capacity[x - x0] * g);
+        out[x] = n < EXTINCT ? 0.0f : n;
+    }
+    if (x1 == width && width > 1) cell(width - 1, mid[width - 2], mid[0]);
+}
+
+/// Species populations over the planet grid. Each species owns one
+/// contiguous density plane (structure of arrays, species-major) and
+/// every step writes a second set of planes that is then swapped in.
+/// The poles are closed (no flux), so diffusion conserves mass.
+///
+/// Work is sparse: the grid is cut into TILE × TILE tiles and a step only
+/// visits, per species, the tiles that hold population plus their four
+/// neighbours (the reach of the stencil), so spread wakes the next tile
+/// and cost follows occupied area rather than planet size. The active
+/// (species, tile) pairs are stepped in parallel.
+///
+/// Tiles can also be dehydrated (see RegionLOD): their cells are folded
+/// into one total per species and the tile is stepped as a single well-
+/// mixed patch, its logistic limit the sum of its cells' capacities and
+/// its diffusion a flux to each neighbour. Hydrating spreads the total
+/// back over the cells in proportion to capacity. Coarse cells stay zero
+/// in the planes, so the fine stencil sees an empty neighbour there; the
+/// d·n it lets out across that edge is credited to the coarse total, and
+/// d·(mean density) flows back in, so mass is conserved at the boundary.
+class PopulationGrid {
+public:
+    static constexpr u32 TILE = 32;
+
+    /// Diffusion number per sub-step, d = D·dt. 0.25 is the explicit
+    /// stability limit; below 0.2 no cell's update goes negative.
+    static constexpr f32 MAX_DIFFUSION_NUMBER = 0.2f;
+
+    /// Cells where a species cannot live get this inverse capacity: a
+    /// carrying capacity so far below EXTINCT that arrivals die within a step.
+    static constexpr f32 HOSTILE = 1e30f;
+
+    /// Drop all species and size the grid.
+    void reset(u32 width, u32 height) {
+        width_ = width;
+        height_ = height;
+        species_.clear();
+        inv_capacity_.clear();
+        density_.clear();
+        next_.clear();
+        occupied_.clear();
+        next_occupied_.clear();
+        stale_.clear();
+        tiles_x_ = (width + TILE - 1) / TILE;
+        tiles_y_ = (height + TILE - 1) / TILE;
+        biomes_.assign(cells(), BiomeType::Ocean);
+        coarse_tile_.assign(tile_count(), 0);
+        coarse_count_ = 0;
+        coarse_.clear();
+        coarse_flux_.clear();
+        tile_capacity_.clear();
+    }
+
+    /// Habitat for every cell, row-major. Must match the grid size.
+    void set_biomes(const std::vector<BiomeType>& biomes) {
+        if (biomes.size() != cells()) return;
+        biomes_ = biomes;
+        for (u32 s = 0; s < species_count(); s++) update_tile_capacity(s);
+    }
+
+    u32 add_species(const SpeciesTraits& traits) {
+        species_.push_back(traits);
+        for (f32 k : traits.capacity) inv_capacity_.push_back(k > 0.0f ? 1.0f / k : HOSTILE);
+        density_.resize(density_.size() + cells(), 0.0f);
+        next_.resize(density_.size(), 0.0f);
+        occupied_.resize(occupied_.size() + tile_count(), 0);
+        next_occupied_.resize(occupied_.size(), 0);
+        stale_.push_back(0);
+        coarse_.resize(occupied_.size(), 0.0f);
+        coarse_flux_.resize(occupied_.size(), 0.0f);
+        tile_capacity_.resize(occupied_.size(), 0.0f);
+        update_tile_capacity(species_count() - 1);
+        return species_count() - 1;
+    }
+
+    u32 width() const { return width_; }
+    u32 height() const { return height_; }
+    size_t cells() const { return static_cast<size_t>(width_) * height_; }
+    u32 species_count() const { return static_cast<u32>(species_.size()); }
+    bool empty() const { return species_.empty(); }
+    const SpeciesTraits& traits(u32 species) const { return species_[species]; }
+
+    /// Writable plane; the species' active tiles are rescanned next step.
+    /// Anything written into a dehydrated tile is added to its total.
+    f32* density(u32 species) {
+        stale_[species] = 1;
+        return density_.data() + species * cells();
+    }
+    const f32* density(u32 species) const { return density_.data() + species * cells(); }
+    f32 at(u32 species, u32 x, u32 y) const {
+        return density(species)[static_cast<size_t>(y) * width_ + x];
+    }
+
+    u32 tiles_x() const { return tiles_x_; }
+    u32 tiles_y() const { return tiles_y_; }
+    u32 tile_count() const { return tiles_x_ * tiles_y_; }
+
+    /// Whether the species has population in tile (tx, ty), as of the last
+    /// step or edit.
+    bool tile_occupied(u32 species, u32 tx, u32 ty) {
+        refresh_occupancy();
+        return occupied_[static_cast<size_t>(species) * tile_count() + ty * tiles_x_ + tx] != 0;
+    }
+
+    /// (species, tile) pairs visited by the last sub-step.
+    size_t active_tiles() const { return jobs_.size(); }
+
+    /// Capacity of the cell's biome for the species.
+    f32 capacity_at(u32 species, u32 x, u32 y) const {
+        return species_[species].capacity[static_cast<size_t>(
+            biomes_[static_cast<size_t>(y) * width_ + x])];
+    }
+
+    /// Fill a disc of cells (longitude wraps) with `fraction` of their capacity.
+    void seed(u32 species, u32 cx, u32 cy, u32 radius, f32 fraction = 1.0f) {
+        i32 r = static_cast<i32>(radius);
+        for (i32 dy = -r; dy <= r; dy++) {
+            i32 y = static_cast<i32>(cy) + dy;
+            if (y < 0 || y >= static_cast<i32>(height_)) continue;
+            for (i32 dx = -r; dx <= r; dx++) {
+                if (dx * dx + dy * dy > r * r) continue;
+                u32 x = static_cast<u32>((static_cast<i32>(cx) + dx) % static_cast<i32>(width_) +
+                                         static_cast<i32>(width_)) % width_;
+                density(species)[static_cast<size_t>(y) * width_ + x] =
+                    fraction * capacity_at(species, x, static_cast<u32>(y));
+            }
+        }
+    }
+
+    /// Sum of a species' density over all cells, hydrated or not.
+    f64 total(u32 species) const {
+        const f32* n = density(species);
+        f64 sum = 0.0;
+        for (size_t i = 0; i < cells(); i++) sum += n[i];
+        for (u32 t = 0; t < tile_count(); t++) sum += coarse_[tile_index(species, t)];
+        return sum;
+    }
+
+    // ─── Level of Detail ───
+
+    bool hydrated(u32 tile) const { return coarse_tile_[tile] == 0; }
+    u32 coarse_tile_count() const { return coarse_count_; }
+
+    /// A species' total density over a tile, at either level of detail.
+    f64 tile_total(u32 species, u32 tile) const {
+        if (coarse_tile_[tile]) return coarse_[tile_index(species, tile)];
+        return tile_total_cells(density(species), tile);
+    }
+
+    /// Fold a tile's cells into one total per species and zero them.
+    void dehydrate_tile(u32 tile) {
+        if (coarse_tile_[tile]) return;
+        refresh_occupancy();
+        for (u32 s = 0; s < species_count(); s++) {
+            size_t i = tile_index(s, tile);
+            coarse_[i] = static_cast<f32>(tile_total(s, tile));
+            clear_tile(density_.data() + s * cells(), tile);
+            clear_tile(next_.data() + s * cells(), tile);
+            occupied_[i] = coarse_[i] > 0.0f;
+            next_occupied_[i] = 0;
+        }
+        coarse_tile_[tile] = 1;
+        coarse_count_++;
+    }
+
+    /// Spread each species' total back over the tile's cells in proportion
+    /// to their capacity (evenly if the tile can't support it at all).
+    void hydrate_tile(u32 tile) {
+        if (!coarse_tile_[tile]) return;
+        refresh_occupancy();
+        u32 x0, x1, y0, y1;
+        tile_rect(tile, x0, x1, y0, y1);
+        for (u32 s = 0; s < species_count(); s++) {
+            size_t i = tile_index(s, tile);
+            f64 total = coarse_[i];
+            if (total > 0.0) {
+                const f32* table = species_[s].capacity.data();
+                f64 capacity = tile_capacity_[i];
+                f64 area = static_cast<f64>(x1 - x0) * (y1 - y0);
+                f32* n = density_.data() + s * cells();
+                for (u32 y = y0; y < y1; y++) {
+                    for (u32 x = x0; x < x1; x++) {
+                        size_t c = static_cast<size_t>(y) * width_ + x;
+                        f64 share = capacity > 0.0 ? table[static_cast<size_t>(biomes_[c])] / capacity
+                                                   : 1.0 / area;
+                        n[c] = static_cast<f32>(total * share);
+                    }
+                }
+            }
+            coarse_[i] = 0.0f;
+            occupied_[i] = total > 0.0;
+            next_occupied_[i] = 0;
+        }
+        coarse_tile_[tile] = 0;
+        coarse_count_--;
+    }
+
+    // ─── External Growth ───
+
+    /// Multiply every species in `tile` by e^g, cell by cell, with g read
+    /// from `log_growth` (TILE × TILE, row-major from the tile's corner).
+    /// A coarse tile's totals are scaled by the capacity-weighted mean of
+    /// the factors, as if it had been hydrated first. Never populates an
+    /// empty cell, so occupancy holds; different tiles may be done in
+    /// parallel.
+    void apply_growth(u32 tile, const f32* log_growth) {
+        u32 x0, x1, y0, y1;
+        tile_rect(tile, x0, x1, y0, y1);
+        std::array<f32, TILE * TILE> factor;
+        for (u32 y = y0; y < y1; y++) {
+            for (u32 x = x0; x < x1; x++) {
+                u32 k = (y - y0) * TILE + (x - x0);
+                factor[k] = log_growth[k] != 0.0f ? std::exp(log_growth[k]) : 1.0f;
+            }
+        }
+
+        if (coarse_tile_[tile]) {
+            f64 area = static_cast<f64>(x1 - x0) * (y1 - y0), mean_factor = 0.0;
+            for (u32 y = y0; y < y1; y++)
+                for (u32 x = x0; x < x1; x++) mean_factor += factor[(y - y0) * TILE + (x - x0)];
+            mean_factor /= area;
+            for (u32 s = 0; s < species_count(); s++) {
+                size_t i = tile_index(s, tile);
+                if (coarse_[i] <= 0.0f) continue;
+                f64 weighted = mean_factor;
+                if (tile_capacity_[i] > 0.0f) {
+                    const f32* table = species_[s].capacity.data();
+                    f64 sum = 0.0;
+                    for (u32 y = y0; y < y1; y++) {
+                        const BiomeType* row = biomes_.data() + static_cast<size_t>(y) * width_;
+                        for (u32 x = x0; x < x1; x++)
+                            sum += table[static_cast<size_t>(row[x])] * factor[(y - y0) * TILE + (x - x0)];
+                    }
+                    weighted = sum / tile_capacity_[i];
+                }
+                coarse_[i] = static_cast<f32>(coarse_[i] * weighted);
+            }
+            return;
+        }
+
+        for (u32 s = 0; s < species_count(); s++) {
+            if (!stale_[s] && !occupied_[tile_index(s, tile)]) continue;
+            f32* n = density_.data() + s * cells();
+            for (u32 y = y0; y < y1; y++) {
+                f32* row = n + static_cast<size_t>(y) * width_;
+                const f32* f = factor.data() + (y - y0) * TILE - x0;
+                for (u32 x = x0; x < x1; x++) row[x] *= f[x];
+            }
+        }
+    }
+
+    /// Sub-steps needed to keep the fastest disperser stable over `years`.
+    u32 substeps(f32 years) const {
+        f32 fastest = 0.0f;
+        for (const auto& s : species_) fastest = std::max(fastest, s.diffusion);
+        return std::max(1u, static_cast<u32>(std::ceil(fastest * years / MAX_DIFFUSION_NUMBER)));
+    }
+
+    /// Advance every species by `years`.
+    void step(f32 years) {
+        if (empty() || years <= 0.0f || cells() == 0) return;
+        refresh_occupancy();
+        u32 n = substeps(years);
+        f32 dt = years / n;
+
+        std::vector<f32> d(species_count()), e(species_count());
+        for (u32 s = 0; s < species_count(); s++) {
+            d[s] = species_[s].diffusion * dt;
+            // Past e^30 the logistic step lands on K anyway; this keeps e finite
+            e[s] = std::exp(std::min(species_[s].growth_rate * dt, 30.0f));
+        }
+        for (u32 i = 0; i < n; i++) {
+            schedule();
+            parallel_for(0, static_cast<u32>(jobs_.size()), [&](u32 lo, u32 hi) {
+                std::vector<f32> inv_k(TILE);
+                for (u32 j = lo; j < hi; j++) {
+                    const TileJob& job = jobs_[j];
+                    step_tile(job, d[job.species], e[job.species], inv_k.data());
+                }
+            }, 4);
+            if (coarse_count_ > 0) {
+                parallel_for(0, species_count(), [&](u32 lo, u32 hi) {
+                    for (u32 sp = lo; sp < hi; sp++) step_coarse(sp, d[sp], e[sp]);
+                }, 1);
+            }
+            density_.swap(next_);
+            occupied_.swap(next_occupied_);
+        }
+    }
+
+    // ─── Serialisation ───
+    // Biomes are not stored; they come from the planet via set_biomes().
+
+    void serialise(BinaryWriter& writer) const {
+        writer.write_u32(width_);
+        writer.write_u32(height_);
+        writer.write_u32(species_count());
+        for (const auto& s : species_) {
+            writer.write_string(s.name);
+            writer.write_f32(s.growth_rate);
+            writer.write_f32(s.diffusion);
+            for (f32 k : s.capacity) writer.write_f32(k);
+        }
+        writer.write_bytes(density_.data(), density_.size() * sizeof(f32));
+        writer.write_bytes(coarse_tile_.data(), coarse_tile_.size());
+        writer.write_bytes(coarse_.data(), coarse_.size() * sizeof(f32));
+    }
+
+    void deserialise(BinaryReader& reader) {
+        u32 width = reader.read_u32();
+        u32 height = reader.read_u32();
+        std::vector<BiomeType> biomes = std::move(biomes_);
+        reset(width, height);
+        if (biomes.size() == cells()) biomes_ = std::move(biomes);
+
+        u32 count = reader.read_u32();
+        for (u32 i = 0; i < count; i++) {
+            SpeciesTraits s;
+            s.name = reader.read_string();
+            s.growth_rate = reader.read_f32();
+            s.diffusion = reader.read_f32();
+            for (f32& k : s.capacity) k = reader.read_f32();
+            add_species(s);
+            stale_.back() = 1;
+        }
+        reader.read_bytes(density_.data(), density_.size() * sizeof(f32));
+        reader.read_bytes(coarse_tile_.data(), coarse_tile_.size());
+        reader.read_bytes(coarse_.data(), coarse_.size() * sizeof(f32));
+        coarse_count_ = static_cast<u32>(std::count(coarse_tile_.begin(), coarse_tile_.end(), 1));
+    }
+
+private:
+    struct TileJob {
+        u32 species;
+        u32 tile;
+    };
+
+    size_t tile_index(u32 species, u32 tile) const {
+        return static_cast<size_t>(species) * tile_count() + tile;
+    }
+
+    void tile_rect(u32 tile, u32& x0, u32& x1, u32& y0, u32& y1) const {
+        x0 = (tile % tiles_x_) * TILE;
+        x1 = std::min(x0 + TILE, width_);
+        y0 = (tile / tiles_x_) * TILE;
+        y1 = std::min(y0 + TILE, height_);
+    }
+
+    f32 tile_area(u32 tile) const {
+        u32 x0, x1, y0, y1;
+        tile_rect(tile, x0, x1, y0, y1);
+        return static_cast<f32>((x1 - x0) * (y1 - y0));
+    }
+
+    /// Sum of the species' capacity over each tile's cells.
+    void update_tile_capacity(u32 species) {
+        const f32* table = species_[species].capacity.data();
+        for (u32 t = 0; t < tile_count(); t++) {
+            u32 x0, x1, y0, y1;
+            tile_rect(t, x0, x1, y0, y1);
+            f64 sum = 0.0;
+            for (u32 y = y0; y < y1; y++) {
+                const BiomeType* row = biomes_.data() + static_cast<size_t>(y) * width_;
+                for (u32 x = x0; x < x1; x++) sum += table[static_cast<size_t>(row[x])];
+            }
+            tile_capacity_[tile_index(species, t)] = static_cast<f32>(sum);
+        }
+    }
+
+    /// Rescan the tiles of species whose planes were edited directly.
+    /// Edits inside coarse tiles are moved into their totals.
+    void refresh_occupancy() {
+        for (u32 s = 0; s < species_count(); s++) {
+            if (!stale_[s]) continue;
+            stale_[s] = 0;
+            f32* n = density_.data() + s * cells();
+            for (u32 t = 0; t < tile_count(); t++) {
+                u32 x0 = (t % tiles_x_) * TILE, x1 = std::min(x0 + TILE, width_);
+                u32 y0 = (t / tiles_x_) * TILE, y1 = std::min(y0 + TILE, height_);
+                if (coarse_tile_[t]) {
+                    size_t i = tile_index(s, t);
+                    coarse_[i] = static_cast<f32>(coarse_[i] + tile_total_cells(n, t));
+                    clear_tile(n, t);
+                    occupied_[i] = coarse_[i] > 0.0f;
+                    continue;
+                }
+                bool any = false;
+                for (u32 y = y0; y < y1 && !any; y++)
+                    for (u32 x = x0; x < x1; x++) any |= n[static_cast<size_t>(y) * width_ + x] > 0.0f;
+                occupied_[tile_index(s, t)] = any;
+            }
+        }
+    }
+
+    /// List the tiles each species must visit this sub-step: occupied ones
+    /// and their neighbours (longitude wraps). Tiles left out must read as
+    /// empty in the output planes, so any that still hold the population
+    /// of two sub-steps ago are cleared.
+    void schedule() {
+        jobs_.clear();
+        for (u32 s = 0; s < species_count(); s++) {
+            const u8* occ = occupied_.data() + tile_index(s, 0);
+            for (u32 ty = 0; ty < tiles_y_; ty++) {
+                for (u32 tx = 0; tx < tiles_x_; tx++) {
+                    u32 t = ty * tiles_x_ + tx;
+                    if (coarse_tile_[t]) continue; // Stepped by step_coarse()
+                    bool active = occ[t] ||
+                                  occ[ty * tiles_x_ + (tx + tiles_x_ - 1) % tiles_x_] ||
+                                  occ[ty * tiles_x_ + (tx + 1) % tiles_x_] ||
+                                  (ty > 0 && occ[t - tiles_x_]) ||
+                                  (ty + 1 < tiles_y_ && occ[t + tiles_x_]);
+                    if (active) {
+                        jobs_.push_back({s, t});
+                    } else if (next_occupied_[tile_index(s, t)]) {
+                        clear_tile(next_.data() + s * cells(), t);
+                        next_occupied_[tile_index(s, t)] = 0;
+                    }
+                }
+            }
+        }
+    }
+
+    void clear_tile(f32* plane, u32 tile) {
+        u32 x0 = (tile % tiles_x_) * TILE, x1 = std::min(x0 + TILE, width_);
+        u32 y0 = (tile / tiles_x_) * TILE, y1 = std::min(y0 + TILE, height_);
+        for (u32 y = y0; y < y1; y++) {
+            f32* row = plane + static_cast<size_t>(y) * width_;
+            std::fill(row + x0, row + x1, 0.0f);
+        }
+    }
+
+    f64 tile_total_cells(const f32* plane, u32 tile) const {
+        u32 x0, x1, y0, y1;
+        tile_rect(tile, x0, x1, y0, y1);
+        f64 sum = 0.0;
+        for (u32 y = y0; y < y1; y++)
+            for (u32 x = x0; x < x1; x++) sum += plane[static_cast<size_t>(y) * width_ + x];
+        return sum;
+    }
+
+    /// One sub-step of a species' coarse tiles, after the fine tiles: the
+    /// flux between coarse neighbours as if each were uniform at its mean
+    /// density (gradient over one tile width), the exchange with hydrated
+    /// neighbours' edge cells, then the logistic on the tile total.
+    void step_coarse(u32 s, f32 d, f32 e) {
+        const f32* src = density_.data() + s * cells();
+        f32* dst = next_.data() + s * cells();
+        const f32* total = coarse_.data() + tile_index(s, 0);
+        f32* flux = coarse_flux_.data() + tile_index(s, 0);
+        const u8* occ = occupied_.data() + tile_index(s, 0);
+        u8* next_occ = next_occupied_.data() + tile_index(s, 0);
+
+        for (u32 t = 0; t < tile_count(); t++) {
+            if (!coarse_tile_[t]) continue;
+            u32 tx = t % tiles_x_, ty = t / tiles_x_;
+            u32 x0, x1, y0, y1;
+            tile_rect(t, x0, x1, y0, y1);
+            const f32 mean = total[t] / tile_area(t);
+            f64 in = 0.0;
+
+            // Neighbour tile and the line of its cells along the shared edge
+            auto exchange = [&](u32 nb, u32 cx0, u32 cx1, u32 cy0, u32 cy1) {
+                if (nb == t) return;
+                f32 length = static_cast<f32>((cx1 - cx0) * (cy1 - cy0));
+                if (coarse_tile_[nb]) {
+                    in += d * length * (total[nb] / tile_area(nb) - mean) / TILE;
+                    return;
+                }
+                if (!occ[nb] && !occ[t]) return; // Neither side stepped
+                for (u32 y = cy0; y < cy1; y++) {
+                    for (u32 x = cx0; x < cx1; x++) {
+                        size_t c = static_cast<size_t>(y) * width_ + x;
+                        in += d * src[c];
+                        dst[c] += d * mean;
+                    }
+                }
+                in -= d * length * mean;
+                if (mean > 0.0f) next_occ[nb] = 1;
+            };
+            u32 west = (x0 + width_ - 1) % width_, east = x1 % width_;
+            exchange(ty * tiles_x_ + (tx + tiles_x_ - 1) % tiles_x_, west, west + 1, y0, y1);
+            exchange(ty * tiles_x_ + (tx + 1) % tiles_x_, east, east + 1, y0, y1);
+            if (ty > 0) exchange(t - tiles_x_, x0, x1, y0 - 1, y0);
+            if (ty + 1 < tiles_y_) exchange(t + tiles_x_, x0, x1, y1, y1 + 1);
+            flux[t] = static_cast<f32>(in);
+        }
+
+        // Exact logistic over the sub-step, as for cells
+        const f32 g = e - 1.0f;
+        for (u32 t = 0; t < tile_count(); t++) {
+            if (!coarse_tile_[t]) continue;
+            size_t i = tile_index(s, t);
+            f32 capacity = tile_capacity_[i];
+            f32 inv_k = capacity > 0.0f ? 1.0f / capacity : HOSTILE;
+            f32 m = std::max(0.0f, coarse_[i] + flux[t]);
+            f32 n = m * e / (1.0f + m * inv_k * g);
+            coarse_[i] = n < EXTINCT ? 0.0f : n;
+            next_occ[t] = coarse_[i] > 0.0f;
+        }
+    }
+
+    void step_tile(const TileJob& job, f32 d, f32 e, f32* inv_k) {
+        const f32* table = inv_capacity_.data() + job.species * BIOME_COUNT;
+        const f32* src = density_.data() + job.species * cells();
+        f32* dst = next_.data() + job.species * cells();
+        u32 x0 = (job.tile % tiles_x_) * TILE, x1 = std::min(x0 + TILE, width_);
+        u32 y0 = (job.tile / tiles_x_) * TILE, y1 = std::min(y0 + TILE, height_);
+
+        for (u32 y = y0; y < y1; y++) {
+            size_t row = static_cast<size_t>(y) * width_;
+            const BiomeType* biome = biomes_.data() + row;
+            for (u32 x = x0; x < x1; x++) inv_k[x - x0] = table[static_cast<size_t>(biome[x])];
+
+            // Closed poles: the missing neighbour row mirrors the edge row
+            const f32* mid = src + row;
+            const f32* up = y > 0 ? mid - width_ : mid;
+            const f32* down = y + 1 < height_ ? mid + width_ : mid;
+            f32* out = dst + row;
+            reaction_diffusion_span(up, mid, down, inv_k, out, width_, x0, x1, d, e);
+        }
+
+        // Densities are never negative; an occupied tile usually shows it
+        // in its first cell
+        bool any = false;
+        for (u32 y = y0; y < y1 && !any; y++) {
+            const f32* row = dst + static_cast<size_t>(y) * width_;
+            any = std::any_of(row + x0, row + x1, [](f32 v) { return v > 0.0f; });
+        }
+        next_occupied_[tile_index(job.species, job.tile)] = any;
+    }
+
+    u32 width_ = 0, height_ = 0;
+    std::vector<SpeciesTraits> species_;
+    std::vector<f32> inv_capacity_;  // species × BIOME_COUNT
+    std::vector<BiomeType> biomes_;  // One per cell
+    std::vector<f32> density_;       // species × cells, species-major
+    std::vector<f32> next_;          // Written by step(), then swapped in
+
+    // ─── Active Tiles ───
+    u32 tiles_x_ = 0, tiles_y_ = 0;
+    std::vector<u8> occupied_;       // species × tiles: population in density_
+    std::vector<u8> next_occupied_;  // Same for next_
+    std::vector<u8> stale_;          // Per species: occupied_ needs a rescan
+    std::vector<TileJob> jobs_;
+
+    // ─── Coarse Tiles ───
+    std::vector<u8> coarse_tile_;    // Per tile: dehydrated, for every species
+    u32 coarse_count_ = 0;
+    std::vector<f32> coarse_;        // species × tiles: total density of coarse tiles
+    std::vector<f32> coarse_flux_;   // species × tiles: scratch for step_coarse()
+    std::vector<f32> tile_capacity_; // species × tiles: Σ capacity over the tile
+};
+
+} // namespace godsim
@@ -1,11 +1,26 @@
 #pragma once
 
 #include "layers/Layer.h"
+#include "layers/planetary/PlanetData.h"
+#include "layers/planetary/Pathfinder.h"
+#include "core/util/Profiler.h"
+#include "SettlementPool.h"
 
 namespace godsim {
 
+/// The Civilisation layer simulates settlements on the planet surface.
+/// Each settlement is a Registry entity with a CellLocation (so it is
+/// spatially indexed); its hot state lives in a SettlementPool and is
+/// advanced by batched systems each tick.
 class CivilisationLayer : public Layer {
 public:
+    static constexpr u32 DEFAULT_SETTLEMENTS = 256;
+    static constexpr f32 ABANDON_POPULATION = 10.0f;
+    static constexpr f32 FOUNDING_POPULATION = 200.0f; // Smallest town that sends settlers
+    static constexpr f32 FOUNDING_RATE = 0.1f;          // Attempts per crowded town per year
+    static constexpr i32 FOUNDING_RANGE = 6;            // Cells settlers travel
+    static constexpr f32 MIN_SPACING = 2.0f;            // Cells between settlements
+
     LayerID     id()   const override { return LayerID::Civilisation; }
     std::string name() const override { return "Civilisation"; }
 
@@ -17,11 +32,54 @@ public:
     }
 
     void shutdown() override {
-        LOG_INFO("CivilisationLayer shutdown (ticked {} times)", tick_count_);
+        LOG_INFO("CivilisationLayer shutdown (ticked {} times, {} settlements, {:.0f} people)",
+                 tick_count_, pool_.size(), pool_.total_population());
+    }
+
+    /// Found `count` villages on random habitable land.
+    void settle(const PlanetData& planet, u32 count = DEFAULT_SETTLEMENTS) {
+        planet_ = &planet;
+        if (!registry_->spatial().configured()) {
+            registry_->configure_spatial(planet.width, planet.height);
+        }
+        paths_.build(planet);
+        u32 placed = 0;
+        for (u32 attempt = 0; attempt < count * 50 && placed < count; attempt++) {
+            u32 x = static_cast<u32>(rng_->next_int(0, static_cast<i32>(planet.width) - 1));
+            u32 y = static_cast<u32>(rng_->next_int(0, static_cast<i32>(planet.height) - 1));
+            if (!can_found(x, y)) continue;
+            found(x, y, rng_->next_float(100.0f, 1000.0f));
+            placed++;
+        }
+        LOG_INFO("  Founded {} settlements", placed);
     }
 
+    const SettlementPool& settlements() const { return pool_; }
+    SettlementParams& params() { return params_; }
+
+    /// Overland routes between settlements (and anywhere else on land).
+    Pathfinder& paths() { return paths_; }
+
+    /// Terrain under `edits` changed (terraforming): refresh routes.
+    void terrain_changed(const DirtyRegion& edits) { paths_.update(edits); }
+
     void tick(SimTime current_time, SimTime delta_time) override {
         increment_tick();
+        if (planet_ && !pool_.empty()) {
+            f32 years = static_cast<f32>(delta_time.years());
+            {
+                ProfileScope scope("Civilisation.environment");
+                sample_environment(pool_, *planet_, params_);
+            }
+            {
+                ProfileScope scope("Civilisation.economy");
+                update_settlements(pool_, params_, years);
+            }
+            {
+                ProfileScope scope("Civilisation.lifecycle");
+                update_lifecycle(current_time, years);
+            }
+        }
         bus_->emit(
             LayerTickedEvent{LayerID::Civilisation, current_time, delta_time},
             current_time, ALL_LAYERS
@@ -30,16 +88,98 @@ public:
 
     void serialise(BinaryWriter& writer) const override {
         writer.write_u64(tick_count_);
+        writer.write_u32(planet_ ? planet_->width : 0);
+        pool_.serialise(writer);
+        for (EntityID e : pool_.entity) writer.write_u64(e.value);
     }
 
-    void deserialise(BinaryReader& reader) override {
+    /// Settlements come back under their stored IDs at their stored cells
+    /// (as new entities before version 5).
+    void deserialise(BinaryReader& reader, u32 version) override {
         tick_count_ = reader.read_u64();
+        if (version < 2) return; // Settlements weren't kept before version 2
+        u32 width = reader.read_u32();
+        u32 n = reader.read_u32();
+        std::vector<u32> cells(n);
+        std::vector<f32> population(n), food(n), wealth(n), growth(n);
+        reader.read_bytes(cells.data(), n * sizeof(u32));
+        reader.read_bytes(population.data(), n * sizeof(f32));
+        reader.read_bytes(food.data(), n * sizeof(f32));
+        reader.read_bytes(wealth.data(), n * sizeof(f32));
+        reader.read_bytes(growth.data(), n * sizeof(f32));
+        std::vector<EntityID> ids(n);
+        if (version >= 5) {
+            for (EntityID& e : ids) e = EntityID{reader.read_u64()};
+            registry_->restore_entities(pool_.entity, ids);
+        } else {
+            for (EntityID e : pool_.entity) registry_->destroy_entity(e);
+            for (EntityID& e : ids) e = registry_->create_entity(LayerID::Civilisation);
+        }
+        pool_.clear();
+        for (u32 i = 0; i < n; i++) {
+            EntityID e = ids[i];
+            if (width) registry_->set_location(e, cells[i] % width + 0.5f, cells[i] / width + 0.5f);
+            u32 index = pool_.add(e, cells[i], population[i], growth[i]);
+            pool_.food[index] = food[i];
+            pool_.wealth[index] = wealth[i];
+        }
     }
 
 private:
+    bool can_found(u32 x, u32 y) const {
+        u32 c = y * planet_->width + x;
+        if (settlement_habitability(planet_->biome_map[c]) < 0.3f) return false;
+        return !registry_->spatial().nearest(x + 0.5f, y + 0.5f, MIN_SPACING).is_valid();
+    }
+
+    EntityID found(u32 x, u32 y, f32 people) {
+        EntityID e = registry_->create_entity(LayerID::Civilisation);
+        registry_->set_location(e, x + 0.5f, y + 0.5f);
+        pool_.add(e, y * planet_->width + x, people, rng_->next_float(0.01f, 0.03f));
+        return e;
+    }
+
+    /// Abandon dead settlements and send settlers out of crowded ones.
+    /// Serial: it touches the registry, and few settlements qualify.
+    void update_lifecycle(SimTime now, f32 years) {
+        for (u32 i = static_cast<u32>(pool_.size()); i-- > 0;) {
+            if (pool_.population[i] >= ABANDON_POPULATION) continue;
+            EntityID e = pool_.entity[i];
+            pool_.remove(i);
+            registry_->destroy_entity(e);
+            bus_->emit(EntityDestroyedEvent{e, LayerID::Civilisation}, now, ALL_LAYERS);
+        }
+
+        const u32 existing = static_cast<u32>(pool_.size());
+        const f32 chance = std::min(FOUNDING_RATE * years, 1.0f);
+        for (u32 i = 0; i < existing; i++) {
+            f32 p = pool_.population[i];
+            if (p < FOUNDING_POPULATION || p * pool_.inv_capacity[i] < 0.8f) continue;
+            if (rng_->next_float() >= chance) continue;
+
+            i32 w = static_cast<i32>(planet_->width), h = static_cast<i32>(planet_->height);
+            i32 x = static_cast<i32>(pool_.cell[i] % planet_->width) +
+                    rng_->next_int(-FOUNDING_RANGE, FOUNDING_RANGE);
+            i32 y = static_cast<i32>(pool_.cell[i] / planet_->width) +
+                    rng_->next_int(-FOUNDING_RANGE, FOUNDING_RANGE);
+            if (y < 0 || y >= h) continue;
+            x = (x % w + w) % w;
+            if (!can_found(static_cast<u32>(x), static_cast<u32>(y))) continue;
+
+            f32 settlers = p * 0.2f;
+            pool_.population[i] -= settlers;
+            EntityID e = found(static_cast<u32>(x), static_cast<u32>(y), settlers);
+            bus_->emit(EntityCreatedEvent{e, LayerID::Civilisation}, now, ALL_LAYERS);
+        }
+    }
+
     Registry* registry_ = nullptr;
     EventBus* bus_ = nullptr;
     RNG* rng_ = nullptr;
+    const PlanetData* planet_ = nullptr;
+    SettlementParams params_;
+    SettlementPool pool_;
+    Pathfinder paths_;
 };
 
 } // namespace godsim
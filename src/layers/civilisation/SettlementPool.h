@@ -0,0 +1,216 @@
+#pragma once
+
+#include "layers/planetary/Biome.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/ecs/EntityID.h"
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+/// How well each biome supports farming settlements, [0, 1].
+inline f32 settlement_habitability(BiomeType biome) {
+    static constexpr f32 TABLE[static_cast<size_t>(BiomeType::COUNT)] = {
+        0.0f,  // Ocean
+        0.0f,  // DeepOcean
+        0.0f,  // Ice
+        0.1f,  // Tundra
+        0.35f, // BorealForest
+        0.9f,  // TemperateGrassland
+        0.75f, // TemperateForest
+        0.55f, // TemperateRainforest
+        0.45f, // Shrubland
+        0.08f, // Desert
+        0.6f,  // Savanna
+        0.5f,  // TropicalForest
+        0.35f, // TropicalRainforest
+        0.65f, // Wetland
+        0.12f, // Mountain
+        0.4f,  // Beach
+    };
+    return TABLE[static_cast<size_t>(biome)];
+}
+
+/// Tunables for the settlement economy. Rates are per year.
+struct SettlementParams {
+    f32 people_per_cell = 20000.0f; // Population a perfectly habitable cell supports
+    f32 food_per_capita = 1.0f;     // Consumed per person per year
+    f32 base_yield = 2.5f;          // Produced per person per year on ideal land
+    f32 storage_years = 2.0f;       // Granaries hold this many years of need
+    f32 spoilage = 0.2f;            // Fraction of stores lost per year
+    f32 famine_mortality = 0.3f;    // Death rate when nobody is fed
+    f32 surplus_price = 0.01f;      // Wealth per unit of food sold beyond storage
+    f32 comfort_temperature = 16.0f;
+    f32 comfort_range = 30.0f;      // °C from comfort at which land is useless
+};
+
+/// Hot settlement state in structure-of-arrays form: one contiguous
+/// array per field, index-aligned, so systems sweep the fields they
+/// need and vectorise. Removal swaps the last settlement into the gap;
+/// index_of() follows entities through that.
+class SettlementPool {
+public:
+    // ─── Persistent State ───
+    std::vector<EntityID> entity;
+    std::vector<u32> cell;          // y * width + x on the planet grid
+    std::vector<f32> population;
+    std::vector<f32> food;          // Stored food, person-years
+    std::vector<f32> wealth;
+    std::vector<f32> growth_rate;   // Intrinsic growth, per year
+
+    // ─── Derived Each Tick (sample_environment) ───
+    std::vector<f32> inv_capacity;  // 1 / population the cell supports
+    std::vector<f32> yield;         // Food per person per year
+
+    size_t size() const { return entity.size(); }
+    bool empty() const { return entity.empty(); }
+
+    u32 add(EntityID id, u32 cell_index, f32 people, f32 rate) {
+        u32 index = static_cast<u32>(size());
+        entity.push_back(id);
+        cell.push_back(cell_index);
+        population.push_back(people);
+        food.push_back(0.0f);
+        wealth.push_back(0.0f);
+        growth_rate.push_back(rate);
+        inv_capacity.push_back(0.0f);
+        yield.push_back(0.0f);
+        index_[id] = index;
+        return index;
+    }
+
+    void remove(u32 index) {
+        u32 last = static_cast<u32>(size()) - 1;
+        index_.erase(entity[index]);
+        if (index != last) {
+            move_slot(last, index);
+            index_[entity[index]] = index;
+        }
+        entity.pop_back();
+        cell.pop_back();
+        population.pop_back();
+        food.pop_back();
+        wealth.pop_back();
+        growth_rate.pop_back();
+        inv_capacity.pop_back();
+        yield.pop_back();
+    }
+
+    void clear() {
+        *this = SettlementPool{};
+    }
+
+    /// Index of the entity's settlement, or -1.
+    i64 index_of(EntityID id) const {
+        auto it = index_.find(id);
+        return it != index_.end() ? static_cast<i64>(it->second) : -1;
+    }
+
+    f64 total_population() const {
+        f64 sum = 0.0;
+        for (f32 p : population) sum += p;
+        return sum;
+    }
+
+    // ─── Serialisation ───
+    // Entities are the owner's to store; it restores them and calls add().
+
+    void serialise(BinaryWriter& writer) const {
+        u32 n = static_cast<u32>(size());
+        writer.write_u32(n);
+        writer.write_bytes(cell.data(), n * sizeof(u32));
+        writer.write_bytes(population.data(), n * sizeof(f32));
+        writer.write_bytes(food.data(), n * sizeof(f32));
+        writer.write_bytes(wealth.data(), n * sizeof(f32));
+        writer.write_bytes(growth_rate.data(), n * sizeof(f32));
+    }
+
+private:
+    void move_slot(u32 from, u32 to) {
+        entity[to] = entity[from];
+        cell[to] = cell[from];
+        population[to] = population[from];
+        food[to] = food[from];
+        wealth[to] = wealth[from];
+        growth_rate[to] = growth_rate[from];
+        inv_capacity[to] = inv_capacity[from];
+        yield[to] = yield[from];
+    }
+
+    std::unordered_map<EntityID, u32> index_;
+};
+
+// ─── Systems ───
+// Each runs over the whole pool in parallel batches.
+
+/// Read biome and temperature under every settlement into the derived
+/// arrays. This is the only pass that touches the planet grids.
+inline void sample_environment(SettlementPool& pool, const PlanetData& planet,
+                               const SettlementParams& params) {
+    parallel_for(0, static_cast<u32>(pool.size()), [&](u32 lo, u32 hi) {
+        for (u32 i = lo; i < hi; i++) {
+            u32 c = pool.cell[i];
+            f32 land = settlement_habitability(planet.biome_map[c]);
+            f32 t = planet.temperature.data_ptr()[c];
+            f32 comfort = std::max(
+                0.0f, 1.0f - std::abs(t - params.comfort_temperature) / params.comfort_range);
+            f32 habitability = land * (0.5f + 0.5f * comfort);
+            pool.inv_capacity[i] = 1.0f / std::max(params.people_per_cell * habitability, 1.0f);
+            pool.yield[i] = params.base_yield * habitability;
+        }
+    }, 4096);
+}
+
+/// Harvest, eat, store, sell and grow settlements [lo, hi) over `years`.
+/// Branch-free over contiguous arrays:
+///
+///   stock  = food + pop·(yield − need)·dt
+///   unfed  = max(−stock, 0) / (pop·need·dt)
+///   pop   += pop·(r·(1 − pop/K) − famine·unfed)·dt
+///
+/// Stores above the granary limit are sold for wealth.
+inline void settlement_economy_span(f32* __restrict pop, f32* __restrict food,
+                                    f32* __restrict wealth, const f32* __restrict rate,
+                                    const f32* __restrict inv_k, const f32* __restrict yield,
+                                    size_t lo, size_t hi, const SettlementParams& params,
+                                    f32 years) {
+    const f32 need = params.food_per_capita;
+    const f32 keep = std::max(1.0f - params.spoilage * years, 0.0f);
+    const f32 storage = need * params.storage_years;
+    const f32 price = params.surplus_price;
+    const f32 famine = params.famine_mortality;
+    // By-value min/max: std::min/max return references, which leave
+    // branches in the loop and stop it vectorising
+    auto lo_of = [](f32 a, f32 b) { return a < b ? a : b; };
+    auto hi_of = [](f32 a, f32 b) { return a > b ? a : b; };
+
+    for (size_t i = lo; i < hi; i++) {
+        f32 p = pop[i];
+        f32 eaten = p * need * years;
+        f32 stock = food[i] * keep + p * yield[i] * years - eaten;
+        f32 unfed = hi_of(-stock, 0.0f) / hi_of(eaten, 1e-6f);
+        stock = hi_of(stock, 0.0f);
+        f32 granary = p * storage;
+        wealth[i] += hi_of(stock - granary, 0.0f) * price;
+        food[i] = lo_of(stock, granary);
+        f32 r = rate[i] * (1.0f - p * inv_k[i]) - famine * unfed;
+        pop[i] = hi_of(p + p * r * years, 0.0f);
+    }
+}
+
+/// Run the settlement economy over the whole pool.
+inline void update_settlements(SettlementPool& pool, const SettlementParams& params, f32 years) {
+    parallel_for(0, static_cast<u32>(pool.size()), [&](u32 lo, u32 hi) {
+        settlement_economy_span(pool.population.data(), pool.food.data(), pool.wealth.data(),
+                                pool.growth_rate.data(), pool.inv_capacity.data(),
+                                pool.yield.data(), lo, hi, params, years);
+    }, 4096);
+}
+
+} // namespace godsim
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "Celestial.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace godsim {
+
+/// Barnes–Hut octree over point masses, for O(N log N) gravity.
+///
+/// build() sorts the bodies along a Morton (Z-order) curve, so every node
+/// covers a contiguous range of the sorted copies and children are found
+/// by binary search on the keys. The top levels are split serially and
+/// the subtrees below them are built in parallel, then spliced into one
+/// node array. accelerations() walks the tree once per group of up to
+/// GROUP_SIZE neighbouring bodies, in parallel, and sums the shared
+/// interaction list over the group in a flat loop.
+///
+/// A node is used as a single mass when d > s/θ + δ, where d is the
+/// distance from its centre of mass to the group's bounding box, s its side and δ the offset of the
+/// centre of mass from the cell centre (Barnes' criterion, which stays
+/// safe when a body sits near a lopsided cell's corner).
+class BarnesHut {
+public:
+    static constexpr u32 LEAF_SIZE = 8;
+    static constexpr u32 MAX_DEPTH = 21; // Bits per axis in the Morton key
+    static constexpr u32 SPLIT_DEPTH = 2; // Levels built serially before going parallel
+    static constexpr u32 GROUP_SIZE = 32; // Bodies sharing one tree walk
+
+    struct Node {
+        f64 cx = 0.0, cy = 0.0, cz = 0.0; // Centre of mass
+        f64 mass = 0.0;
+        f64 size = 0.0;   // Side of the cell
+        f64 offset = 0.0; // Centre of mass to cell centre
+        u32 begin = 0, end = 0; // Sorted body range
+        u32 first_child = 0;
+        u32 child_count = 0;
+
+        bool leaf() const { return child_count == 0; }
+    };
+
+    /// Build over n bodies. Positions are copied; the tree is valid until
+    /// the next build().
+    void build(const f64* x, const f64* y, const f64* z, const f64* mass, u32 n) {
+        nodes_.clear();
+        count_ = n;
+        if (n == 0) return;
+
+        // ─── Bounding cube ───
+        f64 lo[3] = {x[0], y[0], z[0]}, hi[3] = {x[0], y[0], z[0]};
+        for (u32 i = 1; i < n; i++) {
+            lo[0] = std::min(lo[0], x[i]); hi[0] = std::max(hi[0], x[i]);
+            lo[1] = std::min(lo[1], y[i]); hi[1] = std::max(hi[1], y[i]);
+            lo[2] = std::min(lo[2], z[i]); hi[2] = std::max(hi[2], z[i]);
+        }
+        size_ = std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2], 1e-9}) * (1.0 + 1e-9);
+        origin_[0] = lo[0];
+        origin_[1] = lo[1];
+        origin_[2] = lo[2];
+
+        // ─── Morton keys, sorted ───
+        keys_.resize(n);
+        const f64 scale = static_cast<f64>(1u << MAX_DEPTH) / size_;
+        parallel_for(0, n, [&](u32 b, u32 e) {
+            for (u32 i = b; i < e; i++) {
+                keys_[i] = {morton(quantise((x[i] - lo[0]) * scale),
+                                   quantise((y[i] - lo[1]) * scale),
+                                   quantise((z[i] - lo[2]) * scale)), i};
+            }
+        }, 4096);
+        parallel_sort(keys_);
+
+        order_.resize(n);
+        px_.resize(n);
+        py_.resize(n);
+        pz_.resize(n);
+        pm_.resize(n);
+        parallel_for(0, n, [&](u32 b, u32 e) {
+            for (u32 k = b; k < e; k++) {
+                u32 i = keys_[k].second;
+                order_[k] = i;
+                px_[k] = x[i];
+                py_[k] = y[i];
+                pz_[k] = z[i];
+                pm_[k] = mass[i];
+            }
+        }, 4096);
+
+        // ─── Top levels serially, subtrees in parallel ───
+        struct Task {
+            u32 node;
+            u32 begin, end, depth;
+        };
+        std::vector<Task> tasks;
+        std::vector<std::pair<u32, u32>> shallow; // (node, depth) built here, parents first
+        nodes_.push_back({});
+        std::vector<Task> frontier{{0, 0, n, 0}};
+        while (!frontier.empty()) {
+            Task t = frontier.back();
+            frontier.pop_back();
+            if (t.depth == SPLIT_DEPTH || t.end - t.begin <= LEAF_SIZE) {
+                tasks.push_back(t);
+                continue;
+            }
+            shallow.push_back({t.node, t.depth});
+            split(nodes_, t.node, t.begin, t.end, t.depth, [&](u32 child, u32 b, u32 e) {
+                frontier.push_back({child, b, e, t.depth + 1});
+            });
+        }
+
+        std::vector<std::vector<Node>> subtrees(tasks.size());
+        parallel_for(0, static_cast<u32>(tasks.size()), [&](u32 b, u32 e) {
+            for (u32 i = b; i < e; i++) {
+                subtrees[i].push_back({});
+                build_subtree(subtrees[i], 0, tasks[i].begin, tasks[i].end, tasks[i].depth);
+            }
+        }, 1);
+
+        // Splice: subtree index j > 0 lands at offset + j − 1, its root in place
+        for (size_t i = 0; i < tasks.size(); i++) {
+            auto& sub = subtrees[i];
+            u32 offset = static_cast<u32>(nodes_.size());
+            for (auto& node : sub) {
+                if (!node.leaf()) node.first_child += offset - 1;
+            }
+            nodes_[tasks[i].node] = sub[0];
+            nodes_.insert(nodes_.end(), sub.begin() + 1, sub.end());
+        }
+        for (auto it = shallow.rbegin(); it != shallow.rend(); ++it) {
+            finish(nodes_, it->first, it->second);
+        }
+    }
+
+    /// Gravitational acceleration on every body (by original index),
+    /// with Plummer softening `softening` (pc) and opening angle `theta`.
+    void accelerations(f64 theta, f64 softening, f64* ax, f64* ay, f64* az) const {
+        if (count_ == 0) return;
+        // Groups: the largest nodes holding at most GROUP_SIZE bodies
+        std::vector<u32> groups, stack{0};
+        while (!stack.empty()) {
+            u32 index = stack.back();
+            stack.pop_back();
+            const Node& node = nodes_[index];
+            if (node.leaf() || node.end - node.begin <= GROUP_SIZE) {
+                groups.push_back(index);
+            } else {
+                for (u32 c = 0; c < node.child_count; c++) stack.push_back(node.first_child + c);
+            }
+        }
+        const f64 inv_theta = 1.0 / theta;
+        const f64 eps2 = softening * softening;
+        parallel_for(0, static_cast<u32>(groups.size()), [&](u32 b, u32 e) {
+            Interactions list;
+            std::vector<u32> pending;
+            for (u32 g = b; g < e; g++) {
+                const Node& group = nodes_[groups[g]];
+                gather(group, inv_theta, pending, list);
+                for (u32 k = group.begin; k < group.end; k++) {
+                    f64 a[3];
+                    sum(list, px_[k], py_[k], pz_[k], eps2, a);
+                    u32 i = order_[k];
+                    ax[i] = GRAVITY * a[0];
+                    ay[i] = GRAVITY * a[1];
+                    az[i] = GRAVITY * a[2];
+                }
+            }
+        }, 16);
+    }
+
+    const std::vector<Node>& nodes() const { return nodes_; }
+    u32 body_count() const { return count_; }
+
+private:
+    /// Point masses one group's bodies interact with: accepted nodes and
+    /// the bodies of opened leaves, the group's own included.
+    struct Interactions {
+        std::vector<f64> x, y, z, m;
+        void clear() { x.clear(); y.clear(); z.clear(); m.clear(); }
+        void add(f64 px, f64 py, f64 pz, f64 pm) {
+            x.push_back(px); y.push_back(py); z.push_back(pz); m.push_back(pm);
+        }
+    };
+
+    /// Walk once for a whole group, accepting a node only if it passes the
+    /// opening test from the nearest point of the group's bounding box, so
+    /// it is far enough from every body in the group.
+    void gather(const Node& group, f64 inv_theta, std::vector<u32>& stack, Interactions& list) const {
+        f64 lo[3] = {px_[group.begin], py_[group.begin], pz_[group.begin]};
+        f64 hi[3] = {lo[0], lo[1], lo[2]};
+        for (u32 k = group.begin + 1; k < group.end; k++) {
+            lo[0] = std::min(lo[0], px_[k]); hi[0] = std::max(hi[0], px_[k]);
+            lo[1] = std::min(lo[1], py_[k]); hi[1] = std::max(hi[1], py_[k]);
+            lo[2] = std::min(lo[2], pz_[k]); hi[2] = std::max(hi[2], pz_[k]);
+        }
+        list.clear();
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = nodes_[stack.back()];
+            stack.pop_back();
+            f64 dx = std::max({lo[0] - node.cx, node.cx - hi[0], 0.0});
+            f64 dy = std::max({lo[1] - node.cy, node.cy - hi[1], 0.0});
+            f64 dz = std::max({lo[2] - node.cz, node.cz - hi[2], 0.0});
+            f64 open = node.size * inv_theta + node.offset;
+            if (dx * dx + dy * dy + dz * dz > open * open) {
+                list.add(node.cx, node.cy, node.cz, node.mass);
+            } else if (node.leaf()) {
+                for (u32 j = node.begin; j < node.end; j++) list.add(px_[j], py_[j], pz_[j], pm_[j]);
+            } else {
+                for (u32 c = 0; c < node.child_count; c++) stack.push_back(node.first_child + c);
+            }
+        }
+    }
+
+    /// Acceleration / G at (x, y, z) from every entry in the list. A body
+    /// meets itself at zero distance, which contributes nothing.
+    static void sum(const Interactions& list, f64 x, f64 y, f64 z, f64 eps2, f64* a) {
+        const f64* __restrict lx = list.x.data();
+        const f64* __restrict ly = list.y.data();
+        const f64* __restrict lz = list.z.data();
+        const f64* __restrict lm = list.m.data();
+        const u32 n = static_cast<u32>(list.m.size());
+        f64 sx = 0.0, sy = 0.0, sz = 0.0;
+        for (u32 j = 0; j < n; j++) {
+            f64 dx = lx[j] - x, dy = ly[j] - y, dz = lz[j] - z;
+            f64 r2 = dx * dx + dy * dy + dz * dz + eps2;
+            f64 s = r2 > 0.0 ? lm[j] / (r2 * std::sqrt(r2)) : 0.0;
+            sx += dx * s;
+            sy += dy * s;
+            sz += dz * s;
+        }
+        a[0] = sx;
+        a[1] = sy;
+        a[2] = sz;
+    }
+
+    static u32 quantise(f64 v) {
+        constexpr f64 top = static_cast<f64>((1u << MAX_DEPTH) - 1);
+        return static_cast<u32>(std::clamp(v, 0.0, top));
+    }
+
+    /// Spread the low 21 bits of v to every third bit.
+    static u64 spread(u32 v) {
+        u64 x = v & 0x1FFFFF;
+        x = (x | x << 32) & 0x1F00000000FFFFull;
+        x = (x | x << 16) & 0x1F0000FF0000FFull;
+        x = (x | x << 8)  & 0x100F00F00F00F00Full;
+        x = (x | x << 4)  & 0x10C30C30C30C30C3ull;
+        x = (x | x << 2)  & 0x1249249249249249ull;
+        return x;
+    }
+
+    static u64 morton(u32 x, u32 y, u32 z) { return spread(x) | spread(y) << 1 | spread(z) << 2; }
+
+    /// Sort chunks in parallel, then merge them pairwise.
+    static void parallel_sort(std::vector<std::pair<u64, u32>>& v) {
+        const u32 n = static_cast<u32>(v.size());
+        const u32 chunks = std::max(1u, std::min(ThreadPool::instance().size(), n / 16384));
+        std::vector<u32> bounds(chunks + 1);
+        for (u32 c = 0; c <= chunks; c++) bounds[c] = static_cast<u32>(static_cast<u64>(n) * c / chunks);
+        parallel_for(0, chunks, [&](u32 b, u32 e) {
+            for (u32 c = b; c < e; c++) std::sort(v.begin() + bounds[c], v.begin() + bounds[c + 1]);
+        }, 1);
+        for (u32 width = 1; width < chunks; width *= 2) {
+            u32 pairs = (chunks + 2 * width - 1) / (2 * width);
+            parallel_for(0, pairs, [&](u32 b, u32 e) {
+                for (u32 p = b; p < e; p++) {
+                    u32 first = p * 2 * width;
+                    u32 mid = std::min(first + width, chunks), last = std::min(first + 2 * width, chunks);
+                    if (mid == last) continue;
+                    std::inplace_merge(v.begin() + bounds[first], v.begin() + bounds[mid],
+                                       v.begin() + bounds[last]);
+                }
+            }, 1);
+        }
+    }
+
+    /// Create the children of `index` (one per occupied octant, stored
+    /// contiguously) and call fn(child, begin, end) for each.
+    template<typename Fn>
+    void split(std::vector<Node>& nodes, u32 index, u32 begin, u32 end, u32 depth, Fn&& fn) const {
+        const u32 shift = 3 * (MAX_DEPTH - 1 - depth);
+        const f64 size = size_ / static_cast<f64>(1u << depth);
+        u32 ranges[9];
+        ranges[0] = begin;
+        u32 count = 0;
+        for (u32 o = 0; o < 8; o++) {
+            auto it = std::partition_point(keys_.begin() + ranges[o], keys_.begin() + end,
+                                           [&](const auto& key) { return ((key.first >> shift) & 7) <= o; });
+            ranges[o + 1] = static_cast<u32>(it - keys_.begin());
+            if (ranges[o + 1] > ranges[o]) count++;
+        }
+        u32 first = static_cast<u32>(nodes.size());
+        nodes[index].first_child = first;
+        nodes[index].child_count = count;
+        nodes[index].size = size;
+        nodes[index].begin = begin;
+        nodes[index].end = end;
+        nodes.resize(first + count);
+        u32 child = first;
+        for (u32 o = 0; o < 8; o++) {
+            if (ranges[o + 1] > ranges[o]) fn(child++, ranges[o], ranges[o + 1]);
+        }
+    }
+
+    void build_subtree(std::vector<Node>& nodes, u32 index, u32 begin, u32 end, u32 depth) const {
+        if (end - begin <= LEAF_SIZE || depth >= MAX_DEPTH) {
+            Node& leaf = nodes[index];
+            leaf.begin = begin;
+            leaf.end = end;
+            leaf.size = size_ / static_cast<f64>(1u << depth);
+            leaf.child_count = 0;
+            finish(nodes, index, depth);
+            return;
+        }
+        split(nodes, index, begin, end, depth, [&](u32 child, u32 b, u32 e) {
+            build_subtree(nodes, child, b, e, depth + 1);
+        });
+        finish(nodes, index, depth);
+    }
+
+    /// Mass, centre of mass and centre offset from the children (or bodies).
+    void finish(std::vector<Node>& nodes, u32 index, u32 depth) const {
+        Node& node = nodes[index];
+        f64 m = 0.0, cx = 0.0, cy = 0.0, cz = 0.0;
+        if (node.leaf()) {
+            for (u32 j = node.begin; j < node.end; j++) {
+                m += pm_[j];
+                cx += pm_[j] * px_[j];
+                cy += pm_[j] * py_[j];
+                cz += pm_[j] * pz_[j];
+            }
+        } else {
+            for (u32 c = 0; c < node.child_count; c++) {
+                const Node& child = nodes[node.first_child + c];
+                m += child.mass;
+                cx += child.mass * child.cx;
+                cy += child.mass * child.cy;
+                cz += child.mass * child.cz;
+            }
+        }
+        node.mass = m;
+        if (m > 0.0) {
+            node.cx = cx / m;
+            node.cy = cy / m;
+            node.cz = cz / m;
+        } else {
+            node.cx = px_[node.begin];
+            node.cy = py_[node.begin];
+            node.cz = pz_[node.begin];
+        }
+
+        // Cell centre from the Morton prefix of any body inside
+        const u64 key = keys_[node.begin].first;
+        const u32 shift = MAX_DEPTH - depth;
+        f64 centre[3];
+        for (u32 axis = 0; axis < 3; axis++) {
+            u32 q = 0;
+            for (u32 bit = 0; bit < MAX_DEPTH; bit++) q |= static_cast<u32>((key >> (3 * bit + axis)) & 1) << bit;
+            u32 cell = depth == 0 ? 0 : q >> shift;
+            centre[axis] = origin_[axis] + (static_cast<f64>(cell) + 0.5) * node.size;
+        }
+        f64 ox = node.cx - centre[0], oy = node.cy - centre[1], oz = node.cz - centre[2];
+        node.offset = std::sqrt(ox * ox + oy * oy + oz * oz);
+    }
+
+    std::vector<Node> nodes_;
+    std::vector<std::pair<u64, u32>> keys_; // (Morton key, body), sorted
+    std::vector<u32> order_;                // Sorted position → body
+    std::vector<f64> px_, py_, pz_, pm_;    // Sorted copies
+    f64 origin_[3] = {};
+    f64 size_ = 1.0;
+    u32 count_ = 0;
+};
+
+} // namespace godsim
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "core/ecs/EntityID.h"
+#include "core/util/Types.h"
+
+#include <cmath>
+
+namespace godsim {
+
+// ─── Units ───
+// The cosmological layer works in parsecs, solar masses and megayears.
+
+/// Gravitational constant in pc³ / (M☉ · Myr²).
+inline constexpr f64 GRAVITY = 4.498502151469554e-3;
+inline constexpr f64 PARSECS_PER_AU = 4.84813681109536e-6;
+
+struct Vec3d {
+    f64 x = 0.0, y = 0.0, z = 0.0;
+
+    Vec3d operator+(const Vec3d& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3d operator-(const Vec3d& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3d operator*(f64 s) const { return {x * s, y * s, z * s}; }
+    f64 dot(const Vec3d& o) const { return x * o.x + y * o.y + z * o.z; }
+    f64 length() const { return std::sqrt(dot(*this)); }
+};
+
+// ─── Components ───
+
+/// Any star, planet or moon.
+struct CelestialBody {
+    f64 mass = 1.0;   // M☉
+    f64 radius = 0.0; // pc
+};
+
+/// A body on a fixed Keplerian orbit around `parent_entity`. It is not
+/// integrated and feels no other body: its state is evaluated in closed
+/// form from these elements, relative to the parent's position.
+struct OrbitalRelation {
+    EntityID parent_entity;
+    f64 semi_major_axis = 0.0;      // pc
+    f64 eccentricity = 0.0;         // [0, 1)
+    f64 inclination = 0.0;          // rad
+    f64 ascending_node = 0.0;       // rad
+    f64 argument_of_periapsis = 0.0; // rad
+    f64 mean_anomaly = 0.0;         // rad, at `epoch`
+    f64 epoch = 0.0;                // Myr
+};
+
+// ─── Kepler Orbits ───
+
+/// Eccentric anomaly E with E − e·sin E = M (Newton's method).
+inline f64 solve_kepler(f64 mean_anomaly, f64 e) {
+    constexpr f64 PI = 3.14159265358979323846;
+    f64 m = std::remainder(mean_anomaly, 2.0 * PI);
+    f64 E = e < 0.8 ? m : (m < 0.0 ? -PI : PI);
+    for (int i = 0; i < 32; i++) {
+        f64 step = (E - e * std::sin(E) - m) / (1.0 - e * std::cos(E));
+        E -= step;
+        if (std::abs(step) < 1e-14) break;
+    }
+    return E;
+}
+
+/// Orbital period in Myr around a total mass of `mass` M☉.
+inline f64 orbital_period(const OrbitalRelation& orbit, f64 mass) {
+    f64 a = orbit.semi_major_axis;
+    return 6.283185307179586 * std::sqrt(a * a * a / (GRAVITY * mass));
+}
+
+/// Position and velocity relative to the parent at time `t` (Myr), for a
+/// parent-plus-body mass of `mass`.
+inline void orbit_state(const OrbitalRelation& orbit, f64 mass, f64 t,
+                        Vec3d& position, Vec3d& velocity) {
+    const f64 a = orbit.semi_major_axis, e = orbit.eccentricity;
+    const f64 n = std::sqrt(GRAVITY * mass / (a * a * a));
+    const f64 E = solve_kepler(orbit.mean_anomaly + n * (t - orbit.epoch), e);
+    const f64 cos_e = std::cos(E), sin_e = std::sin(E);
+    const f64 b = a * std::sqrt(1.0 - e * e);
+    const f64 rate = n / (1.0 - e * cos_e); // dE/dt
+
+    // In the orbital plane, periapsis along +x
+    const f64 px = a * (cos_e - e), py = b * sin_e;
+    const f64 vx = -a * sin_e * rate, vy = b * cos_e * rate;
+
+    // Rotate by Rz(Ω) · Rx(i) · Rz(ω)
+    const f64 co = std::cos(orbit.ascending_node), so = std::sin(orbit.ascending_node);
+    const f64 cw = std::cos(orbit.argument_of_periapsis), sw = std::sin(orbit.argument_of_periapsis);
+    const f64 ci = std::cos(orbit.inclination), si = std::sin(orbit.inclination);
+    const Vec3d p{co * cw - so * sw * ci, so * cw + co * sw * ci, sw * si};
+    const Vec3d q{-co * sw - so * cw * ci, -so * sw + co * cw * ci, cw * si};
+    position = p * px + q * py;
+    velocity = p * vx + q * vy;
+}
+
+} // namespace godsim
@@ -1,11 +1,29 @@
 #pragma once
 
 #include "layers/Layer.h"
+#include "core/util/Profiler.h"
+#include "NBodySystem.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
 
 namespace godsim {
 
+/// The Cosmological layer owns the galaxy: stars integrated under mutual
+/// gravity, and the home system's planet and moon on Kepler orbits.
+/// Each is a Registry entity with a CelestialBody (and an
+/// OrbitalRelation for orbiters); the hot state lives in an NBodySystem.
 class CosmologicalLayer : public Layer {
 public:
+    static constexpr u32 DEFAULT_STARS = 20000;
+    static constexpr f64 DISK_MASS = 6e10;       // M☉
+    static constexpr f64 SCALE_LENGTH = 2600.0;  // Exponential disk, pc
+    static constexpr f64 SCALE_HEIGHT = 300.0;   // pc
+    static constexpr f64 DISK_RADIUS = 15000.0;  // pc
+    static constexpr f64 HOME_RADIUS = 8000.0;   // Home star's distance from the centre, pc
+    static constexpr f64 SOLAR_RADIUS = 2.2546e-8; // pc
+
     LayerID     id()   const override { return LayerID::Cosmological; }
     std::string name() const override { return "Cosmological"; }
 
@@ -17,11 +35,79 @@ public:
     }
 
     void shutdown() override {
-        LOG_INFO("CosmologicalLayer shutdown (ticked {} times)", tick_count_);
+        LOG_INFO("CosmologicalLayer shutdown (ticked {} times, {} stars, {:.1f} Myr)",
+                 tick_count_, system_.size(), system_.time());
+    }
+
+    /// Populate an exponential disk of `stars` stars on near-circular
+    /// orbits, then give the star nearest HOME_RADIUS a planet and moon.
+    void generate_galaxy(u32 stars = DEFAULT_STARS) {
+        const f64 star_mass = DISK_MASS / stars;
+        system_.params().softening = 0.5 * SCALE_LENGTH / std::cbrt(static_cast<f64>(stars));
+
+        // Radius from the exponential disk's cumulative mass, by rejection
+        std::vector<f64> radius(stars), angle(stars), height(stars);
+        for (u32 i = 0; i < stars; i++) {
+            f64 r;
+            do {
+                r = -SCALE_LENGTH * std::log(std::max(1e-12, static_cast<f64>(rng_->next_float())) *
+                                             std::max(1e-12, static_cast<f64>(rng_->next_float())));
+            } while (r > DISK_RADIUS);
+            radius[i] = r;
+            angle[i] = rng_->next_float(0.0f, 6.2831853f);
+            height[i] = SCALE_HEIGHT * std::log(std::max(1e-6f, rng_->next_float())) *
+                        (rng_->next_float() < 0.5f ? -1.0 : 1.0) * 0.5;
+        }
+
+        // Circular speed from the mass inside each radius
+        std::vector<u32> by_radius(stars);
+        std::iota(by_radius.begin(), by_radius.end(), 0u);
+        std::sort(by_radius.begin(), by_radius.end(), [&](u32 a, u32 b) { return radius[a] < radius[b]; });
+        std::vector<f64> speed(stars);
+        for (u32 k = 0; k < stars; k++) {
+            u32 i = by_radius[k];
+            f64 r = std::max(radius[i], system_.params().softening);
+            speed[i] = std::sqrt(GRAVITY * star_mass * k / r);
+        }
+
+        u32 home = 0;
+        for (u32 i = 0; i < stars; i++) {
+            f64 c = std::cos(angle[i]), s = std::sin(angle[i]);
+            f64 v = speed[i] * (1.0 + 0.1 * rng_->next_float(-1.0f, 1.0f));
+            EntityID e = registry_->create_entity(LayerID::Cosmological);
+            registry_->add_component<CelestialBody>(e, CelestialBody{star_mass, SOLAR_RADIUS});
+            system_.add_body(e, {radius[i] * c, radius[i] * s, height[i]}, {-v * s, v * c, 0.0}, star_mass);
+            if (std::abs(radius[i] - HOME_RADIUS) < std::abs(radius[home] - HOME_RADIUS)) home = i;
+        }
+
+        // Home system: an Earth-like planet and its moon
+        OrbitalRelation planet_orbit;
+        planet_orbit.parent_entity = system_.entity[home];
+        planet_orbit.semi_major_axis = 1.0 * PARSECS_PER_AU;
+        planet_orbit.eccentricity = 0.0167;
+        home_planet_ = add_orbiter(planet_orbit, 3.003e-6, 1.0 * SOLAR_RADIUS / 109.0);
+
+        OrbitalRelation moon_orbit;
+        moon_orbit.parent_entity = home_planet_;
+        moon_orbit.semi_major_axis = 0.00257 * PARSECS_PER_AU;
+        moon_orbit.eccentricity = 0.0549;
+        moon_orbit.inclination = 0.0898;
+        add_orbiter(moon_orbit, 3.694e-8, 0.27 * SOLAR_RADIUS / 109.0);
+
+        LOG_INFO("  Galaxy: {} stars, softening {:.1f} pc, home star at {:.0f} pc",
+                 stars, system_.params().softening, radius[home]);
     }
 
+    const NBodySystem& system() const { return system_; }
+    NBodySystem& system() { return system_; }
+    EntityID home_planet() const { return home_planet_; }
+
     void tick(SimTime current_time, SimTime delta_time) override {
         increment_tick();
+        if (system_.size() > 0) {
+            ProfileScope scope("Cosmological.gravity");
+            system_.advance(delta_time.megayears());
+        }
         bus_->emit(
             LayerTickedEvent{LayerID::Cosmological, current_time, delta_time},
             current_time, ALL_LAYERS
@@ -30,16 +116,77 @@ public:
 
     void serialise(BinaryWriter& writer) const override {
         writer.write_u64(tick_count_);
+        writer.write_u32(static_cast<u32>(system_.size()));
+        for (EntityID e : system_.entity) writer.write_u64(e.value);
+        writer.write_u32(static_cast<u32>(system_.orbiters().size()));
+        for (const auto& o : system_.orbiters()) writer.write_u64(o.entity.value);
+        system_.serialise(writer);
+        writer.write_u32(orbiter_of(home_planet_));
     }
 
-    void deserialise(BinaryReader& reader) override {
+    /// Bodies come back under their stored IDs (as new entities in their
+    /// stored order before version 5).
+    void deserialise(BinaryReader& reader, u32 version) override {
         tick_count_ = reader.read_u64();
+        if (version < 2) return; // The system wasn't kept before version 2
+        std::vector<EntityID> current = system_.entity;
+        for (const auto& o : system_.orbiters()) current.push_back(o.entity);
+
+        // Stars mostly outlive a restore; keep their entities rather than
+        // recreating tens of thousands
+        std::vector<EntityID> bodies, orbiters;
+        if (version >= 5) {
+            for (auto* ids : {&bodies, &orbiters}) {
+                ids->resize(reader.read_u32());
+                for (EntityID& e : *ids) e = EntityID{reader.read_u64()};
+            }
+            std::vector<EntityID> stored = bodies;
+            stored.insert(stored.end(), orbiters.begin(), orbiters.end());
+            registry_->restore_entities(current, stored);
+        } else {
+            for (EntityID e : current) registry_->destroy_entity(e);
+        }
+        system_.deserialise(reader, [&](u32 kind, u32 index) {
+            if (version < 5) return registry_->create_entity(LayerID::Cosmological);
+            const auto& ids = kind == 0 ? bodies : orbiters;
+            GODSIM_ASSERT(index < ids.size(), "Snapshot has no entity for body {}", index);
+            return ids[index];
+        });
+        for (u32 i = 0; i < system_.size(); i++) {
+            registry_->add_or_replace_component<CelestialBody>(system_.entity[i],
+                                                               CelestialBody{system_.mass[i], SOLAR_RADIUS});
+        }
+        for (const auto& o : system_.orbiters()) {
+            registry_->add_or_replace_component<CelestialBody>(o.entity, CelestialBody{o.mass, 0.0});
+            registry_->add_or_replace_component<OrbitalRelation>(o.entity, o.orbit);
+        }
+        u32 home = reader.read_u32();
+        home_planet_ = home < system_.orbiters().size() ? system_.orbiters()[home].entity
+                                                        : EntityID::null();
     }
 
 private:
+    EntityID add_orbiter(const OrbitalRelation& orbit, f64 mass, f64 radius) {
+        EntityID e = registry_->create_entity(LayerID::Cosmological);
+        registry_->add_component<CelestialBody>(e, CelestialBody{mass, radius});
+        registry_->add_component<OrbitalRelation>(e, orbit);
+        system_.add_orbiter(e, orbit, mass);
+        return e;
+    }
+
+    u32 orbiter_of(EntityID e) const {
+        const auto& orbiters = system_.orbiters();
+        for (u32 i = 0; i < orbiters.size(); i++) {
+            if (orbiters[i].entity == e) return i;
+        }
+        return ~0u;
+    }
+
     Registry* registry_ = nullptr;
     EventBus* bus_ = nullptr;
     RNG* rng_ = nullptr;
+    NBodySystem system_;
+    EntityID home_planet_ = EntityID::null();
 };
 
 } // namespace godsim
@@ -0,0 +1,273 @@
+#pragma once
+
+#include "BarnesHut.h"
+#include "Celestial.h"
+#include "core/ecs/EntityID.h"
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+/// Tunables for the gravity integrator.
+struct NBodyParams {
+    f64 theta = 0.6;     // Barnes–Hut opening angle; smaller is more exact
+    f64 softening = 5.0; // Plummer softening length, pc
+    f64 step = 1.0;      // Fixed integration step, Myr
+};
+
+/// Gravitating bodies in structure-of-arrays form, advanced with a
+/// fixed-step kick-drift-kick leapfrog over Barnes–Hut forces. Leapfrog
+/// is symplectic and time-reversible, so with a fixed step the energy
+/// error stays bounded instead of drifting.
+///
+/// Bodies with an OrbitalRelation (planets, moons) take the analytic
+/// fast path instead: they are "orbiters", placed in closed form
+/// relative to their parent, cost nothing in the force pass and neither
+/// pull nor are pulled by anything else. An orbiter's parent may be a
+/// body or another orbiter added before it.
+///
+/// advance() banks time and takes whole steps, so fine tick levels cost
+/// nothing until a step is due; positions in between are drifted from
+/// the last step for the orbiters' parents.
+class NBodySystem {
+public:
+    // ─── Integrated Bodies ───
+    std::vector<EntityID> entity;
+    std::vector<f64> x, y, z;
+    std::vector<f64> vx, vy, vz;
+    std::vector<f64> ax, ay, az; // At the current positions
+    std::vector<f64> mass;
+
+    /// A body on a Kepler orbit, with its state after update_orbiters().
+    struct Orbiter {
+        EntityID entity;
+        OrbitalRelation orbit;
+        f64 mass = 0.0;
+        i64 parent_body = -1;    // Index into the integrated bodies, or
+        i64 parent_orbiter = -1; // into orbiters (always an earlier one)
+        Vec3d position, velocity;
+    };
+
+    size_t size() const { return entity.size(); }
+    const std::vector<Orbiter>& orbiters() const { return orbiters_; }
+    NBodyParams& params() { return params_; }
+
+    /// Simulated time in Myr, including banked time not yet stepped.
+    f64 time() const { return time_ + pending_; }
+
+    u32 add_body(EntityID id, const Vec3d& position, const Vec3d& velocity, f64 m) {
+        u32 index = static_cast<u32>(size());
+        entity.push_back(id);
+        x.push_back(position.x); y.push_back(position.y); z.push_back(position.z);
+        vx.push_back(velocity.x); vy.push_back(velocity.y); vz.push_back(velocity.z);
+        ax.push_back(0.0); ay.push_back(0.0); az.push_back(0.0);
+        mass.push_back(m);
+        body_index_[id] = index;
+        forces_valid_ = false;
+        return index;
+    }
+
+    /// Add a body on a Kepler orbit. The parent must already be present.
+    /// Returns false if it isn't.
+    bool add_orbiter(EntityID id, const OrbitalRelation& orbit, f64 m) {
+        Orbiter o;
+        o.entity = id;
+        o.orbit = orbit;
+        o.mass = m;
+        auto body = body_index_.find(orbit.parent_entity);
+        auto parent = orbiter_index_.find(orbit.parent_entity);
+        if (body != body_index_.end()) {
+            o.parent_body = body->second;
+        } else if (parent != orbiter_index_.end()) {
+            o.parent_orbiter = parent->second;
+        } else {
+            return false;
+        }
+        orbiter_index_[id] = static_cast<u32>(orbiters_.size());
+        orbiters_.push_back(o);
+        update_orbiter(orbiters_.back(), time());
+        return true;
+    }
+
+    // ─── Integration ───
+
+    /// Bank `myr` and take every whole step now due, then place orbiters.
+    void advance(f64 myr) {
+        pending_ += myr;
+        while (pending_ >= params_.step) {
+            step(params_.step);
+            pending_ -= params_.step;
+            time_ += params_.step;
+        }
+        update_orbiters(time());
+    }
+
+    /// One kick-drift-kick step of `dt` Myr.
+    void step(f64 dt) {
+        const u32 n = static_cast<u32>(size());
+        if (n == 0) return;
+        if (!forces_valid_) compute_forces();
+        const f64 half = 0.5 * dt;
+        parallel_for(0, n, [&](u32 b, u32 e) {
+            for (u32 i = b; i < e; i++) {
+                vx[i] += ax[i] * half; vy[i] += ay[i] * half; vz[i] += az[i] * half;
+                x[i] += vx[i] * dt; y[i] += vy[i] * dt; z[i] += vz[i] * dt;
+            }
+        }, 4096);
+        compute_forces();
+        parallel_for(0, n, [&](u32 b, u32 e) {
+            for (u32 i = b; i < e; i++) {
+                vx[i] += ax[i] * half; vy[i] += ay[i] * half; vz[i] += az[i] * half;
+            }
+        }, 4096);
+    }
+
+    /// Rebuild the tree and recompute accelerations at current positions.
+    void compute_forces() {
+        tree_.build(x.data(), y.data(), z.data(), mass.data(), static_cast<u32>(size()));
+        tree_.accelerations(params_.theta, params_.softening, ax.data(), ay.data(), az.data());
+        forces_valid_ = true;
+    }
+
+    /// Evaluate every orbiter at time `t` (Myr). Parents come first, so a
+    /// single pass resolves moons of planets.
+    void update_orbiters(f64 t) {
+        for (auto& o : orbiters_) update_orbiter(o, t);
+    }
+
+    // ─── Queries ───
+
+    /// Current position of a body or orbiter (integrated bodies are
+    /// drifted over banked time). Returns false if unknown.
+    bool position_of(EntityID id, Vec3d& out) const {
+        if (auto it = body_index_.find(id); it != body_index_.end()) {
+            out = body_position(it->second);
+            return true;
+        }
+        if (auto it = orbiter_index_.find(id); it != orbiter_index_.end()) {
+            out = orbiters_[it->second].position;
+            return true;
+        }
+        return false;
+    }
+
+    Vec3d body_position(u32 i) const {
+        return {x[i] + vx[i] * pending_, y[i] + vy[i] * pending_, z[i] + vz[i] * pending_};
+    }
+
+    /// Kinetic plus potential energy of the integrated bodies, with the
+    /// same softening as the forces. O(N²): for diagnostics and tests.
+    f64 total_energy() const {
+        const u32 n = static_cast<u32>(size());
+        const f64 eps2 = params_.softening * params_.softening;
+        f64 kinetic = 0.0, potential = 0.0;
+        for (u32 i = 0; i < n; i++) {
+            kinetic += 0.5 * mass[i] * (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+            for (u32 j = i + 1; j < n; j++) {
+                f64 dx = x[j] - x[i], dy = y[j] - y[i], dz = z[j] - z[i];
+                potential -= GRAVITY * mass[i] * mass[j] / std::sqrt(dx * dx + dy * dy + dz * dz + eps2);
+            }
+        }
+        return kinetic + potential;
+    }
+
+    const BarnesHut& tree() const { return tree_; }
+
+    // ─── Serialisation ───
+    // Entities are the owner's to store; it restores them and passes their
+    // ids to deserialise() in the stored order (bodies, then orbiters).
+
+    void serialise(BinaryWriter& writer) const {
+        writer.write_f64(time_);
+        writer.write_f64(pending_);
+        u32 n = static_cast<u32>(size());
+        writer.write_u32(n);
+        for (const auto* field : {&x, &y, &z, &vx, &vy, &vz, &mass}) {
+            writer.write_bytes(field->data(), n * sizeof(f64));
+        }
+        writer.write_u32(static_cast<u32>(orbiters_.size()));
+        for (const auto& o : orbiters_) {
+            writer.write_f64(o.mass);
+            writer.write_u32(static_cast<u32>(o.parent_body >= 0 ? o.parent_body : o.parent_orbiter));
+            writer.write_u8(o.parent_body >= 0 ? 0 : 1);
+            const OrbitalRelation& e = o.orbit;
+            for (f64 v : {e.semi_major_axis, e.eccentricity, e.inclination, e.ascending_node,
+                          e.argument_of_periapsis, e.mean_anomaly, e.epoch}) {
+                writer.write_f64(v);
+            }
+        }
+    }
+
+    /// `ids(kind, index)` returns the entity for body (kind 0) or orbiter
+    /// (kind 1) `index`.
+    template<typename IdFn>
+    void deserialise(BinaryReader& reader, IdFn&& ids) {
+        NBodyParams params = params_;
+        *this = NBodySystem{};
+        params_ = params;
+        time_ = reader.read_f64();
+        pending_ = reader.read_f64();
+        u32 n = reader.read_u32();
+        for (auto* field : {&x, &y, &z, &vx, &vy, &vz, &mass}) {
+            field->resize(n);
+            reader.read_bytes(field->data(), n * sizeof(f64));
+        }
+        ax.assign(n, 0.0); ay.assign(n, 0.0); az.assign(n, 0.0);
+        entity.resize(n);
+        for (u32 i = 0; i < n; i++) {
+            entity[i] = ids(0, i);
+            body_index_[entity[i]] = i;
+        }
+
+        u32 count = reader.read_u32();
+        for (u32 k = 0; k < count; k++) {
+            f64 m = reader.read_f64();
+            u32 parent = reader.read_u32();
+            u8 kind = reader.read_u8();
+            OrbitalRelation e;
+            e.parent_entity = kind == 0 ? entity[parent] : orbiters_[parent].entity;
+            for (f64* v : {&e.semi_major_axis, &e.eccentricity, &e.inclination, &e.ascending_node,
+                           &e.argument_of_periapsis, &e.mean_anomaly, &e.epoch}) {
+                *v = reader.read_f64();
+            }
+            add_orbiter(ids(1, k), e, m);
+        }
+    }
+
+private:
+    void update_orbiter(Orbiter& o, f64 t) const {
+        Vec3d parent_position, parent_velocity;
+        f64 parent_mass;
+        if (o.parent_body >= 0) {
+            u32 p = static_cast<u32>(o.parent_body);
+            parent_position = body_position(p);
+            parent_velocity = {vx[p], vy[p], vz[p]};
+            parent_mass = mass[p];
+        } else {
+            const Orbiter& p = orbiters_[static_cast<size_t>(o.parent_orbiter)];
+            parent_position = p.position;
+            parent_velocity = p.velocity;
+            parent_mass = p.mass;
+        }
+        Vec3d r, v;
+        orbit_state(o.orbit, parent_mass + o.mass, t, r, v);
+        o.position = parent_position + r;
+        o.velocity = parent_velocity + v;
+    }
+
+    NBodyParams params_;
+    BarnesHut tree_;
+    bool forces_valid_ = false;
+    f64 time_ = 0.0;    // Time of the integrated state, Myr
+    f64 pending_ = 0.0; // Banked time not yet stepped
+    std::vector<Orbiter> orbiters_;
+    std::unordered_map<EntityID, u32> body_index_;
+    std::unordered_map<EntityID, u32> orbiter_index_;
+};
+
+} // namespace godsim
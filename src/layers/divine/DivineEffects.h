@@ -0,0 +1,404 @@
+#pragma once
+
+#include "core/serialise/BinaryStream.h"
+#include "core/time/SimTime.h"
+#include "core/time/TimerWheel.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+#include "layers/planetary/DirtyRegion.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <vector>
+
+namespace godsim {
+
+/// Grid field a divine effect acts on.
+enum class EffectField : u8 {
+    Elevation,   // Normalised height, kept in [0, 1]
+    Temperature, // °C
+    Moisture,    // Kept in [0, 1]
+    Population,  // Every species, multiplicatively
+    COUNT
+};
+
+constexpr u32 PLANET_FIELDS = 3; // Fields that are planet heightmaps
+
+/// An area effect: every cell within `radius` of the centre has its field
+/// changed at `rate` per year, full strength at the centre easing smoothly
+/// to nothing at the edge, (1 − (d/r)²)². Planet fields change additively;
+/// populations are multiplied by e^(rate · weight · years).
+struct DivineEffect {
+    EffectField field = EffectField::Moisture;
+    f32 x = 0.0f, y = 0.0f; // Centre, cells; longitude wraps
+    f32 radius = 1.0f;      // Cells
+    f32 rate = 0.0f;        // Per year, at the centre
+    SimTime start, end;     // Active over [start, end)
+};
+
+/// Ready-made interventions, as presets for DivineEffect.
+enum class Miracle : u8 { Rain, Drought, Warmth, Frost, Uplift, Blessing, Plague, COUNT };
+
+inline DivineEffect miracle(Miracle kind, f32 x, f32 y, f32 radius, SimTime start, SimTime duration) {
+    struct Preset { EffectField field; f32 rate; };
+    static constexpr Preset PRESETS[] = {
+        {EffectField::Moisture, 0.2f},    // Rain
+        {EffectField::Moisture, -0.2f},   // Drought
+        {EffectField::Temperature, 2.0f}, // Warmth
+        {EffectField::Temperature, -2.0f},// Frost
+        {EffectField::Elevation, 0.01f},  // Uplift
+        {EffectField::Population, 0.5f},  // Blessing
+        {EffectField::Population, -1.0f}, // Plague
+    };
+    const Preset& p = PRESETS[static_cast<size_t>(kind)];
+    DivineEffect e;
+    e.field = p.field;
+    e.x = x;
+    e.y = y;
+    e.radius = radius;
+    e.rate = p.rate;
+    e.start = start;
+    e.end = start + duration;
+    return e;
+}
+
+/// Refers to an effect in an EffectSystem; goes stale once it ends.
+struct EffectHandle {
+    u32 slot = ~0u;
+    u32 generation = 0;
+
+    bool valid() const { return slot != ~0u; }
+};
+
+/// What an EffectSystem writes to. Unset targets are skipped.
+struct EffectTargets {
+    std::array<f32*, PLANET_FIELDS> planes{}; // Elevation, temperature, moisture
+    /// Called per tile, possibly in parallel, with the tile's log-growth
+    /// (TILE × TILE, row-major from its corner).
+    std::function<void(u32 tile, const f32* log_growth)> population;
+};
+
+/// The set of active divine effects on a width × height grid.
+///
+/// Effects are bucketed by the TILE × TILE tiles their discs overlap, so
+/// applying them is a pass over occupied tiles only, in parallel: each
+/// tile sums every effect on it into a scratch buffer per field, then
+/// writes each cell once. Expiry is a TimerWheel of end times, so ending
+/// thousands of effects costs only those that are due.
+///
+/// Buckets are kept in slot order and freed slots are reused lowest
+/// first, so results depend only on which effects are live, not on the
+/// history that got them there, and a restored system matches bit for bit.
+class EffectSystem {
+public:
+    static constexpr u32 TILE = 32;
+
+    void resize(u32 width, u32 height) {
+        width_ = width;
+        height_ = height;
+        tiles_x_ = (width + TILE - 1) / TILE;
+        tiles_y_ = (height + TILE - 1) / TILE;
+        clear();
+    }
+
+    /// Remove every effect.
+    void clear() {
+        slots_.clear();
+        free_ = {};
+        buckets_.assign(tile_count(), {});
+        expiry_.reset();
+        live_ = 0;
+    }
+
+    u32 width() const { return width_; }
+    u32 height() const { return height_; }
+    u32 tiles_x() const { return tiles_x_; }
+    u32 tile_count() const { return tiles_x_ * tiles_y_; }
+    size_t size() const { return live_; }
+
+    /// Effects overlapping a tile.
+    size_t bucket_size(u32 tile) const { return buckets_[tile].size(); }
+
+    /// Start an effect. Returns an invalid handle if it could never act
+    /// (no area, no duration, or off the grid).
+    EffectHandle add(DivineEffect effect) {
+        if (tile_count() == 0 || !(effect.radius > 0.0f) || effect.end <= effect.start ||
+            effect.y + effect.radius < 0.0f || effect.y - effect.radius >= static_cast<f32>(height_)) {
+            return {};
+        }
+        const f32 w = static_cast<f32>(width_);
+        effect.x -= w * std::floor(effect.x / w);
+
+        u32 slot;
+        if (!free_.empty()) {
+            slot = free_.top();
+            free_.pop();
+        } else {
+            slot = static_cast<u32>(slots_.size());
+            slots_.push_back({});
+        }
+        Slot& s = slots_[slot];
+        s.effect = effect;
+        s.live = true;
+        live_++;
+        for_tiles(effect, [&](u32 tile) {
+            auto& bucket = buckets_[tile];
+            bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), slot), slot);
+        });
+        EffectHandle handle{slot, s.generation};
+        expiry_.schedule(effect.end, handle);
+        return handle;
+    }
+
+    /// End an effect early. False if it had already ended.
+    bool remove(EffectHandle handle) {
+        if (!find(handle)) return false;
+        Slot& s = slots_[handle.slot];
+        for_tiles(s.effect, [&](u32 tile) {
+            auto& bucket = buckets_[tile];
+            bucket.erase(std::lower_bound(bucket.begin(), bucket.end(), handle.slot));
+        });
+        s.live = false;
+        s.generation++; // Its expiry timer now refers to nothing
+        free_.push(handle.slot);
+        live_--;
+        return true;
+    }
+
+    const DivineEffect* find(EffectHandle handle) const {
+        if (handle.slot >= slots_.size()) return nullptr;
+        const Slot& s = slots_[handle.slot];
+        return s.live && s.generation == handle.generation ? &s.effect : nullptr;
+    }
+
+    /// Remove effects ended by `now`. Returns how many.
+    size_t expire(SimTime now) {
+        size_t ended = 0;
+        expiry_.advance(now, [&](SimTime, EffectHandle handle) { ended += remove(handle); });
+        return ended;
+    }
+
+    /// Apply every effect's share of [from, to) to the targets. Tiles whose
+    /// planet fields changed are added to `dirty`. Returns tiles visited.
+    u32 apply(SimTime from, SimTime to, const EffectTargets& targets, DirtyRegion* dirty = nullptr) {
+        active_.clear();
+        for (u32 t = 0; t < tile_count(); t++) {
+            if (!buckets_[t].empty()) active_.push_back(t);
+        }
+        if (active_.empty() || to <= from) return 0;
+        touched_.assign(tile_count(), 0);
+
+        parallel_for(0, static_cast<u32>(active_.size()), [&](u32 lo, u32 hi) {
+            Scratch scratch;
+            for (u32 j = lo; j < hi; j++) apply_tile(active_[j], from, to, targets, scratch);
+        }, 1);
+
+        if (dirty) {
+            for (u32 t : active_) {
+                if (!touched_[t]) continue;
+                i32 x0 = static_cast<i32>((t % tiles_x_) * TILE), y0 = static_cast<i32>((t / tiles_x_) * TILE);
+                dirty->add(x0, y0, std::min(x0 + static_cast<i32>(TILE), static_cast<i32>(width_)),
+                           y0 + static_cast<i32>(TILE));
+            }
+        }
+        return static_cast<u32>(active_.size());
+    }
+
+    // ─── Serialisation ───
+    // Slots are stored whole, dead ones included, so handles held across a
+    // save and load stay valid.
+
+    void serialise(BinaryWriter& writer) const {
+        writer.write_u32(width_);
+        writer.write_u32(height_);
+        writer.write_u32(static_cast<u32>(slots_.size()));
+        for (const Slot& s : slots_) {
+            writer.write_u32(s.generation);
+            writer.write_u8(s.live ? 1 : 0);
+            if (!s.live) continue;
+            const DivineEffect& e = s.effect;
+            writer.write_u8(static_cast<u8>(e.field));
+            writer.write_f32(e.x);
+            writer.write_f32(e.y);
+            writer.write_f32(e.radius);
+            writer.write_f32(e.rate);
+            writer.write_i64(e.start.ticks);
+            writer.write_i64(e.end.ticks);
+        }
+    }
+
+    void deserialise(BinaryReader& reader) {
+        u32 width = reader.read_u32();
+        u32 height = reader.read_u32();
+        resize(width, height);
+        u32 count = reader.read_u32();
+        slots_.resize(count);
+        std::vector<DivineEffect> effects(count);
+        for (u32 i = 0; i < count; i++) {
+            slots_[i].generation = reader.read_u32();
+            if (!reader.read_u8()) continue;
+            DivineEffect& e = effects[i];
+            e.field = static_cast<EffectField>(reader.read_u8());
+            e.x = reader.read_f32();
+            e.y = reader.read_f32();
+            e.radius = reader.read_f32();
+            e.rate = reader.read_f32();
+            e.start = SimTime{reader.read_i64()};
+            e.end = SimTime{reader.read_i64()};
+            slots_[i].live = true;
+        }
+        // Re-add in slot order: each live slot takes itself off the free list
+        for (u32 i = 0; i < count; i++) {
+            if (!slots_[i].live) free_.push(i);
+        }
+        for (u32 i = 0; i < count; i++) {
+            Slot& s = slots_[i];
+            if (!s.live) continue;
+            s.effect = effects[i];
+            live_++;
+            for_tiles(s.effect, [&](u32 tile) { buckets_[tile].push_back(i); });
+            expiry_.schedule(s.effect.end, EffectHandle{i, s.generation});
+        }
+    }
+
+private:
+    struct Slot {
+        DivineEffect effect;
+        u32 generation = 0;
+        bool live = false;
+    };
+
+    /// Per-worker accumulation buffers, one tile per field.
+    struct Scratch {
+        std::array<std::vector<f32>, static_cast<size_t>(EffectField::COUNT)> sum;
+        std::array<bool, static_cast<size_t>(EffectField::COUNT)> used{};
+    };
+
+    /// Call fn(tile) once for every tile the effect's disc may touch.
+    template<typename Fn>
+    void for_tiles(const DivineEffect& e, Fn&& fn) const {
+        i32 ty0 = std::max(0, static_cast<i32>(std::floor((e.y - e.radius) / TILE)));
+        i32 ty1 = std::min(static_cast<i32>(tiles_y_) - 1, static_cast<i32>(std::floor((e.y + e.radius) / TILE)));
+        i32 w = static_cast<i32>(width_);
+        i32 cx0 = static_cast<i32>(std::floor(e.x - e.radius)), cx1 = static_cast<i32>(std::floor(e.x + e.radius));
+
+        // Columns as up to two unwrapped cell ranges
+        std::array<std::pair<i32, i32>, 2> spans{};
+        size_t n = 0;
+        if (cx1 - cx0 + 1 >= w) {
+            spans[n++] = {0, w - 1};
+        } else if (cx0 < 0) {
+            spans[n++] = {cx0 + w, w - 1};
+            spans[n++] = {0, cx1};
+        } else if (cx1 >= w) {
+            spans[n++] = {cx0, w - 1};
+            spans[n++] = {0, cx1 - w};
+        } else {
+            spans[n++] = {cx0, cx1};
+        }
+        for (i32 ty = ty0; ty <= ty1; ty++) {
+            for (size_t k = 0; k < n; k++) {
+                for (i32 tx = spans[k].first / static_cast<i32>(TILE);
+                     tx <= spans[k].second / static_cast<i32>(TILE); tx++) {
+                    // A nearly full-width disc reaches some tiles from both sides
+                    if (k == 1 && tx >= spans[0].first / static_cast<i32>(TILE)) break;
+                    fn(static_cast<u32>(ty) * tiles_x_ + static_cast<u32>(tx));
+                }
+            }
+        }
+    }
+
+    /// Add the falloff for `n` cells of one row, the first `dx` from the
+    /// centre. Branch-free so it vectorises.
+    static void accumulate_span(f32* __restrict out, u32 n, f32 dx, f32 dy2, f32 inv_r2, f32 amplitude) {
+        for (u32 i = 0; i < n; i++) {
+            f32 d = dx + static_cast<f32>(i);
+            f32 t = std::max(0.0f, 1.0f - (d * d + dy2) * inv_r2);
+            out[i] += amplitude * t * t;
+        }
+    }
+
+    void apply_tile(u32 tile, SimTime from, SimTime to, const EffectTargets& targets, Scratch& scratch) {
+        const u32 x0 = (tile % tiles_x_) * TILE, x1 = std::min(x0 + TILE, width_);
+        const u32 y0 = (tile / tiles_x_) * TILE, y1 = std::min(y0 + TILE, height_);
+        const f32 w = static_cast<f32>(width_);
+        scratch.used.fill(false);
+
+        for (u32 slot : buckets_[tile]) {
+            const DivineEffect& e = slots_[slot].effect;
+            size_t f = static_cast<size_t>(e.field);
+            bool bound = f < PLANET_FIELDS ? targets.planes[f] != nullptr : static_cast<bool>(targets.population);
+            SimTime begin = std::max(from, e.start), finish = std::min(to, e.end);
+            if (!bound || finish <= begin) continue;
+
+            auto& sum = scratch.sum[f];
+            if (!scratch.used[f]) {
+                sum.assign(TILE * TILE, 0.0f);
+                scratch.used[f] = true;
+            }
+            const f32 amplitude = e.rate * static_cast<f32>((finish - begin).years());
+            const f32 inv_r2 = 1.0f / (e.radius * e.radius);
+            u32 ya = static_cast<u32>(std::max(static_cast<f32>(y0), std::ceil(e.y - e.radius)));
+            u32 yb = static_cast<u32>(std::min(static_cast<f32>(y1), std::floor(e.y + e.radius) + 1.0f));
+
+            // Take the centre's image nearest this tile, so the disc's
+            // columns are one plain range. That only holds while no cell of
+            // the tile can also reach another image, i.e. the disc plus a
+            // tile fits in the width; wider discs fall back to wrapped distance
+            f32 cx = e.x, mid = 0.5f * static_cast<f32>(x0 + x1);
+            if (cx - mid > 0.5f * w) cx -= w;
+            if (mid - cx > 0.5f * w) cx += w;
+            const bool narrow = 2.0f * e.radius + static_cast<f32>(TILE) <= w;
+            u32 xa = x0, xb = x1;
+            if (narrow) {
+                xa = static_cast<u32>(std::max(static_cast<f32>(x0), std::ceil(cx - e.radius)));
+                xb = static_cast<u32>(std::min(static_cast<f32>(x1), std::floor(cx + e.radius) + 1.0f));
+            }
+            for (u32 y = ya; y < yb; y++) {
+                f32 dy = static_cast<f32>(y) - e.y;
+                f32* row = sum.data() + (y - y0) * TILE - x0;
+                if (narrow) {
+                    accumulate_span(row + xa, xb - xa, static_cast<f32>(xa) - cx, dy * dy, inv_r2, amplitude);
+                    continue;
+                }
+                for (u32 x = xa; x < xb; x++) {
+                    f32 dx = std::abs(static_cast<f32>(x) - cx);
+                    dx = std::min(dx, w - dx);
+                    f32 t = std::max(0.0f, 1.0f - (dx * dx + dy * dy) * inv_r2);
+                    row[x] += amplitude * t * t;
+                }
+            }
+        }
+
+        static constexpr f32 LOW[PLANET_FIELDS] = {0.0f, -std::numeric_limits<f32>::max(), 0.0f};
+        static constexpr f32 HIGH[PLANET_FIELDS] = {1.0f, std::numeric_limits<f32>::max(), 1.0f};
+        for (u32 f = 0; f < PLANET_FIELDS; f++) {
+            if (!scratch.used[f]) continue;
+            const f32* sum = scratch.sum[f].data();
+            for (u32 y = y0; y < y1; y++) {
+                f32* row = targets.planes[f] + static_cast<size_t>(y) * width_;
+                const f32* s = sum + (y - y0) * TILE - x0;
+                for (u32 x = x0; x < x1; x++) row[x] = std::clamp(row[x] + s[x], LOW[f], HIGH[f]);
+            }
+            touched_[tile] = 1;
+        }
+        size_t pop = static_cast<size_t>(EffectField::Population);
+        if (scratch.used[pop]) targets.population(tile, scratch.sum[pop].data());
+    }
+
+    u32 width_ = 0, height_ = 0;
+    u32 tiles_x_ = 0, tiles_y_ = 0;
+    std::vector<Slot> slots_;
+    std::priority_queue<u32, std::vector<u32>, std::greater<u32>> free_;
+    std::vector<std::vector<u32>> buckets_; // Slot ids per tile, ascending
+    TimerWheel<EffectHandle> expiry_;
+    size_t live_ = 0;
+    std::vector<u32> active_;
+    std::vector<u8> touched_;
+};
+
+} // namespace godsim
@@ -1,11 +1,20 @@
 #pragma once
 
 #include "layers/Layer.h"
+#include "layers/biological/PopulationGrid.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/util/Profiler.h"
+#include "DivineEffects.h"
 
 namespace godsim {
 
+/// The Divine layer carries out the player's interventions. Miracles,
+/// blessings and curses are area effects (DivineEffect) that act on the
+/// planet's fields and populations every tick until they end.
 class DivineLayer : public Layer {
 public:
+    static_assert(EffectSystem::TILE == PopulationGrid::TILE, "population growth is applied per tile");
+
     LayerID     id()   const override { return LayerID::Divine; }
     std::string name() const override { return "Divine"; }
 
@@ -17,11 +26,52 @@ public:
     }
 
     void shutdown() override {
-        LOG_INFO("DivineLayer shutdown (ticked {} times)", tick_count_);
+        LOG_INFO("DivineLayer shutdown (ticked {} times, {} effects active)", tick_count_, effects_.size());
+    }
+
+    /// Act on this planet (and its populations, if given). Clears any
+    /// effects cast before.
+    void bind(PlanetData& planet, PopulationGrid* populations = nullptr) {
+        planet_ = &planet;
+        populations_ = populations;
+        effects_.resize(planet.width, planet.height);
+        edits_.resize(planet.width, planet.height);
+    }
+
+    // ─── Interventions ───
+
+    /// Start an effect; invalid handle if it could never act.
+    EffectHandle cast(const DivineEffect& effect) { return effects_.add(effect); }
+
+    EffectHandle cast(Miracle kind, f32 x, f32 y, f32 radius, SimTime start, SimTime duration) {
+        return effects_.add(miracle(kind, x, y, radius, start, duration));
     }
 
+    /// End an effect early. False if it had already ended.
+    bool dispel(EffectHandle handle) { return effects_.remove(handle); }
+
+    const EffectSystem& effects() const { return effects_; }
+
+    /// Planet cells changed by effects since the caller last cleared it.
+    /// Pass it to the planetary and civilisation layers' terrain_changed()
+    /// (and tile export), then clear it.
+    DirtyRegion& edits() { return edits_; }
+
     void tick(SimTime current_time, SimTime delta_time) override {
         increment_tick();
+        if (planet_ && effects_.size() > 0) {
+            ProfileScope scope("Divine.effects");
+            EffectTargets targets;
+            targets.planes = {planet_->elevation.data_ptr(), planet_->temperature.data_ptr(),
+                              planet_->moisture.data_ptr()};
+            if (populations_) {
+                targets.population = [this](u32 tile, const f32* growth) {
+                    populations_->apply_growth(tile, growth);
+                };
+            }
+            effects_.apply(current_time, current_time + delta_time, targets, &edits_);
+        }
+        effects_.expire(current_time + delta_time);
         bus_->emit(
             LayerTickedEvent{LayerID::Divine, current_time, delta_time},
             current_time, ALL_LAYERS
@@ -30,16 +80,22 @@ public:
 
     void serialise(BinaryWriter& writer) const override {
         writer.write_u64(tick_count_);
+        effects_.serialise(writer);
     }
 
-    void deserialise(BinaryReader& reader) override {
+    void deserialise(BinaryReader& reader, u32 version) override {
         tick_count_ = reader.read_u64();
+        if (version >= 3) effects_.deserialise(reader);
     }
 
 private:
     Registry* registry_ = nullptr;
     EventBus* bus_ = nullptr;
     RNG* rng_ = nullptr;
+    PlanetData* planet_ = nullptr;
+    PopulationGrid* populations_ = nullptr;
+    EffectSystem effects_;
+    DirtyRegion edits_;
 };
 
 } // namespace godsim
@@ -1,13 +1,17 @@
 #pragma once
 
 #include "Heightmap.h"
+#include "SeasonalClimate.h"
 #include "core/noise/Noise.h"
 #include "core/rng/RNG.h"
+#include "core/util/Parallel.h"
 #include "core/util/Types.h"
 #include "core/util/Log.h"
 
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <numbers>
 #include <queue>
 
 namespace godsim {
@@ -15,11 +19,22 @@ namespace godsim {
 /// Configuration for climate generation.
 struct ClimateConfig {
     f32 sea_level       = 0.40f;
-    f32 axial_tilt      = 23.5f;   // Degrees — affects seasonal variation
+    f32 axial_tilt      = 23.5f;   // Degrees — drives the seasonal cycle
     f32 base_temp       = 15.0f;   // Global average temperature °C
     f32 temp_range      = 70.0f;   // Pole-to-equator temperature range
     f32 altitude_lapse  = 40.0f;   // Temperature drop per unit altitude
     f32 ocean_moisture  = 0.9f;    // Moisture at ocean cells
+
+    // Moisture transport by the prevailing winds
+    f32 rain_length     = 0.25f;   // Share of a row over which flat land rains out 1/e of the air's humidity
+    f32 orographic_rain = 5.0f;    // E-folds of humidity rained out per unit of elevation climbed
+    f32 ocean_uptake    = 0.3f;    // Share of its humidity deficit air regains over each ocean cell
+    u32 wind_laps       = 2;       // Sweeps round each row; the first starts from saturated air
+
+    // Seasons
+    u32 season_phases    = 12;     // Points of the year sampled to fit the harmonics
+    u32 season_harmonics = 2;      // Kept per cell, up to SeasonPhase::MAX_HARMONICS
+    f32 seasonal_swing   = 100.0f; // °C per unit of daily insolation (share of the solar constant) off its mean
 };
 
 /// Generates temperature and moisture maps from terrain.
@@ -37,38 +52,9 @@ public:
         PerlinNoise noise(rng_.next_u64());
 
         for (u32 y = 0; y < h; y++) {
-            // Latitude: 0 at equator (center), 1 at poles
-            f32 latitude = std::abs(2.0f * static_cast<f32>(y) / h - 1.0f);
-
-            // Base temperature: hot at equator, cold at poles
-            // Uses cosine curve for realistic latitude bands
-            f32 lat_temp = config.base_temp - config.temp_range * 0.5f *
-                           (latitude * latitude); // Quadratic falloff
-
-            for (u32 x = 0; x < w; x++) {
-                f32 elev = elevation.get(x, y);
-                f32 t = lat_temp;
-
-                // Altitude cooling: higher = colder
-                if (elev > config.sea_level) {
-                    f32 land_height = (elev - config.sea_level) / (1.0f - config.sea_level);
-                    t -= land_height * config.altitude_lapse;
-                }
-
-                // Ocean moderates temperature (less extreme)
-                if (elev < config.sea_level) {
-                    t = t * 0.7f + config.base_temp * 0.3f;
-                }
-
-                // Add some noise for local variation
-                f64 nx = static_cast<f64>(x) / w;
-                f64 ny = static_cast<f64>(y) / h;
-                f32 variation = static_cast<f32>(
-                    noise.fbm(nx * 6.0, ny * 6.0, 3, 1.0, 0.5, 2.0)) * 5.0f;
-                t += variation;
-
-                temp.set(x, y, t);
-            }
+            size_t row = static_cast<size_t>(y) * w;
+            temperature_row(elevation.data_ptr() + row, y, w, h, noise, config,
+                            temp.data_ptr() + row);
         }
 
         LOG_INFO("    Temperature range: {:.1f}°C to {:.1f}°C",
@@ -77,8 +63,9 @@ public:
     }
 
     /// Generate moisture map. Output in [0, 1].
-    /// Based on: distance from ocean, rain shadow from mountains,
-    /// latitude (tropical convergence zones are wet).
+    /// Based on: distance from ocean, humidity carried by the prevailing
+    /// winds (so mountains dry their lee sides), latitude (tropical
+    /// convergence zones are wet).
     Heightmap generate_moisture(const Heightmap& elevation,
                                  const Heightmap& temperature,
                                  const ClimateConfig& config) {
@@ -93,37 +80,178 @@ public:
         PerlinNoise noise(rng_.next_u64());
         Heightmap moisture(w, h);
 
-        for (u32 y = 0; y < h; y++) {
-            f32 latitude = std::abs(2.0f * static_cast<f32>(y) / h - 1.0f);
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            for (u32 y = y0; y < y1; y++) {
+                size_t row = static_cast<size_t>(y) * w;
+                moisture_row(elevation.data_ptr() + row, ocean_dist.data_ptr() + row,
+                             y, w, h, noise, config, moisture.data_ptr() + row);
+            }
+        }, 4);
 
-            // ITCZ: tropical convergence zone is wet (near equator)
-            f32 tropical_moisture = std::exp(-latitude * latitude * 8.0f) * 0.3f;
+        LOG_INFO("    Moisture range: {:.3f} to {:.3f}",
+                 moisture.min_value(), moisture.max_value());
+        return moisture;
+    }
 
-            // Temperate storm tracks
-            f32 temperate_moisture = std::exp(-(latitude - 0.5f) * (latitude - 0.5f) * 20.0f) * 0.15f;
+    /// Fit the seasonal cycle around the annual temperature and moisture
+    /// maps. The sun's declination follows axial_tilt through the year;
+    /// each phase's daily insolation and the latitude of the tropical rain
+    /// belt (which follows the sun) are sampled per row and projected onto
+    /// the first few harmonics. Each cell then scales and delays its row's
+    /// harmonics: the ocean's thermal inertia damps and lags its swing,
+    /// continental interiors swing hardest, and only land gets the rain
+    /// belt's wet and dry seasons (the ocean stays at ocean_moisture).
+    SeasonalClimate generate_seasons(const Heightmap& elevation, const ClimateConfig& config) {
+        LOG_INFO("  Generating seasons...");
+        u32 w = elevation.width();
+        u32 h = elevation.height();
+        u32 harmonics = std::clamp(config.season_harmonics, 1u, SeasonPhase::MAX_HARMONICS);
+        u32 phases = std::max(config.season_phases, 2 * harmonics + 1); // Nyquist
+        SeasonalClimate seasons(w, h, harmonics);
+        Heightmap ocean_dist = compute_ocean_distance(elevation, config);
 
-            for (u32 x = 0; x < w; x++) {
-                f32 elev = elevation.get(x, y);
+        f64 tilt = config.axial_tilt * std::numbers::pi / 180.0;
+        u32 stride = seasons.stride();
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            std::vector<f64> insolation(phases), rain_belt(phases);
+            std::array<f64, 2 * SeasonPhase::MAX_HARMONICS> heat{}, rain{};
+            for (u32 y = y0; y < y1; y++) {
+                // Signed latitude, north (y = 0) positive
+                f64 lat = 1.0 - 2.0 * (y + 0.5) / h;
+                for (u32 n = 0; n < phases; n++) {
+                    f64 declination = tilt * std::sin(2.0 * std::numbers::pi * n / phases);
+                    insolation[n] = daily_insolation(lat * std::numbers::pi * 0.5, declination);
+                    f64 belt = lat - declination / (std::numbers::pi * 0.5);
+                    rain_belt[n] = std::exp(-belt * belt * 8.0) * 0.3; // As moisture_row's ITCZ
+                }
+                project(insolation, harmonics, heat.data());
+                project(rain_belt, harmonics, rain.data());
+
+                for (u32 x = 0; x < w; x++) {
+                    size_t cell = static_cast<size_t>(y) * w + x;
+                    f32* t = &seasons.temperature[cell * stride];
+                    f32* m = &seasons.moisture[cell * stride];
+                    if (elevation.data_ptr()[cell] < config.sea_level) {
+                        delayed(heat.data(), harmonics, 0.25 * config.seasonal_swing, 1.0 / 6.0, t);
+                        continue;
+                    }
+                    f64 inland = std::min(1.0, ocean_dist.data_ptr()[cell] / (0.05 * w));
+                    delayed(heat.data(), harmonics, (0.4 + 0.6 * inland) * config.seasonal_swing,
+                            1.0 / 12.0, t);
+                    delayed(rain.data(), harmonics, 1.0, 1.0 / 24.0, m);
+                }
+            }
+        }, 4);
+        return seasons;
+    }
+
+    // ─── Per-row Kernels ───
+    // Temperature and moisture are local given elevation (and ocean distance),
+    // so both the in-memory and streaming pipelines share these.
+
+    /// Temperature for row `y` of a `w`×`h` map.
+    static void temperature_row(const f32* elev_row, u32 y, u32 w, u32 h,
+                                const PerlinNoise& noise, const ClimateConfig& config,
+                                f32* out) {
+        // Latitude: 0 at equator (center), 1 at poles
+        f32 latitude = std::abs(2.0f * static_cast<f32>(y) / h - 1.0f);
+
+        // Base temperature: hot at equator, cold at poles
+        // Uses cosine curve for realistic latitude bands
+        f32 lat_temp = config.base_temp - config.temp_range * 0.5f *
+                       (latitude * latitude); // Quadratic falloff
+
+        for (u32 x = 0; x < w; x++) {
+            f32 elev = elev_row[x];
+            f32 t = lat_temp;
+
+            // Altitude cooling: higher = colder
+            if (elev > config.sea_level) {
+                f32 land_height = (elev - config.sea_level) / (1.0f - config.sea_level);
+                t -= land_height * config.altitude_lapse;
+            }
+
+            // Ocean moderates temperature (less extreme)
+            if (elev < config.sea_level) {
+                t = t * 0.7f + config.base_temp * 0.3f;
+            }
+
+            // Add some noise for local variation
+            f64 nx = static_cast<f64>(x) / w;
+            f64 ny = static_cast<f64>(y) / h;
+            f32 variation = static_cast<f32>(
+                noise.fbm(nx * 6.0, ny * 6.0, 3, 1.0, 0.5, 2.0)) * 5.0f;
+            t += variation;
+
+            out[x] = t;
+        }
+    }
+
+    /// Moisture for row `y`, given elevation and distance-to-ocean rows.
+    ///
+    /// Humidity is advected along the row by its prevailing wind — trade
+    /// easterlies within 30° of the equator, westerlies to 60°, polar
+    /// easterlies beyond — in an upwind sweep that wraps round the planet.
+    /// Air regains humidity over ocean and rains it out over land: slowly
+    /// on the flat, fast while climbing, so windward slopes are wet and the
+    /// lee of a range is dry. The sweep starts from saturated air and goes
+    /// round config.wind_laps times, which converges because the ocean
+    /// keeps pulling the humidity back towards saturation; only the last
+    /// lap is written. Winds are purely zonal, so rows stay independent.
+    static void moisture_row(const f32* elev_row, const f32* dist_row, u32 y, u32 w, u32 h,
+                             const PerlinNoise& noise, const ClimateConfig& config,
+                             f32* out) {
+        f32 latitude = std::abs(2.0f * static_cast<f32>(y) / h - 1.0f);
+
+        // ITCZ: tropical convergence zone is wet (near equator)
+        f32 tropical_moisture = std::exp(-latitude * latitude * 8.0f) * 0.3f;
+
+        // Temperate storm tracks
+        f32 temperate_moisture = std::exp(-(latitude - 0.5f) * (latitude - 0.5f) * 20.0f) * 0.15f;
+
+        // u64 so print-resolution maps don't overflow the diagonal
+        f32 max_dist = std::sqrt(static_cast<f32>(
+            static_cast<u64>(w) * w + static_cast<u64>(h) * h)) * 0.5f;
+
+        // Prevailing wind: +1 blows towards +x (westerlies)
+        bool westerly = latitude >= 1.0f / 3.0f && latitude < 2.0f / 3.0f;
+        u32 step = westerly ? 1 : w - 1;
+        f32 flat_keep = std::exp(-1.0f / (config.rain_length * w));
+
+        f32 humidity = 1.0f; // Share of saturation
+        u32 x = westerly ? 0 : w - 1;
+        f32 upwind = elev_row[(x + w - step) % w];
+        u32 laps = std::max(config.wind_laps, 1u);
+        for (u32 lap = 0; lap < laps; lap++) {
+            bool write = lap + 1 == laps;
+            for (u32 i = 0; i < w; i++, x = (x + step) % w) {
+                f32 elev = elev_row[x];
 
                 // Ocean cells
                 if (elev < config.sea_level) {
-                    moisture.set(x, y, config.ocean_moisture);
+                    humidity += (1.0f - humidity) * config.ocean_uptake;
+                    if (write) out[x] = config.ocean_moisture;
+                    upwind = elev;
                     continue;
                 }
 
+                // Climbing air cools and rains out what it carries
+                f32 climb = std::max(0.0f, elev - std::max(upwind, config.sea_level));
+                f32 carried = humidity;
+                humidity *= flat_keep * std::exp(-config.orographic_rain * climb);
+                upwind = elev;
+                if (!write) continue;
+
                 // Distance from ocean (closer = wetter)
-                f32 dist = ocean_dist.get(x, y);
-                f32 max_dist = std::sqrt(static_cast<f32>(w * w + h * h)) * 0.5f;
+                f32 dist = dist_row[x];
                 f32 ocean_factor = 1.0f - std::clamp(dist / max_dist, 0.0f, 1.0f);
                 ocean_factor = std::pow(ocean_factor, 0.4f); // Slow falloff
 
-                // Altitude: mountains create rain shadow (reduce moisture)
-                f32 land_height = (elev - config.sea_level) / (1.0f - config.sea_level);
-                f32 altitude_factor = 1.0f - land_height * 0.5f;
-
-                // Combine
+                // Combine, scaled by what the wind brings; windward slopes
+                // (climb per circumference) get the orographic rain
                 f32 m = ocean_factor * 0.5f + tropical_moisture + temperate_moisture;
-                m *= altitude_factor;
+                m *= 0.35f + 0.65f * carried;
+                m += carried * std::min(climb * w * 0.02f, 0.3f);
 
                 // Noise variation
                 f64 nx = static_cast<f64>(x) / w;
@@ -132,16 +260,47 @@ public:
                     noise.fbm(nx * 5.0, ny * 5.0, 3, 1.0, 0.5, 2.0)) * 0.15f;
                 m += variation;
 
-                moisture.set(x, y, std::clamp(m, 0.0f, 1.0f));
+                out[x] = std::clamp(m, 0.0f, 1.0f);
             }
         }
-
-        LOG_INFO("    Moisture range: {:.3f} to {:.3f}",
-                 moisture.min_value(), moisture.max_value());
-        return moisture;
     }
 
 private:
+    /// Mean insolation over a day at `lat` when the sun is at `declination`
+    /// (radians), as a share of the solar constant.
+    static f64 daily_insolation(f64 lat, f64 declination) {
+        f64 cos_h = std::clamp(-std::tan(lat) * std::tan(declination), -1.0, 1.0);
+        f64 hour = std::acos(cos_h); // Half-day length: 0 in polar night, π in polar day
+        return (hour * std::sin(lat) * std::sin(declination) +
+                std::cos(lat) * std::cos(declination) * std::sin(hour)) / std::numbers::pi;
+    }
+
+    /// (cos, sin) Fourier coefficients 1..harmonics of evenly spaced
+    /// samples over one year. The mean is dropped.
+    static void project(const std::vector<f64>& samples, u32 harmonics, f64* out) {
+        f64 n = static_cast<f64>(samples.size());
+        for (u32 k = 0; k < harmonics; k++) {
+            f64 a = 0.0, b = 0.0;
+            for (size_t i = 0; i < samples.size(); i++) {
+                f64 theta = 2.0 * std::numbers::pi * (k + 1) * i / n;
+                a += samples[i] * std::cos(theta);
+                b += samples[i] * std::sin(theta);
+            }
+            out[2 * k] = 2.0 * a / n;
+            out[2 * k + 1] = 2.0 * b / n;
+        }
+    }
+
+    /// Harmonics `in` scaled by `gain` and delayed by `lag` years.
+    static void delayed(const f64* in, u32 harmonics, f64 gain, f64 lag, f32* out) {
+        for (u32 k = 0; k < harmonics; k++) {
+            f64 shift = 2.0 * std::numbers::pi * (k + 1) * lag;
+            f64 a = in[2 * k], b = in[2 * k + 1];
+            out[2 * k] = static_cast<f32>(gain * (a * std::cos(shift) - b * std::sin(shift)));
+            out[2 * k + 1] = static_cast<f32>(gain * (a * std::sin(shift) + b * std::cos(shift)));
+        }
+    }
+
     /// BFS flood fill from ocean cells to compute distance-to-ocean.
     Heightmap compute_ocean_distance(const Heightmap& elevation,
                                       const ClimateConfig& config) {
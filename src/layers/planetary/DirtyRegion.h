@@ -0,0 +1,164 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace godsim {
+
+/// Half-open rectangle of grid cells: [x0, x1) × [y0, y1).
+struct CellRect {
+    u32 x0 = 0, y0 = 0;
+    u32 x1 = 0, y1 = 0;
+
+    bool empty() const { return x1 <= x0 || y1 <= y0; }
+    u32  width()  const { return x1 - x0; }
+    u32  height() const { return y1 - y0; }
+
+    bool overlaps(const CellRect& o) const {
+        return x0 < o.x1 && o.x0 < x1 && y0 < o.y1 && o.y0 < y1;
+    }
+
+    bool contains(u32 x, u32 y) const {
+        return x >= x0 && x < x1 && y >= y0 && y < y1;
+    }
+
+    /// Smallest rect covering both.
+    CellRect merged(const CellRect& o) const {
+        return {std::min(x0, o.x0), std::min(y0, o.y0),
+                std::max(x1, o.x1), std::max(y1, o.y1)};
+    }
+
+    /// Grow by `margin` cells on every side, clamped to the grid.
+    CellRect expanded(u32 margin, u32 grid_w, u32 grid_h) const {
+        return {x0 > margin ? x0 - margin : 0, y0 > margin ? y0 - margin : 0,
+                std::min(grid_w, x1 + margin), std::min(grid_h, y1 + margin)};
+    }
+};
+
+/// The eight neighbours of a cell on a planet grid (row-major, `w` cells
+/// per row), where longitude wraps and latitude stops at the poles.
+struct GridNeighbours {
+    static constexpr u32 NONE = 0xFFFFFFFFu;
+
+    /// Directions: E, W, S, N, SE, SW, NE, NW.
+    static constexpr i32 DX[8] = {1, -1, 0, 0, 1, -1, 1, -1};
+    static constexpr i32 DY[8] = {0, 0, 1, -1, 1, 1, -1, -1};
+
+    /// The cell one step from `cell` in direction `dir`, or NONE past a pole.
+    static u32 step(u32 cell, u32 dir, u32 w, u32 h) {
+        i32 y = static_cast<i32>(cell / w) + DY[dir];
+        if (y < 0 || y >= static_cast<i32>(h)) return NONE;
+        i32 x = (static_cast<i32>(cell % w) + DX[dir] + static_cast<i32>(w)) % static_cast<i32>(w);
+        return static_cast<u32>(y) * w + static_cast<u32>(x);
+    }
+
+    /// fn(neighbour, direction) for each in-grid neighbour.
+    template<typename Fn>
+    static void for_each(u32 cell, u32 w, u32 h, Fn&& fn) {
+        for (u32 d = 0; d < 8; d++) {
+            u32 next = step(cell, d, w, h);
+            if (next != NONE) fn(next, d);
+        }
+    }
+};
+
+/// Accumulates edited areas of a planet grid so incremental consumers
+/// (tile export, GPU uploads, derived-data passes) only redo what changed.
+/// Longitude wraps: a rect hanging off the left or right edge is split in two.
+class DirtyRegion {
+public:
+    DirtyRegion() = default;
+    DirtyRegion(u32 grid_w, u32 grid_h) : grid_w_(grid_w), grid_h_(grid_h) {}
+
+    void resize(u32 grid_w, u32 grid_h) {
+        grid_w_ = grid_w;
+        grid_h_ = grid_h;
+        rects_.clear();
+    }
+
+    /// Mark cells [x0, x1) × [y0, y1) dirty. x may extend past either edge
+    /// (it wraps); y is clamped to the grid.
+    void add(i32 x0, i32 y0, i32 x1, i32 y1) {
+        if (grid_w_ == 0 || grid_h_ == 0) return;
+        i32 w = static_cast<i32>(grid_w_);
+        y0 = std::max(y0, 0);
+        y1 = std::min(y1, static_cast<i32>(grid_h_));
+        if (y1 <= y0 || x1 <= x0) return;
+
+        if (x1 - x0 >= w) {
+            insert({0, static_cast<u32>(y0), grid_w_, static_cast<u32>(y1)});
+            return;
+        }
+        // Shift so x0 lands inside [0, w)
+        i32 shift = ((x0 % w) + w) % w - x0;
+        x0 += shift;
+        x1 += shift;
+        if (x1 <= w) {
+            insert({static_cast<u32>(x0), static_cast<u32>(y0),
+                    static_cast<u32>(x1), static_cast<u32>(y1)});
+        } else {
+            insert({static_cast<u32>(x0), static_cast<u32>(y0),
+                    grid_w_, static_cast<u32>(y1)});
+            insert({0, static_cast<u32>(y0),
+                    static_cast<u32>(x1 - w), static_cast<u32>(y1)});
+        }
+    }
+
+    void add(const CellRect& r) {
+        add(static_cast<i32>(r.x0), static_cast<i32>(r.y0),
+            static_cast<i32>(r.x1), static_cast<i32>(r.y1));
+    }
+
+    /// Merge another region's rects into this one.
+    void add(const DirtyRegion& other) {
+        for (const auto& r : other.rects_) add(r);
+    }
+
+    void mark_all() {
+        rects_.clear();
+        if (grid_w_ && grid_h_) rects_.push_back({0, 0, grid_w_, grid_h_});
+    }
+
+    void clear() { rects_.clear(); }
+    bool empty() const { return rects_.empty(); }
+    const std::vector<CellRect>& rects() const { return rects_; }
+
+    /// Bounding box of everything dirty (empty rect if clean).
+    CellRect bounds() const {
+        if (rects_.empty()) return {};
+        CellRect b = rects_[0];
+        for (const auto& r : rects_) b = b.merged(r);
+        return b;
+    }
+
+    u32 grid_width()  const { return grid_w_; }
+    u32 grid_height() const { return grid_h_; }
+
+private:
+    /// Overlapping rects are merged so repeated brush strokes in one area
+    /// collapse into a single rect instead of growing the list.
+    void insert(CellRect r) {
+        bool merged = true;
+        while (merged) {
+            merged = false;
+            for (size_t i = 0; i < rects_.size(); i++) {
+                if (rects_[i].overlaps(r)) {
+                    r = r.merged(rects_[i]);
+                    rects_[i] = rects_.back();
+                    rects_.pop_back();
+                    merged = true;
+                    break;
+                }
+            }
+        }
+        rects_.push_back(r);
+    }
+
+    u32 grid_w_ = 0;
+    u32 grid_h_ = 0;
+    std::vector<CellRect> rects_;
+};
+
+} // namespace godsim
@@ -0,0 +1,356 @@
+#pragma once
+
+#include "Heightmap.h"
+#include "DirtyRegion.h"
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Assert.h"
+#include "core/util/Log.h"
+#include "core/util/Parallel.h"
+#include "core/util/Profiler.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+enum class RiverNodeKind : u8 {
+    Source,     // No river flows in
+    Confluence, // Two or more rivers meet
+    Mouth,      // Reaches the sea
+};
+
+struct RiverNode {
+    u32 cell = 0;
+    RiverNodeKind kind = RiverNodeKind::Source;
+};
+
+/// A stretch of river from one node down to the next, with no junction in
+/// between.
+struct RiverSegment {
+    u32 from = 0, to = 0;         // Node indices
+    u32 first = 0, count = 0;     // Its cells in Hydrosphere::river_cells, upstream first, both nodes included
+    f32 discharge = 0.0f;         // Flow just above `to`
+};
+
+/// Rivers and lakes of a planet, as produced by Hydrology::generate().
+/// Rivers are a graph rather than a grid, so they cost a few bytes per
+/// river cell; lakes are a mask.
+struct Hydrosphere {
+    std::vector<u8> lake_mask;      // One per cell: 1 where a depression holds water
+    std::vector<RiverNode> nodes;
+    std::vector<RiverSegment> segments;
+    std::vector<u32> river_cells;   // Cell indices of every segment, back to back
+    f32 river_threshold = 0.0f;     // Flow a cell needs to be a river
+
+    bool empty() const { return lake_mask.empty(); }
+    bool is_lake(size_t cell) const { return !lake_mask.empty() && lake_mask[cell] != 0; }
+
+    u32 lake_cell_count() const {
+        return static_cast<u32>(std::count(lake_mask.begin(), lake_mask.end(), u8{1}));
+    }
+
+    void serialise(BinaryWriter& writer) const {
+        writer.write_f32(river_threshold);
+        writer.write_u32(static_cast<u32>(lake_mask.size()));
+        writer.write_bytes(lake_mask.data(), lake_mask.size());
+        writer.write_u32(static_cast<u32>(nodes.size()));
+        for (const auto& n : nodes) {
+            writer.write_u32(n.cell);
+            writer.write_u8(static_cast<u8>(n.kind));
+        }
+        writer.write_u32(static_cast<u32>(segments.size()));
+        for (const auto& s : segments) {
+            writer.write_u32(s.from);
+            writer.write_u32(s.to);
+            writer.write_u32(s.first);
+            writer.write_u32(s.count);
+            writer.write_f32(s.discharge);
+        }
+        writer.write_u32(static_cast<u32>(river_cells.size()));
+        writer.write_bytes(river_cells.data(), river_cells.size() * sizeof(u32));
+    }
+
+    void deserialise(BinaryReader& reader) {
+        river_threshold = reader.read_f32();
+        lake_mask.resize(reader.read_u32());
+        reader.read_bytes(lake_mask.data(), lake_mask.size());
+        nodes.resize(reader.read_u32());
+        for (auto& n : nodes) {
+            n.cell = reader.read_u32();
+            n.kind = static_cast<RiverNodeKind>(reader.read_u8());
+        }
+        segments.resize(reader.read_u32());
+        for (auto& s : segments) {
+            s.from = reader.read_u32();
+            s.to = reader.read_u32();
+            s.first = reader.read_u32();
+            s.count = reader.read_u32();
+            s.discharge = reader.read_f32();
+        }
+        river_cells.resize(reader.read_u32());
+        reader.read_bytes(river_cells.data(), river_cells.size() * sizeof(u32));
+    }
+};
+
+struct HydrologyConfig {
+    f32 sea_level = 0.40f;
+    f32 river_area = 1.0f / 4096.0f; // Rain-weighted share of the map a river drains
+    f32 min_lake_depth = 0.001f;     // Shallower filled pits stay dry
+};
+
+/// Hydrology on the planet grid (8-connected, longitude wraps):
+///
+///  1. Depression filling by priority-flood with an epsilon gradient
+///     (Barnes et al.): flooding inward from the sea, every cell is raised
+///     to just above the lowest spill into already-drained ground. Cells
+///     found below their spill go on a plain FIFO instead of the heap, so
+///     the pits that make up most of a noisy terrain cost O(1) each.
+///  2. D8 flow directions on the filled surface, steepest descent, in
+///     parallel by rows. The epsilon gradient guarantees every land cell
+///     a strictly lower neighbour, so every path ends in the sea.
+///  3. Flow accumulation of rain (moisture) in parallel: each headwater
+///     cell walks downstream adding its flow into the next cell, and the
+///     last donor to arrive at a cell carries on from there. Flow is fixed
+///     point, so the result does not depend on the order threads arrive.
+///  4. Rivers (cells draining at least river_area of the map's rain) are
+///     reduced to a graph of sources, confluences and mouths.
+class Hydrology {
+public:
+    static constexpr u8 NO_FLOW = 0xFF;
+    static constexpr u32 NO_CELL = GridNeighbours::NONE;
+    static constexpr f32 RAIN_SCALE = 64.0f; // Fixed-point steps per unit of rain
+
+    /// Run every stage. `moisture` may be empty, in which case it rains
+    /// the same everywhere.
+    static Hydrosphere generate(const Heightmap& elevation, const Heightmap& moisture,
+                                const HydrologyConfig& config) {
+        ProfileScope scope("Hydrology.generate");
+        u32 w = elevation.width(), h = elevation.height();
+        LOG_INFO("  Hydrology ({}x{})...", w, h);
+
+        Hydrosphere hydro;
+        std::vector<f32> filled = fill_depressions(elevation, config.sea_level);
+        hydro.lake_mask = lake_mask(elevation, filled, config);
+
+        std::vector<u8> dirs = flow_directions(filled, w, h, elevation, config.sea_level);
+        std::vector<f32> flow = flow_accumulation(dirs, w, h, elevation, moisture, config.sea_level);
+
+        f64 total = static_cast<f64>(w) * h;
+        if (moisture.size() == elevation.size()) total *= std::clamp(moisture.average(), 0.01f, 1.0f);
+        hydro.river_threshold = std::max(4.0f, static_cast<f32>(total * config.river_area));
+        extract_rivers(hydro, dirs, flow, w, h);
+
+        LOG_INFO("    {} lake cells, {} river segments over {} cells", hydro.lake_cell_count(),
+                 hydro.segments.size(), hydro.river_cells.size());
+        return hydro;
+    }
+
+    /// Surface with every depression filled to its spill level, plus a
+    /// gradient of one float step per cell across the fill so it drains.
+    /// Sea cells keep their elevation.
+    static std::vector<f32> fill_depressions(const Heightmap& elevation, f32 sea_level) {
+        ProfileScope scope("Hydrology.fill");
+        u32 w = elevation.width(), h = elevation.height();
+        size_t n = static_cast<size_t>(w) * h;
+        const f32* elev = elevation.data_ptr();
+        std::vector<f32> filled(elev, elev + n);
+        std::vector<u8> closed(n, 0);
+
+        // Min-heap on (height, cell): the cell index breaks ties so runs
+        // are repeatable
+        using Item = std::pair<f32, u32>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+        std::deque<u32> pit;
+
+        // The sea drains everything; flood inward from its shore
+        bool any_sea = false;
+        for (u32 c = 0; c < n; c++) {
+            if (elev[c] >= sea_level) continue;
+            any_sea = true;
+            closed[c] = 1;
+            bool shore = false;
+            GridNeighbours::for_each(c, w, h, [&](u32 nb, u32) { shore |= elev[nb] >= sea_level; });
+            if (shore) open.push({elev[c], c});
+        }
+        if (!any_sea) {
+            u32 lowest = static_cast<u32>(std::min_element(elev, elev + n) - elev);
+            closed[lowest] = 1;
+            open.push({elev[lowest], lowest});
+        }
+
+        while (!open.empty() || !pit.empty()) {
+            u32 c;
+            if (!pit.empty()) {
+                c = pit.front();
+                pit.pop_front();
+            } else {
+                c = open.top().second;
+                open.pop();
+            }
+            f32 spill = std::nextafter(filled[c], std::numeric_limits<f32>::infinity());
+            GridNeighbours::for_each(c, w, h, [&](u32 nb, u32) {
+                if (closed[nb]) return;
+                closed[nb] = 1;
+                if (filled[nb] <= spill) {
+                    filled[nb] = spill;
+                    pit.push_back(nb);
+                } else {
+                    open.push({filled[nb], nb});
+                }
+            });
+        }
+        return filled;
+    }
+
+    /// Land cells filled more than min_lake_depth above their ground.
+    static std::vector<u8> lake_mask(const Heightmap& elevation, const std::vector<f32>& filled,
+                                     const HydrologyConfig& config) {
+        u32 w = elevation.width(), h = elevation.height();
+        const f32* elev = elevation.data_ptr();
+        std::vector<u8> mask(filled.size(), 0);
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            for (size_t c = static_cast<size_t>(y0) * w; c < static_cast<size_t>(y1) * w; c++) {
+                mask[c] = elev[c] >= config.sea_level && filled[c] - elev[c] > config.min_lake_depth;
+            }
+        }, 16);
+        return mask;
+    }
+
+    /// Steepest-descent neighbour (0-7) of every land cell on `filled`;
+    /// NO_FLOW for the sea and for a land cell with no lower neighbour,
+    /// which only happens to the outlet of a world without sea.
+    static std::vector<u8> flow_directions(const std::vector<f32>& filled, u32 w, u32 h,
+                                           const Heightmap& elevation, f32 sea_level) {
+        ProfileScope scope("Hydrology.directions");
+        const f32* elev = elevation.data_ptr();
+        std::vector<u8> dirs(filled.size(), NO_FLOW);
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            for (u32 c = y0 * w; c < y1 * w; c++) {
+                if (elev[c] < sea_level) continue;
+                f32 best = 0.0f;
+                GridNeighbours::for_each(c, w, h, [&](u32 nb, u32 d) {
+                    f32 slope = (filled[c] - filled[nb]) * (d < 4 ? 1.0f : 0.70710678f);
+                    if (slope > best) {
+                        best = slope;
+                        dirs[c] = static_cast<u8>(d);
+                    }
+                });
+            }
+        }, 16);
+        return dirs;
+    }
+
+    /// Rain-weighted upstream area of every cell, in cells of full rain.
+    /// Sea cells receive what their shore drains into them.
+    static std::vector<f32> flow_accumulation(const std::vector<u8>& dirs, u32 w, u32 h,
+                                              const Heightmap& elevation, const Heightmap& moisture,
+                                              f32 sea_level) {
+        ProfileScope scope("Hydrology.accumulation");
+        size_t n = dirs.size();
+        GODSIM_ASSERT(static_cast<f64>(n) * RAIN_SCALE < 4294967295.0, "Grid too large for 32-bit flow");
+        const f32* elev = elevation.data_ptr();
+        const f32* rain = moisture.size() == n ? moisture.data_ptr() : nullptr;
+
+        std::vector<std::atomic<u32>> acc(n);
+        std::vector<std::atomic<u8>> waiting(n); // Donors yet to arrive
+        std::vector<u8> headwater(n);            // No donors at all
+
+        // Each cell's own rain and how many neighbours drain into it
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            for (u32 c = y0 * w; c < y1 * w; c++) {
+                f32 r = elev[c] < sea_level ? 0.0f : rain ? std::clamp(rain[c], 0.0f, 1.0f) : 1.0f;
+                acc[c].store(static_cast<u32>(std::lround(r * RAIN_SCALE)), std::memory_order_relaxed);
+                u8 donors = 0;
+                GridNeighbours::for_each(c, w, h, [&](u32 nb, u32) { donors += receiver(nb, dirs[nb], w, h) == c; });
+                waiting[c].store(donors, std::memory_order_relaxed);
+                headwater[c] = donors == 0;
+            }
+        }, 16);
+
+        parallel_for(0, h, [&](u32 y0, u32 y1) {
+            for (u32 c = y0 * w; c < y1 * w; c++) {
+                if (dirs[c] == NO_FLOW || !headwater[c]) continue;
+                u32 cur = c;
+                u32 carried = acc[c].load(std::memory_order_relaxed);
+                for (;;) {
+                    u32 next = receiver(cur, dirs[cur], w, h);
+                    if (next == NO_CELL) break;
+                    acc[next].fetch_add(carried, std::memory_order_relaxed);
+                    // The last donor in finishes the cell and walks on
+                    if (waiting[next].fetch_sub(1, std::memory_order_acq_rel) != 1) break;
+                    if (dirs[next] == NO_FLOW) break;
+                    cur = next;
+                    carried = acc[cur].load(std::memory_order_relaxed);
+                }
+            }
+        }, 16);
+
+        std::vector<f32> flow(n);
+        for (size_t c = 0; c < n; c++) flow[c] = static_cast<f32>(acc[c].load(std::memory_order_relaxed)) / RAIN_SCALE;
+        return flow;
+    }
+
+    /// Reduce land cells with flow >= hydro.river_threshold to a graph.
+    static void extract_rivers(Hydrosphere& hydro, const std::vector<u8>& dirs,
+                               const std::vector<f32>& flow, u32 w, u32 h) {
+        ProfileScope scope("Hydrology.rivers");
+        hydro.nodes.clear();
+        hydro.segments.clear();
+        hydro.river_cells.clear();
+        auto is_river = [&](u32 c) { return dirs[c] != NO_FLOW && flow[c] >= hydro.river_threshold; };
+
+        // Flow only grows downstream, so below a river cell is river or sea
+        std::unordered_map<u32, u32> node_at;
+        for (u32 c = 0; c < dirs.size(); c++) {
+            if (!is_river(c)) continue;
+            u32 inflows = 0;
+            GridNeighbours::for_each(c, w, h, [&](u32 nb, u32) {
+                inflows += is_river(nb) && receiver(nb, dirs[nb], w, h) == c;
+            });
+            u32 next = receiver(c, dirs[c], w, h);
+            bool mouth = next == NO_CELL || dirs[next] == NO_FLOW;
+            if (mouth && inflows == 0) continue; // A river one cell long isn't one
+            if (!mouth && inflows == 1) continue;
+            node_at[c] = static_cast<u32>(hydro.nodes.size());
+            hydro.nodes.push_back({c, mouth ? RiverNodeKind::Mouth
+                                     : inflows == 0 ? RiverNodeKind::Source : RiverNodeKind::Confluence});
+        }
+
+        for (u32 i = 0; i < hydro.nodes.size(); i++) {
+            if (hydro.nodes[i].kind == RiverNodeKind::Mouth) continue;
+            RiverSegment seg;
+            seg.from = i;
+            seg.first = static_cast<u32>(hydro.river_cells.size());
+            u32 cur = hydro.nodes[i].cell;
+            hydro.river_cells.push_back(cur);
+            for (;;) {
+                u32 above = cur;
+                cur = receiver(cur, dirs[cur], w, h);
+                hydro.river_cells.push_back(cur);
+                auto it = node_at.find(cur);
+                if (it != node_at.end()) {
+                    seg.to = it->second;
+                    seg.discharge = flow[above];
+                    break;
+                }
+            }
+            seg.count = static_cast<u32>(hydro.river_cells.size()) - seg.first;
+            hydro.segments.push_back(seg);
+        }
+    }
+
+    /// Cell that `cell` drains into (a GridNeighbours direction), or NO_CELL.
+    static u32 receiver(u32 cell, u8 dir, u32 w, u32 h) {
+        if (dir == NO_FLOW) return NO_CELL;
+        return GridNeighbours::step(cell, dir, w, h);
+    }
+};
+
+} // namespace godsim
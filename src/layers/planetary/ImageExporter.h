@@ -3,6 +3,8 @@
 #include "Heightmap.h"
 #include "Biome.h"
 #include "PlanetData.h"
+#include "core/serialise/Deflate.h"
+#include "core/util/Parallel.h"
 #include "core/util/Types.h"
 #include "core/util/Log.h"
 
@@ -10,196 +12,486 @@
 #include <string>
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
 
 namespace godsim {
 
-/// Exports planetary data as PPM image files.
-/// PPM is a dead-simple format: no external libraries needed.
-/// Open with GIMP, IrfanView, VS Code, or convert with ImageMagick.
-class ImageExporter {
+/// On-disk image container.
+enum class ImageFormat : u8 {
+    PPM = 0, // Uncompressed binary PPM (P6)
+    PNG,     // 8-bit RGB PNG with built-in deflate
+};
+
+inline const char* image_extension(ImageFormat format) {
+    switch (format) {
+        case ImageFormat::PPM: return ".ppm";
+        case ImageFormat::PNG: return ".png";
+        default:               return ".bin";
+    }
+}
+
+/// Streams an 8-bit RGB image to disk in row bands.
+/// Each band is written with a single bulk write; PNG bands are filtered and
+/// deflated in parallel and emitted as their own IDAT chunk, so memory stays
+/// bounded by the band size rather than the image size.
+class ImageWriter {
 public:
-    /// Export elevation as a grayscale heightmap.
-    static void export_heightmap(const Heightmap& map, const std::string& path) {
-        u32 w = map.width();
-        u32 h = map.height();
-
-        std::ofstream file(path, std::ios::binary);
-        file << "P6\n" << w << " " << h << "\n255\n";
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                f32 v = std::clamp(map.get(x, y), 0.0f, 1.0f);
-                u8 c = static_cast<u8>(v * 255);
-                file.put(c); file.put(c); file.put(c);
-            }
+    ImageWriter() = default;
+    ImageWriter(const ImageWriter&) = delete;
+    ImageWriter& operator=(const ImageWriter&) = delete;
+
+    /// Open `path` and write the header. Returns false if the file can't be created.
+    bool open(const std::string& path, u32 width, u32 height, ImageFormat format) {
+        file_.open(path, std::ios::binary);
+        if (!file_) {
+            LOG_ERROR("Failed to open image for writing: {}", path);
+            return false;
         }
-
-        LOG_INFO("Exported heightmap: {}", path);
+        width_ = width;
+        height_ = height;
+        format_ = format;
+        rows_written_ = 0;
+
+        if (format_ == ImageFormat::PPM) {
+            std::string header = "P6\n" + std::to_string(width) + " " +
+                                 std::to_string(height) + "\n255\n";
+            file_.write(header.data(), static_cast<std::streamsize>(header.size()));
+        } else {
+            static const u8 signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+            file_.write(reinterpret_cast<const char*>(signature), 8);
+
+            std::vector<u8> ihdr;
+            put_be32(ihdr, width);
+            put_be32(ihdr, height);
+            ihdr.push_back(8); // Bit depth
+            ihdr.push_back(2); // Colour type: truecolour RGB
+            ihdr.push_back(0); // Compression: deflate
+            ihdr.push_back(0); // Filter method: adaptive
+            ihdr.push_back(0); // Interlace: none
+            write_chunk("IHDR", ihdr);
+
+            prev_row_.assign(static_cast<size_t>(width) * 3, 0);
+            idat_.clear();
+            zlib_ = Deflate::ZlibStream{};
+            zlib_.begin(idat_);
+        }
+        return true;
     }
 
-    /// Export elevation with ocean colouring (blue below sea level).
-    static void export_terrain(const Heightmap& elevation, f32 sea_level,
-                                const std::string& path) {
-        u32 w = elevation.width();
-        u32 h = elevation.height();
-
-        std::ofstream file(path, std::ios::binary);
-        file << "P6\n" << w << " " << h << "\n255\n";
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                f32 e = elevation.get(x, y);
-
-                u8 r, g, b;
-                if (e < sea_level - 0.05f) {
-                    // Deep ocean
-                    f32 depth = (sea_level - e) / sea_level;
-                    r = static_cast<u8>(15 + (1 - depth) * 30);
-                    g = static_cast<u8>(50 + (1 - depth) * 60);
-                    b = static_cast<u8>(100 + (1 - depth) * 60);
-                } else if (e < sea_level) {
-                    // Shallow ocean
-                    r = 40; g = 100; b = 150;
-                } else if (e < sea_level + 0.02f) {
-                    // Beach
-                    r = 210; g = 200; b = 160;
-                } else {
-                    // Land — green to brown to white based on height
-                    f32 land_h = (e - sea_level) / (1.0f - sea_level);
-
-                    if (land_h < 0.3f) {
-                        // Lowlands — green
-                        f32 t = land_h / 0.3f;
-                        r = static_cast<u8>(50 + t * 60);
-                        g = static_cast<u8>(130 - t * 20);
-                        b = static_cast<u8>(40 + t * 20);
-                    } else if (land_h < 0.6f) {
-                        // Hills — brown
-                        f32 t = (land_h - 0.3f) / 0.3f;
-                        r = static_cast<u8>(110 + t * 40);
-                        g = static_cast<u8>(110 - t * 20);
-                        b = static_cast<u8>(60 + t * 20);
-                    } else {
-                        // Mountains — grey to white
-                        f32 t = (land_h - 0.6f) / 0.4f;
-                        r = static_cast<u8>(150 + t * 105);
-                        g = static_cast<u8>(150 + t * 105);
-                        b = static_cast<u8>(150 + t * 105);
-                    }
+    /// Append `rows` tightly packed RGB rows.
+    void write_rows(const u8* rgb, u32 rows) {
+        if (!file_ || rows == 0) return;
+        size_t stride = static_cast<size_t>(width_) * 3;
+
+        if (format_ == ImageFormat::PPM) {
+            file_.write(reinterpret_cast<const char*>(rgb),
+                        static_cast<std::streamsize>(stride * rows));
+        } else {
+            // Filter rows in parallel; each row only depends on the raw row above.
+            std::vector<u8> filtered((stride + 1) * rows);
+            parallel_for(0, rows, [&](u32 lo, u32 hi) {
+                for (u32 r = lo; r < hi; r++) {
+                    const u8* above = r == 0 ? prev_row_.data() : rgb + (r - 1) * stride;
+                    filter_row(rgb + r * stride, above, stride, &filtered[r * (stride + 1)]);
                 }
+            }, 8);
+            std::copy(rgb + (rows - 1) * stride, rgb + rows * stride, prev_row_.begin());
+
+            zlib_.write(filtered.data(), filtered.size(), idat_);
+            write_chunk("IDAT", idat_);
+            idat_.clear();
+        }
+        rows_written_ += rows;
+    }
 
-                file.put(static_cast<char>(r));
-                file.put(static_cast<char>(g));
-                file.put(static_cast<char>(b));
+    /// Finish the file. Called automatically on destruction.
+    void close() {
+        if (!file_.is_open()) return;
+        if (rows_written_ != height_) {
+            LOG_WARN("Image closed after {} of {} rows", rows_written_, height_);
+        }
+        if (format_ == ImageFormat::PNG) {
+            zlib_.finish(idat_);
+            write_chunk("IDAT", idat_);
+            idat_.clear();
+            write_chunk("IEND", {});
+        }
+        file_.close();
+    }
+
+    ~ImageWriter() { close(); }
+
+    /// CRC-32 (ISO 3309) as used by PNG chunks.
+    static u32 crc32(const u8* data, size_t size, u32 crc = 0) {
+        static const auto table = [] {
+            std::array<u32, 256> t{};
+            for (u32 n = 0; n < 256; n++) {
+                u32 c = n;
+                for (int k = 0; k < 8; k++) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                t[n] = c;
             }
+            return t;
+        }();
+        crc = ~crc;
+        for (size_t i = 0; i < size; i++) crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+        return ~crc;
+    }
+
+private:
+    static void put_be32(std::vector<u8>& out, u32 v) {
+        out.push_back(static_cast<u8>(v >> 24));
+        out.push_back(static_cast<u8>(v >> 16));
+        out.push_back(static_cast<u8>(v >> 8));
+        out.push_back(static_cast<u8>(v));
+    }
+
+    void write_chunk(const char type[4], const std::vector<u8>& data) {
+        std::vector<u8> header;
+        put_be32(header, static_cast<u32>(data.size()));
+        header.insert(header.end(), type, type + 4);
+
+        u32 crc = crc32(header.data() + 4, 4);
+        crc = crc32(data.data(), data.size(), crc);
+        std::vector<u8> trailer;
+        put_be32(trailer, crc);
+
+        file_.write(reinterpret_cast<const char*>(header.data()), 8);
+        file_.write(reinterpret_cast<const char*>(data.data()),
+                    static_cast<std::streamsize>(data.size()));
+        file_.write(reinterpret_cast<const char*>(trailer.data()), 4);
+    }
+
+    static u8 paeth(u8 a, u8 b, u8 c) {
+        int p = static_cast<int>(a) + b - c;
+        int pa = std::abs(p - a), pb = std::abs(p - b), pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc) return a;
+        if (pb <= pc) return b;
+        return c;
+    }
+
+    /// Pick the PNG filter with the smallest sum of absolute residuals
+    /// (the standard minimum-sum heuristic) and write the filtered row.
+    static void filter_row(const u8* row, const u8* above, size_t stride, u8* out) {
+        constexpr size_t BPP = 3;
+        u64 best_cost = ~0ull;
+        u8 best = 0;
+        for (u8 f = 0; f < 5; f++) {
+            u64 cost = 0;
+            for (size_t i = 0; i < stride; i++) {
+                u8 a = i >= BPP ? row[i - BPP] : 0;
+                u8 c = i >= BPP ? above[i - BPP] : 0;
+                u8 r = static_cast<u8>(row[i] - predict(f, a, above[i], c));
+                cost += r < 128 ? r : 256 - r;
+            }
+            if (cost < best_cost) {
+                best_cost = cost;
+                best = f;
+            }
+        }
+        out[0] = best;
+        for (size_t i = 0; i < stride; i++) {
+            u8 a = i >= BPP ? row[i - BPP] : 0;
+            u8 c = i >= BPP ? above[i - BPP] : 0;
+            out[i + 1] = static_cast<u8>(row[i] - predict(best, a, above[i], c));
         }
+    }
 
-        LOG_INFO("Exported terrain map: {}", path);
+    static u8 predict(u8 filter, u8 a, u8 b, u8 c) {
+        switch (filter) {
+            case 1:  return a;                                              // Sub
+            case 2:  return b;                                              // Up
+            case 3:  return static_cast<u8>((static_cast<int>(a) + b) / 2); // Average
+            case 4:  return paeth(a, b, c);                                 // Paeth
+            default: return 0;                                              // None
+        }
     }
 
-    /// Export biome map using the standard biome colour palette.
-    static void export_biomes(const PlanetData& planet, const std::string& path) {
-        u32 w = planet.width;
-        u32 h = planet.height;
+    std::ofstream file_;
+    u32 width_ = 0;
+    u32 height_ = 0;
+    u32 rows_written_ = 0;
+    ImageFormat format_ = ImageFormat::PPM;
+
+    // PNG state
+    Deflate::ZlibStream zlib_;
+    std::vector<u8> prev_row_;
+    std::vector<u8> idat_;
+};
+
+/// Exports planetary data as image files (PPM or PNG).
+/// PPM is a dead-simple format: no external libraries needed.
+/// Open with GIMP, IrfanView, VS Code, or convert with ImageMagick.
+///
+/// All exports encode row bands in parallel into a buffer and hand each band
+/// to an ImageWriter; export_all() computes every map in one fused pass.
+class ImageExporter {
+public:
+    /// Rows encoded per band. Bands are sized to keep a few MB in flight.
+    static u32 band_rows(u32 width) {
+        return std::clamp<u32>((1u << 20) / std::max(width, 1u), 16, 1024);
+    }
 
-        std::ofstream file(path, std::ios::binary);
-        file << "P6\n" << w << " " << h << "\n255\n";
+    // ─── Colour Ramps (one pixel, written to out[0..2]) ───
 
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                BiomeType biome = planet.biome_at(x, y);
-                const auto& info = BIOME_INFO[static_cast<size_t>(biome)];
+    /// Grayscale elevation.
+    static void heightmap_colour(f32 e, u8* out) {
+        f32 v = std::clamp(e, 0.0f, 1.0f);
+        u8 c = static_cast<u8>(v * 255);
+        out[0] = out[1] = out[2] = c;
+    }
 
-                file.put(static_cast<char>(info.r));
-                file.put(static_cast<char>(info.g));
-                file.put(static_cast<char>(info.b));
+    /// Elevation with ocean colouring (blue below sea level).
+    static void terrain_colour(f32 e, f32 sea_level, u8* out) {
+        u8 r, g, b;
+        if (e < sea_level - 0.05f) {
+            // Deep ocean
+            f32 depth = (sea_level - e) / sea_level;
+            r = static_cast<u8>(15 + (1 - depth) * 30);
+            g = static_cast<u8>(50 + (1 - depth) * 60);
+            b = static_cast<u8>(100 + (1 - depth) * 60);
+        } else if (e < sea_level) {
+            // Shallow ocean
+            r = 40; g = 100; b = 150;
+        } else if (e < sea_level + 0.02f) {
+            // Beach
+            r = 210; g = 200; b = 160;
+        } else {
+            // Land — green to brown to white based on height
+            f32 land_h = (e - sea_level) / (1.0f - sea_level);
+
+            if (land_h < 0.3f) {
+                // Lowlands — green
+                f32 t = land_h / 0.3f;
+                r = static_cast<u8>(50 + t * 60);
+                g = static_cast<u8>(130 - t * 20);
+                b = static_cast<u8>(40 + t * 20);
+            } else if (land_h < 0.6f) {
+                // Hills — brown
+                f32 t = (land_h - 0.3f) / 0.3f;
+                r = static_cast<u8>(110 + t * 40);
+                g = static_cast<u8>(110 - t * 20);
+                b = static_cast<u8>(60 + t * 20);
+            } else {
+                // Mountains — grey to white
+                f32 t = (land_h - 0.6f) / 0.4f;
+                r = static_cast<u8>(150 + t * 105);
+                g = static_cast<u8>(150 + t * 105);
+                b = static_cast<u8>(150 + t * 105);
             }
         }
+        out[0] = r; out[1] = g; out[2] = b;
+    }
+
+    /// Standard biome palette.
+    static void biome_colour(BiomeType biome, u8* out) {
+        const auto& info = BIOME_INFO[static_cast<size_t>(biome)];
+        out[0] = info.r; out[1] = info.g; out[2] = info.b;
+    }
+
+    /// Heatmap for temperature already normalised to [0, 1]
+    /// (blue = cold, red = hot).
+    static void temperature_colour(f32 t, u8* out) {
+        // Blue → Cyan → Green → Yellow → Red
+        u8 r, g, b;
+        if (t < 0.25f) {
+            f32 s = t / 0.25f;
+            r = 0; g = static_cast<u8>(s * 180); b = static_cast<u8>(200 - s * 50);
+        } else if (t < 0.5f) {
+            f32 s = (t - 0.25f) / 0.25f;
+            r = 0; g = static_cast<u8>(180 + s * 50); b = static_cast<u8>(150 * (1 - s));
+        } else if (t < 0.75f) {
+            f32 s = (t - 0.5f) / 0.25f;
+            r = static_cast<u8>(s * 230); g = static_cast<u8>(230 - s * 50); b = 0;
+        } else {
+            f32 s = (t - 0.75f) / 0.25f;
+            r = static_cast<u8>(230 + s * 25); g = static_cast<u8>(180 * (1 - s)); b = 0;
+        }
+        out[0] = r; out[1] = g; out[2] = b;
+    }
+
+    /// Moisture (brown = dry, green = wet, blue = ocean-level wet).
+    static void moisture_colour(f32 moisture, u8* out) {
+        f32 m = std::clamp(moisture, 0.0f, 1.0f);
+        u8 r, g, b;
+        if (m < 0.3f) {
+            f32 s = m / 0.3f;
+            r = static_cast<u8>(180 - s * 80);
+            g = static_cast<u8>(150 - s * 30);
+            b = static_cast<u8>(80 + s * 20);
+        } else if (m < 0.6f) {
+            f32 s = (m - 0.3f) / 0.3f;
+            r = static_cast<u8>(100 * (1 - s));
+            g = static_cast<u8>(120 + s * 60);
+            b = static_cast<u8>(100 * (1 - s) + s * 50);
+        } else {
+            f32 s = (m - 0.6f) / 0.4f;
+            r = static_cast<u8>(30 * (1 - s));
+            g = static_cast<u8>(180 - s * 60);
+            b = static_cast<u8>(50 + s * 130);
+        }
+        out[0] = r; out[1] = g; out[2] = b;
+    }
+
+    // ─── Single-Map Export ───
 
+    /// Export elevation as a grayscale heightmap.
+    static void export_heightmap(const Heightmap& map, const std::string& path,
+                                 ImageFormat format = ImageFormat::PPM) {
+        export_grid(map.width(), map.height(), path, format,
+            [&](u32 x, u32 y, u8* out) { heightmap_colour(map.get(x, y), out); });
+        LOG_INFO("Exported heightmap: {}", path);
+    }
+
+    /// Export elevation with ocean colouring (blue below sea level).
+    static void export_terrain(const Heightmap& elevation, f32 sea_level,
+                               const std::string& path,
+                               ImageFormat format = ImageFormat::PPM) {
+        export_grid(elevation.width(), elevation.height(), path, format,
+            [&](u32 x, u32 y, u8* out) { terrain_colour(elevation.get(x, y), sea_level, out); });
+        LOG_INFO("Exported terrain map: {}", path);
+    }
+
+    /// Export biome map using the standard biome colour palette.
+    static void export_biomes(const PlanetData& planet, const std::string& path,
+                              ImageFormat format = ImageFormat::PPM) {
+        export_grid(planet.width, planet.height, path, format,
+            [&](u32 x, u32 y, u8* out) { biome_colour(planet.biome_at(x, y), out); });
         LOG_INFO("Exported biome map: {}", path);
     }
 
     /// Export temperature as a heatmap (blue = cold, red = hot).
-    static void export_temperature(const Heightmap& temperature,
-                                    const std::string& path) {
-        u32 w = temperature.width();
-        u32 h = temperature.height();
-
+    static void export_temperature(const Heightmap& temperature, const std::string& path,
+                                   ImageFormat format = ImageFormat::PPM) {
         // Get range for normalisation
         f32 min_t = temperature.min_value();
-        f32 max_t = temperature.max_value();
-        f32 range = max_t - min_t;
+        f32 range = temperature.max_value() - min_t;
         if (range < 1e-6f) range = 1.0f;
 
-        std::ofstream file(path, std::ios::binary);
-        file << "P6\n" << w << " " << h << "\n255\n";
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                f32 t = (temperature.get(x, y) - min_t) / range; // [0, 1]
-
-                // Blue → Cyan → Green → Yellow → Red
-                u8 r, g, b;
-                if (t < 0.25f) {
-                    f32 s = t / 0.25f;
-                    r = 0; g = static_cast<u8>(s * 180); b = static_cast<u8>(200 - s * 50);
-                } else if (t < 0.5f) {
-                    f32 s = (t - 0.25f) / 0.25f;
-                    r = 0; g = static_cast<u8>(180 + s * 50); b = static_cast<u8>(150 * (1 - s));
-                } else if (t < 0.75f) {
-                    f32 s = (t - 0.5f) / 0.25f;
-                    r = static_cast<u8>(s * 230); g = static_cast<u8>(230 - s * 50); b = 0;
-                } else {
-                    f32 s = (t - 0.75f) / 0.25f;
-                    r = static_cast<u8>(230 + s * 25); g = static_cast<u8>(180 * (1 - s)); b = 0;
-                }
-
-                file.put(static_cast<char>(r));
-                file.put(static_cast<char>(g));
-                file.put(static_cast<char>(b));
-            }
-        }
-
+        export_grid(temperature.width(), temperature.height(), path, format,
+            [&](u32 x, u32 y, u8* out) {
+                temperature_colour((temperature.get(x, y) - min_t) / range, out);
+            });
         LOG_INFO("Exported temperature map: {}", path);
     }
 
     /// Export moisture map (brown = dry, green = wet, blue = ocean-level wet).
-    static void export_moisture(const Heightmap& moisture, const std::string& path) {
-        u32 w = moisture.width();
-        u32 h = moisture.height();
-
-        std::ofstream file(path, std::ios::binary);
-        file << "P6\n" << w << " " << h << "\n255\n";
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                f32 m = std::clamp(moisture.get(x, y), 0.0f, 1.0f);
-
-                u8 r, g, b;
-                if (m < 0.3f) {
-                    f32 s = m / 0.3f;
-                    r = static_cast<u8>(180 - s * 80);
-                    g = static_cast<u8>(150 - s * 30);
-                    b = static_cast<u8>(80 + s * 20);
-                } else if (m < 0.6f) {
-                    f32 s = (m - 0.3f) / 0.3f;
-                    r = static_cast<u8>(100 * (1 - s));
-                    g = static_cast<u8>(120 + s * 60);
-                    b = static_cast<u8>(100 * (1 - s) + s * 50);
-                } else {
-                    f32 s = (m - 0.6f) / 0.4f;
-                    r = static_cast<u8>(30 * (1 - s));
-                    g = static_cast<u8>(180 - s * 60);
-                    b = static_cast<u8>(50 + s * 130);
-                }
+    static void export_moisture(const Heightmap& moisture, const std::string& path,
+                                ImageFormat format = ImageFormat::PPM) {
+        export_grid(moisture.width(), moisture.height(), path, format,
+            [&](u32 x, u32 y, u8* out) { moisture_colour(moisture.get(x, y), out); });
+        LOG_INFO("Exported moisture map: {}", path);
+    }
+
+    // ─── Fused Export ───
+
+    /// Export elevation, terrain, biome, temperature and moisture maps into
+    /// `output_dir` in a single parallel pass over the planet: each cell is
+    /// read once and encoded into all five band buffers.
+    static void export_all(const PlanetData& planet, const std::string& output_dir,
+                           ImageFormat format = ImageFormat::PPM) {
+        u32 w = planet.width, h = planet.height;
 
-                file.put(static_cast<char>(r));
-                file.put(static_cast<char>(g));
-                file.put(static_cast<char>(b));
+        BandWriter writer;
+        if (!writer.open(output_dir, w, h, format, planet.sea_level,
+                         planet.temperature.min_value(), planet.temperature.max_value())) {
+            return;
+        }
+        u32 band = band_rows(w);
+        for (u32 y0 = 0; y0 < h; y0 += band) {
+            writer.write_band(planet.band(y0, std::min(band, h - y0)));
+        }
+        writer.close();
+    }
+
+    /// The five export_all() maps written from PlanetBand slices, for callers
+    /// that never hold a whole planet (StreamingPlanetGenerator). Global values
+    /// the colour ramps need (sea level, temperature range) are fixed at open().
+    class BandWriter {
+    public:
+        bool open(const std::string& output_dir, u32 width, u32 height, ImageFormat format,
+                  f32 sea_level, f32 temperature_min, f32 temperature_max) {
+            static const char* names[5] = {"elevation", "terrain", "biomes", "temperature", "moisture"};
+            for (int i = 0; i < 5; i++) {
+                if (!writers_[i].open(output_dir + "/" + names[i] + image_extension(format),
+                                      width, height, format)) {
+                    return false;
+                }
             }
+            output_dir_ = output_dir;
+            width_ = width;
+            height_ = height;
+            format_ = format;
+            sea_level_ = sea_level;
+            min_t_ = temperature_min;
+            range_t_ = temperature_max - temperature_min;
+            if (range_t_ < 1e-6f) range_t_ = 1.0f;
+            return true;
         }
 
-        LOG_INFO("Exported moisture map: {}", path);
+        /// Colour one band into all five maps. Bands must arrive top to bottom.
+        void write_band(const PlanetBand& band) {
+            size_t stride = static_cast<size_t>(band.width) * 3;
+            for (auto& b : buffers_) b.resize(stride * band.rows);
+
+            parallel_for(0, band.rows, [&](u32 lo, u32 hi) {
+                for (u32 r = lo; r < hi; r++) {
+                    size_t cell = static_cast<size_t>(r) * band.width;
+                    size_t base = r * stride;
+                    for (u32 x = 0; x < band.width; x++) {
+                        size_t idx = base + x * 3;
+                        f32 e = band.elevation[cell + x];
+                        heightmap_colour(e, &buffers_[0][idx]);
+                        terrain_colour(e, sea_level_, &buffers_[1][idx]);
+                        biome_colour(band.biomes[cell + x], &buffers_[2][idx]);
+                        temperature_colour((band.temperature[cell + x] - min_t_) / range_t_,
+                                           &buffers_[3][idx]);
+                        moisture_colour(band.moisture[cell + x], &buffers_[4][idx]);
+                    }
+                }
+            }, 4);
+            for (int i = 0; i < 5; i++) writers_[i].write_rows(buffers_[i].data(), band.rows);
+        }
+
+        void close() {
+            for (auto& wr : writers_) wr.close();
+            LOG_INFO("Exported {} maps ({}x{}, {}) to {}", 5, width_, height_,
+                     format_ == ImageFormat::PNG ? "PNG" : "PPM", output_dir_);
+        }
+
+    private:
+        std::array<ImageWriter, 5> writers_;
+        std::array<std::vector<u8>, 5> buffers_;
+        std::string output_dir_;
+        u32 width_ = 0, height_ = 0;
+        ImageFormat format_ = ImageFormat::PPM;
+        f32 sea_level_ = 0.4f;
+        f32 min_t_ = 0.0f, range_t_ = 1.0f;
+    };
+
+private:
+    /// Encode a grid band by band with `colour(x, y, out)` and stream it to `path`.
+    template<typename ColourFn>
+    static void export_grid(u32 w, u32 h, const std::string& path, ImageFormat format,
+                            ColourFn&& colour) {
+        ImageWriter writer;
+        if (!writer.open(path, w, h, format)) return;
+
+        u32 band = band_rows(w);
+        size_t stride = static_cast<size_t>(w) * 3;
+        std::vector<u8> buffer(stride * band);
+
+        for (u32 y0 = 0; y0 < h; y0 += band) {
+            u32 rows = std::min(band, h - y0);
+            parallel_for(0, rows, [&](u32 lo, u32 hi) {
+                for (u32 r = lo; r < hi; r++) {
+                    u8* row = &buffer[r * stride];
+                    for (u32 x = 0; x < w; x++) colour(x, y0 + r, row + x * 3);
+                }
+            }, 4);
+            writer.write_rows(buffer.data(), rows);
+        }
     }
 };
 
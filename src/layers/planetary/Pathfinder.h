@@ -0,0 +1,626 @@
+#pragma once
+
+#include "PlanetData.h"
+#include "DirtyRegion.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+/// Cost of crossing one cell of each biome overland, relative to open
+/// grassland. Zero means impassable.
+inline f32 travel_cost(BiomeType biome) {
+    static constexpr f32 TABLE[static_cast<size_t>(BiomeType::COUNT)] = {
+        0.0f, // Ocean
+        0.0f, // DeepOcean
+        4.0f, // Ice
+        1.5f, // Tundra
+        2.0f, // BorealForest
+        1.0f, // TemperateGrassland
+        1.6f, // TemperateForest
+        2.2f, // TemperateRainforest
+        1.3f, // Shrubland
+        2.0f, // Desert
+        1.1f, // Savanna
+        2.2f, // TropicalForest
+        3.0f, // TropicalRainforest
+        3.0f, // Wetland
+        5.0f, // Mountain
+        1.0f, // Beach
+    };
+    return TABLE[static_cast<size_t>(biome)];
+}
+
+/// Overland route finding on the planet grid, for migration, trade and
+/// armies. Moves are 8-connected, longitude wraps, water is impassable
+/// and diagonals may not cut past impassable corners. A step between
+/// neighbours costs the mean of the two cells' travel_cost() times the
+/// step length, plus CLIMB_COST per unit of elevation change, so costs
+/// are symmetric.
+///
+/// Two services share that cost model:
+///
+///  - find_path(): hierarchical search. The grid is cut into CLUSTER ×
+///    CLUSTER clusters; each passable run along a cluster border gets
+///    one or two transitions, and each cluster stores the cheapest cost
+///    between its transition cells through its own cells. A query
+///    searches that small abstract graph, then runs A* on the grid
+///    restricted to the clusters the abstract route crosses. Paths are
+///    near-optimal, not exact.
+///
+///  - flow_field(): exact cost-to-goal and next step for every cell, for
+///    destinations many agents head to. The most recently used fields
+///    are cached.
+///
+/// Costs are read live from PlanetData. After terraforming, pass the
+/// edited area to update(): it re-solves only the clusters it touches
+/// and drops cached fields the edit can affect.
+class Pathfinder {
+public:
+    static constexpr u32 CLUSTER = 32;
+    static constexpr f32 CLIMB_COST = 200.0f;  // Per unit of normalised elevation
+    static constexpr f32 MIN_STEP_COST = 1.0f; // Cheapest travel_cost(), for the heuristic
+    static constexpr u32 LONG_ENTRANCE = 6;    // Runs this long get a transition at each end
+    static constexpr size_t DEFAULT_FLOW_CACHE = 8;
+    static constexpr u8 NO_DIRECTION = 0xFF;
+    static constexpr f32 UNREACHABLE = std::numeric_limits<f32>::infinity();
+
+    /// Reverse of each GridNeighbours direction.
+    static constexpr u8 OPPOSITE[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+
+    /// Cost to one goal from every cell, and the direction of the next step.
+    struct FlowField {
+        u32 goal = 0;
+        u32 width = 0, height = 0;
+        std::vector<f32> cost;     // UNREACHABLE if the goal can't be reached
+        std::vector<u8> direction; // GridNeighbours direction; NO_DIRECTION at the goal or if unreachable
+
+        bool reachable(u32 cell) const { return cost[cell] != UNREACHABLE; }
+
+        /// The neighbour to move to from `cell` (`cell` itself at the goal).
+        u32 next(u32 cell) const {
+            u8 d = direction[cell];
+            if (d == NO_DIRECTION) return cell;
+            return GridNeighbours::step(cell, d, width, height);
+        }
+    };
+
+    // ─── Setup ───
+
+    /// Build the cluster graph for `planet`, which must outlive this.
+    void build(const PlanetData& planet, size_t flow_cache = DEFAULT_FLOW_CACHE) {
+        planet_ = &planet;
+        w_ = planet.width;
+        h_ = planet.height;
+        flow_capacity_ = std::max<size_t>(flow_cache, 1);
+        flows_.clear();
+        clusters_x_ = (w_ + CLUSTER - 1) / CLUSTER;
+        clusters_y_ = (h_ + CLUSTER - 1) / CLUSTER;
+        size_t n = static_cast<size_t>(clusters_x_) * clusters_y_;
+        clusters_.assign(n, {});
+        east_.assign(n, {});
+        south_.assign(n, {});
+
+        std::vector<u32> all(n);
+        for (u32 c = 0; c < n; c++) all[c] = c;
+        rebuild(all, all);
+    }
+
+    bool built() const { return planet_ != nullptr; }
+
+    /// Re-solve the clusters under edited cells and drop cached flow
+    /// fields the edit could change.
+    void update(const DirtyRegion& edits) {
+        if (!planet_ || edits.empty()) return;
+
+        std::vector<u8> touched(clusters_.size(), 0);
+        for (const auto& rect : edits.rects()) {
+            // Step costs reach one cell past the edit
+            u32 y0 = rect.y0 > 0 ? rect.y0 - 1 : 0;
+            u32 y1 = std::min(rect.y1 + 1, h_);
+            auto mark = [&](u32 x0, u32 x1) {
+                for (u32 cy = y0 / CLUSTER; cy <= (y1 - 1) / CLUSTER; cy++) {
+                    for (u32 cx = x0 / CLUSTER; cx <= (x1 - 1) / CLUSTER; cx++) {
+                        touched[cy * clusters_x_ + cx] = 1;
+                    }
+                }
+            };
+            mark(rect.x0, rect.x1);
+            mark(rect.x0 > 0 ? rect.x0 - 1 : w_ - 1, rect.x0 > 0 ? rect.x0 : w_);
+            mark(rect.x1 < w_ ? rect.x1 : 0, rect.x1 < w_ ? rect.x1 + 1 : 1);
+
+            flows_.erase(std::remove_if(flows_.begin(), flows_.end(), [&](const CachedFlow& f) {
+                return touches_reachable(*f.field, rect);
+            }), flows_.end());
+        }
+
+        // Borders of touched clusters change; so do the neighbours sharing them
+        std::vector<u32> borders, solve;
+        std::vector<u8> solving(clusters_.size(), 0);
+        for (u32 c = 0; c < touched.size(); c++) {
+            if (!touched[c]) continue;
+            borders.push_back(c);
+            u32 cx = c % clusters_x_, cy = c / clusters_x_;
+            u32 west = cy * clusters_x_ + (cx + clusters_x_ - 1) % clusters_x_;
+            borders.push_back(west);
+            if (cy > 0) borders.push_back(c - clusters_x_);
+            for (u32 s : neighbour_clusters(c)) solving[s] = 1;
+            solving[c] = 1;
+        }
+        std::sort(borders.begin(), borders.end());
+        borders.erase(std::unique(borders.begin(), borders.end()), borders.end());
+        for (u32 c = 0; c < solving.size(); c++) {
+            if (solving[c]) solve.push_back(c);
+        }
+        rebuild(borders, solve);
+    }
+
+    // ─── Cost Model ───
+
+    bool passable(u32 cell) const { return travel_cost(planet_->biome_map[cell]) > 0.0f; }
+
+    /// Call fn(neighbour, step cost, direction) for every legal move out of `cell`.
+    template<typename Fn>
+    void for_each_step(u32 cell, Fn&& fn) const {
+        const f32 cost = travel_cost(planet_->biome_map[cell]);
+        if (cost <= 0.0f) return;
+        const i32 x = static_cast<i32>(cell % w_), y = static_cast<i32>(cell / w_);
+        const f32* elev = planet_->elevation.data_ptr();
+        const auto& DX = GridNeighbours::DX;
+        const auto& DY = GridNeighbours::DY;
+        bool open[4] = {};
+        for (u8 d = 0; d < 8; d++) {
+            i32 ny = y + DY[d];
+            if (ny < 0 || ny >= static_cast<i32>(h_)) continue;
+            if (d >= 4) {
+                // Diagonals need both orthogonal cells they pass between
+                if (!open[DX[d] > 0 ? 0 : 1] || !open[DY[d] > 0 ? 2 : 3]) continue;
+            }
+            u32 next = static_cast<u32>(ny) * w_ + wrap_x(x + DX[d]);
+            f32 next_cost = travel_cost(planet_->biome_map[next]);
+            if (next_cost <= 0.0f) continue;
+            if (d < 4) open[d] = true;
+            f32 length = d < 4 ? 1.0f : 1.41421356f;
+            fn(next, 0.5f * (cost + next_cost) * length +
+                     CLIMB_COST * std::abs(elev[next] - elev[cell]), d);
+        }
+    }
+
+    /// Sum of step costs along a path of neighbouring cells.
+    f32 path_cost(const std::vector<u32>& path) const {
+        f32 total = 0.0f;
+        for (size_t i = 1; i < path.size(); i++) {
+            f32 step = UNREACHABLE;
+            for_each_step(path[i - 1], [&](u32 next, f32 cost, u8) {
+                if (next == path[i]) step = cost;
+            });
+            total += step;
+        }
+        return total;
+    }
+
+    // ─── Paths ───
+
+    /// Cells from `from` to `to` inclusive, or empty if there is no route.
+    std::vector<u32> find_path(u32 from, u32 to) const {
+        if (!planet_ || !passable(from) || !passable(to)) return {};
+        if (from == to) return {from};
+
+        const u32 cs = cluster_of(from), cg = cluster_of(to);
+        LocalSearch start_search, goal_search;
+        local_search(from, cs, start_search);
+        local_search(to, cg, goal_search);
+
+        // A* over transition cells; START and GOAL stand in for the endpoints
+        struct Visit {
+            f32 g;
+            u32 parent;
+            bool closed;
+        };
+        std::unordered_map<u32, Visit> visits;
+        using Item = std::pair<f32, u32>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<>> open;
+        auto reach = [&](u32 node, f32 g, u32 parent) {
+            auto [it, fresh] = visits.try_emplace(node, Visit{g, parent, false});
+            if (!fresh) {
+                if (it->second.closed || g >= it->second.g) return;
+                it->second = {g, parent, false};
+            }
+            f32 h = node == GOAL ? 0.0f : heuristic(node, to);
+            open.push({g + h, node});
+        };
+
+        const Cluster& start_cluster = clusters_[cs];
+        for (u32 node : start_cluster.nodes) {
+            f32 g = start_search.dist[local_index(node, box_of(cs))];
+            if (g != UNREACHABLE) reach(node, g, START);
+        }
+        if (cs == cg) {
+            f32 direct = start_search.dist[local_index(to, box_of(cs))];
+            if (direct != UNREACHABLE) reach(GOAL, direct, START);
+        }
+
+        while (!open.empty()) {
+            u32 node = open.top().second;
+            open.pop();
+            Visit& visit = visits[node];
+            if (visit.closed) continue;
+            visit.closed = true;
+            if (node == GOAL) break;
+            f32 g = visit.g;
+
+            u32 c = cluster_of(node);
+            if (c == cg) {
+                f32 rest = goal_search.dist[local_index(node, box_of(cg))];
+                if (rest != UNREACHABLE) reach(GOAL, g + rest, node);
+            }
+            for_each_abstract_edge(node, [&](u32 next, f32 cost) { reach(next, g + cost, node); });
+        }
+
+        auto goal = visits.find(GOAL);
+        if (goal == visits.end() || !goal->second.closed) return {};
+
+        // Refine with A* on the grid through the clusters the route crosses
+        std::unordered_map<u32, u32> corridor; // Cluster → slot
+        corridor.try_emplace(cs, 0);
+        for (u32 node = visits[GOAL].parent; node != START; node = visits[node].parent) {
+            corridor.try_emplace(cluster_of(node), static_cast<u32>(corridor.size()));
+        }
+        corridor.try_emplace(cg, static_cast<u32>(corridor.size()));
+        return corridor_search(from, to, corridor);
+    }
+
+    // ─── Flow Fields ───
+
+    /// Flow field towards `goal`, from the cache or computed now.
+    std::shared_ptr<const FlowField> flow_field(u32 goal) {
+        for (auto& f : flows_) {
+            if (f.field->goal == goal) {
+                f.last_used = ++use_clock_;
+                return f.field;
+            }
+        }
+        auto field = std::make_shared<FlowField>(compute_flow_field(goal));
+        if (flows_.size() >= flow_capacity_) {
+            flows_.erase(std::min_element(flows_.begin(), flows_.end(),
+                [](const CachedFlow& a, const CachedFlow& b) { return a.last_used < b.last_used; }));
+        }
+        flows_.push_back({field, ++use_clock_});
+        return field;
+    }
+
+    /// Exact cost-to-goal over the whole grid (Dijkstra from the goal;
+    /// step costs are symmetric).
+    FlowField compute_flow_field(u32 goal) const {
+        FlowField field;
+        field.goal = goal;
+        field.width = w_;
+        field.height = h_;
+        size_t n = static_cast<size_t>(w_) * h_;
+        field.cost.assign(n, UNREACHABLE);
+        field.direction.assign(n, NO_DIRECTION);
+        if (!passable(goal)) return field;
+
+        using Item = std::pair<f32, u32>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<>> open;
+        field.cost[goal] = 0.0f;
+        open.push({0.0f, goal});
+        while (!open.empty()) {
+            auto [g, cell] = open.top();
+            open.pop();
+            if (g > field.cost[cell]) continue;
+            for_each_step(cell, [&](u32 next, f32 cost, u8 d) {
+                if (g + cost < field.cost[next]) {
+                    field.cost[next] = g + cost;
+                    field.direction[next] = OPPOSITE[d];
+                    open.push({g + cost, next});
+                }
+            });
+        }
+        return field;
+    }
+
+    size_t cached_flow_fields() const { return flows_.size(); }
+
+    // ─── Stats ───
+
+    u32 cluster_count() const { return static_cast<u32>(clusters_.size()); }
+
+    size_t abstract_node_count() const {
+        size_t n = 0;
+        for (const auto& c : clusters_) n += c.nodes.size();
+        return n;
+    }
+
+private:
+    static constexpr u32 NONE = std::numeric_limits<u32>::max();
+    static constexpr u32 START = NONE - 1;
+    static constexpr u32 GOAL = NONE - 2;
+
+    /// A passable step across a cluster border: `a` in the west/north
+    /// cluster, `b` in its east/south neighbour.
+    struct Transition {
+        u32 a, b;
+    };
+
+    /// Transition cells of one cluster and the cheapest cost between
+    /// each pair through the cluster (nodes² matrix, row-major).
+    struct Cluster {
+        std::vector<u32> nodes; // Sorted
+        std::vector<f32> costs;
+    };
+
+    /// Dijkstra scratch over one cluster's cells, kept between searches
+    /// so solving a cluster doesn't allocate per node.
+    struct LocalSearch {
+        using Item = std::pair<f32, u32>;
+        std::vector<f32> dist; // By local_index()
+        std::vector<Item> open;
+    };
+
+    struct CachedFlow {
+        std::shared_ptr<const FlowField> field;
+        u64 last_used = 0;
+    };
+
+    u32 wrap_x(i32 x) const {
+        i32 w = static_cast<i32>(w_);
+        return static_cast<u32>((x % w + w) % w);
+    }
+
+    u32 cluster_of(u32 cell) const {
+        return (cell / w_ / CLUSTER) * clusters_x_ + (cell % w_) / CLUSTER;
+    }
+
+    CellRect box_of(u32 c) const {
+        u32 x0 = (c % clusters_x_) * CLUSTER, y0 = (c / clusters_x_) * CLUSTER;
+        return {x0, y0, std::min(x0 + CLUSTER, w_), std::min(y0 + CLUSTER, h_)};
+    }
+
+    std::vector<u32> neighbour_clusters(u32 c) const {
+        std::vector<u32> out;
+        u32 cx = c % clusters_x_, cy = c / clusters_x_;
+        if (clusters_x_ > 1) {
+            out.push_back(cy * clusters_x_ + (cx + 1) % clusters_x_);
+            out.push_back(cy * clusters_x_ + (cx + clusters_x_ - 1) % clusters_x_);
+        }
+        if (cy > 0) out.push_back(c - clusters_x_);
+        if (cy + 1 < clusters_y_) out.push_back(c + clusters_x_);
+        return out;
+    }
+
+    /// Octile distance with longitude wrap, scaled to a lower bound on cost.
+    f32 heuristic(u32 a, u32 b) const {
+        f32 dx = std::abs(static_cast<f32>(a % w_) - static_cast<f32>(b % w_));
+        dx = std::min(dx, static_cast<f32>(w_) - dx);
+        f32 dy = std::abs(static_cast<f32>(a / w_) - static_cast<f32>(b / w_));
+        return MIN_STEP_COST * (std::max(dx, dy) + 0.41421356f * std::min(dx, dy));
+    }
+
+    /// Dijkstra from `source` over the cells of cluster `c`.
+    void local_search(u32 source, u32 c, LocalSearch& s) const {
+        const CellRect box = box_of(c);
+        s.dist.assign(static_cast<size_t>(box.width()) * box.height(), UNREACHABLE);
+        s.open.clear();
+
+        auto later = [](const LocalSearch::Item& a, const LocalSearch::Item& b) { return a.first > b.first; };
+        s.dist[local_index(source, box)] = 0.0f;
+        s.open.push_back({0.0f, source});
+        while (!s.open.empty()) {
+            std::pop_heap(s.open.begin(), s.open.end(), later);
+            auto [g, cell] = s.open.back();
+            s.open.pop_back();
+            if (g > s.dist[local_index(cell, box)]) continue;
+            for_each_step(cell, [&](u32 next, f32 cost, u8) {
+                u32 x = next % w_, y = next / w_;
+                if (!box.contains(x, y)) return;
+                f32& d = s.dist[(y - box.y0) * box.width() + (x - box.x0)];
+                if (g + cost < d) {
+                    d = g + cost;
+                    s.open.push_back({d, next});
+                    std::push_heap(s.open.begin(), s.open.end(), later);
+                }
+            });
+        }
+    }
+
+    /// A* from `from` to `to` over the cells of the corridor's clusters.
+    std::vector<u32> corridor_search(u32 from, u32 to,
+                                     const std::unordered_map<u32, u32>& corridor) const {
+        constexpr u32 AREA = CLUSTER * CLUSTER;
+        auto index = [&](u32 cell) {
+            u32 c = cluster_of(cell);
+            auto it = corridor.find(c);
+            return it == corridor.end() ? NONE : it->second * AREA + local_index(cell, box_of(c));
+        };
+        std::vector<f32> dist(corridor.size() * AREA, UNREACHABLE);
+        std::vector<u32> parent(corridor.size() * AREA, NONE);
+
+        using Item = std::pair<f32, u32>;
+        std::priority_queue<Item, std::vector<Item>, std::greater<>> open;
+        dist[index(from)] = 0.0f;
+        open.push({heuristic(from, to), from});
+        while (!open.empty()) {
+            auto [f, cell] = open.top();
+            open.pop();
+            if (cell == to) break;
+            f32 g = dist[index(cell)];
+            if (f > g + heuristic(cell, to)) continue;
+            for_each_step(cell, [&](u32 next, f32 cost, u8) {
+                u32 i = index(next);
+                if (i == NONE || g + cost >= dist[i]) return;
+                dist[i] = g + cost;
+                parent[i] = cell;
+                open.push({g + cost + heuristic(next, to), next});
+            });
+        }
+        if (dist[index(to)] == UNREACHABLE) return {};
+
+        std::vector<u32> path;
+        for (u32 cell = to; cell != NONE; cell = parent[index(cell)]) path.push_back(cell);
+        std::reverse(path.begin(), path.end());
+        return path;
+    }
+
+    u32 local_index(u32 cell, const CellRect& box) const {
+        return (cell / w_ - box.y0) * box.width() + (cell % w_ - box.x0);
+    }
+
+    /// Call fn(neighbour node, cost) for the abstract edges out of `node`.
+    template<typename Fn>
+    void for_each_abstract_edge(u32 node, Fn&& fn) const {
+        u32 c = cluster_of(node);
+        const Cluster& cluster = clusters_[c];
+        auto it = std::lower_bound(cluster.nodes.begin(), cluster.nodes.end(), node);
+        if (it == cluster.nodes.end() || *it != node) return;
+        size_t i = static_cast<size_t>(it - cluster.nodes.begin());
+        size_t k = cluster.nodes.size();
+        for (size_t j = 0; j < k; j++) {
+            f32 cost = cluster.costs[i * k + j];
+            if (j != i && cost != UNREACHABLE) fn(cluster.nodes[j], cost);
+        }
+
+        // Transitions on the cluster's four borders
+        u32 cx = c % clusters_x_, cy = c / clusters_x_;
+        auto cross = [&](u32 from, u32 to) {
+            for_each_step(from, [&](u32 next, f32 cost, u8) {
+                if (next == to) fn(to, cost);
+            });
+        };
+        for (const auto& t : east_[c]) if (t.a == node) cross(t.a, t.b);
+        for (const auto& t : south_[c]) if (t.a == node) cross(t.a, t.b);
+        u32 west = cy * clusters_x_ + (cx + clusters_x_ - 1) % clusters_x_;
+        for (const auto& t : east_[west]) if (t.b == node) cross(t.b, t.a);
+        if (cy > 0) {
+            for (const auto& t : south_[c - clusters_x_]) if (t.b == node) cross(t.b, t.a);
+        }
+    }
+
+    /// Recompute the east and south borders of `borders`, then the
+    /// transition nodes and internal costs of `solve`.
+    void rebuild(const std::vector<u32>& borders, const std::vector<u32>& solve) {
+        parallel_for(0, static_cast<u32>(borders.size()), [&](u32 lo, u32 hi) {
+            for (u32 i = lo; i < hi; i++) find_transitions(borders[i]);
+        }, 64);
+        parallel_for(0, static_cast<u32>(solve.size()), [&](u32 lo, u32 hi) {
+            LocalSearch search;
+            for (u32 i = lo; i < hi; i++) solve_cluster(solve[i], search);
+        }, 16);
+    }
+
+    /// Transitions along the east and south borders of cluster `c`: one
+    /// per passable run, or one at each end of a long run.
+    void find_transitions(u32 c) {
+        const CellRect box = box_of(c);
+        u32 cy = c / clusters_x_;
+
+        auto scan = [&](std::vector<Transition>& out, u32 length, auto&& pair_at) {
+            out.clear();
+            u32 run = 0;
+            for (u32 i = 0; i <= length; i++) {
+                if (i < length) {
+                    auto [a, b] = pair_at(i);
+                    if (passable(a) && passable(b)) {
+                        run++;
+                        continue;
+                    }
+                }
+                if (run == 0) continue;
+                u32 first = i - run, last = i - 1;
+                if (run >= LONG_ENTRANCE) {
+                    auto [a0, b0] = pair_at(first);
+                    auto [a1, b1] = pair_at(last);
+                    out.push_back({a0, b0});
+                    out.push_back({a1, b1});
+                } else {
+                    auto [a, b] = pair_at((first + last) / 2);
+                    out.push_back({a, b});
+                }
+                run = 0;
+            }
+        };
+
+        // A single cluster column wraps onto itself; its seam is internal
+        if (clusters_x_ > 1) {
+            u32 xa = box.x1 - 1, xb = box.x1 % w_;
+            scan(east_[c], box.height(), [&](u32 i) {
+                u32 y = box.y0 + i;
+                return std::pair<u32, u32>{y * w_ + xa, y * w_ + xb};
+            });
+        } else {
+            east_[c].clear();
+        }
+        if (cy + 1 < clusters_y_) {
+            u32 ya = box.y1 - 1, yb = box.y1;
+            scan(south_[c], box.width(), [&](u32 i) {
+                u32 x = box.x0 + i;
+                return std::pair<u32, u32>{ya * w_ + x, yb * w_ + x};
+            });
+        } else {
+            south_[c].clear();
+        }
+    }
+
+    void solve_cluster(u32 c, LocalSearch& search) {
+        Cluster& cluster = clusters_[c];
+        cluster.nodes.clear();
+        u32 cx = c % clusters_x_, cy = c / clusters_x_;
+        for (const auto& t : east_[c]) cluster.nodes.push_back(t.a);
+        for (const auto& t : south_[c]) cluster.nodes.push_back(t.a);
+        if (clusters_x_ > 1) {
+            for (const auto& t : east_[cy * clusters_x_ + (cx + clusters_x_ - 1) % clusters_x_]) {
+                cluster.nodes.push_back(t.b);
+            }
+        }
+        if (cy > 0) {
+            for (const auto& t : south_[c - clusters_x_]) cluster.nodes.push_back(t.b);
+        }
+        std::sort(cluster.nodes.begin(), cluster.nodes.end());
+        cluster.nodes.erase(std::unique(cluster.nodes.begin(), cluster.nodes.end()),
+                            cluster.nodes.end());
+
+        const size_t k = cluster.nodes.size();
+        const CellRect box = box_of(c);
+        cluster.costs.assign(k * k, UNREACHABLE);
+        for (size_t i = 0; i < k; i++) {
+            local_search(cluster.nodes[i], c, search);
+            for (size_t j = 0; j < k; j++) {
+                cluster.costs[i * k + j] = search.dist[local_index(cluster.nodes[j], box)];
+            }
+        }
+    }
+
+    /// Whether any cell within one step of `rect` can reach the field's goal.
+    bool touches_reachable(const FlowField& field, const CellRect& rect) const {
+        u32 y0 = rect.y0 > 0 ? rect.y0 - 1 : 0;
+        u32 y1 = std::min(rect.y1 + 1, h_);
+        for (u32 y = y0; y < y1; y++) {
+            for (i32 x = static_cast<i32>(rect.x0) - 1; x <= static_cast<i32>(rect.x1); x++) {
+                if (field.reachable(y * w_ + wrap_x(x))) return true;
+            }
+        }
+        return false;
+    }
+
+    const PlanetData* planet_ = nullptr;
+    u32 w_ = 0, h_ = 0;
+    u32 clusters_x_ = 0, clusters_y_ = 0;
+    std::vector<Cluster> clusters_;
+    std::vector<std::vector<Transition>> east_;  // Border with the east neighbour (wraps)
+    std::vector<std::vector<Transition>> south_; // Border with the south neighbour
+
+    std::vector<CachedFlow> flows_;
+    size_t flow_capacity_ = DEFAULT_FLOW_CACHE;
+    u64 use_clock_ = 0;
+};
+
+} // namespace godsim
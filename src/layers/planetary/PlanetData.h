@@ -2,14 +2,31 @@
 
 #include "Heightmap.h"
 #include "Biome.h"
+#include "Hydrology.h"
+#include "DirtyRegion.h"
+#include "SeasonalClimate.h"
 #include "core/util/Types.h"
 #include "core/serialise/BinaryStream.h"
+#include "core/serialise/SnapshotVersion.h"
 
+#include <algorithm>
 #include <vector>
 #include <string>
 
 namespace godsim {
 
+/// Read-only view of rows [y0, y0 + rows) of every planet grid (row-major,
+/// `width` cells per row). Produced by PlanetData::band() or streamed by
+/// StreamingPlanetGenerator, so exporters work on either.
+struct PlanetBand {
+    u32 width = 0;
+    u32 y0 = 0, rows = 0;
+    const f32* elevation = nullptr;
+    const f32* temperature = nullptr;
+    const f32* moisture = nullptr;
+    const BiomeType* biomes = nullptr;
+};
+
 /// Complete planetary data for one world.
 /// Holds all the spatial grids generated by the terrain and climate pipelines.
 struct PlanetData {
@@ -20,6 +37,8 @@ struct PlanetData {
     Heightmap temperature;   // Approximate °C
     Heightmap moisture;      // [0, 1]
     std::vector<BiomeType> biome_map; // One per cell
+    Hydrosphere hydrosphere;          // Rivers and lakes; empty until generated
+    SeasonalClimate seasons;          // Yearly swing around temperature and moisture
 
     // ─── Parameters ───
     f32 sea_level = 0.4f;
@@ -59,11 +78,40 @@ struct PlanetData {
         avg_moisture = moisture.average();
     }
 
+    /// Reclassify the cells in `rect` after their fields changed. The
+    /// planet-wide statistics are left as they were.
+    void classify_biomes(const CellRect& rect) {
+        for (u32 y = rect.y0; y < rect.y1; y++) {
+            for (u32 x = rect.x0; x < rect.x1; x++) {
+                biome_map[y * width + x] = classify_biome(elevation.get(x, y), temperature.get(x, y),
+                                                          moisture.get(x, y), sea_level);
+            }
+        }
+    }
+
     /// Get the biome at a specific cell.
     BiomeType biome_at(u32 x, u32 y) const {
         return biome_map[y * width + x];
     }
 
+    /// Temperature and moisture of a cell at one point of the year.
+    SeasonSample season_at(u32 x, u32 y, const SeasonPhase& phase) const {
+        size_t cell = static_cast<size_t>(y) * width + x;
+        return {temperature.data_ptr()[cell] + seasons.temperature_anomaly(cell, phase),
+                std::clamp(moisture.data_ptr()[cell] + seasons.moisture_anomaly(cell, phase), 0.0f, 1.0f)};
+    }
+
+    SeasonSample season_at(u32 x, u32 y, SimTime time) const {
+        return season_at(x, y, seasons.phase(SeasonPhase::year_fraction(time)));
+    }
+
+    /// View of rows [y0, y0 + rows).
+    PlanetBand band(u32 y0, u32 rows) const {
+        size_t offset = static_cast<size_t>(y0) * width;
+        return {width, y0, rows, elevation.data_ptr() + offset, temperature.data_ptr() + offset,
+                moisture.data_ptr() + offset, biome_map.data() + offset};
+    }
+
     // ─── Serialisation ───
     void serialise(BinaryWriter& writer) const {
         writer.write_string(name);
@@ -79,9 +127,14 @@ struct PlanetData {
         for (auto b : biome_map) {
             writer.write_u8(static_cast<u8>(b));
         }
+
+        hydrosphere.serialise(writer);
+        seasons.serialise(writer);
     }
 
-    void deserialise(BinaryReader& reader) {
+    /// `version` is the SNAPSHOT_VERSION the planet was written with;
+    /// fields added since come back empty.
+    void deserialise(BinaryReader& reader, u32 version = SNAPSHOT_VERSION) {
         name = reader.read_string();
         width = reader.read_u32();
         height = reader.read_u32();
@@ -96,6 +149,13 @@ struct PlanetData {
             biome_map[i] = static_cast<BiomeType>(reader.read_u8());
         }
 
+        hydrosphere = {};
+        if (version >= 6) hydrosphere.deserialise(reader);
+        seasons = {};
+        if (version >= 7) seasons.deserialise(reader);
+        GODSIM_ASSERT(seasons.empty() || (seasons.width == width && seasons.height == height),
+                      "Seasons are {}x{} on a {}x{} planet", seasons.width, seasons.height, width, height);
+
         // Recompute stats
         i32 land_cells = 0;
         for (u32 i = 0; i < width * height; i++) {
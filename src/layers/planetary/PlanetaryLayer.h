@@ -5,6 +5,9 @@
 #include "TerrainGenerator.h"
 #include "ClimateGenerator.h"
 #include "ImageExporter.h"
+#include "StreamingGenerator.h"
+#include "SurfaceComponents.h"
+#include "DirtyRegion.h"
 
 namespace godsim {
 
@@ -36,12 +39,7 @@ public:
         planet_.height = size;
 
         // ─── Terrain Generation ───
-        TerrainConfig terrain_config;
-        terrain_config.width = size;
-        terrain_config.height = size;
-        terrain_config.sea_level = 0.40f;
-        terrain_config.num_plates = 7 + rng_->next_int(0, 5);
-        terrain_config.erosion_iterations = static_cast<i32>(size) * 100;
+        TerrainConfig terrain_config = make_terrain_config(size, size);
 
         TerrainGenerator terrain_gen(*rng_);
         planet_.elevation = terrain_gen.generate(terrain_config);
@@ -56,36 +54,70 @@ public:
             planet_.elevation, climate_config);
         planet_.moisture = climate_gen.generate_moisture(
             planet_.elevation, planet_.temperature, climate_config);
+        planet_.seasons = climate_gen.generate_seasons(planet_.elevation, climate_config);
+
+        // ─── Hydrology ───
+        planet_.hydrosphere = Hydrology::generate(planet_.elevation, planet_.moisture, make_hydrology_config());
 
         // ─── Biome Classification ───
         LOG_INFO("  Classifying biomes...");
         planet_.classify_biomes();
+        components_.build(planet_);
 
         LOG_INFO("=== Planet Generated ===");
         LOG_INFO("  Land: {:.1f}%", planet_.land_fraction * 100.0f);
         LOG_INFO("  Avg temp: {:.1f} C", planet_.avg_temperature);
         LOG_INFO("  Avg moisture: {:.2f}", planet_.avg_moisture);
+        LOG_INFO("  Rivers: {} segments, lakes: {} cells",
+                 planet_.hydrosphere.segments.size(), planet_.hydrosphere.lake_cell_count());
+        LOG_INFO("  Landmasses: {} ({} over 1% of the surface), seas: {}",
+                 components_.count(true), components_.count(true, 0.01f), components_.count(false));
 
         generated_ = true;
     }
 
-    /// Export all maps as PPM images to the given directory.
-    void export_maps(const std::string& output_dir) const {
+    /// Generate a planet band by band straight into map images in
+    /// `output_dir`, never holding a whole grid in memory. Meant for
+    /// print-resolution maps; the planet is not kept, so is_generated() is
+    /// unchanged. See StreamingPlanetGenerator for what matches generate_planet.
+    StreamingSummary generate_planet_streamed(const std::string& planet_name, u32 width, u32 height,
+                                              const std::string& output_dir,
+                                              ImageFormat format = ImageFormat::PNG,
+                                              StreamingConfig stream_config = {}) {
+        LOG_INFO("=== Streaming Planet: {} ({}x{}) ===", planet_name, width, height);
+
+        TerrainConfig terrain_config = make_terrain_config(width, height);
+        ClimateConfig climate_config;
+        climate_config.sea_level = terrain_config.sea_level;
+
+        StreamingPlanetGenerator generator(*rng_, std::move(stream_config));
+        generator.prepare(terrain_config, climate_config);
+
+        const auto& summary = generator.summary();
+        ImageExporter::BandWriter writer;
+        if (!writer.open(output_dir, width, height, format, terrain_config.sea_level,
+                         summary.temperature_min, summary.temperature_max)) {
+            return summary;
+        }
+        generator.emit([&](const PlanetBand& band) { writer.write_band(band); });
+        writer.close();
+
+        LOG_INFO("=== Planet Streamed ===");
+        LOG_INFO("  Land: {:.1f}%", summary.land_fraction * 100.0f);
+        LOG_INFO("  Avg temp: {:.1f} C", summary.avg_temperature);
+        LOG_INFO("  Avg moisture: {:.2f}", summary.avg_moisture);
+        return summary;
+    }
+
+    /// Export all maps as images to the given directory.
+    void export_maps(const std::string& output_dir,
+                     ImageFormat format = ImageFormat::PPM) const {
         if (!generated_) {
             LOG_WARN("No planet generated yet — nothing to export");
             return;
         }
 
-        ImageExporter::export_heightmap(planet_.elevation,
-            output_dir + "/elevation.ppm");
-        ImageExporter::export_terrain(planet_.elevation, planet_.sea_level,
-            output_dir + "/terrain.ppm");
-        ImageExporter::export_biomes(planet_,
-            output_dir + "/biomes.ppm");
-        ImageExporter::export_temperature(planet_.temperature,
-            output_dir + "/temperature.ppm");
-        ImageExporter::export_moisture(planet_.moisture,
-            output_dir + "/moisture.ppm");
+        ImageExporter::export_all(planet_, output_dir, format);
     }
 
     void tick(SimTime current_time, SimTime delta_time) override {
@@ -105,11 +137,12 @@ public:
         }
     }
 
-    void deserialise(BinaryReader& reader) override {
+    void deserialise(BinaryReader& reader, u32 version) override {
         tick_count_ = reader.read_u64();
         generated_ = reader.read_u8() != 0;
         if (generated_) {
-            planet_.deserialise(reader);
+            planet_.deserialise(reader, version);
+            components_.build(planet_);
         }
     }
 
@@ -118,12 +151,43 @@ public:
     PlanetData& planet() { return planet_; }
     bool is_generated() const { return generated_; }
 
+    /// Continents, islands and seas of the generated planet.
+    const SurfaceComponents& surface_components() const { return components_; }
+
+    /// Fields under `edits` changed (terraforming, divine effects):
+    /// reclassify their biomes, relabel the components they touched and
+    /// rerun hydrology, since an edit anywhere in a basin can reroute it.
+    void terrain_changed(const DirtyRegion& edits) {
+        if (edits.empty()) return;
+        for (const auto& rect : edits.rects()) planet_.classify_biomes(rect);
+        components_.update(edits);
+        planet_.hydrosphere = Hydrology::generate(planet_.elevation, planet_.moisture, make_hydrology_config());
+    }
+
 private:
+    HydrologyConfig make_hydrology_config() const {
+        HydrologyConfig config;
+        config.sea_level = planet_.sea_level;
+        return config;
+    }
+
+    /// Terrain settings shared by the in-memory and streaming paths.
+    TerrainConfig make_terrain_config(u32 width, u32 height) {
+        TerrainConfig config;
+        config.width = width;
+        config.height = height;
+        config.sea_level = 0.40f;
+        config.num_plates = 7 + rng_->next_int(0, 5);
+        config.erosion_iterations = static_cast<i32>(width) * 100;
+        return config;
+    }
+
     Registry* registry_ = nullptr;
     EventBus* bus_ = nullptr;
     RNG* rng_ = nullptr;
 
     PlanetData planet_;
+    SurfaceComponents components_;
     bool generated_ = false;
 };
 
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "core/serialise/BinaryStream.h"
+#include "core/time/SimTime.h"
+#include "core/util/Assert.h"
+#include "core/util/Types.h"
+
+#include <array>
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+namespace godsim {
+
+/// Temperature (°C) and moisture ([0, 1]) of one cell on one day.
+struct SeasonSample {
+    f32 temperature = 0.0f;
+    f32 moisture = 0.0f;
+};
+
+/// The harmonic basis at one point of the year: cos and sin of each
+/// harmonic, computed once and shared by every cell sampled then.
+struct SeasonPhase {
+    static constexpr u32 MAX_HARMONICS = 3;
+
+    u32 harmonics = 0;
+    std::array<f32, 2 * MAX_HARMONICS> basis{}; // cos kθ, sin kθ for k = 1..harmonics
+
+    /// `year_fraction` in [0, 1), 0 at the northern spring equinox.
+    SeasonPhase(u32 harmonic_count, f32 year_fraction) : harmonics(harmonic_count) {
+        f64 theta = 2.0 * std::numbers::pi * year_fraction;
+        for (u32 k = 0; k < harmonics; k++) {
+            basis[2 * k] = static_cast<f32>(std::cos((k + 1) * theta));
+            basis[2 * k + 1] = static_cast<f32>(std::sin((k + 1) * theta));
+        }
+    }
+
+    /// Year fraction of a simulation day; day 0 is an equinox.
+    static f32 year_fraction(SimTime time) {
+        f64 t = std::fmod(time.days(), 365.25) / 365.25;
+        return static_cast<f32>(t < 0.0 ? t + 1.0 : t);
+    }
+};
+
+/// How each cell's climate swings through the year, as the first few
+/// Fourier harmonics of its departure from the annual mean (which is
+/// PlanetData's temperature and moisture grids). Any day is the mean plus
+/// a short sum, O(1) per cell, and the whole cycle costs 2·harmonics
+/// floats per field per cell instead of a grid per month.
+///
+/// Empty until ClimateGenerator::generate_seasons() fills it; an empty
+/// cycle has no seasons.
+struct SeasonalClimate {
+    u32 width = 0, height = 0;
+    u32 harmonics = 0;
+    std::vector<f32> temperature; // Per cell: (cos, sin) coefficient pairs, °C
+    std::vector<f32> moisture;
+
+    SeasonalClimate() = default;
+    SeasonalClimate(u32 w, u32 h, u32 harmonic_count)
+        : width(w), height(h), harmonics(harmonic_count),
+          temperature(static_cast<size_t>(w) * h * 2 * harmonic_count, 0.0f),
+          moisture(static_cast<size_t>(w) * h * 2 * harmonic_count, 0.0f) {}
+
+    bool empty() const { return harmonics == 0 || temperature.empty(); }
+    u32 stride() const { return 2 * harmonics; }
+
+    SeasonPhase phase(f32 year_fraction) const { return {harmonics, year_fraction}; }
+
+    f32 temperature_anomaly(size_t cell, const SeasonPhase& phase) const {
+        return anomaly(temperature, cell, phase);
+    }
+
+    f32 moisture_anomaly(size_t cell, const SeasonPhase& phase) const {
+        return anomaly(moisture, cell, phase);
+    }
+
+    /// Largest departure from the mean over the year (first harmonic).
+    f32 temperature_amplitude(size_t cell) const {
+        if (empty()) return 0.0f;
+        const f32* c = &temperature[cell * stride()];
+        return std::hypot(c[0], c[1]);
+    }
+
+    // ─── Serialisation ───
+    void serialise(BinaryWriter& writer) const {
+        writer.write_u32(width);
+        writer.write_u32(height);
+        writer.write_u32(harmonics);
+        writer.write_u32(static_cast<u32>(temperature.size()));
+        writer.write_bytes(temperature.data(), temperature.size() * sizeof(f32));
+        writer.write_bytes(moisture.data(), moisture.size() * sizeof(f32));
+    }
+
+    void deserialise(BinaryReader& reader) {
+        width = reader.read_u32();
+        height = reader.read_u32();
+        harmonics = reader.read_u32();
+        u32 count = reader.read_u32();
+        GODSIM_ASSERT(harmonics <= SeasonPhase::MAX_HARMONICS, "Corrupt seasons: {} harmonics", harmonics);
+        GODSIM_ASSERT(count == static_cast<u64>(width) * height * 2 * harmonics,
+                      "Corrupt seasons: {} coefficients for {}x{} cells and {} harmonics",
+                      count, width, height, harmonics);
+        temperature.resize(count);
+        moisture.resize(count);
+        reader.read_bytes(temperature.data(), count * sizeof(f32));
+        reader.read_bytes(moisture.data(), count * sizeof(f32));
+    }
+
+private:
+    f32 anomaly(const std::vector<f32>& field, size_t cell, const SeasonPhase& phase) const {
+        if (empty()) return 0.0f;
+        const f32* c = &field[cell * stride()];
+        f32 sum = 0.0f;
+        for (u32 i = 0; i < stride(); i++) sum += c[i] * phase.basis[i];
+        return sum;
+    }
+};
+
+} // namespace godsim
@@ -0,0 +1,438 @@
+#pragma once
+
+#include "PlanetData.h"
+#include "TerrainGenerator.h"
+#include "ClimateGenerator.h"
+#include "core/rng/RNG.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+#include "core/util/Log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+/// Options for StreamingPlanetGenerator.
+struct StreamingConfig {
+    u32 band_rows = 256;      // Rows generated and handed to the sink at a time
+    std::string scratch_dir;  // Spill files; empty = system temp directory
+    size_t select_limit = size_t(1) << 22; // Most values gathered in memory for sea level
+};
+
+/// Whole-planet values. Ranges and threshold are known after prepare();
+/// the averages are filled in by emit().
+struct StreamingSummary {
+    f32 raw_min = 0.0f, raw_max = 0.0f;  // Eroded elevation before normalisation
+    f32 sea_threshold = 0.0f;            // Normalised elevation remapped to sea level
+    f32 temperature_min = 0.0f, temperature_max = 0.0f;
+    f32 land_fraction = 0.0f;
+    f32 avg_temperature = 0.0f;
+    f32 avg_moisture = 0.0f;
+};
+
+/// Row-addressable f32 grid on disk. The file is removed on close.
+class GridSpill {
+public:
+    GridSpill() = default;
+    ~GridSpill() { close(); }
+    GridSpill(const GridSpill&) = delete;
+    GridSpill& operator=(const GridSpill&) = delete;
+
+    void open(const std::string& path, u32 width) {
+        close();
+        path_ = path;
+        width_ = width;
+        file_.open(path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+        if (!file_) throw std::runtime_error("Cannot open spill file: " + path);
+    }
+
+    void write_rows(u32 y, u32 rows, const f32* data) {
+        file_.seekp(offset(y));
+        file_.write(reinterpret_cast<const char*>(data), offset(rows));
+        if (!file_) throw std::runtime_error("Spill write failed: " + path_);
+    }
+
+    void read_rows(u32 y, u32 rows, f32* data) {
+        file_.seekg(offset(y));
+        file_.read(reinterpret_cast<char*>(data), offset(rows));
+        if (!file_) throw std::runtime_error("Spill read failed: " + path_);
+    }
+
+    void close() {
+        if (!file_.is_open()) return;
+        file_.close();
+        std::error_code ec;
+        std::filesystem::remove(path_, ec);
+    }
+
+private:
+    std::streamoff offset(u32 rows) const {
+        return static_cast<std::streamoff>(rows) * width_ * sizeof(f32);
+    }
+
+    std::fstream file_;
+    std::string path_;
+    u32 width_ = 0;
+};
+
+/// Generates a planet a band of rows at a time, for maps too large to hold
+/// every grid in memory. prepare() runs the terrain pipeline and the global
+/// passes, spilling elevation and ocean distance to disk; emit() then hands
+/// out complete bands (elevation, temperature, moisture, biomes) top to bottom.
+///
+/// Local stages — plates, noise, ridges, blur, temperature, moisture and
+/// biomes — are computed per band with whatever halo rows they read, and
+/// match the in-memory pipeline exactly. The global stages:
+///   - Normalisation: exact. Min/max are tracked while the raw elevation is
+///     spilled.
+///   - Sea level: exact. The quantile is found with histogram passes over the
+///     spill until the bin holding it is small enough to select in memory.
+///   - Ocean distance: exact. The BFS distance is the city-block distance
+///     transform, computed as a forward and a backward raster pass.
+///   - Erosion: approximate. The droplets are the same (same RNG draws) but
+///     run in start-row order within a window of DROPLET_REACH rows around
+///     each band rather than in draw order, so droplets whose paths overlap
+///     interact differently. With erosion off the output is identical.
+///
+/// Resident memory is the erosion window (band + 2·reach rows), a few band
+/// buffers, 8 bytes per droplet and the selection histogram.
+class StreamingPlanetGenerator {
+public:
+    /// Histogram resolution for the sea-level quantile.
+    static constexpr u32 SELECT_BINS = 1u << 16;
+
+    explicit StreamingPlanetGenerator(RNG& rng, StreamingConfig config = {})
+        : rng_(rng), config_(std::move(config)) {
+        config_.band_rows = std::max(config_.band_rows, 1u);
+    }
+
+    /// Run every pass that needs the whole map. Consumes the RNG exactly like
+    /// TerrainGenerator::generate followed by the two ClimateGenerator calls.
+    void prepare(const TerrainConfig& terrain_config, const ClimateConfig& climate_config) {
+        w_ = terrain_config.width;
+        h_ = terrain_config.height;
+        sea_level_ = terrain_config.sea_level;
+        climate_ = climate_config;
+        summary_ = {};
+
+        LOG_INFO("Streaming terrain ({}x{}, {}-row bands)...", w_, h_, config_.band_rows);
+        TerrainGenerator terrain(rng_);
+        terrain.prepare(terrain_config);
+        auto droplets = sort_by_row(terrain.draw_droplets(terrain_config));
+        temperature_noise_ = PerlinNoise(rng_.next_u64());
+        moisture_noise_ = PerlinNoise(rng_.next_u64());
+
+        std::string dir = config_.scratch_dir.empty()
+            ? std::filesystem::temp_directory_path().string() : config_.scratch_dir;
+        std::string stem = dir + "/godsim_stream_" +
+            std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + "_" +
+            std::to_string(reinterpret_cast<std::uintptr_t>(this));
+        elevation_.open(stem + "_elevation.f32", w_);
+        distance_.open(stem + "_distance.f32", w_);
+
+        LOG_INFO("  Pass 1: Plates, noise, ridges and erosion...");
+        terrain_pass(terrain, droplets);
+        droplets = {};
+
+        LOG_INFO("  Pass 2: Sea level quantile...");
+        size_t cells = static_cast<size_t>(w_) * h_;
+        size_t sea_idx = static_cast<size_t>(sea_level_ * cells);
+        f32 raw_threshold = select(std::min(sea_idx, cells - 1));
+
+        LOG_INFO("  Pass 3: Normalisation, forward distance, temperature range...");
+        remap_pass(raw_threshold);
+
+        LOG_INFO("  Pass 4: Backward distance...");
+        distance_backward_pass();
+
+        LOG_INFO("  Streaming prepared. Temperature range: {:.1f}°C to {:.1f}°C",
+                 summary_.temperature_min, summary_.temperature_max);
+    }
+
+    /// Hand out finished bands top to bottom. Band pointers are only valid
+    /// during the callback. Can be called more than once after prepare().
+    void emit(const std::function<void(const PlanetBand&)>& sink) {
+        u32 band = config_.band_rows;
+        size_t cap = static_cast<size_t>(band) * w_;
+        std::vector<f32> elev(cap), dist(cap), temp(cap), moist(cap);
+        std::vector<BiomeType> biomes(cap);
+
+        u64 land = 0;
+        f64 temp_sum = 0.0, moist_sum = 0.0;
+
+        for (u32 y0 = 0; y0 < h_; y0 += band) {
+            u32 rows = std::min(band, h_ - y0);
+            elevation_.read_rows(y0, rows, elev.data());
+            distance_.read_rows(y0, rows, dist.data());
+
+            parallel_for(0, rows, [&](u32 lo, u32 hi) {
+                for (u32 r = lo; r < hi; r++) {
+                    size_t at = static_cast<size_t>(r) * w_;
+                    ClimateGenerator::temperature_row(&elev[at], y0 + r, w_, h_,
+                        temperature_noise_, climate_, &temp[at]);
+                    ClimateGenerator::moisture_row(&elev[at], &dist[at], y0 + r, w_, h_,
+                        moisture_noise_, climate_, &moist[at]);
+                    for (u32 x = 0; x < w_; x++) {
+                        biomes[at + x] = classify_biome(elev[at + x], temp[at + x],
+                                                        moist[at + x], sea_level_);
+                    }
+                }
+            }, 4);
+
+            size_t n = static_cast<size_t>(rows) * w_;
+            for (size_t i = 0; i < n; i++) {
+                if (elev[i] >= sea_level_) land++;
+                temp_sum += temp[i];
+                moist_sum += moist[i];
+            }
+
+            sink({w_, y0, rows, elev.data(), temp.data(), moist.data(), biomes.data()});
+        }
+
+        f64 cells = static_cast<f64>(w_) * h_;
+        summary_.land_fraction = static_cast<f32>(land) / static_cast<f32>(static_cast<u64>(w_) * h_);
+        summary_.avg_temperature = static_cast<f32>(temp_sum / cells);
+        summary_.avg_moisture = static_cast<f32>(moist_sum / cells);
+    }
+
+    const StreamingSummary& summary() const { return summary_; }
+    f32 sea_level() const { return sea_level_; }
+    u32 width() const { return w_; }
+    u32 height() const { return h_; }
+
+private:
+    using Droplet = TerrainGenerator::Droplet;
+
+    /// Stable counting sort by start row; first_drop_[y] indexes the first
+    /// droplet starting on row y.
+    std::vector<Droplet> sort_by_row(const std::vector<Droplet>& drops) {
+        first_drop_.assign(h_ + 1, 0);
+        for (const auto& d : drops) first_drop_[static_cast<u32>(d.y) + 1]++;
+        for (u32 y = 0; y < h_; y++) first_drop_[y + 1] += first_drop_[y];
+
+        std::vector<Droplet> sorted(drops.size());
+        std::vector<u32> next(first_drop_.begin(), first_drop_.end() - 1);
+        for (const auto& d : drops) sorted[next[static_cast<u32>(d.y)]++] = d;
+        return sorted;
+    }
+
+    // ─── Pass 1: Terrain ───
+
+    /// Slide an erosion window down the map. Droplets starting in a band run
+    /// once that band plus DROPLET_REACH rows below it exist; rows more than
+    /// DROPLET_REACH above the next band can no longer change and are spilled.
+    void terrain_pass(const TerrainGenerator& terrain, const std::vector<Droplet>& drops) {
+        u32 band = config_.band_rows;
+        u32 reach = TerrainGenerator::DROPLET_REACH;
+        Heightmap window(w_, std::min(h_, band + 2 * reach));
+        u32 win_lo = 0, win_hi = 0;
+
+        summary_.raw_min = std::numeric_limits<f32>::max();
+        summary_.raw_max = std::numeric_limits<f32>::lowest();
+
+        for (u32 s0 = 0; s0 < h_; s0 += band) {
+            u32 s1 = std::min(h_, s0 + band);
+            u32 need = std::min(h_, s1 + reach);
+            if (need > win_hi) {
+                terrain.generate_rows(win_hi, need,
+                    window.data_ptr() + static_cast<size_t>(win_hi - win_lo) * w_);
+                win_hi = need;
+            }
+
+            for (u32 i = first_drop_[s0]; i < first_drop_[s1]; i++) {
+                TerrainGenerator::run_droplet(window, win_lo, h_, drops[i].x, drops[i].y);
+            }
+
+            u32 done = s1 == h_ ? h_ : (s1 > reach ? s1 - reach : 0);
+            if (done <= win_lo) continue;
+
+            f32* rows = window.data_ptr();
+            size_t n = static_cast<size_t>(done - win_lo) * w_;
+            for (size_t i = 0; i < n; i++) {
+                summary_.raw_min = std::min(summary_.raw_min, rows[i]);
+                summary_.raw_max = std::max(summary_.raw_max, rows[i]);
+            }
+            elevation_.write_rows(win_lo, done - win_lo, rows);
+            std::copy(rows + n, rows + static_cast<size_t>(win_hi - win_lo) * w_, rows);
+            win_lo = done;
+        }
+    }
+
+    // ─── Pass 2: Sea Level Selection ───
+
+    /// Visit every spilled elevation row band in order.
+    template<typename Fn>
+    void scan_elevation(Fn&& fn) {
+        std::vector<f32> buf(static_cast<size_t>(config_.band_rows) * w_);
+        for (u32 y0 = 0; y0 < h_; y0 += config_.band_rows) {
+            u32 rows = std::min(config_.band_rows, h_ - y0);
+            elevation_.read_rows(y0, rows, buf.data());
+            fn(buf.data(), static_cast<size_t>(rows) * w_);
+        }
+    }
+
+    /// k-th smallest raw elevation. Each histogram pass narrows the candidate
+    /// range to the bin holding rank k (bins are monotone in value, so a bin
+    /// is exactly the values between its min and max) until few enough remain
+    /// to nth_element.
+    f32 select(size_t k) {
+        struct Bin {
+            u64 count = 0;
+            f32 min = std::numeric_limits<f32>::max();
+            f32 max = std::numeric_limits<f32>::lowest();
+        };
+
+        f32 lo = summary_.raw_min, hi = summary_.raw_max;
+        u64 candidates = static_cast<u64>(w_) * h_;
+
+        while (lo < hi && candidates > config_.select_limit) {
+            std::vector<Bin> bins(SELECT_BINS);
+            f32 span = hi - lo;
+            scan_elevation([&](const f32* v, size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    if (v[i] < lo || v[i] > hi) continue;
+                    u32 b = std::min(SELECT_BINS - 1,
+                                     static_cast<u32>((v[i] - lo) / span * SELECT_BINS));
+                    bins[b].count++;
+                    bins[b].min = std::min(bins[b].min, v[i]);
+                    bins[b].max = std::max(bins[b].max, v[i]);
+                }
+            });
+
+            u32 b = 0;
+            while (k >= bins[b].count) k -= bins[b++].count;
+            lo = bins[b].min;
+            hi = bins[b].max;
+            candidates = bins[b].count;
+        }
+        if (lo >= hi) return lo;
+
+        std::vector<f32> values;
+        values.reserve(candidates);
+        scan_elevation([&](const f32* v, size_t n) {
+            for (size_t i = 0; i < n; i++) {
+                if (v[i] >= lo && v[i] <= hi) values.push_back(v[i]);
+            }
+        });
+        std::nth_element(values.begin(), values.begin() + k, values.end());
+        return values[k];
+    }
+
+    // ─── Pass 3: Remap ───
+
+    /// Normalise and remap elevation in place, run the forward half of the
+    /// ocean distance transform and find the temperature range.
+    void remap_pass(f32 raw_threshold) {
+        // Same arithmetic as Heightmap::normalise, so values match bit for bit
+        f32 lo = summary_.raw_min;
+        f32 range = summary_.raw_max - lo;
+        bool normalise = range >= 1e-8f;
+        auto norm = [&](f32 v) { return normalise ? (v - lo) / range : v; };
+        f32 threshold = norm(raw_threshold);
+        summary_.sea_threshold = threshold;
+
+        const f32 inf = std::numeric_limits<f32>::infinity();
+        std::vector<f32> above(w_, inf);
+
+        u32 band = config_.band_rows;
+        std::vector<f32> elev(static_cast<size_t>(band) * w_);
+        std::vector<f32> dist(elev.size()), temp(elev.size());
+        summary_.temperature_min = std::numeric_limits<f32>::max();
+        summary_.temperature_max = std::numeric_limits<f32>::lowest();
+
+        for (u32 y0 = 0; y0 < h_; y0 += band) {
+            u32 rows = std::min(band, h_ - y0);
+            size_t n = static_cast<size_t>(rows) * w_;
+            elevation_.read_rows(y0, rows, elev.data());
+
+            parallel_for(0, rows, [&](u32 lo_r, u32 hi_r) {
+                for (u32 r = lo_r; r < hi_r; r++) {
+                    size_t at = static_cast<size_t>(r) * w_;
+                    for (u32 x = 0; x < w_; x++) {
+                        elev[at + x] = TerrainGenerator::remap_sea_level(
+                            norm(elev[at + x]), threshold, sea_level_);
+                    }
+                    ClimateGenerator::temperature_row(&elev[at], y0 + r, w_, h_,
+                        temperature_noise_, climate_, &temp[at]);
+                }
+            }, 4);
+
+            // Forward raster pass: distance via the left and upper neighbours
+            for (u32 r = 0; r < rows; r++) {
+                f32* d = &dist[static_cast<size_t>(r) * w_];
+                const f32* e = &elev[static_cast<size_t>(r) * w_];
+                const f32* up = r > 0 ? d - w_ : above.data();
+                for (u32 x = 0; x < w_; x++) {
+                    f32 v = e[x] < climate_.sea_level ? 0.0f : inf;
+                    if (x > 0) v = std::min(v, d[x - 1] + 1.0f);
+                    d[x] = std::min(v, up[x] + 1.0f);
+                }
+            }
+            std::copy(dist.begin() + (n - w_), dist.begin() + n, above.begin());
+
+            for (size_t i = 0; i < n; i++) {
+                summary_.temperature_min = std::min(summary_.temperature_min, temp[i]);
+                summary_.temperature_max = std::max(summary_.temperature_max, temp[i]);
+            }
+            elevation_.write_rows(y0, rows, elev.data());
+            distance_.write_rows(y0, rows, dist.data());
+        }
+    }
+
+    // ─── Pass 4: Backward Distance ───
+
+    /// Backward raster pass (right and lower neighbours), bottom band first.
+    /// Cells no ocean can reach become -1, matching the BFS's unvisited value.
+    void distance_backward_pass() {
+        const f32 inf = std::numeric_limits<f32>::infinity();
+        std::vector<f32> below(w_, inf);
+        u32 band = config_.band_rows;
+        std::vector<f32> dist(static_cast<size_t>(band) * w_);
+
+        for (u32 y1 = h_; y1 > 0;) {
+            u32 rows = std::min(band, y1);
+            u32 y0 = y1 - rows;
+            distance_.read_rows(y0, rows, dist.data());
+
+            for (u32 r = rows; r-- > 0;) {
+                f32* d = &dist[static_cast<size_t>(r) * w_];
+                const f32* down = r + 1 < rows ? d + w_ : below.data();
+                for (u32 x = w_; x-- > 0;) {
+                    f32 v = d[x];
+                    if (x + 1 < w_) v = std::min(v, d[x + 1] + 1.0f);
+                    d[x] = std::min(v, down[x] + 1.0f);
+                }
+            }
+            std::copy(dist.begin(), dist.begin() + w_, below.begin());
+
+            size_t n = static_cast<size_t>(rows) * w_;
+            for (size_t i = 0; i < n; i++) {
+                if (dist[i] == inf) dist[i] = -1.0f;
+            }
+            distance_.write_rows(y0, rows, dist.data());
+            y1 = y0;
+        }
+    }
+
+    RNG& rng_;
+    StreamingConfig config_;
+    ClimateConfig climate_;
+    PerlinNoise temperature_noise_, moisture_noise_;
+    StreamingSummary summary_;
+
+    u32 w_ = 0, h_ = 0;
+    f32 sea_level_ = 0.4f;
+    std::vector<u32> first_drop_;
+    GridSpill elevation_, distance_;
+};
+
+} // namespace godsim
@@ -0,0 +1,368 @@
+#pragma once
+
+#include "PlanetData.h"
+#include "DirtyRegion.h"
+#include "core/util/Parallel.h"
+#include "core/util/Profiler.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <unordered_map>
+#include <vector>
+
+namespace godsim {
+
+/// One connected stretch of land (a continent or island) or of sea (an
+/// ocean basin or inland sea).
+struct SurfaceComponent {
+    bool     land = false;
+    u32      cells = 0;
+    f32      area = 0.0f;  // Fraction of the sphere's surface
+    CellRect bounds;       // x1 passes the grid width if it straddles the seam
+    f32      centroid_x = 0.0f; // Area-weighted, in cells; x on the wrapped circle
+    f32      centroid_y = 0.0f;
+};
+
+/// Connected components of the land/ocean mask: how many continents,
+/// islands and separate seas a world has, where they are and how big.
+/// Cells connect to their four edge neighbours, the same cells
+/// Pathfinder lets a walker reach without cutting corners, and longitude
+/// wraps. Land is elevation >= sea_level.
+///
+/// Labelling is a parallel union-find. Bands of rows are united
+/// independently (each root is the component's first cell in raster
+/// order, so the result doesn't depend on the thread count), the seams
+/// between bands are joined serially, and the roots are numbered in
+/// raster order. Labels are dense, 0..count() - 1.
+///
+/// Elevation is read live from PlanetData. After terraforming, pass the
+/// edited area to update(): only the components the edit touches are
+/// relabelled, and the others keep their labels, except that the highest
+/// label may move into the place of one that disappeared.
+class SurfaceComponents {
+public:
+    static constexpr u32 NO_LABEL = ~0u;
+
+    // ─── Setup ───
+
+    /// Label `planet`, which must outlive this.
+    void build(const PlanetData& planet) {
+        ProfileScope scope("SurfaceComponents.build");
+        planet_ = &planet;
+        w_ = planet.width;
+        h_ = planet.height;
+        size_t n = static_cast<size_t>(w_) * h_;
+        land_.assign(n, 0);
+        labels_.assign(n, NO_LABEL);
+        parent_.assign(n, 0);
+
+        u32 bands = std::max(1u, std::min(h_, ThreadPool::instance().size() * 4));
+        rows_per_band_ = (h_ + bands - 1) / std::max(bands, 1u);
+        bands_ = rows_per_band_ ? (h_ + rows_per_band_ - 1) / rows_per_band_ : 0;
+
+        // Cell areas (exact for a latitude band) and longitudes, for area
+        // and centroid sums
+        row_area_.resize(h_);
+        for (u32 y = 0; y < h_; y++) {
+            f64 lat0 = (static_cast<f64>(y) / h_ - 0.5) * std::numbers::pi;
+            f64 lat1 = (static_cast<f64>(y + 1) / h_ - 0.5) * std::numbers::pi;
+            row_area_[y] = (std::sin(lat1) - std::sin(lat0)) / (2.0 * w_);
+        }
+        col_cos_.resize(w_);
+        col_sin_.resize(w_);
+        for (u32 x = 0; x < w_; x++) {
+            f64 lon = (x + 0.5) / w_ * 2.0 * std::numbers::pi;
+            col_cos_[x] = std::cos(lon);
+            col_sin_[x] = std::sin(lon);
+        }
+
+        for_bands([&](u32, u32 y0, u32 y1) { classify(0, w_, y0, y1); });
+        u32 count = label(nullptr);
+        std::vector<u32> ids(count);
+        for (u32 k = 0; k < count; k++) ids[k] = k;
+        components_.assign(count, {});
+        assign(nullptr, ids);
+        measure(nullptr, ids);
+    }
+
+    bool built() const { return planet_ != nullptr; }
+
+    /// Relabel the components under edited cells, which may have split,
+    /// merged, appeared or vanished.
+    void update(const DirtyRegion& edits) {
+        if (!planet_ || edits.empty()) return;
+        ProfileScope scope("SurfaceComponents.update");
+
+        for (const auto& rect : edits.rects()) classify(rect.x0, rect.x1, rect.y0, rect.y1);
+
+        // A component can only change if it has a cell in or next to an
+        // edited one; every other component is walled off from those by
+        // cells of the other kind that the edit didn't touch.
+        std::vector<u8> affected(components_.size(), 0);
+        for (const auto& rect : edits.rects()) {
+            u32 y0 = rect.y0 > 0 ? rect.y0 - 1 : 0;
+            u32 y1 = std::min(rect.y1 + 1, h_);
+            for (u32 y = y0; y < y1; y++) {
+                for (u32 xx = rect.x0 + w_ - 1; xx <= rect.x1 + w_; xx++) {
+                    affected[labels_[static_cast<size_t>(y) * w_ + xx % w_]] = 1;
+                }
+            }
+        }
+        std::vector<u32> freed;
+        for (u32 id = 0; id < components_.size(); id++) {
+            if (affected[id]) freed.push_back(id);
+        }
+
+        std::vector<u8> active(labels_.size(), 0);
+        for_bands([&](u32, u32 y0, u32 y1) {
+            for (size_t i = static_cast<size_t>(y0) * w_; i < static_cast<size_t>(y1) * w_; i++) {
+                active[i] = affected[labels_[i]];
+            }
+        });
+
+        // New components take the freed labels first, then new ones
+        u32 count = label(active.data());
+        std::vector<u32> ids(count);
+        u32 next = static_cast<u32>(components_.size());
+        for (u32 k = 0; k < count; k++) ids[k] = k < freed.size() ? freed[k] : next++;
+        components_.resize(next);
+        assign(active.data(), ids);
+        measure(active.data(), ids);
+
+        // Fill labels left over with the highest ones, highest first so
+        // the one moved is never itself left over
+        for (size_t k = freed.size(); k-- > count;) {
+            u32 id = freed[k];
+            u32 last = static_cast<u32>(components_.size()) - 1;
+            if (id != last) {
+                const CellRect& b = components_[last].bounds;
+                for (u32 y = b.y0; y < b.y1; y++) {
+                    for (u32 xx = b.x0; xx < b.x1; xx++) {
+                        u32& label = labels_[static_cast<size_t>(y) * w_ + xx % w_];
+                        if (label == last) label = id;
+                    }
+                }
+                components_[id] = components_[last];
+            }
+            components_.pop_back();
+        }
+    }
+
+    // ─── Queries ───
+
+    u32 count() const { return static_cast<u32>(components_.size()); }
+
+    /// Land (or sea) components of at least `min_area` (fraction of the
+    /// sphere): continents rather than islands, oceans rather than lakes.
+    u32 count(bool land, f32 min_area = 0.0f) const {
+        u32 n = 0;
+        for (const auto& c : components_) n += c.land == land && c.area >= min_area;
+        return n;
+    }
+
+    const SurfaceComponent& component(u32 label) const { return components_[label]; }
+    const std::vector<SurfaceComponent>& components() const { return components_; }
+
+    u32 label_at(u32 x, u32 y) const { return labels_[static_cast<size_t>(y) * w_ + x]; }
+    const std::vector<u32>& labels() const { return labels_; }
+
+private:
+    /// Running sums for one component within one band.
+    struct Accum {
+        bool land = false;
+        u32 cells = 0;
+        f64 area = 0.0, sum_y = 0.0, sum_cos = 0.0, sum_sin = 0.0;
+        u32 min_x = ~0u, max_x = 0;
+        u32 min_s = ~0u, max_s = 0; // x shifted half a turn, for seam-straddlers
+        u32 min_y = ~0u, max_y = 0;
+
+        void merge(const Accum& o) {
+            land = o.land;
+            cells += o.cells;
+            area += o.area;
+            sum_y += o.sum_y;
+            sum_cos += o.sum_cos;
+            sum_sin += o.sum_sin;
+            min_x = std::min(min_x, o.min_x); max_x = std::max(max_x, o.max_x);
+            min_s = std::min(min_s, o.min_s); max_s = std::max(max_s, o.max_s);
+            min_y = std::min(min_y, o.min_y); max_y = std::max(max_y, o.max_y);
+        }
+    };
+
+    /// Call fn(band, y0, y1) for each band of rows, in parallel.
+    template<typename Fn>
+    void for_bands(Fn&& fn) {
+        parallel_for(0, bands_, [&](u32 b0, u32 b1) {
+            for (u32 b = b0; b < b1; b++) {
+                fn(b, b * rows_per_band_, std::min(h_, (b + 1) * rows_per_band_));
+            }
+        });
+    }
+
+    void classify(u32 x0, u32 x1, u32 y0, u32 y1) {
+        const f32* elev = planet_->elevation.data_ptr();
+        for (u32 y = y0; y < y1; y++) {
+            for (u32 x = x0; x < x1; x++) {
+                size_t i = static_cast<size_t>(y) * w_ + x;
+                land_[i] = elev[i] >= planet_->sea_level;
+            }
+        }
+    }
+
+    u32 find(u32 i) {
+        while (parent_[i] != i) {
+            parent_[i] = parent_[parent_[i]];
+            i = parent_[i];
+        }
+        return i;
+    }
+
+    /// Union by smallest index, so every root is its component's first
+    /// cell in raster order.
+    void unite(u32 a, u32 b) {
+        a = find(a);
+        b = find(b);
+        if (a < b) parent_[b] = a;
+        else if (b < a) parent_[a] = b;
+    }
+
+    /// Union-find over `active` cells (all if null). Leaves labels_[i] =
+    /// root cell, and parent_[root] = the component's index in raster
+    /// order of roots; returns the number of components.
+    u32 label(const u8* active) {
+        auto on = [active](size_t i) { return !active || active[i]; };
+        auto joins = [&](size_t a, size_t b) { return on(b) && land_[a] == land_[b]; };
+
+        // Each band on its own: only its own cells are touched
+        for_bands([&](u32, u32 y0, u32 y1) {
+            for (u32 y = y0; y < y1; y++) {
+                u32 row = y * w_;
+                for (u32 x = 0; x < w_; x++) {
+                    u32 i = row + x;
+                    if (!on(i)) continue;
+                    parent_[i] = i;
+                    if (x > 0 && joins(i, i - 1)) unite(i, i - 1);
+                    if (y > y0 && joins(i, i - w_)) unite(i, i - w_);
+                }
+                u32 last = row + w_ - 1;
+                if (w_ > 1 && on(last) && joins(last, row)) unite(last, row);
+            }
+        });
+
+        // Seams between bands
+        for (u32 b = 1; b < bands_; b++) {
+            u32 row = b * rows_per_band_ * w_;
+            for (u32 i = row; i < row + w_; i++) {
+                if (on(i) && joins(i, i - w_)) unite(i, i - w_);
+            }
+        }
+
+        // Roots, read-only
+        for_bands([&](u32, u32 y0, u32 y1) {
+            for (u32 i = y0 * w_; i < y1 * w_; i++) {
+                if (!on(i)) continue;
+                u32 r = i;
+                while (parent_[r] != r) r = parent_[r];
+                labels_[i] = r;
+            }
+        });
+
+        // Number the roots in raster order
+        std::vector<u32> band_roots(bands_, 0);
+        for_bands([&](u32 b, u32 y0, u32 y1) {
+            for (u32 i = y0 * w_; i < y1 * w_; i++) band_roots[b] += on(i) && labels_[i] == i;
+        });
+        u32 total = 0;
+        for (u32& n : band_roots) {
+            u32 first = total;
+            total += n;
+            n = first;
+        }
+        for_bands([&](u32 b, u32 y0, u32 y1) {
+            u32 next = band_roots[b];
+            for (u32 i = y0 * w_; i < y1 * w_; i++) {
+                if (on(i) && labels_[i] == i) parent_[i] = next++;
+            }
+        });
+        return total;
+    }
+
+    /// Replace root cells left by label() with final labels.
+    void assign(const u8* active, const std::vector<u32>& ids) {
+        for_bands([&](u32, u32 y0, u32 y1) {
+            for (u32 i = y0 * w_; i < y1 * w_; i++) {
+                if (!active || active[i]) labels_[i] = ids[parent_[labels_[i]]];
+            }
+        });
+    }
+
+    /// Recompute the components labelled `ids` from the `active` cells.
+    void measure(const u8* active, const std::vector<u32>& ids) {
+        std::vector<std::unordered_map<u32, Accum>> partial(bands_);
+        u32 half = w_ / 2;
+        for_bands([&](u32 b, u32 y0, u32 y1) {
+            auto& sums = partial[b];
+            for (u32 y = y0; y < y1; y++) {
+                for (u32 x = 0; x < w_; x++) {
+                    size_t i = static_cast<size_t>(y) * w_ + x;
+                    if (active && !active[i]) continue;
+                    Accum& a = sums[labels_[i]];
+                    f64 area = row_area_[y];
+                    u32 s = (x + half) % w_;
+                    a.land = land_[i];
+                    a.cells++;
+                    a.area += area;
+                    a.sum_y += area * (y + 0.5);
+                    a.sum_cos += area * col_cos_[x];
+                    a.sum_sin += area * col_sin_[x];
+                    a.min_x = std::min(a.min_x, x); a.max_x = std::max(a.max_x, x);
+                    a.min_s = std::min(a.min_s, s); a.max_s = std::max(a.max_s, s);
+                    a.min_y = std::min(a.min_y, y); a.max_y = std::max(a.max_y, y);
+                }
+            }
+        });
+
+        std::unordered_map<u32, Accum> totals;
+        for (auto& sums : partial) {
+            for (const auto& [id, a] : sums) totals[id].merge(a);
+        }
+
+        for (u32 id : ids) {
+            const Accum& a = totals[id];
+            SurfaceComponent& c = components_[id];
+            c.land = a.land;
+            c.cells = a.cells;
+            c.area = static_cast<f32>(a.area);
+            c.bounds.y0 = a.min_y;
+            c.bounds.y1 = a.max_y + 1;
+            u32 span = a.max_x - a.min_x + 1;
+            u32 span_shifted = a.max_s - a.min_s + 1;
+            if (span_shifted < span) {
+                c.bounds.x0 = (a.min_s + w_ - half) % w_;
+                c.bounds.x1 = c.bounds.x0 + span_shifted;
+            } else {
+                c.bounds.x0 = a.min_x;
+                c.bounds.x1 = a.max_x + 1;
+            }
+            f64 lon = std::atan2(a.sum_sin, a.sum_cos);
+            if (lon < 0.0) lon += 2.0 * std::numbers::pi;
+            f32 cx = static_cast<f32>(std::fmod(lon / (2.0 * std::numbers::pi) * w_ - 0.5 + w_, w_));
+            c.centroid_x = cx < static_cast<f32>(w_) ? cx : 0.0f; // Rounded up to the seam
+            c.centroid_y = static_cast<f32>(a.sum_y / a.area - 0.5);
+        }
+    }
+
+    const PlanetData* planet_ = nullptr;
+    u32 w_ = 0, h_ = 0;
+    u32 bands_ = 0, rows_per_band_ = 0;
+    std::vector<u8> land_;
+    std::vector<u32> labels_;
+    std::vector<u32> parent_; // Union-find scratch
+    std::vector<f64> row_area_;
+    std::vector<f64> col_cos_, col_sin_;
+    std::vector<SurfaceComponent> components_;
+};
+
+} // namespace godsim
@@ -5,6 +5,7 @@
 #include "core/rng/RNG.h"
 #include "core/util/Types.h"
 #include "core/util/Log.h"
+#include "core/util/Parallel.h"
 
 #include <vector>
 #include <cmath>
@@ -31,24 +32,27 @@ struct TerrainConfig {
 ///   5. Final normalisation
 class TerrainGenerator {
 public:
+    /// Longest path of one erosion droplet, in steps of at most one cell.
+    static constexpr i32 DROPLET_LIFETIME = 50;
+
+    /// Rows above and below a droplet's start row that it can read or write.
+    static constexpr u32 DROPLET_REACH = DROPLET_LIFETIME + 3;
+
+    /// Box blur radius applied after the ridge stage.
+    static constexpr i32 RIDGE_BLUR = 2;
+
     explicit TerrainGenerator(RNG& rng) : rng_(rng) {}
 
     /// Run the full generation pipeline.
     Heightmap generate(const TerrainConfig& config) {
         LOG_INFO("Generating terrain ({}x{})...", config.width, config.height);
 
-        // Stage 1: Tectonic plates
-        LOG_INFO("  Stage 1: Tectonic plates ({} plates)...", config.num_plates);
-        auto plate_map = generate_plates(config);
-        auto elevation = plates_to_elevation(plate_map, config);
-
-        // Stage 2: Continental noise
-        LOG_INFO("  Stage 2: Continental noise ({} octaves)...", config.fbm_octaves);
-        apply_continental_noise(elevation, config);
-
-        // Stage 3: Mountain ridges at plate boundaries
-        LOG_INFO("  Stage 3: Mountain ridges...");
-        apply_mountain_ridges(elevation, plate_map, config);
+        // Stages 1-3: Tectonic plates, continental noise, mountain ridges
+        LOG_INFO("  Stages 1-3: Plates ({}), continental noise ({} octaves), ridges...",
+                 config.num_plates, config.fbm_octaves);
+        prepare(config);
+        Heightmap elevation(config.width, config.height);
+        generate_rows(0, config.height, elevation.data_ptr());
 
         // Stage 4: Hydraulic erosion
         LOG_INFO("  Stage 4: Hydraulic erosion ({} iterations)...", config.erosion_iterations);
@@ -66,13 +70,8 @@ public:
 
         for (u32 y = 0; y < config.height; y++) {
             for (u32 x = 0; x < config.width; x++) {
-                f32 e = elevation.get(x, y);
-                if (e <= threshold) {
-                    elevation.set(x, y, (e / threshold) * config.sea_level);
-                } else {
-                    elevation.set(x, y, config.sea_level +
-                        ((e - threshold) / (1.0f - threshold)) * (1.0f - config.sea_level));
-                }
+                elevation.set(x, y, remap_sea_level(elevation.get(x, y), threshold,
+                                                    config.sea_level));
             }
         }
 
@@ -82,6 +81,196 @@ public:
         return elevation;
     }
 
+    // ─── Band Interface ───
+    // Used by StreamingPlanetGenerator to run the pipeline a few rows at a time.
+
+    /// Draw plates and noise seeds. Consumes the RNG exactly as generate() does
+    /// before erosion, so both paths see the same world for the same seed.
+    void prepare(const TerrainConfig& config) {
+        config_ = config;
+        generate_plates(config);
+        continents_ = PerlinNoise(rng_.next_u64());
+        detail_ = PerlinNoise(rng_.next_u64());
+        ridge_noise_ = PerlinNoise(rng_.next_u64());
+    }
+
+    /// Stages 1-3 for rows [y0, y1), written row-major into `out`. The few
+    /// halo rows the boundary test and blur look at are recomputed on each
+    /// call, so any banding of the grid gives identical values.
+    void generate_rows(u32 y0, u32 y1, f32* out) const {
+        u32 w = config_.width;
+        u32 h = config_.height;
+        u32 r = static_cast<u32>(RIDGE_BLUR);
+
+        // Ridged elevation is needed `r` rows beyond the band for the blur,
+        // and plate ids one row further for the boundary test.
+        u32 e_lo = y0 > r ? y0 - r : 0;
+        u32 e_hi = std::min(h, y1 + r);
+        u32 p_lo = e_lo > 0 ? e_lo - 1 : 0;
+        u32 p_hi = std::min(h, e_hi + 1);
+
+        std::vector<i32> plate_map(static_cast<size_t>(p_hi - p_lo) * w);
+        parallel_for(p_lo, p_hi, [&](u32 lo, u32 hi) {
+            for (u32 y = lo; y < hi; y++) {
+                i32* row = &plate_map[static_cast<size_t>(y - p_lo) * w];
+                for (u32 x = 0; x < w; x++) row[x] = nearest_plate(x, y);
+            }
+        }, 4);
+
+        std::vector<f32> ridged(static_cast<size_t>(e_hi - e_lo) * w);
+        parallel_for(e_lo, e_hi, [&](u32 lo, u32 hi) {
+            for (u32 y = lo; y < hi; y++) {
+                auto plate = [&](u32 px, u32 py) {
+                    return plate_map[static_cast<size_t>(py - p_lo) * w + px];
+                };
+                f32* row = &ridged[static_cast<size_t>(y - e_lo) * w];
+                for (u32 x = 0; x < w; x++) {
+                    row[x] = base_elevation(plate(x, y), x, y);
+
+                    // Mountain ridges where any 4-neighbour is on another plate
+                    if (y < 1 || y >= h - 1 || x < 1 || x >= w - 1) continue;
+                    i32 center = plate(x, y);
+                    if (plate(x - 1, y) != center || plate(x + 1, y) != center ||
+                        plate(x, y - 1) != center || plate(x, y + 1) != center) {
+                        f64 nx = static_cast<f64>(x) / w;
+                        f64 ny = static_cast<f64>(y) / h;
+                        f64 ridge = ridge_noise_.ridged(nx * 8.0, ny * 8.0, 5, 1.0, 0.6, 2.0);
+                        row[x] += static_cast<f32>(ridge) * config_.mountain_scale;
+                    }
+                }
+            }
+        }, 4);
+
+        // Blur slightly to smooth harsh plate edges (same kernel as Heightmap::blur)
+        i32 diam = 2 * RIDGE_BLUR + 1;
+        f32 inv = 1.0f / (diam * diam);
+        parallel_for(y0, y1, [&](u32 lo, u32 hi) {
+            for (u32 y = lo; y < hi; y++) {
+                f32* row = out + static_cast<size_t>(y - y0) * w;
+                for (u32 x = 0; x < w; x++) {
+                    f32 sum = 0;
+                    for (i32 dy = -RIDGE_BLUR; dy <= RIDGE_BLUR; dy++) {
+                        u32 sy = std::clamp(static_cast<i32>(y) + dy, 0, static_cast<i32>(h - 1));
+                        const f32* src = &ridged[static_cast<size_t>(sy - e_lo) * w];
+                        for (i32 dx = -RIDGE_BLUR; dx <= RIDGE_BLUR; dx++) {
+                            u32 sx = std::clamp(static_cast<i32>(x) + dx, 0, static_cast<i32>(w - 1));
+                            sum += src[sx];
+                        }
+                    }
+                    row[x] = sum * inv;
+                }
+            }
+        }, 4);
+    }
+
+    /// Start position of one erosion droplet.
+    struct Droplet {
+        f32 x, y;
+    };
+
+    /// Draw the stage 4 droplet start positions in generate()'s RNG order.
+    std::vector<Droplet> draw_droplets(const TerrainConfig& config) {
+        std::vector<Droplet> drops(static_cast<size_t>(std::max(config.erosion_iterations, 0)));
+        for (auto& d : drops) {
+            d.x = rng_.next_float(1.0f, static_cast<f32>(config.width - 2));
+            d.y = rng_.next_float(1.0f, static_cast<f32>(config.height - 2));
+        }
+        return drops;
+    }
+
+    /// Trace one droplet starting at global (px, py). `grid` holds global rows
+    /// [row_offset, row_offset + grid.height()) of a map `full_height` rows
+    /// tall, and must cover DROPLET_REACH rows either side of the start row.
+    static void run_droplet(Heightmap& grid, u32 row_offset, u32 full_height,
+                            f32 px, f32 py) {
+        u32 w = grid.width();
+        u32 h = full_height;
+        f32 off = static_cast<f32>(row_offset); // py - off is exact for integer offsets
+
+        f32 sediment = 0.0f;
+        f32 speed = 0.0f;
+        f32 water = 1.0f;
+
+        const f32 erosion_rate = 0.3f;
+        const f32 deposit_rate = 0.3f;
+        const f32 evaporate_rate = 0.01f;
+        const f32 gravity = 4.0f;
+
+        f32 dir_x = 0, dir_y = 0;
+        f32 inertia = 0.3f;
+
+        for (i32 step = 0; step < DROPLET_LIFETIME; step++) {
+            u32 ix = static_cast<u32>(px);
+            u32 iy = static_cast<u32>(py);
+
+            if (ix < 1 || ix >= w - 1 || iy < 1 || iy >= h - 1) break;
+            u32 ly = iy - row_offset;
+
+            // Compute gradient
+            f32 h_l = grid.get(ix - 1, ly);
+            f32 h_r = grid.get(ix + 1, ly);
+            f32 h_u = grid.get(ix, ly - 1);
+            f32 h_d = grid.get(ix, ly + 1);
+
+            f32 gx = (h_r - h_l) * 0.5f;
+            f32 gy = (h_d - h_u) * 0.5f;
+
+            // Update direction with inertia
+            dir_x = dir_x * inertia - gx * (1.0f - inertia);
+            dir_y = dir_y * inertia - gy * (1.0f - inertia);
+
+            // Normalise direction
+            f32 len = std::sqrt(dir_x * dir_x + dir_y * dir_y);
+            if (len < 1e-6f) break;
+            dir_x /= len;
+            dir_y /= len;
+
+            // Move
+            f32 new_px = px + dir_x;
+            f32 new_py = py + dir_y;
+
+            u32 nix = static_cast<u32>(new_px);
+            u32 niy = static_cast<u32>(new_py);
+            if (nix < 1 || nix >= w - 1 || niy < 1 || niy >= h - 1) break;
+
+            f32 old_h = grid.sample(px, py - off);
+            f32 new_h = grid.sample(new_px, new_py - off);
+            f32 h_diff = new_h - old_h;
+
+            if (h_diff > 0) {
+                // Going uphill — deposit sediment
+                f32 to_deposit = std::min(sediment, h_diff);
+                grid.at(ix, ly) += to_deposit;
+                sediment -= to_deposit;
+            } else {
+                // Going downhill — erode
+                f32 capacity = std::max(-h_diff, 0.01f) * speed * water * 8.0f;
+                if (sediment > capacity) {
+                    f32 to_deposit = (sediment - capacity) * deposit_rate;
+                    grid.at(ix, ly) += to_deposit;
+                    sediment -= to_deposit;
+                } else {
+                    f32 to_erode = std::min((capacity - sediment) * erosion_rate,
+                                             -h_diff);
+                    grid.at(ix, ly) -= to_erode;
+                    sediment += to_erode;
+                }
+            }
+
+            speed = std::sqrt(std::max(speed * speed + h_diff * gravity, 0.0f));
+            water *= (1.0f - evaporate_rate);
+
+            px = new_px;
+            py = new_py;
+        }
+    }
+
+    /// Stage 5 remap: put the `threshold` elevation exactly at `sea_level`.
+    static f32 remap_sea_level(f32 e, f32 threshold, f32 sea_level) {
+        if (e <= threshold) return (e / threshold) * sea_level;
+        return sea_level + ((e - threshold) / (1.0f - threshold)) * (1.0f - sea_level);
+    }
+
 private:
     // ─── Stage 1: Tectonic Plates (Voronoi) ───
 
@@ -91,11 +280,10 @@ private:
         bool is_oceanic;        // Oceanic plates sit lower
     };
 
-    /// Generate a plate assignment map using Voronoi.
-    std::vector<i32> generate_plates(const TerrainConfig& config) {
+    /// Random plate centres and properties.
+    void generate_plates(const TerrainConfig& config) {
         std::vector<PlateInfo> plates(config.num_plates);
 
-        // Random plate centres and properties
         for (int i = 0; i < config.num_plates; i++) {
             plates[i].center_x = rng_.next_float(0.0f, static_cast<f32>(config.width));
             plates[i].center_y = rng_.next_float(0.0f, static_cast<f32>(config.height));
@@ -104,209 +292,67 @@ private:
             plates[i].is_oceanic = rng_.next_float() < 0.45f;
         }
 
-        // Assign each cell to nearest plate (Voronoi)
-        std::vector<i32> plate_map(config.width * config.height);
-        for (u32 y = 0; y < config.height; y++) {
-            for (u32 x = 0; x < config.width; x++) {
-                f32 min_dist = 1e18f;
-                i32 nearest = 0;
-
-                for (int i = 0; i < config.num_plates; i++) {
-                    // Toroidal distance (wraps horizontally for planet)
-                    f32 dx = static_cast<f32>(x) - plates[i].center_x;
-                    f32 dy = static_cast<f32>(y) - plates[i].center_y;
-
-                    // Wrap X for horizontal continuity
-                    if (dx > config.width * 0.5f) dx -= config.width;
-                    if (dx < -config.width * 0.5f) dx += config.width;
-
-                    f32 dist = dx * dx + dy * dy;
-                    if (dist < min_dist) {
-                        min_dist = dist;
-                        nearest = i;
-                    }
-                }
-                plate_map[y * config.width + x] = nearest;
-            }
-        }
-
         plates_ = std::move(plates);
-        return plate_map;
     }
 
-    /// Convert plate assignments to initial elevation.
-    Heightmap plates_to_elevation(const std::vector<i32>& plate_map,
-                                   const TerrainConfig& config) {
-        Heightmap elevation(config.width, config.height);
-
-        for (u32 y = 0; y < config.height; y++) {
-            for (u32 x = 0; x < config.width; x++) {
-                i32 plate = plate_map[y * config.width + x];
-                // Continental plates sit higher than oceanic
-                f32 base = plates_[plate].is_oceanic ? 0.25f : 0.55f;
-                elevation.set(x, y, base);
-            }
-        }
-
-        return elevation;
-    }
+    /// Assign a cell to its nearest plate (Voronoi).
+    i32 nearest_plate(u32 x, u32 y) const {
+        f32 min_dist = 1e18f;
+        i32 nearest = 0;
 
-    // ─── Stage 2: Continental Noise ───
+        for (int i = 0; i < static_cast<int>(plates_.size()); i++) {
+            // Toroidal distance (wraps horizontally for planet)
+            f32 dx = static_cast<f32>(x) - plates_[i].center_x;
+            f32 dy = static_cast<f32>(y) - plates_[i].center_y;
 
-    void apply_continental_noise(Heightmap& elevation, const TerrainConfig& config) {
-        PerlinNoise continents(rng_.next_u64());
-        PerlinNoise detail(rng_.next_u64());
+            // Wrap X for horizontal continuity
+            if (dx > config_.width * 0.5f) dx -= config_.width;
+            if (dx < -config_.width * 0.5f) dx += config_.width;
 
-        for (u32 y = 0; y < config.height; y++) {
-            for (u32 x = 0; x < config.width; x++) {
-                f64 nx = static_cast<f64>(x) / config.width;
-                f64 ny = static_cast<f64>(y) / config.height;
-
-                // Large-scale continental shapes
-                f64 continent_noise = continents.fbm(nx * 4.0, ny * 4.0,
-                    config.fbm_octaves, 1.0, 0.55, 2.0);
-
-                // Smaller detail
-                f64 detail_noise = detail.fbm(nx * 12.0, ny * 12.0,
-                    4, 1.0, 0.5, 2.0);
-
-                f32 current = elevation.get(x, y);
-                current += static_cast<f32>(continent_noise) * 0.35f;
-                current += static_cast<f32>(detail_noise) * 0.08f;
-
-                elevation.set(x, y, current);
+            f32 dist = dx * dx + dy * dy;
+            if (dist < min_dist) {
+                min_dist = dist;
+                nearest = i;
             }
         }
+        return nearest;
     }
 
-    // ─── Stage 3: Mountain Ridges at Plate Boundaries ───
-
-    void apply_mountain_ridges(Heightmap& elevation,
-                                const std::vector<i32>& plate_map,
-                                const TerrainConfig& config) {
-        PerlinNoise ridge_noise(rng_.next_u64());
+    // ─── Stage 2: Continental Noise ───
 
-        // Detect plate boundaries and add ridged noise there
-        for (u32 y = 1; y < config.height - 1; y++) {
-            for (u32 x = 1; x < config.width - 1; x++) {
-                i32 center = plate_map[y * config.width + x];
-                bool is_boundary = false;
+    /// Plate base height plus large-scale and detail fBm.
+    f32 base_elevation(i32 plate, u32 x, u32 y) const {
+        // Continental plates sit higher than oceanic
+        f32 current = plates_[plate].is_oceanic ? 0.25f : 0.55f;
 
-                // Check 4 neighbours
-                if (plate_map[y * config.width + (x - 1)] != center) is_boundary = true;
-                if (plate_map[y * config.width + (x + 1)] != center) is_boundary = true;
-                if (plate_map[(y - 1) * config.width + x] != center) is_boundary = true;
-                if (plate_map[(y + 1) * config.width + x] != center) is_boundary = true;
+        f64 nx = static_cast<f64>(x) / config_.width;
+        f64 ny = static_cast<f64>(y) / config_.height;
 
-                if (is_boundary) {
-                    f64 nx = static_cast<f64>(x) / config.width;
-                    f64 ny = static_cast<f64>(y) / config.height;
+        // Large-scale continental shapes
+        f64 continent_noise = continents_.fbm(nx * 4.0, ny * 4.0,
+            config_.fbm_octaves, 1.0, 0.55, 2.0);
 
-                    f64 ridge = ridge_noise.ridged(nx * 8.0, ny * 8.0, 5, 1.0, 0.6, 2.0);
+        // Smaller detail
+        f64 detail_noise = detail_.fbm(nx * 12.0, ny * 12.0, 4, 1.0, 0.5, 2.0);
 
-                    f32 current = elevation.get(x, y);
-                    current += static_cast<f32>(ridge) * config.mountain_scale;
-                    elevation.set(x, y, current);
-                }
-            }
-        }
-
-        // Blur slightly to smooth harsh plate edges
-        elevation.blur(2);
+        current += static_cast<f32>(continent_noise) * 0.35f;
+        current += static_cast<f32>(detail_noise) * 0.08f;
+        return current;
     }
 
     // ─── Stage 4: Hydraulic Erosion (simplified) ───
     // Simulates water flowing downhill, carving valleys and depositing sediment.
 
     void apply_erosion(Heightmap& elevation, const TerrainConfig& config) {
-        u32 w = config.width;
-        u32 h = config.height;
-
-        for (i32 iter = 0; iter < config.erosion_iterations; iter++) {
-            // Drop a "raindrop" at a random position
-            f32 px = rng_.next_float(1.0f, static_cast<f32>(w - 2));
-            f32 py = rng_.next_float(1.0f, static_cast<f32>(h - 2));
-            f32 sediment = 0.0f;
-            f32 speed = 0.0f;
-            f32 water = 1.0f;
-
-            const f32 erosion_rate = 0.3f;
-            const f32 deposit_rate = 0.3f;
-            const f32 evaporate_rate = 0.01f;
-            const f32 gravity = 4.0f;
-            const i32 max_lifetime = 50;
-
-            f32 dir_x = 0, dir_y = 0;
-            f32 inertia = 0.3f;
-
-            for (i32 step = 0; step < max_lifetime; step++) {
-                u32 ix = static_cast<u32>(px);
-                u32 iy = static_cast<u32>(py);
-
-                if (ix < 1 || ix >= w - 1 || iy < 1 || iy >= h - 1) break;
-
-                // Compute gradient
-                f32 h_l = elevation.get(ix - 1, iy);
-                f32 h_r = elevation.get(ix + 1, iy);
-                f32 h_u = elevation.get(ix, iy - 1);
-                f32 h_d = elevation.get(ix, iy + 1);
-
-                f32 gx = (h_r - h_l) * 0.5f;
-                f32 gy = (h_d - h_u) * 0.5f;
-
-                // Update direction with inertia
-                dir_x = dir_x * inertia - gx * (1.0f - inertia);
-                dir_y = dir_y * inertia - gy * (1.0f - inertia);
-
-                // Normalise direction
-                f32 len = std::sqrt(dir_x * dir_x + dir_y * dir_y);
-                if (len < 1e-6f) break;
-                dir_x /= len;
-                dir_y /= len;
-
-                // Move
-                f32 new_px = px + dir_x;
-                f32 new_py = py + dir_y;
-
-                u32 nix = static_cast<u32>(new_px);
-                u32 niy = static_cast<u32>(new_py);
-                if (nix < 1 || nix >= w - 1 || niy < 1 || niy >= h - 1) break;
-
-                f32 old_h = elevation.sample(px, py);
-                f32 new_h = elevation.sample(new_px, new_py);
-                f32 h_diff = new_h - old_h;
-
-                if (h_diff > 0) {
-                    // Going uphill — deposit sediment
-                    f32 to_deposit = std::min(sediment, h_diff);
-                    elevation.at(ix, iy) += to_deposit;
-                    sediment -= to_deposit;
-                } else {
-                    // Going downhill — erode
-                    f32 capacity = std::max(-h_diff, 0.01f) * speed * water * 8.0f;
-                    if (sediment > capacity) {
-                        f32 to_deposit = (sediment - capacity) * deposit_rate;
-                        elevation.at(ix, iy) += to_deposit;
-                        sediment -= to_deposit;
-                    } else {
-                        f32 to_erode = std::min((capacity - sediment) * erosion_rate,
-                                                 -h_diff);
-                        elevation.at(ix, iy) -= to_erode;
-                        sediment += to_erode;
-                    }
-                }
-
-                speed = std::sqrt(std::max(speed * speed + h_diff * gravity, 0.0f));
-                water *= (1.0f - evaporate_rate);
-
-                px = new_px;
-                py = new_py;
-            }
+        for (const auto& drop : draw_droplets(config)) {
+            run_droplet(elevation, 0, config.height, drop.x, drop.y);
         }
     }
 
     RNG& rng_;
     std::vector<PlateInfo> plates_;
+    TerrainConfig config_;
+    PerlinNoise continents_, detail_, ridge_noise_;
 };
 
 } // namespace godsim
@@ -0,0 +1,328 @@
+#pragma once
+
+#include "ImageExporter.h"
+#include "DirtyRegion.h"
+#include "PlanetData.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+#include "core/util/Log.h"
+
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+/// Map layers available in the tile pyramid.
+enum class TileLayer : u8 {
+    Biome = 0,
+    Terrain,
+    Elevation,
+    Temperature,
+    Moisture,
+    COUNT
+};
+
+inline const char* tile_layer_name(TileLayer layer) {
+    switch (layer) {
+        case TileLayer::Biome:       return "biome";
+        case TileLayer::Terrain:     return "terrain";
+        case TileLayer::Elevation:   return "elevation";
+        case TileLayer::Temperature: return "temperature";
+        case TileLayer::Moisture:    return "moisture";
+        default:                     return "unknown";
+    }
+}
+
+/// Configuration for tile pyramid export.
+struct TileConfig {
+    u32 tile_size = 256;
+    ImageFormat format = ImageFormat::PNG;
+    std::vector<TileLayer> layers = {TileLayer::Biome, TileLayer::Terrain,
+                                     TileLayer::Elevation, TileLayer::Temperature,
+                                     TileLayer::Moisture};
+};
+
+/// Emits a slippy-map style pyramid (`<dir>/<layer>/<z>/<x>/<y>.png`) for
+/// browser tile viewers, straight from PlanetData.
+///
+/// Zoom `max_zoom()` is the full-resolution grid; each coarser level is a 2×2
+/// box downsample of the one below, computed once per level rather than per
+/// tile. The level images are kept between exports so that after a terraform
+/// only cells inside the dirty region are re-coloured, only their footprint is
+/// re-downsampled, and only the tiles that footprint touches are rewritten.
+class TileExporter {
+public:
+    explicit TileExporter(TileConfig config = {}) : config_(std::move(config)) {}
+
+    /// Deepest zoom level for a grid (the level at full resolution).
+    static u32 max_zoom_for(u32 width, u32 height, u32 tile_size) {
+        u32 z = 0;
+        while ((static_cast<u64>(tile_size) << z) < std::max(width, height)) z++;
+        return z;
+    }
+
+    u32 max_zoom() const { return max_zoom_; }
+    const TileConfig& config() const { return config_; }
+
+    /// Path of one tile inside `dir`.
+    std::string tile_path(const std::string& dir, TileLayer layer, u32 z, u32 x, u32 y) const {
+        return dir + "/" + tile_layer_name(layer) + "/" + std::to_string(z) + "/" +
+               std::to_string(x) + "/" + std::to_string(y) + image_extension(config_.format);
+    }
+
+    // ─── Dirty Tracking ───
+
+    /// Record edited cells; the next export_dirty() rewrites only their tiles.
+    void mark_dirty(const CellRect& rect) { dirty_.add(rect); }
+    void mark_dirty(const DirtyRegion& region) { dirty_.add(region); }
+    bool has_dirty() const { return !dirty_.empty(); }
+
+    // ─── Export ───
+
+    /// Build every level from scratch and write all tiles. Returns tiles written.
+    u32 export_all(const PlanetData& planet, const std::string& dir) {
+        LOG_INFO("Exporting tile pyramid ({}x{}, {}px tiles) to {}",
+                 planet.width, planet.height, config_.tile_size, dir);
+        allocate(planet);
+
+        u32 written = 0;
+        for (auto& pyramid : pyramids_) {
+            update_range(planet, pyramid);
+            written += rebuild(planet, pyramid, {{0, 0, width_, height_}}, dir);
+        }
+        write_metadata(dir);
+        dirty_.clear();
+
+        LOG_INFO("  Tile pyramid: {} zoom levels, {} tiles", max_zoom_ + 1, written);
+        return written;
+    }
+
+    /// Rewrite only tiles overlapping regions marked dirty since the last
+    /// export. Falls back to a full export if nothing has been built yet or
+    /// the planet was resized. Returns tiles written.
+    u32 export_dirty(const PlanetData& planet, const std::string& dir) {
+        if (pyramids_.empty() || width_ != planet.width || height_ != planet.height) {
+            return export_all(planet, dir);
+        }
+        if (dirty_.empty()) return 0;
+
+        u32 written = 0;
+        for (auto& pyramid : pyramids_) {
+            // A layer normalised by global range must be fully redrawn if the range moved.
+            if (update_range(planet, pyramid)) {
+                written += rebuild(planet, pyramid, {{0, 0, width_, height_}}, dir);
+            } else {
+                written += rebuild(planet, pyramid, dirty_.rects(), dir);
+            }
+        }
+        LOG_INFO("Updated {} dirty tiles in {}", written, dir);
+        dirty_.clear();
+        return written;
+    }
+
+private:
+    struct LevelImage {
+        u32 width = 0, height = 0;
+        std::vector<u8> rgb;
+    };
+
+    struct Pyramid {
+        TileLayer layer;
+        std::vector<LevelImage> levels; // levels[z]; back() is full resolution
+        f32 range_min = 0.0f, range_span = 1.0f;
+    };
+
+    void allocate(const PlanetData& planet) {
+        width_ = planet.width;
+        height_ = planet.height;
+        max_zoom_ = max_zoom_for(width_, height_, config_.tile_size);
+        dirty_.resize(width_, height_);
+
+        pyramids_.clear();
+        for (auto layer : config_.layers) {
+            Pyramid p;
+            p.layer = layer;
+            p.levels.resize(max_zoom_ + 1);
+            for (u32 z = 0; z <= max_zoom_; z++) {
+                u32 shift = max_zoom_ - z;
+                auto& lvl = p.levels[z];
+                lvl.width = std::max(1u, (width_ + (1u << shift) - 1) >> shift);
+                lvl.height = std::max(1u, (height_ + (1u << shift) - 1) >> shift);
+                lvl.rgb.assign(static_cast<size_t>(lvl.width) * lvl.height * 3, 0);
+            }
+            pyramids_.push_back(std::move(p));
+        }
+    }
+
+    /// Refresh the normalisation range. Returns true if it changed.
+    static bool update_range(const PlanetData& planet, Pyramid& p) {
+        if (p.layer != TileLayer::Temperature) return false;
+        f32 lo = planet.temperature.min_value();
+        f32 span = planet.temperature.max_value() - lo;
+        if (span < 1e-6f) span = 1.0f;
+        bool changed = lo != p.range_min || span != p.range_span;
+        p.range_min = lo;
+        p.range_span = span;
+        return changed;
+    }
+
+    void colour_cell(const PlanetData& planet, const Pyramid& p, u32 x, u32 y, u8* out) const {
+        switch (p.layer) {
+            case TileLayer::Biome:
+                ImageExporter::biome_colour(planet.biome_at(x, y), out);
+                break;
+            case TileLayer::Terrain:
+                ImageExporter::terrain_colour(planet.elevation.get(x, y), planet.sea_level, out);
+                break;
+            case TileLayer::Elevation:
+                ImageExporter::heightmap_colour(planet.elevation.get(x, y), out);
+                break;
+            case TileLayer::Temperature:
+                ImageExporter::temperature_colour(
+                    (planet.temperature.get(x, y) - p.range_min) / p.range_span, out);
+                break;
+            case TileLayer::Moisture:
+                ImageExporter::moisture_colour(planet.moisture.get(x, y), out);
+                break;
+            default:
+                out[0] = out[1] = out[2] = 0;
+                break;
+        }
+    }
+
+    /// Re-colour `rects` at full resolution, propagate them up the pyramid and
+    /// write each affected tile once. Returns tiles written.
+    u32 rebuild(const PlanetData& planet, Pyramid& p, std::vector<CellRect> rects,
+                const std::string& dir) {
+        // Full-resolution level
+        auto& base = p.levels[max_zoom_];
+        for (const auto& rect : rects) {
+            parallel_for(rect.y0, rect.y1, [&](u32 lo, u32 hi) {
+                for (u32 y = lo; y < hi; y++) {
+                    u8* row = &base.rgb[static_cast<size_t>(y) * base.width * 3];
+                    for (u32 x = rect.x0; x < rect.x1; x++) {
+                        colour_cell(planet, p, x, y, row + x * 3);
+                    }
+                }
+            }, 8);
+        }
+        u32 written = write_tiles(p, max_zoom_, rects, dir);
+
+        // Coarser levels: halve each rect (rounding outward) and downsample it
+        for (u32 z = max_zoom_; z-- > 0;) {
+            const auto& src = p.levels[z + 1];
+            auto& dst = p.levels[z];
+            for (auto& rect : rects) {
+                rect = {rect.x0 / 2, rect.y0 / 2,
+                        std::min((rect.x1 + 1) / 2, dst.width),
+                        std::min((rect.y1 + 1) / 2, dst.height)};
+                parallel_for(rect.y0, rect.y1, [&](u32 lo, u32 hi) {
+                    for (u32 y = lo; y < hi; y++) downsample_row(src, dst, y, rect.x0, rect.x1);
+                }, 8);
+            }
+            written += write_tiles(p, z, rects, dir);
+        }
+        return written;
+    }
+
+    /// 2×2 box filter of `src` into row `y` of `dst`, clamping odd edges.
+    static void downsample_row(const LevelImage& src, LevelImage& dst, u32 y, u32 x0, u32 x1) {
+        u32 sy0 = std::min(2 * y, src.height - 1);
+        u32 sy1 = std::min(2 * y + 1, src.height - 1);
+        const u8* row0 = &src.rgb[static_cast<size_t>(sy0) * src.width * 3];
+        const u8* row1 = &src.rgb[static_cast<size_t>(sy1) * src.width * 3];
+        u8* out = &dst.rgb[static_cast<size_t>(y) * dst.width * 3];
+        for (u32 x = x0; x < x1; x++) {
+            u32 sx0 = std::min(2 * x, src.width - 1) * 3;
+            u32 sx1 = std::min(2 * x + 1, src.width - 1) * 3;
+            for (u32 ch = 0; ch < 3; ch++) {
+                out[x * 3 + ch] = static_cast<u8>(
+                    (row0[sx0 + ch] + row0[sx1 + ch] + row1[sx0 + ch] + row1[sx1 + ch] + 2) / 4);
+            }
+        }
+    }
+
+    /// Write every tile of level `z` overlapping any of `rects` (level pixels).
+    u32 write_tiles(const Pyramid& p, u32 z, const std::vector<CellRect>& rects,
+                    const std::string& dir) const {
+        const auto& lvl = p.levels[z];
+        u32 ts = config_.tile_size;
+        u32 tiles_x = (lvl.width + ts - 1) / ts;
+        u32 tiles_y = (lvl.height + ts - 1) / ts;
+
+        std::vector<u8> marked(static_cast<size_t>(tiles_x) * tiles_y, 0);
+        for (const auto& rect : rects) {
+            if (rect.empty()) continue;
+            for (u32 ty = rect.y0 / ts; ty < (rect.y1 + ts - 1) / ts; ty++) {
+                for (u32 tx = rect.x0 / ts; tx < (rect.x1 + ts - 1) / ts; tx++) {
+                    marked[ty * tiles_x + tx] = 1;
+                }
+            }
+        }
+
+        std::vector<u32> tiles;
+        std::vector<u8> column_made(tiles_x, 0);
+        for (u32 i = 0; i < marked.size(); i++) {
+            if (!marked[i]) continue;
+            tiles.push_back(i);
+            u32 tx = i % tiles_x;
+            if (!column_made[tx]) {
+                std::filesystem::create_directories(
+                    dir + "/" + tile_layer_name(p.layer) + "/" + std::to_string(z) + "/" +
+                    std::to_string(tx));
+                column_made[tx] = 1;
+            }
+        }
+
+        parallel_for(0, static_cast<u32>(tiles.size()), [&](u32 lo, u32 hi) {
+            std::vector<u8> tile(static_cast<size_t>(ts) * ts * 3);
+            for (u32 i = lo; i < hi; i++) {
+                u32 tx = tiles[i] % tiles_x;
+                u32 ty = tiles[i] / tiles_x;
+                std::fill(tile.begin(), tile.end(), 0); // Pad edge tiles with black
+
+                u32 px0 = tx * ts, py0 = ty * ts;
+                u32 pw = std::min(ts, lvl.width - px0);
+                u32 ph = std::min(ts, lvl.height - py0);
+                for (u32 r = 0; r < ph; r++) {
+                    const u8* src = &lvl.rgb[(static_cast<size_t>(py0 + r) * lvl.width + px0) * 3];
+                    std::copy(src, src + pw * 3, &tile[static_cast<size_t>(r) * ts * 3]);
+                }
+
+                ImageWriter writer;
+                if (writer.open(tile_path(dir, p.layer, z, tx, ty), ts, ts, config_.format)) {
+                    writer.write_rows(tile.data(), ts);
+                }
+            }
+        });
+        return static_cast<u32>(tiles.size());
+    }
+
+    /// Small descriptor the web viewer reads to configure itself.
+    void write_metadata(const std::string& dir) const {
+        std::filesystem::create_directories(dir);
+        std::ofstream file(dir + "/tiles.json");
+        file << "{\n"
+             << "  \"width\": " << width_ << ",\n"
+             << "  \"height\": " << height_ << ",\n"
+             << "  \"tile_size\": " << config_.tile_size << ",\n"
+             << "  \"max_zoom\": " << max_zoom_ << ",\n"
+             << "  \"format\": \"" << (image_extension(config_.format) + 1) << "\",\n"
+             << "  \"layers\": [";
+        for (size_t i = 0; i < config_.layers.size(); i++) {
+            file << (i ? ", " : "") << "\"" << tile_layer_name(config_.layers[i]) << "\"";
+        }
+        file << "]\n}\n";
+    }
+
+    TileConfig config_;
+    u32 width_ = 0, height_ = 0;
+    u32 max_zoom_ = 0;
+    std::vector<Pyramid> pyramids_;
+    DirtyRegion dirty_;
+};
+
+} // namespace godsim
@@ -7,12 +7,14 @@
 #include "layers/biological/BiologicalLayer.h"
 #include "layers/civilisation/CivilisationLayer.h"
 #include "layers/divine/DivineLayer.h"
+#include "layers/planetary/TileExporter.h"
 
 // Renderer
 #include "renderer/PlanetRenderer.h"
 
 #include <filesystem>
 #include <string>
+#include <cstdio>
 #include <cstring>
 
 int main(int argc, char* argv[]) {
@@ -27,10 +29,39 @@ int main(int argc, char* argv[]) {
     godsim::u64 seed = 12345;
     std::string output_dir = "maps";
     bool headless = false;
+    godsim::ImageFormat map_format = godsim::ImageFormat::PPM;
+    bool export_tiles = false;
+    godsim::u32 stream_size = 0;
+    godsim::CaptureSettings capture;
+    bool capture_frames = false;
+    bool software_capture = false;
 
     for (int i = 1; i < argc; i++) {
         if (std::strcmp(argv[i], "--headless") == 0) {
             headless = true;
+        } else if (std::strcmp(argv[i], "--png") == 0) {
+            map_format = godsim::ImageFormat::PNG;
+        } else if (std::strcmp(argv[i], "--tiles") == 0) {
+            export_tiles = true;
+        } else if (std::strcmp(argv[i], "--stream") == 0 && i + 1 < argc) {
+            try { stream_size = static_cast<godsim::u32>(std::stoul(argv[++i])); }
+            catch (...) { LOG_WARN("Expected --stream SIZE, got {}", argv[i]); }
+        } else if (std::strcmp(argv[i], "--capture") == 0 && i + 1 < argc) {
+            try {
+                capture.frames = static_cast<godsim::u32>(std::stoul(argv[++i]));
+                capture_frames = true;
+            } catch (...) { LOG_WARN("Expected --capture FRAMES, got {}", argv[i]); }
+        } else if (std::strcmp(argv[i], "--capture-path") == 0 && i + 1 < argc) {
+            if (!godsim::CameraPath::load(argv[++i], capture.path)) return 1;
+        } else if (std::strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            if (std::sscanf(argv[++i], "%ux%u", &capture.width, &capture.height) != 2) {
+                LOG_WARN("Expected --size WIDTHxHEIGHT, got {}", argv[i]);
+            }
+        } else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc) {
+            try { capture.fps = std::stof(argv[++i]); }
+            catch (...) { LOG_WARN("Expected --fps RATE, got {}", argv[i]); }
+        } else if (std::strcmp(argv[i], "--software") == 0) {
+            software_capture = true;
         } else if (std::strcmp(argv[i], "--output") == 0 && i + 1 < argc) {
             output_dir = argv[++i];
         } else {
@@ -46,33 +77,82 @@ int main(int argc, char* argv[]) {
     // Create simulation
     godsim::Simulation sim(seed);
 
-    sim.add_layer<godsim::CosmologicalLayer>();
+    auto* cosmological = sim.add_layer<godsim::CosmologicalLayer>();
     auto* planetary = sim.add_layer<godsim::PlanetaryLayer>();
-    sim.add_layer<godsim::BiologicalLayer>();
-    sim.add_layer<godsim::CivilisationLayer>();
-    sim.add_layer<godsim::DivineLayer>();
+    auto* biological = sim.add_layer<godsim::BiologicalLayer>();
+    auto* civilisation = sim.add_layer<godsim::CivilisationLayer>();
+    auto* divine = sim.add_layer<godsim::DivineLayer>();
 
     sim.initialise();
 
-    // ─── Generate a planet ───
+    // ─── Print-resolution maps: stream straight to disk and stop ───
+    if (stream_size > 0) {
+        std::filesystem::create_directories(output_dir);
+        planetary->generate_planet_streamed("Terra", stream_size, stream_size, output_dir,
+                                            map_format);
+        sim.shutdown();
+        return 0;
+    }
+
+    // ─── Generate the galaxy and a planet ───
+    cosmological->generate_galaxy();
     planetary->generate_planet("Terra", 512);
+    biological->populate(planetary->planet());
+    sim.registry().configure_spatial(planetary->planet().width, planetary->planet().height);
+    sim.regions().configure(planetary->planet().width, planetary->planet().height);
+    civilisation->settle(planetary->planet());
+    divine->bind(planetary->planet(), &biological->populations());
+
+    // ─── Batch capture: render the camera path offscreen and stop ───
+    if (capture_frames) {
+        capture.output_dir = output_dir + "/capture";
+        capture.format = map_format;
+        if (!software_capture) {
+            try {
+                godsim::PlanetRenderer renderer;
+                renderer.init(planetary->planet(), true);
+                renderer.capture(capture);
+            } catch (const std::exception& e) {
+                LOG_WARN("GPU capture failed ({}); using the software renderer", e.what());
+                software_capture = true;
+            }
+        }
+        if (software_capture) godsim::capture_software(planetary->planet(), capture);
+        sim.shutdown();
+        return 0;
+    }
 
     // ─── Export maps ───
     std::filesystem::create_directories(output_dir);
-    planetary->export_maps(output_dir);
+    planetary->export_maps(output_dir, map_format);
     LOG_INFO("Maps exported to: {}", std::filesystem::absolute(output_dir).string());
 
+    godsim::TileExporter tiles;
+    const std::string tile_dir = output_dir + "/tiles";
+    if (export_tiles) tiles.export_all(planetary->planet(), tile_dir);
+
     // ─── Render ───
     if (!headless) {
         try {
             godsim::PlanetRenderer renderer;
             renderer.init(planetary->planet());
+            renderer.set_registry(&sim.registry());
+            renderer.set_regions(&sim.regions());
             renderer.run();
+            biological->update_habitat(planetary->planet());
+            planetary->terrain_changed(renderer.edits());
+            civilisation->terrain_changed(renderer.edits());
 
             // Re-export maps if terrain was modified
             std::filesystem::create_directories(output_dir);
-            planetary->export_maps(output_dir);
+            planetary->export_maps(output_dir, map_format);
             LOG_INFO("Maps re-exported to: {}", std::filesystem::absolute(output_dir).string());
+
+            // Only tiles under terraformed cells need rewriting
+            if (export_tiles) {
+                tiles.mark_dirty(renderer.edits());
+                tiles.export_dirty(planetary->planet(), tile_dir);
+            }
         } catch (const std::exception& e) {
             LOG_ERROR("Renderer failed: {}", e.what());
             LOG_INFO("Run with --headless to skip rendering");
@@ -86,6 +166,13 @@ int main(int argc, char* argv[]) {
     sim.run(10);
     LOG_INFO("Time: {}", sim.current_time().to_string());
 
+    // Divine effects reshape the planet as they tick: catch up what depends on it
+    if (!divine->edits().empty()) {
+        planetary->terrain_changed(divine->edits());
+        civilisation->terrain_changed(divine->edits());
+        divine->edits().clear();
+    }
+
     // ─── Snapshot round-trip ───
     auto snap_path = (std::filesystem::temp_directory_path() / "godsim_phase1.snap").string();
     sim.save_snapshot(snap_path);
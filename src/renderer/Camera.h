@@ -3,6 +3,7 @@
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include "InputState.h"
+#include "CameraPath.h"
 #include <cmath>
 #include <algorithm>
 
@@ -76,11 +77,20 @@ public:
     const glm::vec3& position()   const { return position_; }
 
     float distance()   const { return distance_; }
+    float fov()        const { return fov_; } // Vertical, degrees
     void set_distance(float d) { distance_ = std::clamp(d, min_distance_, max_distance_); update_matrices(); }
 
     float yaw() const { return yaw_; }
     float pitch() const { return pitch_; }
 
+    /// Place the camera directly, e.g. from a scripted CameraPath.
+    void set_orbit(const OrbitPose& pose) {
+        yaw_ = pose.yaw;
+        pitch_ = std::clamp(pose.pitch, -1.5f, 1.5f);
+        distance_ = std::clamp(pose.distance, min_distance_, max_distance_);
+        update_matrices();
+    }
+
 private:
     void update_matrices() {
         // Camera position on a sphere around origin
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "core/util/Log.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+/// Orbit camera placement: the same parameters Camera uses, in radians.
+struct OrbitPose {
+    f32 yaw = 0.0f;
+    f32 pitch = 0.3f;
+    f32 distance = 3.2f;
+};
+
+struct CameraKey {
+    f32 time = 0.0f; // Seconds
+    OrbitPose pose;
+};
+
+/// Scripted camera motion for offline capture: keyframed orbit poses,
+/// linearly interpolated. Yaw is not wrapped, so a key at 2π after one
+/// at 0 makes a full turn.
+class CameraPath {
+public:
+    void add(f32 time, const OrbitPose& pose) {
+        CameraKey key{time, pose};
+        auto at = std::upper_bound(keys_.begin(), keys_.end(), time,
+                                   [](f32 t, const CameraKey& k) { return t < k.time; });
+        keys_.insert(at, key);
+    }
+
+    bool empty() const { return keys_.empty(); }
+    const std::vector<CameraKey>& keys() const { return keys_; }
+    f32 duration() const { return keys_.empty() ? 0.0f : keys_.back().time; }
+
+    /// Pose at time t, clamped to the first and last keys.
+    OrbitPose at(f32 t) const {
+        if (keys_.empty()) return {};
+        if (t <= keys_.front().time) return keys_.front().pose;
+        if (t >= keys_.back().time) return keys_.back().pose;
+        auto next = std::upper_bound(keys_.begin(), keys_.end(), t,
+                                     [](f32 v, const CameraKey& k) { return v < k.time; });
+        const CameraKey& b = *next;
+        const CameraKey& a = *(next - 1);
+        f32 s = (t - a.time) / std::max(b.time - a.time, 1e-6f);
+        return {a.pose.yaw + (b.pose.yaw - a.pose.yaw) * s,
+                a.pose.pitch + (b.pose.pitch - a.pose.pitch) * s,
+                a.pose.distance + (b.pose.distance - a.pose.distance) * s};
+    }
+
+    /// One or more full turns around the equator at fixed pitch and distance.
+    static CameraPath turntable(f32 seconds, f32 pitch = 0.3f, f32 distance = 3.2f,
+                                f32 turns = 1.0f) {
+        constexpr f32 TWO_PI = 6.28318530718f;
+        CameraPath path;
+        path.add(0.0f, {0.0f, pitch, distance});
+        path.add(seconds, {TWO_PI * turns, pitch, distance});
+        return path;
+    }
+
+    /// Parse keys from text: one "time yaw_deg pitch_deg distance" per
+    /// line; blank lines and '#' comments are ignored.
+    static bool parse(std::istream& in, CameraPath& out) {
+        constexpr f32 DEG = 3.14159265359f / 180.0f;
+        out = {};
+        std::string line;
+        u32 line_no = 0;
+        while (std::getline(in, line)) {
+            line_no++;
+            line = line.substr(0, line.find('#'));
+            if (line.find_first_not_of(" \t\r") == std::string::npos) continue;
+            std::istringstream fields(line);
+            f32 time, yaw, pitch, distance;
+            if (!(fields >> time >> yaw >> pitch >> distance)) {
+                LOG_WARN("Camera path line {}: expected 'time yaw pitch distance'", line_no);
+                return false;
+            }
+            out.add(time, {yaw * DEG, pitch * DEG, distance});
+        }
+        return !out.empty();
+    }
+
+    static bool load(const std::string& path, CameraPath& out) {
+        std::ifstream file(path);
+        if (!file) {
+            LOG_WARN("Cannot open camera path: {}", path);
+            return false;
+        }
+        return parse(file, out);
+    }
+
+private:
+    std::vector<CameraKey> keys_; // Sorted by time
+};
+
+} // namespace godsim
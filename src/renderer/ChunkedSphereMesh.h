@@ -0,0 +1,253 @@
+#pragma once
+
+#include "GL33Loader.h"
+#include "Shader.h"
+#include "TerrainQuadtree.h"
+#include "TerrainVertex.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/util/Types.h"
+
+#include <memory>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace godsim {
+
+/// Planet surface as a chunked cube-sphere. Each frame the quadtree picks
+/// the chunks to draw; meshes are built on demand into a bounded LRU cache.
+/// Chunks not built yet within this frame's budget fall back to their
+/// nearest cached ancestor, so the surface never has holes.
+/// Vertices carry baked displacement and normals (PackedVertex, drawn with
+/// TERRAIN_VERT); terraform edits re-bake only the chunks they touch.
+class ChunkedSphereMesh {
+public:
+    struct Stats {
+        u32 selected = 0;   // Chunks the quadtree asked for
+        u32 drawn = 0;      // Chunks actually drawn (after ancestor fallback)
+        u32 built = 0;      // Meshes built this frame
+        u32 rebaked = 0;    // Meshes re-baked after terrain edits
+        u32 cached = 0;     // Meshes resident on the GPU
+        u64 triangles = 0;  // Triangles submitted this frame
+        u64 uploaded_bytes = 0; // Vertex data sent to the GPU this frame
+    };
+
+    ChunkedSphereMesh() = default;
+    ChunkedSphereMesh(const ChunkedSphereMesh&) = delete;
+    ChunkedSphereMesh& operator=(const ChunkedSphereMesh&) = delete;
+    ~ChunkedSphereMesh() { destroy(); }
+
+    void create(const PlanetData& planet, const QuadtreeConfig& config, f32 displacement_scale,
+                u32 build_budget = 48, u32 cache_capacity = 1536) {
+        tree_ = TerrainQuadtree(config);
+        baker_ = std::make_unique<TerrainBaker>(planet.elevation, planet.sea_level,
+                                                displacement_scale);
+        grid_w_ = planet.width;
+        grid_h_ = planet.height;
+        build_budget_ = build_budget;
+        cache_capacity_ = cache_capacity;
+
+        auto indices = tree_.chunk_indices();
+        index_count_ = static_cast<u32>(indices.size());
+        gl::GenBuffers(1, &ebo_);
+        gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        gl::BufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32),
+                       indices.data(), GL_STATIC_DRAW);
+
+        // Roots are always resident: every fallback chain ends at one
+        for (u8 face = 0; face < 6; face++) build({face, 0, 0, 0});
+    }
+
+    void destroy() {
+        for (auto& [id, chunk] : cache_) release(chunk);
+        cache_.clear();
+        if (ebo_) gl::DeleteBuffers(1, &ebo_);
+        ebo_ = 0;
+    }
+
+    /// Select and prepare chunks for the given camera.
+    void update(const LodView& view) {
+        frame_++;
+        stats_ = {};
+        tree_.select(view, selected_);
+        stats_.selected = static_cast<u32>(selected_.size());
+
+        draw_ids_.clear();
+        for (const auto& key : selected_) {
+            ChunkKey k = key;
+            auto it = cache_.find(k.packed());
+            if (it == cache_.end() && stats_.built < build_budget_) {
+                build(k);
+                stats_.built++;
+                it = cache_.find(k.packed());
+            }
+            while (it == cache_.end()) {
+                k = k.parent();
+                it = cache_.find(k.packed());
+            }
+            it->second.last_used = frame_;
+            draw_ids_.insert(k.packed());
+        }
+
+        // A fallback ancestor covers its whole subtree: drop descendants drawn under it
+        draw_list_.clear();
+        for (u64 id : draw_ids_) {
+            const Chunk& chunk = cache_.at(id);
+            bool covered = false;
+            for (ChunkKey p = chunk.key; p.level > 0 && !covered;) {
+                p = p.parent();
+                covered = draw_ids_.count(p.packed()) > 0;
+            }
+            if (!covered) draw_list_.push_back(&chunk);
+        }
+
+        // Edited chunks on screen are re-baked now; others were already dropped
+        for (const Chunk* chunk : draw_list_) {
+            if (!chunk->stale) continue;
+            build(chunk->key);
+            stats_.rebaked++;
+        }
+
+        evict();
+        stats_.drawn = static_cast<u32>(draw_list_.size());
+        stats_.cached = static_cast<u32>(cache_.size());
+        stats_.triangles = static_cast<u64>(stats_.drawn) * tree_.triangles_per_chunk();
+    }
+
+    /// Re-bake chunks covering edited cells. Cached chunks that are not on
+    /// screen are dropped and rebuilt when next needed; roots stay resident.
+    void invalidate(const DirtyRegion& region) {
+        if (region.empty()) return;
+        for (auto it = cache_.begin(); it != cache_.end();) {
+            Chunk& chunk = it->second;
+            bool touched = false;
+            for (const auto& rect : region.rects()) {
+                if (chunk_touches(tree_, chunk.key, rect, grid_w_, grid_h_)) {
+                    touched = true;
+                    break;
+                }
+            }
+            if (touched && chunk.key.level > 0 && chunk.last_used < frame_) {
+                release(chunk);
+                it = cache_.erase(it);
+                continue;
+            }
+            chunk.stale = chunk.stale || touched;
+            ++it;
+        }
+    }
+
+    /// Draw with TERRAIN_VERT bound on `shader`.
+    void draw(const ShaderProgram& shader) const {
+        GLint origin_loc = shader.uniform("uChunkOrigin");
+        GLint extent_loc = shader.uniform("uChunkExtent");
+        for (const Chunk* chunk : draw_list_) {
+            const ChunkFrame& f = chunk->frame;
+            gl::Uniform3f(origin_loc, f.origin.x, f.origin.y, f.origin.z);
+            gl::Uniform3f(extent_loc, f.extent.x, f.extent.y, f.extent.z);
+            gl::BindVertexArray(chunk->vao);
+            gl::DrawElements(GL_TRIANGLES, index_count_, GL_UNSIGNED_INT, nullptr);
+        }
+        gl::BindVertexArray(0);
+    }
+
+    const Stats& stats() const { return stats_; }
+    const TerrainQuadtree& quadtree() const { return tree_; }
+
+private:
+    struct Chunk {
+        ChunkKey key;
+        GLuint vao = 0, vbo = 0;
+        ChunkFrame frame;
+        u64 last_used = 0;
+        bool stale = false;
+    };
+
+    void build(const ChunkKey& key) {
+        ChunkFrame frame;
+        baker_->bake(tree_, key, vertices_, frame);
+        size_t bytes = vertices_.size() * sizeof(PackedVertex);
+        stats_.uploaded_bytes += bytes;
+
+        // Re-bake in place: same vertex count, so the buffer is reused
+        auto existing = cache_.find(key.packed());
+        if (existing != cache_.end()) {
+            Chunk& chunk = existing->second;
+            chunk.frame = frame;
+            chunk.stale = false;
+            gl::BindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+            gl::BufferSubData(GL_ARRAY_BUFFER, 0, bytes, vertices_.data());
+            return;
+        }
+
+        Chunk chunk;
+        chunk.key = key;
+        chunk.frame = frame;
+        chunk.last_used = frame_;
+        gl::GenVertexArrays(1, &chunk.vao);
+        gl::GenBuffers(1, &chunk.vbo);
+        gl::BindVertexArray(chunk.vao);
+        gl::BindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+        gl::BufferData(GL_ARRAY_BUFFER, bytes, vertices_.data(), GL_STATIC_DRAW);
+        gl::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+
+        // location 0: xyz quantised in the chunk box + elevation (unorm16)
+        // location 1: octahedral normal (snorm16)
+        gl::VertexAttribPointer(0, 4, GL_UNSIGNED_SHORT, GL_TRUE, sizeof(PackedVertex),
+                                (void*)offsetof(PackedVertex, px));
+        gl::EnableVertexAttribArray(0);
+        gl::VertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, sizeof(PackedVertex),
+                                (void*)offsetof(PackedVertex, nx));
+        gl::EnableVertexAttribArray(1);
+        gl::BindVertexArray(0);
+
+        cache_[key.packed()] = chunk;
+    }
+
+    /// Drop least recently used chunks beyond the cache capacity. Roots and
+    /// anything drawn this frame stay.
+    void evict() {
+        if (cache_.size() <= cache_capacity_) return;
+        std::vector<std::pair<u64, u64>> candidates; // (last_used, id)
+        for (const auto& [id, chunk] : cache_) {
+            if (chunk.key.level > 0 && chunk.last_used < frame_)
+                candidates.push_back({chunk.last_used, id});
+        }
+        size_t excess = cache_.size() - cache_capacity_;
+        if (candidates.size() > excess) {
+            std::nth_element(candidates.begin(), candidates.begin() + excess, candidates.end());
+            candidates.resize(excess);
+        }
+        for (const auto& [used, id] : candidates) {
+            release(cache_.at(id));
+            cache_.erase(id);
+        }
+    }
+
+    static void release(Chunk& chunk) {
+        if (chunk.vbo) gl::DeleteBuffers(1, &chunk.vbo);
+        if (chunk.vao) gl::DeleteVertexArrays(1, &chunk.vao);
+        chunk.vao = chunk.vbo = 0;
+    }
+
+    TerrainQuadtree tree_;
+    std::unique_ptr<TerrainBaker> baker_;
+    u32 grid_w_ = 0, grid_h_ = 0;
+    std::unordered_map<u64, Chunk> cache_;
+    GLuint ebo_ = 0;
+    u32 index_count_ = 0;
+    u32 build_budget_ = 48;
+    u32 cache_capacity_ = 1536;
+    u64 frame_ = 0;
+    Stats stats_;
+
+    // Per-frame scratch
+    std::vector<ChunkKey> selected_;
+    std::unordered_set<u64> draw_ids_;
+    std::vector<const Chunk*> draw_list_;
+    std::vector<PackedVertex> vertices_;
+};
+
+} // namespace godsim
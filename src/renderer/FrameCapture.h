@@ -0,0 +1,103 @@
+#pragma once
+
+#include "CameraPath.h"
+#include "SoftwareRenderer.h"
+#include "UploadWorker.h"
+#include "layers/planetary/ImageExporter.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/util/Log.h"
+#include "core/util/Types.h"
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+/// Offline image-sequence capture along a scripted camera path.
+struct CaptureSettings {
+    u32 width = 1280;
+    u32 height = 720;
+    u32 frames = 120;
+    f32 fps = 30.0f;            // Path time advances 1/fps per frame
+    f32 fov = 45.0f;            // Vertical, degrees (matches Camera)
+    std::string output_dir = "capture";
+    ImageFormat format = ImageFormat::PNG;
+    CameraPath path = CameraPath::turntable(4.0f);
+};
+
+struct CaptureReport {
+    u32 frames = 0;
+    f64 seconds = 0.0;
+    f64 fps() const { return seconds > 0.0 ? frames / seconds : 0.0; }
+};
+
+/// "frame_00042.png" inside the output directory.
+inline std::string capture_frame_path(const CaptureSettings& settings, u32 index) {
+    char name[32];
+    std::snprintf(name, sizeof(name), "frame_%05u", index);
+    return settings.output_dir + "/" + name + image_extension(settings.format);
+}
+
+/// Encodes and writes captured frames on a background thread so the
+/// renderer can start the next frame meanwhile. At most `depth` frames
+/// are held; submit() waits for the oldest beyond that.
+class FrameSink {
+public:
+    explicit FrameSink(const CaptureSettings& settings, u32 depth = 3)
+        : settings_(settings), depth_(std::max(depth, 1u)) {
+        std::filesystem::create_directories(settings.output_dir);
+    }
+
+    void submit(u32 index, std::vector<u8> rgb) {
+        if (tickets_.size() >= depth_) {
+            worker_.wait(tickets_.front());
+            tickets_.erase(tickets_.begin());
+        }
+        auto frame = std::make_shared<std::vector<u8>>(std::move(rgb));
+        std::string path = capture_frame_path(settings_, index);
+        u32 w = settings_.width, h = settings_.height;
+        ImageFormat format = settings_.format;
+        tickets_.push_back(worker_.submit([frame, path, w, h, format] {
+            ImageWriter writer;
+            if (writer.open(path, w, h, format)) writer.write_rows(frame->data(), h);
+        }));
+    }
+
+    void finish() { worker_.wait_all(); }
+
+private:
+    CaptureSettings settings_;
+    u32 depth_;
+    UploadWorker worker_;
+    std::vector<u64> tickets_;
+};
+
+/// Render the whole capture with the CPU fallback renderer.
+inline CaptureReport capture_software(const PlanetData& planet, const CaptureSettings& settings) {
+    LOG_INFO("Software capture: {} frames at {}x{} into {}", settings.frames, settings.width,
+             settings.height, settings.output_dir);
+    SoftwareRenderer renderer(planet);
+    FrameSink sink(settings);
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<u8> rgb;
+    for (u32 i = 0; i < settings.frames; i++) {
+        renderer.render(settings.path.at(i / settings.fps), settings.fov, settings.width,
+                        settings.height, rgb);
+        sink.submit(i, std::move(rgb));
+    }
+    sink.finish();
+
+    CaptureReport report;
+    report.frames = settings.frames;
+    report.seconds = std::chrono::duration<f64>(std::chrono::steady_clock::now() - start).count();
+    LOG_INFO("Captured {} frames in {:.2f} s ({:.1f} fps)", report.frames, report.seconds,
+             report.fps());
+    return report;
+}
+
+} // namespace godsim
@@ -0,0 +1,115 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+/// Render passes timed separately, in draw order.
+enum class RenderPass : u32 {
+    Stars = 0,
+    Planet,
+    Clouds,
+    Atmosphere,
+    COUNT
+};
+
+inline constexpr u32 RENDER_PASS_COUNT = static_cast<u32>(RenderPass::COUNT);
+
+inline const char* render_pass_name(RenderPass pass) {
+    switch (pass) {
+        case RenderPass::Stars:      return "Stars";
+        case RenderPass::Planet:     return "Planet";
+        case RenderPass::Clouds:     return "Clouds";
+        case RenderPass::Atmosphere: return "Atmosphere";
+        default:                     return "?";
+    }
+}
+
+/// Measurements for one rendered frame. GPU times are negative when the
+/// driver has no timer queries; they arrive a few frames late, so a
+/// sample carries the most recent GPU result rather than its own frame's.
+struct FrameSample {
+    f32 frame_ms = 0.0f;    // Wall time since the previous frame
+    f32 cpu_ms = 0.0f;      // CPU time spent building the frame (before swap)
+    f32 gpu_ms = -1.0f;     // Sum of the timed passes on the GPU
+    std::array<f32, RENDER_PASS_COUNT> pass_cpu_ms{-1.0f, -1.0f, -1.0f, -1.0f}; // -1: not drawn
+    std::array<f32, RENDER_PASS_COUNT> pass_gpu_ms{-1.0f, -1.0f, -1.0f, -1.0f};
+    u64 triangles = 0;
+    u64 upload_bytes = 0;   // Vertex and texture data sent to the GPU
+};
+
+/// Rolling history of frame samples. The HUD reads short averages; on
+/// exit the whole history is summarised as percentiles.
+class FrameStats {
+public:
+    explicit FrameStats(u32 capacity = 8192) : capacity_(std::max(capacity, 1u)) {
+        history_.reserve(capacity_);
+    }
+
+    void record(const FrameSample& sample) {
+        if (history_.size() < capacity_) {
+            history_.push_back(sample);
+        } else {
+            history_[next_] = sample;
+        }
+        next_ = (next_ + 1) % capacity_;
+        frames_++;
+        total_upload_bytes_ += sample.upload_bytes;
+    }
+
+    /// Samples currently held (at most the capacity).
+    u32 size() const { return static_cast<u32>(history_.size()); }
+    u64 frames() const { return frames_; }
+    u64 total_upload_bytes() const { return total_upload_bytes_; }
+
+    /// The n-th most recent sample; 0 is the latest. Requires n < size().
+    const FrameSample& recent(u32 n = 0) const {
+        return history_[(next_ + capacity_ - 1 - n) % capacity_];
+    }
+
+    /// Mean of `get` over the last `n` samples, skipping unavailable (< 0)
+    /// values. Returns -1 when nothing was available.
+    template<typename Get>
+    f32 mean_recent(u32 n, Get get) const {
+        f64 sum = 0.0;
+        u32 used = 0;
+        for (u32 i = 0; i < std::min(n, size()); i++) {
+            f32 v = get(recent(i));
+            if (v < 0.0f) continue;
+            sum += v;
+            used++;
+        }
+        return used ? static_cast<f32>(sum / used) : -1.0f;
+    }
+
+    /// Nearest-rank percentile (p in [0, 100]) of `get` over the history,
+    /// skipping unavailable (< 0) values. Returns -1 when nothing was available.
+    template<typename Get>
+    f32 percentile(f32 p, Get get) const {
+        scratch_.clear();
+        for (const auto& s : history_) {
+            f32 v = get(s);
+            if (v >= 0.0f) scratch_.push_back(v);
+        }
+        if (scratch_.empty()) return -1.0f;
+        f32 rank = std::ceil(std::clamp(p, 0.0f, 100.0f) / 100.0f * scratch_.size());
+        size_t k = static_cast<size_t>(std::max(rank, 1.0f)) - 1;
+        std::nth_element(scratch_.begin(), scratch_.begin() + k, scratch_.end());
+        return scratch_[k];
+    }
+
+private:
+    u32 capacity_;
+    u32 next_ = 0;
+    u64 frames_ = 0;
+    u64 total_upload_bytes_ = 0;
+    std::vector<FrameSample> history_;
+    mutable std::vector<f32> scratch_;
+};
+
+} // namespace godsim
@@ -28,6 +28,7 @@ typedef double          GLdouble;
 typedef char            GLchar;
 typedef ptrdiff_t       GLsizeiptr;
 typedef ptrdiff_t       GLintptr;
+typedef uint64_t        GLuint64;
 
 // ═══════════════════════════════════════════════════════════════
 //  GL CONSTANTS
@@ -115,6 +116,31 @@ typedef ptrdiff_t       GLintptr;
 #define GL_CLAMP_TO_EDGE            0x812F
 #define GL_RGB                      0x1907
 #define GL_RGBA                     0x1908
+#define GL_RED                      0x1903
+#define GL_R8                       0x8229
+#define GL_R16                      0x822A
+#define GL_UNPACK_ALIGNMENT         0x0CF5
+
+// Pixel buffer objects
+#define GL_PIXEL_UNPACK_BUFFER      0x88EC
+#define GL_STREAM_DRAW              0x88E0
+#define GL_MAP_WRITE_BIT            0x0002
+#define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+
+// Framebuffers (offscreen capture)
+#define GL_FRAMEBUFFER              0x8D40
+#define GL_RENDERBUFFER             0x8D41
+#define GL_COLOR_ATTACHMENT0        0x8CE0
+#define GL_DEPTH_ATTACHMENT         0x8D00
+#define GL_DEPTH_COMPONENT24        0x81A6
+#define GL_RGBA8                    0x8058
+#define GL_FRAMEBUFFER_COMPLETE     0x8CD5
+#define GL_PACK_ALIGNMENT           0x0D05
+
+// Timer queries
+#define GL_TIME_ELAPSED             0x88BF
+#define GL_QUERY_RESULT             0x8866
+#define GL_QUERY_RESULT_AVAILABLE   0x8867
 
 // Get
 #define GL_VENDOR                   0x1F00
@@ -228,6 +254,12 @@ inline EnableVertexAttribArrayFn EnableVertexAttribArray  = nullptr;
 using BufferSubDataFn = void(*)(GLenum, GLintptr, GLsizeiptr, const void*);
 inline BufferSubDataFn BufferSubData = nullptr;
 
+// --- Buffer mapping ---
+using MapBufferRangeFn = void*(*)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+using UnmapBufferFn    = GLboolean(*)(GLenum);
+inline MapBufferRangeFn MapBufferRange = nullptr;
+inline UnmapBufferFn    UnmapBuffer    = nullptr;
+
 // --- Textures ---
 using GenTexturesFn      = void(*)(GLsizei, GLuint*);
 using BindTextureFn      = void(*)(GLenum, GLuint);
@@ -236,6 +268,7 @@ using TexImage2DFn       = void(*)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint
 using TexSubImage2DFn    = void(*)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, const void*);
 using TexParameteriFn    = void(*)(GLenum, GLenum, GLint);
 using ActiveTextureFn    = void(*)(GLenum);
+using PixelStoreiFn      = void(*)(GLenum, GLint);
 
 inline GenTexturesFn    GenTextures    = nullptr;
 inline BindTextureFn    BindTexture    = nullptr;
@@ -244,6 +277,45 @@ inline TexImage2DFn     TexImage2D     = nullptr;
 inline TexSubImage2DFn  TexSubImage2D  = nullptr;
 inline TexParameteriFn  TexParameteri  = nullptr;
 inline ActiveTextureFn  ActiveTexture  = nullptr;
+inline PixelStoreiFn    PixelStorei    = nullptr;
+
+// --- Framebuffers ---
+using GenFramebuffersFn         = void(*)(GLsizei, GLuint*);
+using DeleteFramebuffersFn      = void(*)(GLsizei, const GLuint*);
+using BindFramebufferFn         = void(*)(GLenum, GLuint);
+using FramebufferRenderbufferFn = void(*)(GLenum, GLenum, GLenum, GLuint);
+using CheckFramebufferStatusFn  = GLenum(*)(GLenum);
+using GenRenderbuffersFn        = void(*)(GLsizei, GLuint*);
+using DeleteRenderbuffersFn     = void(*)(GLsizei, const GLuint*);
+using BindRenderbufferFn        = void(*)(GLenum, GLuint);
+using RenderbufferStorageFn     = void(*)(GLenum, GLenum, GLsizei, GLsizei);
+using ReadPixelsFn              = void(*)(GLint, GLint, GLsizei, GLsizei, GLenum, GLenum, void*);
+
+inline GenFramebuffersFn         GenFramebuffers         = nullptr;
+inline DeleteFramebuffersFn      DeleteFramebuffers      = nullptr;
+inline BindFramebufferFn         BindFramebuffer         = nullptr;
+inline FramebufferRenderbufferFn FramebufferRenderbuffer = nullptr;
+inline CheckFramebufferStatusFn  CheckFramebufferStatus  = nullptr;
+inline GenRenderbuffersFn        GenRenderbuffers        = nullptr;
+inline DeleteRenderbuffersFn     DeleteRenderbuffers     = nullptr;
+inline BindRenderbufferFn        BindRenderbuffer        = nullptr;
+inline RenderbufferStorageFn     RenderbufferStorage     = nullptr;
+inline ReadPixelsFn              ReadPixels              = nullptr;
+
+// --- Queries ---
+using GenQueriesFn          = void(*)(GLsizei, GLuint*);
+using DeleteQueriesFn       = void(*)(GLsizei, const GLuint*);
+using BeginQueryFn          = void(*)(GLenum, GLuint);
+using EndQueryFn            = void(*)(GLenum);
+using GetQueryObjectivFn    = void(*)(GLuint, GLenum, GLint*);
+using GetQueryObjectui64vFn = void(*)(GLuint, GLenum, GLuint64*);
+
+inline GenQueriesFn          GenQueries          = nullptr;
+inline DeleteQueriesFn       DeleteQueries       = nullptr;
+inline BeginQueryFn          BeginQuery          = nullptr;
+inline EndQueryFn            EndQuery            = nullptr;
+inline GetQueryObjectivFn    GetQueryObjectiv    = nullptr;
+inline GetQueryObjectui64vFn GetQueryObjectui64v = nullptr;
 
 // --- Draw ---
 using DrawElementsFn = void(*)(GLenum, GLsizei, GLenum, const void*);
@@ -303,6 +375,8 @@ inline bool load() {
     BufferData    = (BufferDataFn)    get("glBufferData");
     BufferSubData = (BufferSubDataFn) get("glBufferSubData");
     DeleteBuffers = (DeleteBuffersFn) get("glDeleteBuffers");
+    MapBufferRange = (MapBufferRangeFn) get("glMapBufferRange");
+    UnmapBuffer    = (UnmapBufferFn)    get("glUnmapBuffer");
 
     // VAOs
     GenVertexArrays    = (GenVertexArraysFn)    get("glGenVertexArrays");
@@ -321,6 +395,27 @@ inline bool load() {
     TexSubImage2D  = (TexSubImage2DFn)  get("glTexSubImage2D");
     TexParameteri  = (TexParameteriFn)  get("glTexParameteri");
     ActiveTexture  = (ActiveTextureFn)  get("glActiveTexture");
+    PixelStorei    = (PixelStoreiFn)    get("glPixelStorei");
+
+    // Framebuffers
+    GenFramebuffers         = (GenFramebuffersFn)         get("glGenFramebuffers");
+    DeleteFramebuffers      = (DeleteFramebuffersFn)      get("glDeleteFramebuffers");
+    BindFramebuffer         = (BindFramebufferFn)         get("glBindFramebuffer");
+    FramebufferRenderbuffer = (FramebufferRenderbufferFn) get("glFramebufferRenderbuffer");
+    CheckFramebufferStatus  = (CheckFramebufferStatusFn)  get("glCheckFramebufferStatus");
+    GenRenderbuffers        = (GenRenderbuffersFn)        get("glGenRenderbuffers");
+    DeleteRenderbuffers     = (DeleteRenderbuffersFn)     get("glDeleteRenderbuffers");
+    BindRenderbuffer        = (BindRenderbufferFn)        get("glBindRenderbuffer");
+    RenderbufferStorage     = (RenderbufferStorageFn)     get("glRenderbufferStorage");
+    ReadPixels              = (ReadPixelsFn)              get("glReadPixels");
+
+    // Queries (optional: GPU timing is skipped without them)
+    GenQueries          = (GenQueriesFn)          get("glGenQueries");
+    DeleteQueries       = (DeleteQueriesFn)       get("glDeleteQueries");
+    BeginQuery          = (BeginQueryFn)          get("glBeginQuery");
+    EndQuery            = (EndQueryFn)            get("glEndQuery");
+    GetQueryObjectiv    = (GetQueryObjectivFn)    get("glGetQueryObjectiv");
+    GetQueryObjectui64v = (GetQueryObjectui64vFn) get("glGetQueryObjectui64v");
 
     // Draw
     DrawElements = (DrawElementsFn) get("glDrawElements");
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "GL33Loader.h"
+#include "FrameStats.h"
+#include "core/util/Log.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+
+namespace godsim {
+
+/// Per-pass GPU timing with GL_TIME_ELAPSED queries. Results are read
+/// back LATENCY frames later so the CPU never waits on the GPU; until a
+/// frame's queries are available the previous result is kept. When the
+/// driver exposes no timer queries every call is a no-op and results
+/// stay at -1.
+class GpuTimer {
+public:
+    static constexpr u32 LATENCY = 4;
+
+    GpuTimer() = default;
+    GpuTimer(const GpuTimer&) = delete;
+    GpuTimer& operator=(const GpuTimer&) = delete;
+    ~GpuTimer() { destroy(); }
+
+    void create() {
+        supported_ = gl::GenQueries && gl::DeleteQueries && gl::BeginQuery &&
+                     gl::EndQuery && gl::GetQueryObjectiv && gl::GetQueryObjectui64v;
+        if (!supported_) {
+            LOG_WARN("GPU timer queries unavailable; GPU frame times disabled");
+            return;
+        }
+        for (auto& frame : frames_) gl::GenQueries(RENDER_PASS_COUNT, frame.queries.data());
+    }
+
+    void destroy() {
+        if (!supported_) return;
+        for (auto& frame : frames_) gl::DeleteQueries(RENDER_PASS_COUNT, frame.queries.data());
+        supported_ = false;
+    }
+
+    bool supported() const { return supported_; }
+
+    /// Start a frame: collects the oldest frame's results if they are ready.
+    void begin_frame() {
+        if (!supported_) return;
+        current_ = (current_ + 1) % LATENCY;
+        Frame& frame = frames_[current_];
+        if (frame.pending) collect(frame);
+        frame.used = {};
+        frame.pending = true;
+    }
+
+    /// Bracket one pass. Passes must not nest (GL allows one active
+    /// TIME_ELAPSED query).
+    void begin(RenderPass pass) {
+        if (!supported_) return;
+        auto i = static_cast<u32>(pass);
+        frames_[current_].used[i] = true;
+        gl::BeginQuery(GL_TIME_ELAPSED, frames_[current_].queries[i]);
+    }
+
+    void end() {
+        if (supported_) gl::EndQuery(GL_TIME_ELAPSED);
+    }
+
+    /// Latest available per-pass times in ms; -1 for passes not drawn.
+    const std::array<f32, RENDER_PASS_COUNT>& pass_ms() const { return pass_ms_; }
+
+    /// Sum of the latest pass times, or -1 if none are available.
+    f32 total_ms() const {
+        f32 total = -1.0f;
+        for (f32 ms : pass_ms_) {
+            if (ms >= 0.0f) total = std::max(total, 0.0f) + ms;
+        }
+        return total;
+    }
+
+private:
+    struct Frame {
+        std::array<GLuint, RENDER_PASS_COUNT> queries{};
+        std::array<bool, RENDER_PASS_COUNT> used{};
+        bool pending = false;
+    };
+
+    void collect(Frame& frame) {
+        // Queries complete in order: if the last one used is ready, all are
+        for (u32 i = RENDER_PASS_COUNT; i-- > 0;) {
+            if (!frame.used[i]) continue;
+            GLint ready = 0;
+            gl::GetQueryObjectiv(frame.queries[i], GL_QUERY_RESULT_AVAILABLE, &ready);
+            if (!ready) return; // Slow GPU: keep the previous result
+            break;
+        }
+        for (u32 i = 0; i < RENDER_PASS_COUNT; i++) {
+            if (!frame.used[i]) {
+                pass_ms_[i] = -1.0f;
+                continue;
+            }
+            GLuint64 ns = 0;
+            gl::GetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &ns);
+            pass_ms_[i] = static_cast<f32>(static_cast<f64>(ns) * 1e-6);
+        }
+        frame.pending = false;
+    }
+
+    bool supported_ = false;
+    u32 current_ = 0;
+    std::array<Frame, LATENCY> frames_{};
+    std::array<f32, RENDER_PASS_COUNT> pass_ms_{-1.0f, -1.0f, -1.0f, -1.0f};
+};
+
+} // namespace godsim
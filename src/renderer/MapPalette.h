@@ -0,0 +1,115 @@
+#pragma once
+
+#include "layers/planetary/Biome.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace godsim {
+
+/// GPU colour lookup for the planet surface. The renderer uploads raw
+/// single-channel data (see TexelPacking.h) and the fragment shader maps
+/// it through this palette, so map-mode switches and terrain edits never
+/// run a colour pass on the CPU.
+///
+/// Layout: PALETTE_WIDTH × PALETTE_ROWS RGB8, one row per MapPaletteRow.
+/// Ramp rows hold 256 samples of t ∈ [0, 1], read with linear filtering.
+enum class MapPaletteRow : u32 {
+    Biome = 0,      // Entry i = BIOME_INFO[i]
+    Elevation,      // t = raw elevation (sea level is baked in)
+    Temperature,    // t = temperature normalised to the planet's range
+    Moisture,       // t = moisture
+    COUNT
+};
+
+inline constexpr u32 PALETTE_WIDTH = 256;
+inline constexpr u32 PALETTE_ROWS = static_cast<u32>(MapPaletteRow::COUNT);
+
+// ─── Ramps ───
+
+inline void elevation_ramp(f32 e, f32 sea_level, u8* rgb) {
+    if (e < sea_level) {
+        // Ocean: dark blue → blue
+        f32 t = e / sea_level;
+        rgb[0] = static_cast<u8>(10 + 30 * t);
+        rgb[1] = static_cast<u8>(20 + 60 * t);
+        rgb[2] = static_cast<u8>(80 + 100 * t);
+        return;
+    }
+    // Land: green → yellow → white
+    f32 t = (e - sea_level) / (1.0f - sea_level);
+    if (t < 0.5f) {
+        f32 s = t * 2.0f;
+        rgb[0] = static_cast<u8>(40 + 180 * s);
+        rgb[1] = static_cast<u8>(140 + 80 * s);
+        rgb[2] = 40;
+    } else {
+        f32 s = (t - 0.5f) * 2.0f;
+        rgb[0] = static_cast<u8>(220 + 35 * s);
+        rgb[1] = static_cast<u8>(220 + 35 * s);
+        rgb[2] = static_cast<u8>(40 + 215 * s);
+    }
+}
+
+/// Blue → cyan → green → yellow → red over normalised temperature.
+inline void temperature_ramp(f32 t, u8* rgb) {
+    if (t < 0.25f) {
+        f32 s = t * 4.0f;
+        rgb[0] = 0;
+        rgb[1] = static_cast<u8>(50 * s);
+        rgb[2] = static_cast<u8>(180 + 50 * s);
+    } else if (t < 0.5f) {
+        f32 s = (t - 0.25f) * 4.0f;
+        rgb[0] = static_cast<u8>(30 * s);
+        rgb[1] = static_cast<u8>(50 + 170 * s);
+        rgb[2] = static_cast<u8>(230 - 180 * s);
+    } else if (t < 0.75f) {
+        f32 s = (t - 0.5f) * 4.0f;
+        rgb[0] = static_cast<u8>(30 + 210 * s);
+        rgb[1] = static_cast<u8>(220 - 20 * s);
+        rgb[2] = static_cast<u8>(50 - 30 * s);
+    } else {
+        f32 s = (t - 0.75f) * 4.0f;
+        rgb[0] = 240;
+        rgb[1] = static_cast<u8>(200 - 170 * s);
+        rgb[2] = 20;
+    }
+}
+
+/// Brown (dry) → green → teal (wet).
+inline void moisture_ramp(f32 m, u8* rgb) {
+    if (m < 0.5f) {
+        f32 s = m * 2.0f;
+        rgb[0] = static_cast<u8>(180 - 140 * s);
+        rgb[1] = static_cast<u8>(140 + 40 * s);
+        rgb[2] = static_cast<u8>(60 - 20 * s);
+    } else {
+        f32 s = (m - 0.5f) * 2.0f;
+        rgb[0] = static_cast<u8>(40 - 20 * s);
+        rgb[1] = static_cast<u8>(180 - 20 * s);
+        rgb[2] = static_cast<u8>(40 + 140 * s);
+    }
+}
+
+/// Fill the full palette image (PALETTE_WIDTH × PALETTE_ROWS × RGB).
+inline void build_map_palette(f32 sea_level, std::vector<u8>& rgb) {
+    rgb.assign(static_cast<size_t>(PALETTE_WIDTH) * PALETTE_ROWS * 3, 0);
+    auto entry = [&](MapPaletteRow row, u32 i) {
+        return rgb.data() + (static_cast<size_t>(row) * PALETTE_WIDTH + i) * 3;
+    };
+    for (size_t i = 0; i < BIOME_INFO.size(); i++) {
+        u8* c = entry(MapPaletteRow::Biome, static_cast<u32>(i));
+        c[0] = BIOME_INFO[i].r;
+        c[1] = BIOME_INFO[i].g;
+        c[2] = BIOME_INFO[i].b;
+    }
+    for (u32 i = 0; i < PALETTE_WIDTH; i++) {
+        f32 t = static_cast<f32>(i) / (PALETTE_WIDTH - 1);
+        elevation_ramp(t, sea_level, entry(MapPaletteRow::Elevation, i));
+        temperature_ramp(t, entry(MapPaletteRow::Temperature, i));
+        moisture_ramp(t, entry(MapPaletteRow::Moisture, i));
+    }
+}
+
+} // namespace godsim
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "GL33Loader.h"
+#include "core/util/Log.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace godsim {
+
+/// Framebuffer with RGBA8 colour and 24-bit depth renderbuffers, for
+/// rendering without presenting to a window.
+class OffscreenTarget {
+public:
+    OffscreenTarget() = default;
+    OffscreenTarget(const OffscreenTarget&) = delete;
+    OffscreenTarget& operator=(const OffscreenTarget&) = delete;
+    ~OffscreenTarget() { destroy(); }
+
+    /// Returns false if the driver lacks framebuffer objects or rejects the size.
+    bool create(u32 width, u32 height) {
+        if (!gl::GenFramebuffers || !gl::ReadPixels) return false;
+        width_ = width;
+        height_ = height;
+
+        gl::GenFramebuffers(1, &fbo_);
+        gl::GenRenderbuffers(2, renderbuffers_);
+        gl::BindFramebuffer(GL_FRAMEBUFFER, fbo_);
+
+        gl::BindRenderbuffer(GL_RENDERBUFFER, renderbuffers_[0]);
+        gl::RenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width, height);
+        gl::FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER,
+                                    renderbuffers_[0]);
+        gl::BindRenderbuffer(GL_RENDERBUFFER, renderbuffers_[1]);
+        gl::RenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width, height);
+        gl::FramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER,
+                                    renderbuffers_[1]);
+        gl::BindRenderbuffer(GL_RENDERBUFFER, 0);
+
+        bool complete = gl::CheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+        gl::BindFramebuffer(GL_FRAMEBUFFER, 0);
+        if (!complete) {
+            LOG_WARN("Offscreen framebuffer {}x{} incomplete", width, height);
+            destroy();
+        }
+        return complete;
+    }
+
+    void destroy() {
+        if (!fbo_) return;
+        gl::DeleteFramebuffers(1, &fbo_);
+        gl::DeleteRenderbuffers(2, renderbuffers_);
+        fbo_ = 0;
+    }
+
+    void bind() const {
+        gl::BindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        gl::Viewport(0, 0, static_cast<GLsizei>(width_), static_cast<GLsizei>(height_));
+    }
+
+    static void unbind() { gl::BindFramebuffer(GL_FRAMEBUFFER, 0); }
+
+    /// Read the colour buffer as RGB8, rows top to bottom (GL reads bottom-up).
+    void read_rgb(std::vector<u8>& rgb) const {
+        size_t stride = static_cast<size_t>(width_) * 3;
+        rgb.resize(stride * height_);
+        gl::BindFramebuffer(GL_FRAMEBUFFER, fbo_);
+        gl::PixelStorei(GL_PACK_ALIGNMENT, 1);
+        gl::ReadPixels(0, 0, static_cast<GLsizei>(width_), static_cast<GLsizei>(height_), GL_RGB,
+                       GL_UNSIGNED_BYTE, rgb.data());
+        for (u32 y = 0; y < height_ / 2; y++) {
+            std::swap_ranges(rgb.begin() + y * stride, rgb.begin() + (y + 1) * stride,
+                             rgb.begin() + (height_ - 1 - y) * stride);
+        }
+    }
+
+    u32 width() const { return width_; }
+    u32 height() const { return height_; }
+
+private:
+    GLuint fbo_ = 0;
+    GLuint renderbuffers_[2] = {0, 0}; // Colour, depth
+    u32 width_ = 0, height_ = 0;
+};
+
+} // namespace godsim
@@ -4,13 +4,23 @@
 #include "Camera.h"
 #include "Shader.h"
 #include "SphereMesh.h"
+#include "ChunkedSphereMesh.h"
+#include "TerrainPicker.h"
+#include "FrameStats.h"
+#include "GpuTimer.h"
+#include "FrameCapture.h"
+#include "OffscreenTarget.h"
 #include "layers/planetary/PlanetData.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "core/ecs/Registry.h"
+#include "simulation/RegionLOD.h"
 #include "core/util/Log.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <string>
+#include <chrono>
 #include <cmath>
 #include <cstdio>
 
@@ -20,44 +30,45 @@
 
 namespace godsim {
 
+/// Radial terrain exaggeration baked into terrain chunks, as a fraction of planet radius.
+inline constexpr float DISPLACEMENT_SCALE = 0.035f;
+
 // ═══════════════════════════════════════════════════════════════
 //  PLANET SURFACE SHADER (with cursor highlight)
 // ═══════════════════════════════════════════════════════════════
 
 inline const char* PLANET_VERT = R"glsl(
 #version 330 core
-
-layout(location = 0) in vec3 aPos;
-layout(location = 1) in vec3 aNormal;
-layout(location = 2) in vec2 aUV;
+// Terrain chunks arrive displaced: see PackedVertex / TerrainBaker.
+layout(location = 0) in vec4 aPosElev;   // xyz in the chunk box, w = elevation
+layout(location = 1) in vec2 aOctNormal; // Octahedral surface normal
 
 out vec3 vNormal;
 out vec3 vWorldPos;
-out vec2 vUV;
+out vec3 vDir;
 out float vElevation;
 
 uniform mat4 uModel;
 uniform mat4 uView;
 uniform mat4 uProjection;
-uniform sampler2D uElevationTex;
-uniform float uDisplacementScale;
-uniform float uSeaLevel;
+uniform vec3 uChunkOrigin;
+uniform vec3 uChunkExtent;
+
+vec3 octDecode(vec2 e) {
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = max(-n.z, 0.0);
+    n.xy += vec2(n.x >= 0.0 ? -t : t, n.y >= 0.0 ? -t : t);
+    return normalize(n);
+}
 
 void main() {
-    float elev = texture(uElevationTex, aUV).r;
-    vElevation = elev;
-
-    float displacement = 0.0;
-    if (elev > uSeaLevel) {
-        displacement = (elev - uSeaLevel) * uDisplacementScale;
-    }
-
-    vec3 displaced = aPos * (1.0 + displacement);
+    vec3 pos = uChunkOrigin + aPosElev.xyz * uChunkExtent;
+    vElevation = aPosElev.w;
 
-    vec4 worldPos = uModel * vec4(displaced, 1.0);
+    vec4 worldPos = uModel * vec4(pos, 1.0);
     vWorldPos = worldPos.xyz;
-    vNormal = mat3(uModel) * aNormal;
-    vUV = aUV;
+    vNormal = mat3(uModel) * octDecode(aOctNormal);
+    vDir = pos; // Displacement is radial
     gl_Position = uProjection * uView * worldPos;
 }
 )glsl";
@@ -67,13 +78,17 @@ inline const char* PLANET_FRAG = R"glsl(
 
 in vec3 vNormal;
 in vec3 vWorldPos;
-in vec2 vUV;
+in vec3 vDir;
 in float vElevation;
 
 out vec4 FragColor;
 
-uniform sampler2D uBiomeTex;
+uniform sampler2D uBiomeTex;     // R8 biome index
+uniform sampler2D uElevationTex; // R16 elevation
 uniform sampler2D uNormalTex;
+uniform sampler2D uDataTex;      // R16 heatmap field (temperature / moisture)
+uniform sampler2D uPaletteTex;   // Biome colours and ramps, one row each (MapPalette.h)
+uniform int uMapMode;            // MapMode
 uniform vec3 uLightDir;
 uniform vec3 uCameraPos;
 uniform float uSeaLevel;
@@ -99,7 +114,49 @@ float noise2D(vec2 p) {
     return mix(mix(a, b, f.x), mix(c, d, f.x), f.y);
 }
 
+// Equirectangular UV per fragment: interpolating vertex UVs would smear
+// across the longitude seam wherever a terrain chunk straddles it.
+vec2 sphereUV(vec3 d) {
+    float u = atan(d.z, d.x) / 6.28318531;
+    return vec2(u < 0.0 ? u + 1.0 : u, acos(clamp(d.y, -1.0, 1.0)) / 3.14159265);
+}
+
+const float PALETTE_ROWS = 4.0;
+
+vec3 paletteRamp(float row, float t) {
+    vec2 at = vec2((clamp(t, 0.0, 1.0) * 255.0 + 0.5) / 256.0, (row + 0.5) / PALETTE_ROWS);
+    return texture(uPaletteTex, at).rgb;
+}
+
+vec3 biomeEntry(ivec2 texel, ivec2 size) {
+    texel.x = (texel.x + size.x) % size.x;
+    texel.y = clamp(texel.y, 0, size.y - 1);
+    int index = int(texelFetch(uBiomeTex, texel, 0).r * 255.0 + 0.5);
+    return texelFetch(uPaletteTex, ivec2(index, 0), 0).rgb;
+}
+
+// Bilinear blend of palette colours; filtering the indices themselves
+// would invent biomes between neighbours.
+vec3 biomeColour(vec2 uv) {
+    ivec2 size = textureSize(uBiomeTex, 0);
+    vec2 p = uv * vec2(size) - 0.5;
+    ivec2 i = ivec2(floor(p));
+    vec2 f = fract(p);
+    vec3 a = mix(biomeEntry(i, size), biomeEntry(i + ivec2(1, 0), size), f.x);
+    vec3 b = mix(biomeEntry(i + ivec2(0, 1), size), biomeEntry(i + ivec2(1, 1), size), f.x);
+    return mix(a, b, f.y);
+}
+
+vec3 surfaceColour(vec2 uv) {
+    float elev = texture(uElevationTex, uv).r;
+    if (uMapMode == 1) return paletteRamp(1.0, elev);
+    if (uMapMode == 2) return paletteRamp(2.0, texture(uDataTex, uv).r);
+    if (uMapMode == 3) return paletteRamp(3.0, texture(uDataTex, uv).r);
+    return biomeColour(uv) * (0.82 + 0.18 * elev);
+}
+
 void main() {
+    vec2 vUV = sphereUV(normalize(vDir));
     vec3 N = normalize(vNormal);
     vec3 L = normalize(uLightDir);
     vec3 V = normalize(uCameraPos - vWorldPos);
@@ -116,7 +173,7 @@ void main() {
     vec3 finalN = normalize(mix(N, perturbedN, isLand * 0.7));
 
     // ─── Base colour ───
-    vec3 baseColour = texture(uBiomeTex, vUV).rgb;
+    vec3 baseColour = surfaceColour(vUV);
 
     float noiseVal = noise2D(vUV * 200.0) * 0.06 - 0.03;
     baseColour += vec3(noiseVal) * isLand;
@@ -413,10 +470,12 @@ struct PickResult {
     float u = 0, v = 0;           // UV on sphere [0,1]
     int   grid_x = 0, grid_y = 0; // Grid cell in planet data
     glm::vec3 world_pos{0.0f};
+    EntityID entity;              // Nearest located entity, if any within reach
 };
 
-/// Intersect ray with unit sphere at origin. Returns nearest hit.
-inline PickResult pick_planet(const Camera& camera,
+/// Intersect the cursor ray with the displaced terrain (see TerrainPicker).
+/// UVs are sub-cell; the grid cell is the texel containing them.
+inline PickResult pick_planet(const Camera& camera, const TerrainPicker& picker,
                                double screen_x, double screen_y,
                                int viewport_w, int viewport_h,
                                u32 grid_w, u32 grid_h) {
@@ -425,41 +484,17 @@ inline PickResult pick_planet(const Camera& camera,
     glm::vec3 origin, dir;
     camera.screen_to_ray(screen_x, screen_y, viewport_w, viewport_h, origin, dir);
 
-    // Ray-sphere: |origin + t*dir|^2 = 1
-    float a = glm::dot(dir, dir);
-    float b = 2.0f * glm::dot(origin, dir);
-    float c = glm::dot(origin, origin) - 1.0f;
-    float disc = b * b - 4.0f * a * c;
-
-    if (disc < 0.0f) return result;
-
-    float t = (-b - std::sqrt(disc)) / (2.0f * a);
-    if (t < 0.0f) return result;
+    TerrainPicker::Hit hit = picker.intersect({origin.x, origin.y, origin.z},
+                                              {dir.x, dir.y, dir.z});
+    if (!hit.hit) return result;
 
     result.hit = true;
-    result.world_pos = origin + t * dir;
-
-    // Convert world position to UV (matching sphere mesh generation)
-    glm::vec3 p = glm::normalize(result.world_pos);
-
-    // atan2(z, x) for longitude, asin(y) for latitude
-    float lon = std::atan2(p.z, p.x);             // [-pi, pi]
-    float lat = std::asin(std::clamp(p.y, -1.0f, 1.0f)); // [-pi/2, pi/2]
-
-    // Convert to UV matching SphereMesh (u = sector/sectors, v = stack/stacks)
-    result.u = lon / (2.0f * static_cast<float>(M_PI));
-    if (result.u < 0.0f) result.u += 1.0f;
-
-    result.v = 0.5f - lat / static_cast<float>(M_PI);  // 0 = north pole, 1 = south pole
-
-    result.u = std::clamp(result.u, 0.0f, 1.0f);
-    result.v = std::clamp(result.v, 0.0f, 1.0f);
-
-    result.grid_x = static_cast<int>(result.u * (grid_w - 1));
-    result.grid_y = static_cast<int>(result.v * (grid_h - 1));
+    result.world_pos = glm::vec3(hit.position.x, hit.position.y, hit.position.z);
+    result.u = hit.u;
+    result.v = hit.v;
 
-    result.grid_x = std::clamp(result.grid_x, 0, static_cast<int>(grid_w - 1));
-    result.grid_y = std::clamp(result.grid_y, 0, static_cast<int>(grid_h - 1));
+    result.grid_x = std::min(static_cast<int>(result.u * grid_w), static_cast<int>(grid_w) - 1);
+    result.grid_y = std::min(static_cast<int>(result.v * grid_h), static_cast<int>(grid_h) - 1);
 
     return result;
 }
@@ -470,9 +505,9 @@ inline PickResult pick_planet(const Camera& camera,
 
 /// Apply a gaussian brush to the heightmap centered on (cx, cy).
 /// `strength` is positive to raise, negative to lower.
-/// `radius` is in grid cells.
+/// `radius` is in grid cells. Marks the touched cells in `dirty`.
 inline void terraform_brush(PlanetData& planet, int cx, int cy,
-                             int radius, float strength) {
+                             int radius, float strength, DirtyRegion& dirty) {
     int w = static_cast<int>(planet.width);
     int h = static_cast<int>(planet.height);
     float inv_r2 = 1.0f / (radius * radius);
@@ -494,6 +529,7 @@ inline void terraform_brush(PlanetData& planet, int cx, int cy,
             elev = std::clamp(elev + strength * weight, 0.0f, 1.0f);
         }
     }
+    dirty.add(cx - radius, cy - radius, cx + radius + 1, cy + radius + 1);
 }
 
 // ═══════════════════════════════════════════════════════════════
@@ -502,11 +538,14 @@ inline void terraform_brush(PlanetData& planet, int cx, int cy,
 
 class PlanetRenderer {
 public:
-    void init(PlanetData& planet) {
+    /// `hidden` creates the GL context without showing a window (for capture()).
+    void init(PlanetData& planet, bool hidden = false) {
         LOG_INFO("Initialising planet renderer...");
 
         planet_ = &planet;
-        window_ = std::make_unique<Window>(1280, 720, "God Simulation — " + planet.name);
+        edits_.resize(planet.width, planet.height);
+        window_ = std::make_unique<Window>(1280, 720, "God Simulation — " + planet.name,
+                                           !hidden);
         sea_level_ = planet.sea_level;
 
         // OpenGL state
@@ -525,9 +564,17 @@ public:
         cloud_shader_.compile(CLOUD_VERT, CLOUD_FRAG);
 
         // Create meshes
-        planet_mesh_.create(planet, 200, 400);
-        atmo_mesh_.create(planet, 64, 128);
-        cloud_mesh_.create(planet, 80, 160);
+        planet_mesh_.create_textures(planet);
+        atmo_mesh_.create_geometry(64, 128);
+        cloud_mesh_.create_geometry(80, 160);
+
+        // Terrain LOD: refine until a vertex is about half a map cell apart
+        QuadtreeConfig lod;
+        lod.max_level = TerrainQuadtree::max_level_for(planet.width, lod.chunk_res);
+        lod.max_height = DISPLACEMENT_SCALE * (1.0f - sea_level_);
+        terrain_.create(planet, lod, DISPLACEMENT_SCALE);
+        picker_.build(planet.elevation, planet.sea_level, DISPLACEMENT_SCALE);
+        gpu_timer_.create();
 
         // Fullscreen quad for stars
         create_fullscreen_quad();
@@ -551,6 +598,15 @@ public:
         LOG_INFO("    ESC         : Close");
     }
 
+    /// Located entities to pick under the cursor (see Registry::spatial()).
+    void set_registry(const Registry* registry) { registry_ = registry; }
+
+    /// Region level of detail to steer from the camera each frame.
+    void set_regions(RegionLOD* regions) { regions_ = regions; }
+
+    /// Cells modified by terraforming since init().
+    const DirtyRegion& edits() const { return edits_; }
+
     void run() {
         // Key toggle tracking (for edge detection)
         bool prev_g = false, prev_t = false, prev_c = false;
@@ -558,11 +614,21 @@ public:
         bool prev_1 = false, prev_2 = false, prev_3 = false, prev_4 = false;
         bool prev_b = false;
         bool prev_plus = false, prev_minus = false;
+        auto last_frame = Clock::now();
 
         while (!window_->should_close()) {
             const auto& input = window_->poll();
             if (input.key_escape) break;
 
+            // ─── Frame timing ───
+            auto frame_start = Clock::now();
+            float dt = std::chrono::duration<float>(frame_start - last_frame).count();
+            last_frame = frame_start;
+            sample_ = {};
+            sample_.frame_ms = dt * 1000.0f;
+            dt = std::min(dt, 0.1f); // Don't jump after a stall (window drag, breakpoint)
+            gpu_timer_.begin_frame();
+
             // ─── Toggle keys (edge-triggered) ───
             if (input.key_g && !prev_g) wireframe_ = !wireframe_;
             prev_g = input.key_g;
@@ -608,21 +674,43 @@ public:
             }
             camera_.set_aspect(static_cast<float>(input.width) /
                                std::max(static_cast<float>(input.height), 1.0f));
-            camera_.update(input, 1.0f / 60.0f);
+            camera_.update(input, dt);
 
-            time_ += 1.0f / 60.0f;
+            time_ += dt;
 
             // ─── Planet picking ───
-            pick_ = pick_planet(camera_, input.mouse_x, input.mouse_y,
+            pick_ = pick_planet(camera_, picker_, input.mouse_x, input.mouse_y,
                                 input.width, input.height,
                                 planet_->width, planet_->height);
+            if (registry_ && pick_.hit) {
+                pick_.entity = registry_->spatial().nearest(
+                    pick_.u * planet_->width, pick_.v * planet_->height, ENTITY_PICK_RADIUS);
+            }
+
+            // ─── Resolution on demand: hydrate what the camera sees ───
+            if (regions_) {
+                RegionFocus focus;
+                if (camera_focus(input.width, input.height, focus)) {
+                    regions_->set_focus(FocusSource::Camera, focus);
+                } else {
+                    regions_->clear_focus(FocusSource::Camera);
+                }
+                regions_->update(REGION_BUDGET);
+            }
 
             // ─── Terraforming ───
             if (terraform_mode_ && pick_.hit && input.right_mouse_down) {
                 int radius = brush_radii_[brush_size_idx_];
                 float strength = input.key_shift ? -0.008f : 0.008f;
 
-                terraform_brush(*planet_, pick_.grid_x, pick_.grid_y, radius, strength);
+                DirtyRegion stroke(planet_->width, planet_->height);
+                terraform_brush(*planet_, pick_.grid_x, pick_.grid_y, radius, strength, stroke);
+                // Biomes are reclassified over a margin around the brush
+                stroke.add(pick_.grid_x - radius - 2, pick_.grid_y - radius - 2,
+                           pick_.grid_x + radius + 3, pick_.grid_y + radius + 3);
+                terrain_.invalidate(stroke);
+                picker_.update(stroke);
+                edits_.add(stroke);
 
                 // Reclassify biomes in affected area
                 int w = static_cast<int>(planet_->width);
@@ -644,13 +732,9 @@ public:
                     }
                 }
 
-                // Rebuild textures
-                planet_mesh_.rebuild_textures(*planet_);
-
-                // If in a data mode, re-apply it
-                if (map_mode_ != MapMode::Biome) {
-                    planet_mesh_.set_map_mode(*planet_, map_mode_);
-                }
+                // Stream the edited texels; heatmap modes colour on the GPU,
+                // and temperature/moisture are untouched by terraforming
+                planet_mesh_.update_textures(*planet_, stroke);
 
                 terrain_dirty_ = true;
             }
@@ -659,123 +743,277 @@ public:
             if (terraform_mode_ && pick_.hit && input.right_mouse_down && input.scroll_dy != 0) {
                 int radius = brush_radii_[brush_size_idx_];
                 float strength = static_cast<float>(input.scroll_dy) * 0.02f;
-                terraform_brush(*planet_, pick_.grid_x, pick_.grid_y, radius, strength);
+                DirtyRegion stroke(planet_->width, planet_->height);
+                terraform_brush(*planet_, pick_.grid_x, pick_.grid_y, radius, strength, stroke);
+                terrain_.invalidate(stroke);
+                picker_.update(stroke);
+                edits_.add(stroke);
                 planet_->classify_biomes();
-                planet_mesh_.rebuild_textures(*planet_);
-                if (map_mode_ != MapMode::Biome) {
-                    planet_mesh_.set_map_mode(*planet_, map_mode_);
-                }
+                planet_mesh_.update_textures(*planet_, stroke);
             }
 
             // ─── Update title bar HUD ───
             update_title();
 
             // ─── Render ───
-            gl::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            render_scene(input.height);
+
+            sample_.cpu_ms = ms_since(frame_start);
+            record_frame();
+            window_->swap_buffers();
+        }
 
-            glm::vec3 lightDir = glm::normalize(glm::vec3(0.7f, 0.5f, 0.5f));
+        log_frame_stats();
+    }
 
-            // Pass 1: Stars
-            gl::Disable(GL_DEPTH_TEST);
-            gl::DepthFunc(GL_ALWAYS);
-            {
-                star_shader_.use();
-                glm::mat4 invVP = glm::inverse(camera_.projection() * camera_.view());
-                star_shader_.set_mat4("uInvViewProj", glm::value_ptr(invVP));
+    const FrameStats& frame_stats() const { return frame_stats_; }
 
-                gl::BindVertexArray(quad_vao_);
-                gl::DrawArrays(GL_TRIANGLES, 0, 6);
-                gl::BindVertexArray(0);
+    /// Render the camera path into an offscreen framebuffer and write an
+    /// image sequence. Terrain chunks are fully refined before each frame
+    /// is drawn; encoding overlaps rendering on the FrameSink thread.
+    /// Throws if no framebuffer can be created.
+    CaptureReport capture(const CaptureSettings& settings) {
+        OffscreenTarget target;
+        if (!target.create(settings.width, settings.height)) {
+            throw std::runtime_error("Offscreen framebuffer unavailable");
+        }
+        LOG_INFO("GPU capture: {} frames at {}x{} into {}", settings.frames, settings.width,
+                 settings.height, settings.output_dir);
+
+        target.bind();
+        camera_.set_aspect(static_cast<float>(settings.width) /
+                           std::max(static_cast<float>(settings.height), 1.0f));
+        pick_ = {}; // No cursor highlight
+        int viewport_height = static_cast<int>(settings.height);
+        FrameSink sink(settings);
+        auto start = Clock::now();
+
+        std::vector<u8> rgb;
+        for (u32 i = 0; i < settings.frames; i++) {
+            time_ = i / settings.fps;
+            gpu_timer_.begin_frame();
+            camera_.set_orbit(settings.path.at(time_));
+
+            // Build every chunk the view needs instead of spreading it over frames
+            for (int pass = 0; pass < 64; pass++) {
+                terrain_.update(lod_view(viewport_height));
+                if (terrain_.stats().built == 0) break;
             }
-            gl::Enable(GL_DEPTH_TEST);
-            gl::DepthFunc(GL_LESS);
+            render_scene(viewport_height);
+            target.read_rgb(rgb);
+            sink.submit(i, std::move(rgb));
+        }
+        sink.finish();
+        OffscreenTarget::unbind();
+
+        CaptureReport report;
+        report.frames = settings.frames;
+        report.seconds = std::chrono::duration<f64>(Clock::now() - start).count();
+        LOG_INFO("Captured {} frames in {:.2f} s ({:.1f} fps)", report.frames, report.seconds,
+                 report.fps());
+        return report;
+    }
 
-            // Pass 2: Planet surface
-            if (wireframe_) gl::PolygonMode(GL_FRONT_AND_BACK, GL_LINE);
-            {
-                planet_shader_.use();
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static float ms_since(Clock::time_point start) {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    }
 
-                glm::mat4 model(1.0f);
-                planet_shader_.set_mat4("uModel", glm::value_ptr(model));
-                planet_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
-                planet_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
+    // ─── Performance counters ───
 
-                planet_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
-                planet_shader_.set_vec3("uCameraPos",
-                    camera_.position().x, camera_.position().y, camera_.position().z);
-                planet_shader_.set_float("uSeaLevel", sea_level_);
-                planet_shader_.set_float("uDisplacementScale", 0.035f);
-                planet_shader_.set_float("uTime", time_);
+    void begin_pass(RenderPass pass) {
+        pass_ = pass;
+        pass_start_ = Clock::now();
+        gpu_timer_.begin(pass);
+    }
 
-                // Cursor highlight uniforms
-                if (pick_.hit) {
-                    planet_shader_.set_vec3("uCursorUV", pick_.u, pick_.v, 0.0f);
-                } else {
-                    planet_shader_.set_vec3("uCursorUV", -1.0f, -1.0f, 0.0f);
-                }
+    void end_pass() {
+        gpu_timer_.end();
+        sample_.pass_cpu_ms[static_cast<u32>(pass_)] = ms_since(pass_start_);
+    }
 
-                float brush_uv_radius = static_cast<float>(brush_radii_[brush_size_idx_])
-                                       / static_cast<float>(planet_->width);
-                planet_shader_.set_float("uBrushRadius", brush_uv_radius);
-                planet_shader_.set_int("uTerraformMode", terraform_mode_ ? 1 : 0);
+    void record_frame() {
+        sample_.pass_gpu_ms = gpu_timer_.pass_ms();
+        sample_.gpu_ms = gpu_timer_.total_ms();
 
-                planet_mesh_.bind_textures();
-                planet_shader_.set_int("uBiomeTex", 0);
-                planet_shader_.set_int("uElevationTex", 1);
-                planet_shader_.set_int("uNormalTex", 2);
+        sample_.triangles = terrain_.stats().triangles + atmo_mesh_.triangle_count() + 2;
+        if (show_clouds_) sample_.triangles += cloud_mesh_.triangle_count();
 
-                planet_mesh_.draw();
+        u64 texture_bytes = planet_mesh_.streamer().stats().bytes;
+        sample_.upload_bytes = terrain_.stats().uploaded_bytes + (texture_bytes - texture_bytes_);
+        texture_bytes_ = texture_bytes;
+
+        frame_stats_.record(sample_);
+    }
+
+    /// Percentile summary of the session, logged when the window closes.
+    void log_frame_stats() const {
+        if (frame_stats_.size() == 0) return;
+        auto line = [&](const char* label, auto get) {
+            f32 p50 = frame_stats_.percentile(50.0f, get);
+            if (p50 < 0.0f) {
+                LOG_INFO("  {:<12} n/a", label);
+                return;
             }
-            if (wireframe_) gl::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
-
-            // Pass 3: Clouds (optional)
-            if (show_clouds_) {
-                gl::Enable(GL_BLEND);
-                gl::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-                gl::DepthFunc(GL_LEQUAL);
-                {
-                    cloud_shader_.use();
-
-                    glm::mat4 cloudModel = glm::scale(glm::mat4(1.0f), glm::vec3(1.012f));
-                    cloud_shader_.set_mat4("uModel", glm::value_ptr(cloudModel));
-                    cloud_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
-                    cloud_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
-                    cloud_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
-                    cloud_shader_.set_vec3("uCameraPos",
-                        camera_.position().x, camera_.position().y, camera_.position().z);
-                    cloud_shader_.set_float("uTime", time_);
-
-                    cloud_mesh_.draw();
-                }
+            LOG_INFO("  {:<12} p50 {:6.2f}  p95 {:6.2f}  p99 {:6.2f}  max {:6.2f} ms", label, p50,
+                     frame_stats_.percentile(95.0f, get), frame_stats_.percentile(99.0f, get),
+                     frame_stats_.percentile(100.0f, get));
+        };
+
+        LOG_INFO("Frame timings over the last {} of {} frames:", frame_stats_.size(),
+                 frame_stats_.frames());
+        line("Frame", [](const FrameSample& s) { return s.frame_ms; });
+        line("CPU", [](const FrameSample& s) { return s.cpu_ms; });
+        line("GPU", [](const FrameSample& s) { return s.gpu_ms; });
+        for (u32 i = 0; i < RENDER_PASS_COUNT; i++) {
+            std::string cpu = std::string(render_pass_name(static_cast<RenderPass>(i))) + " CPU";
+            std::string gpu = std::string(render_pass_name(static_cast<RenderPass>(i))) + " GPU";
+            line(cpu.c_str(), [i](const FrameSample& s) { return s.pass_cpu_ms[i]; });
+            line(gpu.c_str(), [i](const FrameSample& s) { return s.pass_gpu_ms[i]; });
+        }
+        LOG_INFO("  Triangles    p50 {:.0f}  p99 {:.0f}",
+                 frame_stats_.percentile(50.0f, [](const FrameSample& s) {
+                     return static_cast<f32>(s.triangles); }),
+                 frame_stats_.percentile(99.0f, [](const FrameSample& s) {
+                     return static_cast<f32>(s.triangles); }));
+        LOG_INFO("  Uploads      {:.1f} MB total", frame_stats_.total_upload_bytes() / 1048576.0);
+    }
+
+    /// Short performance readout for the title bar, averaged over recent frames.
+    void format_perf(char* buf, size_t size) const {
+        constexpr u32 window = 30;
+        f32 frame = frame_stats_.mean_recent(window, [](const FrameSample& s) { return s.frame_ms; });
+        f32 cpu = frame_stats_.mean_recent(window, [](const FrameSample& s) { return s.cpu_ms; });
+        f32 gpu = frame_stats_.mean_recent(window, [](const FrameSample& s) { return s.gpu_ms; });
+        f32 upload = frame_stats_.mean_recent(window, [](const FrameSample& s) {
+            return static_cast<f32>(s.upload_bytes); });
+        f32 tris = frame_stats_.size() ? static_cast<f32>(frame_stats_.recent().triangles) : 0.0f;
+
+        char gpu_text[24] = "n/a";
+        if (gpu >= 0.0f) std::snprintf(gpu_text, sizeof(gpu_text), "%.1f", gpu);
+        std::snprintf(buf, size, "%.1f ms (%.0f fps) CPU %.1f GPU %s | %.2fM tris | up %.0f KB/f",
+                      std::max(frame, 0.0f), frame > 0.0f ? 1000.0f / frame : 0.0f,
+                      std::max(cpu, 0.0f), gpu_text, tris / 1e6f, std::max(upload, 0.0f) / 1024.0f);
+    }
+
+    /// Draw all passes into the bound framebuffer. Camera aspect and
+    /// viewport must already match the target.
+    void render_scene(int viewport_height) {
+        planet_mesh_.stream_textures();
+        gl::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        glm::vec3 lightDir = glm::normalize(glm::vec3(0.7f, 0.5f, 0.5f));
+
+        // Pass 1: Stars
+        begin_pass(RenderPass::Stars);
+        gl::Disable(GL_DEPTH_TEST);
+        gl::DepthFunc(GL_ALWAYS);
+        {
+            star_shader_.use();
+            glm::mat4 invVP = glm::inverse(camera_.projection() * camera_.view());
+            star_shader_.set_mat4("uInvViewProj", glm::value_ptr(invVP));
+
+            gl::BindVertexArray(quad_vao_);
+            gl::DrawArrays(GL_TRIANGLES, 0, 6);
+            gl::BindVertexArray(0);
+        }
+        gl::Enable(GL_DEPTH_TEST);
+        gl::DepthFunc(GL_LESS);
+        end_pass();
+
+        // Pass 2: Planet surface
+        begin_pass(RenderPass::Planet);
+        if (wireframe_) gl::PolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+        {
+            planet_shader_.use();
+
+            glm::mat4 model(1.0f);
+            planet_shader_.set_mat4("uModel", glm::value_ptr(model));
+            planet_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
+            planet_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
+
+            planet_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
+            planet_shader_.set_vec3("uCameraPos",
+                camera_.position().x, camera_.position().y, camera_.position().z);
+            planet_shader_.set_float("uSeaLevel", sea_level_);
+            planet_shader_.set_float("uTime", time_);
+
+            // Cursor highlight uniforms
+            if (pick_.hit) {
+                planet_shader_.set_vec3("uCursorUV", pick_.u, pick_.v, 0.0f);
+            } else {
+                planet_shader_.set_vec3("uCursorUV", -1.0f, -1.0f, 0.0f);
             }
 
-            // Pass 4: Atmosphere
+            float brush_uv_radius = static_cast<float>(brush_radii_[brush_size_idx_])
+                                   / static_cast<float>(planet_->width);
+            planet_shader_.set_float("uBrushRadius", brush_uv_radius);
+            planet_shader_.set_int("uTerraformMode", terraform_mode_ ? 1 : 0);
+
+            planet_mesh_.bind_textures();
+            planet_shader_.set_int("uBiomeTex", 0);
+            planet_shader_.set_int("uElevationTex", 1);
+            planet_shader_.set_int("uNormalTex", 2);
+            planet_shader_.set_int("uDataTex", 3);
+            planet_shader_.set_int("uPaletteTex", 4);
+            planet_shader_.set_int("uMapMode", static_cast<int>(map_mode_));
+
+            terrain_.update(lod_view(viewport_height));
+            terrain_.draw(planet_shader_);
+        }
+        if (wireframe_) gl::PolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+        end_pass();
+
+        // Pass 3: Clouds (optional)
+        if (show_clouds_) {
+            begin_pass(RenderPass::Clouds);
             gl::Enable(GL_BLEND);
             gl::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
             gl::DepthFunc(GL_LEQUAL);
-            gl::CullFace(GL_FRONT);
             {
-                atmo_shader_.use();
-
-                glm::mat4 atmoModel = glm::scale(glm::mat4(1.0f), glm::vec3(1.06f));
-                atmo_shader_.set_mat4("uModel", glm::value_ptr(atmoModel));
-                atmo_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
-                atmo_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
-                atmo_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
-                atmo_shader_.set_vec3("uCameraPos",
+                cloud_shader_.use();
+
+                glm::mat4 cloudModel = glm::scale(glm::mat4(1.0f), glm::vec3(1.012f));
+                cloud_shader_.set_mat4("uModel", glm::value_ptr(cloudModel));
+                cloud_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
+                cloud_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
+                cloud_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
+                cloud_shader_.set_vec3("uCameraPos",
                     camera_.position().x, camera_.position().y, camera_.position().z);
+                cloud_shader_.set_float("uTime", time_);
 
-                atmo_mesh_.draw();
+                cloud_mesh_.draw();
             }
-            gl::CullFace(GL_BACK);
-            gl::Disable(GL_BLEND);
-            gl::DepthFunc(GL_LESS);
+            end_pass();
+        }
 
-            window_->swap_buffers();
+        // Pass 4: Atmosphere
+        begin_pass(RenderPass::Atmosphere);
+        gl::Enable(GL_BLEND);
+        gl::BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        gl::DepthFunc(GL_LEQUAL);
+        gl::CullFace(GL_FRONT);
+        {
+            atmo_shader_.use();
+
+            glm::mat4 atmoModel = glm::scale(glm::mat4(1.0f), glm::vec3(1.06f));
+            atmo_shader_.set_mat4("uModel", glm::value_ptr(atmoModel));
+            atmo_shader_.set_mat4("uView", glm::value_ptr(camera_.view()));
+            atmo_shader_.set_mat4("uProjection", glm::value_ptr(camera_.projection()));
+            atmo_shader_.set_vec3("uLightDir", lightDir.x, lightDir.y, lightDir.z);
+            atmo_shader_.set_vec3("uCameraPos",
+                camera_.position().x, camera_.position().y, camera_.position().z);
+
+            atmo_mesh_.draw();
         }
+        gl::CullFace(GL_BACK);
+        gl::Disable(GL_BLEND);
+        gl::DepthFunc(GL_LESS);
+        end_pass();
     }
 
-private:
     void set_map_mode(MapMode mode) {
         if (mode == map_mode_) return;
         map_mode_ = mode;
@@ -788,7 +1026,9 @@ private:
         if (++frame_counter < 10) return; // Update every 10 frames
         frame_counter = 0;
 
-        char buf[256];
+        char buf[384];
+        char perf[128];
+        format_perf(perf, sizeof(perf));
 
         // Sim speed names
         static const char* speed_names[] = {"0.5x", "1x", "2x", "5x", "10x", "50x"};
@@ -812,27 +1052,63 @@ private:
             float lat_deg = (0.5f - pick_.v) * 180.0f;
             float lon_deg = (pick_.u - 0.5f) * 360.0f;
 
+            char entity[64] = "";
+            if (pick_.entity.is_valid()) {
+                std::snprintf(entity, sizeof(entity), " | %s #%llu",
+                              layer_name(pick_.entity.layer()).c_str(),
+                              static_cast<unsigned long long>(pick_.entity.id()));
+            }
+
             std::snprintf(buf, sizeof(buf),
                 "God Sim | %s | Elev: %.2f | %.0f°C | Moist: %.2f | "
-                "Lat: %.1f° Lon: %.1f° | Mode: %s | %s%s%s",
+                "Lat: %.1f° Lon: %.1f°%s | Mode: %s | %s%s%s | %s",
                 info.name, elev, temp, moist,
-                lat_deg, lon_deg,
+                lat_deg, lon_deg, entity,
                 map_mode_name(map_mode_),
                 sim_paused_ ? "PAUSED" : speed_names[sim_speed_idx_],
                 terraform_mode_ ? " | TERRAFORM" : "",
-                show_clouds_ ? "" : " | Clouds OFF");
+                show_clouds_ ? "" : " | Clouds OFF", perf);
         } else {
             std::snprintf(buf, sizeof(buf),
-                "God Sim | Mode: %s | %s%s%s",
+                "God Sim | Mode: %s | %s%s%s | %s",
                 map_mode_name(map_mode_),
                 sim_paused_ ? "PAUSED" : speed_names[sim_speed_idx_],
                 terraform_mode_ ? " | TERRAFORM" : "",
-                show_clouds_ ? "" : " | Clouds OFF");
+                show_clouds_ ? "" : " | Clouds OFF", perf);
         }
 
         window_->set_title(buf);
     }
 
+    /// The patch of planet in view, in grid cells: centred under the middle
+    /// of the screen, out to the horizon or the edge of the view, whichever
+    /// is nearer. False if the planet isn't under the centre.
+    bool camera_focus(int viewport_w, int viewport_h, RegionFocus& focus) const {
+        PickResult centre = pick_planet(camera_, picker_, viewport_w * 0.5, viewport_h * 0.5,
+                                        viewport_w, viewport_h, planet_->width, planet_->height);
+        if (!centre.hit) return false;
+        float distance = camera_.distance();
+        float aspect = static_cast<float>(viewport_w) / std::max(static_cast<float>(viewport_h), 1.0f);
+        float horizon = std::acos(std::min(1.0f / distance, 1.0f));
+        float view = (distance - 1.0f) * std::tan(glm::radians(camera_.fov()) * 0.5f) * std::max(aspect, 1.0f);
+        focus.x = static_cast<float>(centre.grid_x) + 0.5f;
+        focus.y = static_cast<float>(centre.grid_y) + 0.5f;
+        focus.radius = std::min(horizon, view) * static_cast<float>(planet_->width) / static_cast<float>(2.0 * M_PI);
+        return true;
+    }
+
+    /// Camera state for terrain chunk selection.
+    LodView lod_view(int viewport_height) const {
+        LodView view;
+        const glm::vec3& eye = camera_.position();
+        view.eye = {eye.x, eye.y, eye.z};
+        glm::mat4 vp = camera_.projection() * camera_.view();
+        std::copy(glm::value_ptr(vp), glm::value_ptr(vp) + 16, view.view_proj.begin());
+        view.viewport_height = static_cast<float>(std::max(viewport_height, 1));
+        view.fov_y = glm::radians(camera_.fov());
+        return view;
+    }
+
     void create_fullscreen_quad() {
         float quad[] = {
             -1.0f, -1.0f, 0.0f,
@@ -858,19 +1134,29 @@ private:
     std::unique_ptr<Window> window_;
     Camera camera_;
     ShaderProgram planet_shader_, atmo_shader_, star_shader_, cloud_shader_;
-    SphereMesh planet_mesh_, atmo_mesh_, cloud_mesh_;
+    SphereMesh planet_mesh_, atmo_mesh_, cloud_mesh_; // planet_mesh_ holds the surface textures
+    ChunkedSphereMesh terrain_;
+    TerrainPicker picker_;
+    GpuTimer gpu_timer_;
     GLuint quad_vao_ = 0, quad_vbo_ = 0;
     float sea_level_ = 0.4f;
     float time_ = 0.0f;
 
     // Picking
+    static constexpr float ENTITY_PICK_RADIUS = 3.0f; // Cells
     PickResult pick_;
+    const Registry* registry_ = nullptr;
+
+    // Region level of detail
+    static constexpr u32 REGION_BUDGET = RegionLOD::DEFAULT_BUDGET; // Transitions per frame
+    RegionLOD* regions_ = nullptr;
 
     // Terraforming
     bool terraform_mode_ = false;
     int brush_size_idx_ = 1; // Default: 8-cell radius
     std::array<int, 4> brush_radii_ = {4, 8, 16, 32};
     bool terrain_dirty_ = false;
+    DirtyRegion edits_; // Cells changed by terraforming since init()
 
     // Map modes
     MapMode map_mode_ = MapMode::Biome;
@@ -882,6 +1168,13 @@ private:
     // Simulation time
     bool sim_paused_ = true;
     int sim_speed_idx_ = 1; // Index into speed_names
+
+    // Performance counters
+    FrameStats frame_stats_;
+    FrameSample sample_;           // Frame being measured
+    RenderPass pass_ = RenderPass::Stars;
+    Clock::time_point pass_start_;
+    u64 texture_bytes_ = 0;        // Streamer byte count at the last frame
 };
 
 } // namespace godsim
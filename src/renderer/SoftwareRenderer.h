@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CameraPath.h"
+#include "TerrainVertex.h"
+#include "layers/planetary/Biome.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/util/Parallel.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+/// Pinhole camera matching Camera: orbiting the origin, looking at it,
+/// +Y up, vertical field of view in degrees.
+struct ViewRays {
+    Vec3f eye, forward, right, up;
+    f32 tan_half_fov = 0.0f;
+    f32 aspect = 1.0f;
+
+    ViewRays(const OrbitPose& pose, f32 fov_deg, f32 aspect_ratio) : aspect(aspect_ratio) {
+        eye = {pose.distance * std::cos(pose.pitch) * std::sin(pose.yaw),
+               pose.distance * std::sin(pose.pitch),
+               pose.distance * std::cos(pose.pitch) * std::cos(pose.yaw)};
+        forward = (eye * -1.0f).normalized();
+        right = cross(forward, {0.0f, 1.0f, 0.0f}).normalized();
+        up = cross(right, forward);
+        tan_half_fov = std::tan(fov_deg * 0.5f * 3.14159265359f / 180.0f);
+    }
+
+    /// Direction through the centre of pixel (x, y); y = 0 is the top row.
+    Vec3f ray(u32 x, u32 y, u32 width, u32 height) const {
+        f32 ndc_x = (2.0f * (x + 0.5f)) / width - 1.0f;
+        f32 ndc_y = 1.0f - (2.0f * (y + 0.5f)) / height;
+        return (forward + right * (ndc_x * tan_half_fov * aspect) + up * (ndc_y * tan_half_fov))
+            .normalized();
+    }
+
+    static Vec3f cross(const Vec3f& a, const Vec3f& b) {
+        return {a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    }
+};
+
+/// Distance along a unit ray to the sphere of `radius` at the origin:
+/// the near hit if `near`, else the far one. Negative on a miss.
+inline f32 ray_sphere(const Vec3f& origin, const Vec3f& dir, f32 radius, bool near = true) {
+    f32 b = origin.dot(dir);
+    f32 c = origin.dot(origin) - radius * radius;
+    f32 disc = b * b - c;
+    if (disc < 0.0f) return -1.0f;
+    f32 s = std::sqrt(disc);
+    return near ? -b - s : -b + s;
+}
+
+/// CPU fallback for offline capture when no GL context can be created.
+/// Ray-casts the undisplaced sphere per pixel and shades it like the
+/// biome map mode of PLANET_FRAG (biome colour, ocean depth, diffuse and
+/// ocean specular) with the atmosphere rim of ATMO_FRAG. Stars, clouds
+/// and normal mapping are left out.
+class SoftwareRenderer {
+public:
+    explicit SoftwareRenderer(const PlanetData& planet)
+        : planet_(planet), baker_(planet.elevation, planet.sea_level, 0.0f) {}
+
+    /// Render one RGB8 frame, rows top to bottom.
+    void render(const OrbitPose& pose, f32 fov_deg, u32 width, u32 height,
+                std::vector<u8>& rgb) const {
+        rgb.assign(static_cast<size_t>(width) * height * 3, 0);
+        ViewRays view(pose, fov_deg, static_cast<f32>(width) / std::max(height, 1u));
+        parallel_for(0, height, [&](u32 y0, u32 y1) {
+            for (u32 y = y0; y < y1; y++) {
+                u8* row = rgb.data() + static_cast<size_t>(y) * width * 3;
+                for (u32 x = 0; x < width; x++) {
+                    Vec3f c = shade(view.eye, view.ray(x, y, width, height));
+                    row[x * 3 + 0] = to_byte(c.x);
+                    row[x * 3 + 1] = to_byte(c.y);
+                    row[x * 3 + 2] = to_byte(c.z);
+                }
+            }
+        }, 16);
+    }
+
+private:
+    static constexpr f32 ATMOSPHERE_RADIUS = 1.06f;
+
+    static u8 to_byte(f32 c) { return static_cast<u8>(std::clamp(c, 0.0f, 1.0f) * 255.0f + 0.5f); }
+
+    static f32 smoothstep(f32 e0, f32 e1, f32 x) {
+        f32 t = std::clamp((x - e0) / (e1 - e0), 0.0f, 1.0f);
+        return t * t * (3.0f - 2.0f * t);
+    }
+
+    static Vec3f mix(const Vec3f& a, const Vec3f& b, f32 t) { return a + (b - a) * t; }
+
+    static Vec3f light_dir() { return Vec3f{0.7f, 0.5f, 0.5f}.normalized(); }
+
+    Vec3f shade(const Vec3f& eye, const Vec3f& dir) const {
+        f32 t = ray_sphere(eye, dir, 1.0f);
+        if (t > 0.0f) return surface(eye + dir * t, dir);
+
+        // Rim of the atmosphere shell seen past the limb (back faces only)
+        f32 far = ray_sphere(eye, dir, ATMOSPHERE_RADIUS, false);
+        if (far <= 0.0f) return {};
+        Vec3f n = (eye + dir * far).normalized();
+        f32 n_dot_l = n.dot(light_dir());
+        f32 lit_side = smoothstep(-0.2f, 0.6f, n_dot_l);
+        Vec3f atmo{0.25f, 0.45f, 0.85f};
+        Vec3f tint = mix(Vec3f{0.6f, 0.25f, 0.1f}, atmo, smoothstep(-0.1f, 0.1f, n_dot_l));
+        f32 alpha = lit_side * 0.55f + 0.2f; // rim = 1 on back faces
+        return mix(tint, atmo, 0.7f) * alpha;
+    }
+
+    Vec3f surface(const Vec3f& hit, const Vec3f& ray) const {
+        Vec3f n = hit.normalized();
+        f32 u, v;
+        sphere_uv(n, u, v);
+        f32 elev = baker_.elevation_at(n);
+        f32 sea = planet_.sea_level;
+
+        Vec3f base;
+        bool ocean = elev < sea;
+        if (ocean) {
+            f32 depth = (sea - elev) / std::max(sea, 1e-6f);
+            base = mix(Vec3f{0.12f, 0.30f, 0.45f}, Vec3f{0.04f, 0.10f, 0.22f},
+                       smoothstep(0.0f, 0.6f, depth));
+        } else {
+            u32 bx = std::min(static_cast<u32>(u * planet_.width), planet_.width - 1);
+            u32 by = std::min(static_cast<u32>(v * planet_.height), planet_.height - 1);
+            const auto& info = BIOME_INFO[static_cast<size_t>(
+                planet_.biome_map[static_cast<size_t>(by) * planet_.width + bx])];
+            base = Vec3f{info.r / 255.0f, info.g / 255.0f, info.b / 255.0f} *
+                   (0.82f + 0.18f * elev);
+        }
+
+        Vec3f l = light_dir();
+        f32 n_dot_l = n.dot(l);
+        f32 diffuse = std::max(0.0f, n_dot_l * 0.6f + 0.4f) * 0.7f;
+        Vec3f colour = base * (0.08f + diffuse); // Ambient folded in (its tint is ~neutral)
+        if (ocean && n_dot_l > 0.0f) {
+            Vec3f h = (l - ray).normalized();
+            f32 spec = std::pow(std::max(n.dot(h), 0.0f), 64.0f) * 0.8f * n_dot_l;
+            colour = colour + Vec3f{1.0f, 0.97f, 0.9f} * spec;
+        }
+        return colour;
+    }
+
+    const PlanetData& planet_;
+    TerrainBaker baker_;
+};
+
+} // namespace godsim
@@ -1,10 +1,15 @@
 #pragma once
 
 #include "GL33Loader.h"
+#include "MapPalette.h"
+#include "TexelPacking.h"
+#include "TextureStreamer.h"
 #include "layers/planetary/PlanetData.h"
 #include "layers/planetary/Biome.h"
+#include "core/util/Parallel.h"
 #include "core/util/Types.h"
 
+#include <memory>
 #include <vector>
 #include <cmath>
 #include <algorithm>
@@ -46,6 +51,12 @@ class SphereMesh {
 public:
     /// Create sphere and upload biome/elevation/normal textures to GPU.
     void create(const PlanetData& planet, int stacks = 200, int sectors = 400) {
+        create_geometry(stacks, sectors);
+        create_textures(planet);
+    }
+
+    /// Build only the UV sphere (atmosphere and cloud shells need no textures).
+    void create_geometry(int stacks, int sectors) {
         std::vector<Vertex> vertices;
         std::vector<u32> indices;
 
@@ -112,67 +123,128 @@ public:
         gl::VertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, u));
         gl::EnableVertexAttribArray(2);
         gl::BindVertexArray(0);
+    }
+
+    /// Upload the surface textures only; the terrain itself is drawn by
+    /// ChunkedSphereMesh. Planet data goes up as single-channel texels
+    /// (biome R8 index, elevation R16) and is coloured through the palette
+    /// texture in PLANET_FRAG. Later updates stream through PBOs.
+    void create_textures(const PlanetData& planet) {
+        gl::PixelStorei(GL_UNPACK_ALIGNMENT, 1); // R8/R16 rows need not be 4-byte multiples
+        u32 w = planet.width, h = planet.height;
+        CellRect all{0, 0, w, h};
+        size_t cells = static_cast<size_t>(w) * h;
+
+        std::vector<u8> bytes(cells);
+        pack_biome_indices(whole_grid(planet.biome_map.data(), w, h), all, bytes.data());
+        biome_tex_ = create_texture(w, h, GL_R8, GL_RED, GL_UNSIGNED_BYTE, bytes.data(), GL_NEAREST);
+
+        std::vector<u16> shorts(cells);
+        auto elevation = whole_grid(planet.elevation.data_ptr(), w, h);
+        pack_unorm16(elevation, all, 0.0f, 1.0f, shorts.data());
+        elevation_tex_ = create_texture(w, h, GL_R16, GL_RED, GL_UNSIGNED_SHORT,
+                                        shorts.data(), GL_LINEAR);
+
+        // Heatmap field for the temperature/moisture modes; filled on demand
+        data_tex_ = create_texture(w, h, GL_R16, GL_RED, GL_UNSIGNED_SHORT, nullptr, GL_LINEAR);
+
+        bytes.resize(cells * 3);
+        pack_normals(elevation, all, w, h, bytes.data());
+        normal_tex_ = create_texture(w, h, GL_RGB, GL_RGB, GL_UNSIGNED_BYTE, bytes.data(), GL_LINEAR);
+
+        std::vector<u8> palette;
+        build_map_palette(planet.sea_level, palette);
+        palette_tex_ = create_texture(PALETTE_WIDTH, PALETTE_ROWS, GL_RGB, GL_RGB,
+                                      GL_UNSIGNED_BYTE, palette.data(), GL_LINEAR);
 
-        create_biome_texture(planet);
-        create_elevation_texture(planet);
-        create_normal_texture(planet);
+        streamer_.create();
     }
 
+    /// Texture units: 0 biome index, 1 elevation, 2 normals, 3 heatmap field, 4 palette.
     void bind_textures() const {
+        GLuint textures[] = {biome_tex_, elevation_tex_, normal_tex_, data_tex_, palette_tex_};
+        for (u32 i = 0; i < 5; i++) {
+            gl::ActiveTexture(GL_TEXTURE0 + i);
+            gl::BindTexture(GL_TEXTURE_2D, textures[i]);
+        }
         gl::ActiveTexture(GL_TEXTURE0);
-        gl::BindTexture(GL_TEXTURE_2D, biome_tex_);
-        gl::ActiveTexture(GL_TEXTURE0 + 1);
-        gl::BindTexture(GL_TEXTURE_2D, elevation_tex_);
-        gl::ActiveTexture(GL_TEXTURE0 + 2);
-        gl::BindTexture(GL_TEXTURE_2D, normal_tex_);
     }
 
+    u32 triangle_count() const { return index_count_ / 3; }
+
     void draw() const {
         gl::BindVertexArray(vao_);
         gl::DrawElements(GL_TRIANGLES, index_count_, GL_UNSIGNED_INT, nullptr);
         gl::BindVertexArray(0);
     }
 
-    /// Rebuild all textures after terrain modification.
-    void rebuild_textures(const PlanetData& planet) {
-        rebuild_biome_texture(planet);
-        rebuild_elevation_texture(planet);
-        rebuild_normal_texture(planet);
-    }
-
-    /// Swap the biome texture to show a different data visualisation.
-    void set_map_mode(const PlanetData& planet, MapMode mode) {
+    /// Queue texture updates for cells changed by a terrain edit. The
+    /// touched cells are copied now (cheap: edits are local) and packed into
+    /// PBOs on the upload worker; stream_textures() lands them.
+    void update_textures(const PlanetData& planet, const DirtyRegion& edit) {
         u32 w = planet.width, h = planet.height;
-        std::vector<u8> pixels(w * h * 3);
-
-        switch (mode) {
-        case MapMode::Biome:
-            generate_biome_pixels(planet, pixels);
-            break;
-        case MapMode::Elevation:
-            generate_elevation_heatmap(planet, pixels);
-            break;
-        case MapMode::Temperature:
-            generate_temperature_heatmap(planet, pixels);
-            break;
-        case MapMode::Moisture:
-            generate_moisture_heatmap(planet, pixels);
-            break;
-        default:
-            generate_biome_pixels(planet, pixels);
-            break;
+        for (const auto& rect : edit.rects()) {
+            // Normals read their neighbours, so one more ring changes
+            CellRect normal_rect = rect.expanded(1, w, h);
+            auto elevation = std::make_shared<GridWindow<f32>>(
+                copy_window(planet.elevation.data_ptr(), w, normal_rect.expanded(1, w, h)));
+            auto biomes = std::make_shared<GridWindow<BiomeType>>(
+                copy_window(planet.biome_map.data(), w, rect));
+
+            streamer_.submit(biome_tex_, GL_RED, GL_UNSIGNED_BYTE, 1, rect,
+                [biomes, rect](u8* out) { pack_biome_indices(biomes->view(), rect, out); });
+            streamer_.submit(elevation_tex_, GL_RED, GL_UNSIGNED_SHORT, 2, rect,
+                [elevation, rect](u8* out) {
+                    pack_unorm16(elevation->view(), rect, 0.0f, 1.0f, reinterpret_cast<u16*>(out));
+                });
+            streamer_.submit(normal_tex_, GL_RGB, GL_UNSIGNED_BYTE, 3, normal_rect,
+                [elevation, normal_rect, w, h](u8* out) {
+                    pack_normals(elevation->view(), normal_rect, w, h, out);
+                });
         }
+    }
 
-        gl::BindTexture(GL_TEXTURE_2D, biome_tex_);
-        gl::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
+    /// Prepare the heatmap field for a map mode. Biome and elevation read
+    /// their own textures; temperature and moisture stream one R16 field,
+    /// packed on the upload worker. PLANET_FRAG picks the palette row from
+    /// uMapMode. The worker reads the live grids: the renderer never writes
+    /// temperature or moisture.
+    void set_map_mode(const PlanetData& planet, MapMode mode) {
+        const Heightmap* field = nullptr;
+        if (mode == MapMode::Temperature) field = &planet.temperature;
+        if (mode == MapMode::Moisture) field = &planet.moisture;
+        if (!field) return;
+
+        CellRect all{0, 0, planet.width, planet.height};
+        bool normalise = mode == MapMode::Temperature;
+        streamer_.submit(data_tex_, GL_RED, GL_UNSIGNED_SHORT, 2, all,
+            [field, all, normalise](u8* out) {
+                f32 lo = 0.0f, hi = 1.0f;
+                if (normalise) {
+                    lo = field->min_value();
+                    hi = std::max(field->max_value(), lo + 1.0f);
+                }
+                auto* texels = reinterpret_cast<u16*>(out);
+                auto src = whole_grid(field->data_ptr(), all.x1, all.y1);
+                parallel_for(all.y0, all.y1, [&](u32 y0, u32 y1) {
+                    CellRect band{all.x0, y0, all.x1, y1};
+                    pack_unorm16(src, band, lo, hi, texels + static_cast<size_t>(y0) * all.x1);
+                }, 64);
+            });
     }
 
+    /// Land finished texture uploads; call once per frame on the GL thread.
+    void stream_textures() { streamer_.poll(); }
+
+    const TextureStreamer& streamer() const { return streamer_; }
+
     ~SphereMesh() {
+        streamer_.destroy(); // Drain the worker before its textures go
         if (vao_) gl::DeleteVertexArrays(1, &vao_);
         if (vbo_) gl::DeleteBuffers(1, &vbo_);
         if (ebo_) gl::DeleteBuffers(1, &ebo_);
-        GLuint textures[] = {biome_tex_, elevation_tex_, normal_tex_};
-        if (biome_tex_) gl::DeleteTextures(3, textures);
+        GLuint textures[] = {biome_tex_, elevation_tex_, normal_tex_, data_tex_, palette_tex_};
+        if (biome_tex_) gl::DeleteTextures(5, textures);
     }
 
     SphereMesh() = default;
@@ -180,225 +252,24 @@ public:
     SphereMesh& operator=(const SphereMesh&) = delete;
 
 private:
-    // ─── Pixel generators for map modes ───
-
-    void generate_biome_pixels(const PlanetData& planet, std::vector<u8>& pixels) {
-        u32 w = planet.width, h = planet.height;
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                BiomeType biome = planet.biome_at(x, y);
-                const auto& info = BIOME_INFO[static_cast<size_t>(biome)];
-                size_t idx = (y * w + x) * 3;
-                float elev = planet.elevation.get(x, y);
-                float shade = 0.82f + 0.18f * elev;
-                pixels[idx + 0] = static_cast<u8>(std::min(255.0f, info.r * shade));
-                pixels[idx + 1] = static_cast<u8>(std::min(255.0f, info.g * shade));
-                pixels[idx + 2] = static_cast<u8>(std::min(255.0f, info.b * shade));
-            }
-        }
-    }
-
-    void generate_elevation_heatmap(const PlanetData& planet, std::vector<u8>& pixels) {
-        u32 w = planet.width, h = planet.height;
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                float e = planet.elevation.get(x, y);
-                size_t idx = (y * w + x) * 3;
-
-                if (e < planet.sea_level) {
-                    // Ocean: dark blue → blue
-                    float t = e / planet.sea_level;
-                    pixels[idx + 0] = static_cast<u8>(10 + 30 * t);
-                    pixels[idx + 1] = static_cast<u8>(20 + 60 * t);
-                    pixels[idx + 2] = static_cast<u8>(80 + 100 * t);
-                } else {
-                    // Land: green → yellow → white
-                    float t = (e - planet.sea_level) / (1.0f - planet.sea_level);
-                    if (t < 0.5f) {
-                        float s = t * 2.0f;
-                        pixels[idx + 0] = static_cast<u8>(40 + 180 * s);
-                        pixels[idx + 1] = static_cast<u8>(140 + 80 * s);
-                        pixels[idx + 2] = static_cast<u8>(40);
-                    } else {
-                        float s = (t - 0.5f) * 2.0f;
-                        pixels[idx + 0] = static_cast<u8>(220 + 35 * s);
-                        pixels[idx + 1] = static_cast<u8>(220 + 35 * s);
-                        pixels[idx + 2] = static_cast<u8>(40 + 215 * s);
-                    }
-                }
-            }
-        }
-    }
-
-    void generate_temperature_heatmap(const PlanetData& planet, std::vector<u8>& pixels) {
-        u32 w = planet.width, h = planet.height;
-        float tmin = planet.temperature.min_value();
-        float tmax = planet.temperature.max_value();
-        float range = std::max(tmax - tmin, 1.0f);
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                float t = (planet.temperature.get(x, y) - tmin) / range; // 0..1
-                size_t idx = (y * w + x) * 3;
-
-                // Blue → cyan → green → yellow → red
-                if (t < 0.25f) {
-                    float s = t * 4.0f;
-                    pixels[idx + 0] = 0;
-                    pixels[idx + 1] = static_cast<u8>(50 * s);
-                    pixels[idx + 2] = static_cast<u8>(180 + 50 * s);
-                } else if (t < 0.5f) {
-                    float s = (t - 0.25f) * 4.0f;
-                    pixels[idx + 0] = static_cast<u8>(30 * s);
-                    pixels[idx + 1] = static_cast<u8>(50 + 170 * s);
-                    pixels[idx + 2] = static_cast<u8>(230 - 180 * s);
-                } else if (t < 0.75f) {
-                    float s = (t - 0.5f) * 4.0f;
-                    pixels[idx + 0] = static_cast<u8>(30 + 210 * s);
-                    pixels[idx + 1] = static_cast<u8>(220 - 20 * s);
-                    pixels[idx + 2] = static_cast<u8>(50 - 30 * s);
-                } else {
-                    float s = (t - 0.75f) * 4.0f;
-                    pixels[idx + 0] = static_cast<u8>(240);
-                    pixels[idx + 1] = static_cast<u8>(200 - 170 * s);
-                    pixels[idx + 2] = static_cast<u8>(20);
-                }
-            }
-        }
-    }
-
-    void generate_moisture_heatmap(const PlanetData& planet, std::vector<u8>& pixels) {
-        u32 w = planet.width, h = planet.height;
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                float m = std::clamp(planet.moisture.get(x, y), 0.0f, 1.0f);
-                size_t idx = (y * w + x) * 3;
-
-                // Brown (dry) → green → teal (wet)
-                if (m < 0.5f) {
-                    float s = m * 2.0f;
-                    pixels[idx + 0] = static_cast<u8>(180 - 140 * s);
-                    pixels[idx + 1] = static_cast<u8>(140 - 40 * s + 80 * s);
-                    pixels[idx + 2] = static_cast<u8>(60 - 20 * s);
-                } else {
-                    float s = (m - 0.5f) * 2.0f;
-                    pixels[idx + 0] = static_cast<u8>(40 - 20 * s);
-                    pixels[idx + 1] = static_cast<u8>(180 - 20 * s);
-                    pixels[idx + 2] = static_cast<u8>(40 + 140 * s);
-                }
-            }
-        }
-    }
-
-    // ─── Texture creation ───
-
-    void create_biome_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> pixels(w * h * 3);
-        generate_biome_pixels(planet, pixels);
-
-        gl::GenTextures(1, &biome_tex_);
-        gl::BindTexture(GL_TEXTURE_2D, biome_tex_);
-        gl::TexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    static GLuint create_texture(u32 w, u32 h, GLint internal_format, GLenum format,
+                                 GLenum type, const void* pixels, GLint filter) {
+        GLuint tex = 0;
+        gl::GenTextures(1, &tex);
+        gl::BindTexture(GL_TEXTURE_2D, tex);
+        gl::TexImage2D(GL_TEXTURE_2D, 0, internal_format, w, h, 0, format, type, pixels);
+        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
         gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
         gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    }
-
-    void create_elevation_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> rgb(w * h * 3);
-        fill_elevation_rgb(planet, rgb);
-
-        gl::GenTextures(1, &elevation_tex_);
-        gl::BindTexture(GL_TEXTURE_2D, elevation_tex_);
-        gl::TexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, rgb.data());
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    }
-
-    void create_normal_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> pixels(w * h * 3);
-        fill_normal_rgb(planet, pixels);
-
-        gl::GenTextures(1, &normal_tex_);
-        gl::BindTexture(GL_TEXTURE_2D, normal_tex_);
-        gl::TexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        gl::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    }
-
-    // ─── Texture rebuilds (reupload) ───
-
-    void rebuild_biome_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> pixels(w * h * 3);
-        generate_biome_pixels(planet, pixels);
-        gl::BindTexture(GL_TEXTURE_2D, biome_tex_);
-        gl::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
-    }
-
-    void rebuild_elevation_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> rgb(w * h * 3);
-        fill_elevation_rgb(planet, rgb);
-        gl::BindTexture(GL_TEXTURE_2D, elevation_tex_);
-        gl::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, rgb.data());
-    }
-
-    void rebuild_normal_texture(const PlanetData& planet) {
-        u32 w = planet.width, h = planet.height;
-        std::vector<u8> pixels(w * h * 3);
-        fill_normal_rgb(planet, pixels);
-        gl::BindTexture(GL_TEXTURE_2D, normal_tex_);
-        gl::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, w, h, GL_RGB, GL_UNSIGNED_BYTE, pixels.data());
-    }
-
-    // ─── Helpers ───
-
-    static void fill_elevation_rgb(const PlanetData& planet, std::vector<u8>& rgb) {
-        u32 w = planet.width, h = planet.height;
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                u8 v = static_cast<u8>(std::clamp(planet.elevation.get(x, y), 0.0f, 1.0f) * 255.0f);
-                size_t idx = (y * w + x) * 3;
-                rgb[idx] = rgb[idx + 1] = rgb[idx + 2] = v;
-            }
-        }
-    }
-
-    static void fill_normal_rgb(const PlanetData& planet, std::vector<u8>& pixels) {
-        u32 w = planet.width, h = planet.height;
-        float strength = 4.0f;
-
-        for (u32 y = 0; y < h; y++) {
-            for (u32 x = 0; x < w; x++) {
-                u32 xl = (x > 0) ? x - 1 : x;
-                u32 xr = (x < w - 1) ? x + 1 : x;
-                u32 yu = (y > 0) ? y - 1 : y;
-                u32 yd = (y < h - 1) ? y + 1 : y;
-
-                float dx = (planet.elevation.get(xr, y) - planet.elevation.get(xl, y)) * strength;
-                float dy = (planet.elevation.get(x, yd) - planet.elevation.get(x, yu)) * strength;
-                float len = std::sqrt(dx * dx + dy * dy + 1.0f);
-
-                size_t idx = (y * w + x) * 3;
-                pixels[idx + 0] = static_cast<u8>((-dx / len * 0.5f + 0.5f) * 255.0f);
-                pixels[idx + 1] = static_cast<u8>((-dy / len * 0.5f + 0.5f) * 255.0f);
-                pixels[idx + 2] = static_cast<u8>((1.0f / len * 0.5f + 0.5f) * 255.0f);
-            }
-        }
+        return tex;
     }
 
     GLuint vao_ = 0, vbo_ = 0, ebo_ = 0;
     GLuint biome_tex_ = 0, elevation_tex_ = 0, normal_tex_ = 0;
+    GLuint data_tex_ = 0, palette_tex_ = 0;
     u32 index_count_ = 0;
+    TextureStreamer streamer_;
 };
 
 } // namespace godsim
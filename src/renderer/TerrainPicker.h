@@ -0,0 +1,268 @@
+#pragma once
+
+#include "TerrainVertex.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "layers/planetary/Heightmap.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace godsim {
+
+/// Ray intersection with the displaced planet surface,
+/// r(dir) = radius_for(bilinear elevation), the same surface
+/// TerrainBaker displaces chunk vertices onto at full refinement.
+///
+/// A max-radius pyramid over the elevation grid makes this cheap. Patch
+/// (i, j) is the bilinear square between texel centres i..i+1 (wrapping)
+/// and j..j+1; level 0 nodes cover BASE × BASE patches and each level
+/// above halves the node count per axis. A ray above a node's maximum
+/// skips the node in one step: moving s along the ray turns its
+/// direction by at most s / r, so a step of (angle to the node border) ×
+/// (node max radius) cannot leave the node, and the ray is also stopped
+/// where it dips to that radius. Inside a base node whose maximum the
+/// ray is below, it marches in eighth-cell steps and bisects the hit.
+class TerrainPicker {
+public:
+    static constexpr u32 BASE = 4;
+
+    struct Hit {
+        bool hit = false;
+        f32 t = 0.0f;     // Distance along the (unit) ray
+        Vec3f position;
+        f32 u = 0.0f, v = 0.0f;
+        u32 steps = 0;
+    };
+
+    TerrainPicker() = default;
+
+    void build(const Heightmap& elevation, f32 sea_level, f32 displacement_scale) {
+        elevation_ = &elevation;
+        baker_ = std::make_unique<TerrainBaker>(elevation, sea_level, displacement_scale);
+        w_ = elevation.width();
+        h_ = elevation.height();
+        patches_y_ = std::max(h_, 2u) - 1;
+
+        levels_.clear();
+        u32 nx = (w_ + BASE - 1) / BASE, ny = (patches_y_ + BASE - 1) / BASE;
+        for (;;) {
+            levels_.push_back({nx, ny, std::vector<f32>(static_cast<size_t>(nx) * ny)});
+            if (nx == 1 && ny == 1) break;
+            nx = (nx + 1) / 2;
+            ny = (ny + 1) / 2;
+        }
+        refresh(0, levels_[0].nx, 0, levels_[0].ny);
+    }
+
+    /// Recompute the pyramid over edited cells.
+    void update(const DirtyRegion& edits) {
+        if (!elevation_) return;
+        for (const auto& rect : edits.rects()) {
+            // Texel (x, y) belongs to patches x-1..x and y-1..y
+            u32 py0 = rect.y0 > 0 ? rect.y0 - 1 : 0;
+            u32 py1 = std::min(rect.y1, patches_y_);
+            refresh(rect.x0 > 0 ? (rect.x0 - 1) / BASE : 0, (rect.x1 - 1) / BASE + 1,
+                    py0 / BASE, (std::max(py1, py0 + 1) - 1) / BASE + 1);
+            if (rect.x0 == 0) refresh((w_ - 1) / BASE, (w_ - 1) / BASE + 1,
+                                      py0 / BASE, (std::max(py1, py0 + 1) - 1) / BASE + 1);
+        }
+    }
+
+    u32 level_count() const { return static_cast<u32>(levels_.size()); }
+    f32 max_radius() const { return levels_.empty() ? 1.0f : levels_.back().max[0]; }
+
+    /// Nearest intersection of the ray (origin, unit dir) with the surface.
+    Hit intersect(const Vec3f& origin, const Vec3f& dir) const {
+        Hit result;
+        if (!elevation_) return result;
+        f32 t = ray_sphere_near(origin, dir, max_radius());
+        if (t < 0.0f) {
+            if (origin.length() > max_radius()) return result;
+            t = 0.0f; // Starting inside the shell
+        }
+        // The surface never dips below the unit sphere, so the ray is
+        // certain to have hit by the time it reaches it.
+        f32 t_unit = ray_sphere_near(origin, dir, 1.0f);
+        f32 t_end = t_unit >= 0.0f ? t_unit : ray_sphere_far(origin, dir, max_radius());
+
+        // Eighth of a cell; coarse steps overshoot borders by a sliver of
+        // that so rays parallel to a border don't creep up on it
+        const f32 cell = PI / h_;
+        const f32 slack = 0.005f * cell;
+        u32 level = level_count() - 1;
+        f32 t_prev = t;
+        for (u32 step = 0; step < MAX_STEPS && t <= t_end; step++) {
+            result.steps = step + 1;
+            Vec3f p = origin + dir * t;
+            f32 r = p.length();
+            Vec3f d = p * (1.0f / r);
+            f32 u, v;
+            sphere_uv(d, u, v);
+            Cursor at = locate(u, v);
+
+            // Coarsest node on the path whose maximum the ray is above. The
+            // span where the ray is inside a radius is taken from the ray
+            // itself, not from r, so a ray skimming the top can't round its
+            // way past it.
+            f32 t_dip = 0.0f, t_rise = 0.0f;
+            auto above = [&](u32 k) {
+                f32 top = node_max(k, at);
+                if (!ray_sphere_span(origin, dir, top, t_dip, t_rise)) return true;
+                return r > top && !(t_dip <= t && t < t_rise);
+            };
+            while (level > 0 && !above(level)) level--;
+            if (above(level)) {
+                f32 s = angle_to_border(level, at, v) * node_max(level, at) + slack;
+                if (t_dip > t) s = std::min(s, t_dip - t + 1e-6f);
+                t_prev = t;
+                t += s;
+                if (level + 1 < level_count()) level++;
+                continue;
+            }
+
+            // Below a base node's maximum: test the surface itself
+            if (r <= baker_->radius_for(baker_->elevation_at(d))) {
+                return refine(origin, dir, t_prev, t, result.steps);
+            }
+            // Longitude cells narrow towards the poles
+            f32 across = std::max(std::sin(v * PI), 0.05f) * (2.0f * PI / w_);
+            t_prev = t;
+            t += 0.125f * std::min(cell, across) * r;
+        }
+        if (t_unit >= 0.0f) return refine(origin, dir, t_prev, t_unit, result.steps);
+        return result;
+    }
+
+private:
+    static constexpr f32 PI = 3.14159265359f;
+    static constexpr u32 MAX_STEPS = 4096;
+
+    struct Level {
+        u32 nx, ny;
+        std::vector<f32> max; // Max surface radius per node
+    };
+
+    /// Position in patch coordinates: patch (i, j) spans [i, i+1) × [j, j+1).
+    struct Cursor {
+        f32 px, py;  // px in [0, w), py unclamped (below 0 / above h-1 near the poles)
+        u32 i, j;
+    };
+
+    Cursor locate(f32 u, f32 v) const {
+        Cursor c;
+        c.px = u * w_ - 0.5f;
+        if (c.px < 0.0f) c.px += w_;
+        c.py = v * h_ - 0.5f;
+        c.i = std::min(static_cast<u32>(c.px), w_ - 1);
+        c.j = static_cast<u32>(std::clamp(c.py, 0.0f, static_cast<f32>(patches_y_ - 1)));
+        return c;
+    }
+
+    f32 node_max(u32 level, const Cursor& c) const {
+        const Level& l = levels_[level];
+        u32 shift = level;
+        return l.max[static_cast<size_t>((c.j / BASE) >> shift) * l.nx + ((c.i / BASE) >> shift)];
+    }
+
+    /// Great-circle angle from the cursor to the nearest border of its node
+    /// at `level` (the poles count as borders).
+    f32 angle_to_border(u32 level, const Cursor& c, f32 v) const {
+        u32 span = BASE << level;
+        u32 j0 = (c.j / span) * span, j1 = std::min(j0 + span, patches_y_);
+        f32 lo = j0 == 0 ? -0.5f : static_cast<f32>(j0);
+        f32 hi = j1 == patches_y_ ? h_ - 0.5f : static_cast<f32>(j1);
+        f32 lat = std::max(std::min(c.py - lo, hi - c.py), 0.0f) * (PI / h_);
+
+        u32 i0 = (c.i / span) * span, i1 = std::min(i0 + span, w_);
+        if (i0 == 0 && i1 == w_) return lat; // Node spans every longitude
+        f32 dlon = std::max(std::min(c.px - i0, i1 - c.px), 0.0f) * (2.0f * PI / w_);
+        f32 lon = std::asin(std::min(std::sin(v * PI) * std::sin(std::min(dlon, PI * 0.5f)), 1.0f));
+        return std::min(lat, lon);
+    }
+
+    Hit refine(const Vec3f& origin, const Vec3f& dir, f32 above, f32 below, u32 steps) const {
+        for (int i = 0; i < 20; i++) {
+            f32 mid = 0.5f * (above + below);
+            Vec3f p = origin + dir * mid;
+            f32 r = p.length();
+            if (r <= baker_->radius_for(baker_->elevation_at(p * (1.0f / r)))) {
+                below = mid;
+            } else {
+                above = mid;
+            }
+        }
+        Hit hit;
+        hit.hit = true;
+        hit.t = below;
+        hit.position = origin + dir * below;
+        sphere_uv(hit.position.normalized(), hit.u, hit.v);
+        hit.steps = steps;
+        return hit;
+    }
+
+    /// Rebuild base nodes [bx0, bx1) × [by0, by1) and their ancestors.
+    void refresh(u32 bx0, u32 bx1, u32 by0, u32 by1) {
+        Level& base = levels_[0];
+        bx1 = std::min(bx1, base.nx);
+        by1 = std::min(by1, base.ny);
+        for (u32 by = by0; by < by1; by++) {
+            u32 y0 = by * BASE, y1 = std::min(y0 + BASE, patches_y_); // Texel rows y0..y1
+            for (u32 bx = bx0; bx < bx1; bx++) {
+                u32 x0 = bx * BASE, x1 = std::min(x0 + BASE, w_);     // Texel cols x0..x1 (wraps)
+                f32 m = 0.0f;
+                for (u32 y = y0; y <= y1 && y < h_; y++)
+                    for (u32 x = x0; x <= x1; x++) m = std::max(m, elevation_->get(x % w_, y));
+                base.max[static_cast<size_t>(by) * base.nx + bx] = baker_->radius_for(m);
+            }
+        }
+        for (u32 k = 1; k < level_count(); k++) {
+            bx0 /= 2; by0 /= 2;
+            bx1 = (bx1 + 1) / 2; by1 = (by1 + 1) / 2;
+            const Level& child = levels_[k - 1];
+            Level& level = levels_[k];
+            for (u32 y = by0; y < std::min(by1, level.ny); y++) {
+                for (u32 x = bx0; x < std::min(bx1, level.nx); x++) {
+                    f32 m = 0.0f;
+                    for (u32 cy = 2 * y; cy < std::min(2 * y + 2, child.ny); cy++)
+                        for (u32 cx = 2 * x; cx < std::min(2 * x + 2, child.nx); cx++)
+                            m = std::max(m, child.max[static_cast<size_t>(cy) * child.nx + cx]);
+                    level.max[static_cast<size_t>(y) * level.nx + x] = m;
+                }
+            }
+        }
+    }
+
+    /// Where the ray is inside the sphere: [t0, t1). False if it never is.
+    static bool ray_sphere_span(const Vec3f& o, const Vec3f& d, f32 radius, f32& t0, f32& t1) {
+        f32 b = o.dot(d), c = o.dot(o) - radius * radius, disc = b * b - c;
+        if (disc < 0.0f) {
+            t0 = t1 = -1.0f;
+            return false;
+        }
+        f32 root = std::sqrt(disc);
+        t0 = -b - root;
+        t1 = -b + root;
+        return true;
+    }
+
+    static f32 ray_sphere_near(const Vec3f& o, const Vec3f& d, f32 radius) {
+        f32 b = o.dot(d), c = o.dot(o) - radius * radius, disc = b * b - c;
+        return disc < 0.0f ? -1.0f : -b - std::sqrt(disc);
+    }
+
+    static f32 ray_sphere_far(const Vec3f& o, const Vec3f& d, f32 radius) {
+        f32 b = o.dot(d), c = o.dot(o) - radius * radius, disc = b * b - c;
+        return disc < 0.0f ? -1.0f : -b + std::sqrt(disc);
+    }
+
+    const Heightmap* elevation_ = nullptr;
+    std::unique_ptr<TerrainBaker> baker_;
+    u32 w_ = 0, h_ = 0, patches_y_ = 0;
+    std::vector<Level> levels_; // levels_[0] is the finest
+};
+
+} // namespace godsim
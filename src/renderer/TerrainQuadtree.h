@@ -0,0 +1,353 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+// ─── Minimal Vector Math ───
+// Kept free of glm so chunk selection builds into the headless test binary.
+
+struct Vec3f {
+    f32 x = 0.0f, y = 0.0f, z = 0.0f;
+
+    Vec3f operator+(const Vec3f& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3f operator-(const Vec3f& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3f operator*(f32 s) const { return {x * s, y * s, z * s}; }
+
+    f32 dot(const Vec3f& o) const { return x * o.x + y * o.y + z * o.z; }
+    f32 length() const { return std::sqrt(dot(*this)); }
+    Vec3f normalized() const {
+        f32 len = length();
+        return len > 0.0f ? *this * (1.0f / len) : *this;
+    }
+};
+
+/// Equirectangular texture coordinate of a unit direction, matching the
+/// UV sphere: u = longitude / 2π in [0, 1), v = colatitude / π.
+inline void sphere_uv(const Vec3f& dir, f32& u, f32& v) {
+    constexpr f32 TWO_PI = 6.28318530718f;
+    constexpr f32 PI = 3.14159265359f;
+    u = std::atan2(dir.z, dir.x) / TWO_PI;
+    if (u < 0.0f) u += 1.0f;
+    if (u >= 1.0f) u -= 1.0f;
+    v = std::acos(std::clamp(dir.y, -1.0f, 1.0f)) / PI;
+}
+
+// ─── Chunk Addressing ───
+
+/// One node of a cube-face quadtree: face 0–5, depth, and cell within the
+/// face's 2^level × 2^level grid.
+struct ChunkKey {
+    u8  face = 0;
+    u8  level = 0;
+    u32 x = 0, y = 0;
+
+    /// Unique 64-bit id (levels up to 27).
+    u64 packed() const {
+        return (static_cast<u64>(face) << 61) | (static_cast<u64>(level) << 56) |
+               (static_cast<u64>(y) << 28) | x;
+    }
+
+    ChunkKey parent() const {
+        return {face, static_cast<u8>(level - 1), x >> 1, y >> 1};
+    }
+
+    /// Child 0–3 in row-major order (bit 0 = x, bit 1 = y).
+    ChunkKey child(u32 i) const {
+        return {face, static_cast<u8>(level + 1), (x << 1) | (i & 1), (y << 1) | (i >> 1)};
+    }
+
+    bool operator==(const ChunkKey& o) const {
+        return face == o.face && level == o.level && x == o.x && y == o.y;
+    }
+};
+
+/// Camera state chunk selection needs. `view_proj` is column-major
+/// (the layout glm::value_ptr produces), OpenGL clip conventions.
+struct LodView {
+    Vec3f eye;
+    std::array<f32, 16> view_proj{};
+    f32 viewport_height = 720.0f;
+    f32 fov_y = 0.785398f; // radians
+};
+
+struct QuadtreeConfig {
+    u32 chunk_res = 16;            // Quads per chunk edge (power of two)
+    u32 max_level = 6;
+    f32 pixel_error = 1.5f;        // Split while projected error exceeds this
+    f32 error_per_spacing = 0.15f; // Geometric error as a fraction of vertex spacing
+    f32 max_height = 0.035f;       // Largest radial displacement above the unit sphere
+};
+
+/// Bounding volume of a chunk at any displacement in [0, max_height].
+struct ChunkBounds {
+    Vec3f centre;       // Bounding sphere
+    f32   radius = 0.0f;
+    Vec3f dir;          // Unit direction of the patch centre
+    f32   cap_angle = 0.0f; // Angular radius of the patch about `dir`
+};
+
+/// Chunked cube-sphere level of detail. Each cube face is a quadtree of
+/// square patches projected onto the sphere; the selection walks down from
+/// the six roots and stops where a patch's geometric error projects to less
+/// than `pixel_error` pixels, skipping patches outside the frustum or behind
+/// the horizon. GPU-independent — the renderer turns keys into meshes.
+class TerrainQuadtree {
+public:
+    struct Stats {
+        u32 visited = 0;
+        u32 culled_frustum = 0;
+        u32 culled_horizon = 0;
+        u32 selected = 0;
+    };
+
+    TerrainQuadtree() = default;
+    explicit TerrainQuadtree(const QuadtreeConfig& config) : config_(config) {}
+
+    const QuadtreeConfig& config() const { return config_; }
+
+    /// Deepest level worth building for a `grid_width`-cell equirectangular
+    /// map: one past the first level whose vertex spacing is under half a cell.
+    static u32 max_level_for(u32 grid_width, u32 chunk_res) {
+        f64 cell = 2.0 * 3.14159265358979 / std::max(grid_width, 1u);
+        f64 spacing = (3.14159265358979 / 2.0) / std::max(chunk_res, 1u);
+        u32 level = 0;
+        while (spacing > cell * 0.5 && level < 20) {
+            spacing *= 0.5;
+            level++;
+        }
+        return level + 1;
+    }
+
+    // ─── Geometry ───
+
+    /// Unit-sphere direction for face coordinates (a, b) ∈ [-1, 1]². The
+    /// equal-angle warp tan(a·π/4) evens out cell sizes across the face; the
+    /// face edges are pinned so neighbouring faces share vertices exactly.
+    static Vec3f face_point(u8 face, f64 a, f64 b) {
+        static constexpr f32 FRAMES[6][3][3] = {
+            {{ 1, 0, 0}, { 0, 0, -1}, {0, 1,  0}}, // +X
+            {{-1, 0, 0}, { 0, 0,  1}, {0, 1,  0}}, // -X
+            {{ 0, 1, 0}, { 1, 0,  0}, {0, 0, -1}}, // +Y
+            {{ 0,-1, 0}, { 1, 0,  0}, {0, 0,  1}}, // -Y
+            {{ 0, 0, 1}, { 1, 0,  0}, {0, 1,  0}}, // +Z
+            {{ 0, 0,-1}, {-1, 0,  0}, {0, 1,  0}}, // -Z
+        };
+        auto warp = [](f64 t) {
+            if (t <= -1.0) return -1.0;
+            if (t >= 1.0) return 1.0;
+            return std::tan(t * 3.14159265358979 / 4.0);
+        };
+        f64 s = warp(a), t = warp(b);
+        const auto& f = FRAMES[face];
+        f64 px = f[0][0] + s * f[1][0] + t * f[2][0];
+        f64 py = f[0][1] + s * f[1][1] + t * f[2][1];
+        f64 pz = f[0][2] + s * f[1][2] + t * f[2][2];
+        f64 inv = 1.0 / std::sqrt(px * px + py * py + pz * pz);
+        return {static_cast<f32>(px * inv), static_cast<f32>(py * inv),
+                static_cast<f32>(pz * inv)};
+    }
+
+    /// Direction of grid vertex (i, j), 0 ≤ i, j ≤ chunk_res, of a chunk.
+    Vec3f chunk_point(const ChunkKey& key, u32 i, u32 j) const {
+        f64 cells = static_cast<f64>(1u << key.level) * config_.chunk_res;
+        f64 a = -1.0 + 2.0 * (static_cast<f64>(key.x) * config_.chunk_res + i) / cells;
+        f64 b = -1.0 + 2.0 * (static_cast<f64>(key.y) * config_.chunk_res + j) / cells;
+        return face_point(key.face, a, b);
+    }
+
+    /// Worst-case surface deviation of a chunk from the fully refined mesh.
+    f32 geometric_error(u32 level) const {
+        f32 spacing = (1.5707963f / config_.chunk_res) / static_cast<f32>(1u << level);
+        return spacing * config_.error_per_spacing;
+    }
+
+    /// Skirt depth hiding cracks against a coarser neighbour.
+    f32 skirt_depth(u32 level) const {
+        return std::max(geometric_error(level) * 4.0f, 0.002f);
+    }
+
+    ChunkBounds bounds(const ChunkKey& key) const {
+        ChunkBounds b;
+        u32 n = config_.chunk_res;
+        b.dir = chunk_point(key, n / 2, n / 2);
+        // Patch edges are great-circle arcs, so the farthest point from the
+        // centre direction is a corner.
+        f32 min_cos = 1.0f;
+        for (u32 c = 0; c < 4; c++) {
+            Vec3f corner = chunk_point(key, (c & 1) ? n : 0, (c & 2) ? n : 0);
+            min_cos = std::min(min_cos, corner.dot(b.dir));
+        }
+        min_cos = std::clamp(min_cos, -1.0f, 1.0f);
+        b.cap_angle = std::acos(min_cos);
+
+        f32 r_lo = 1.0f - skirt_depth(key.level);
+        f32 r_hi = 1.0f + config_.max_height;
+        f32 r_c = 0.5f * (r_lo + r_hi);
+        b.centre = b.dir * r_c;
+        auto reach = [&](f32 r) {
+            return std::sqrt(std::max(0.0f, r * r + r_c * r_c - 2.0f * r * r_c * min_cos));
+        };
+        b.radius = std::max(reach(r_lo), reach(r_hi)) * 1.001f;
+        return b;
+    }
+
+    // ─── Selection ───
+
+    /// Choose the chunks to draw this frame. The result tiles every visible
+    /// part of the sphere with no overlaps.
+    void select(const LodView& view, std::vector<ChunkKey>& out) {
+        out.clear();
+        stats_ = {};
+        extract_planes(view.view_proj);
+        pixels_per_unit_ = view.viewport_height /
+                           (2.0f * std::tan(std::max(view.fov_y, 1e-3f) * 0.5f));
+        eye_ = view.eye;
+        eye_dist_ = eye_.length();
+        eye_dir_ = eye_.normalized();
+        // Angle from the sub-camera point at which the tallest possible
+        // terrain drops below the horizon of the unit sphere.
+        horizon_ = eye_dist_ > 1.0f
+            ? std::acos(1.0f / eye_dist_) + std::acos(1.0f / (1.0f + config_.max_height))
+            : 4.0f;
+
+        for (u8 face = 0; face < 6; face++) visit({face, 0, 0, 0}, out);
+    }
+
+    /// Projected error in pixels of drawing `key` from `view` at its level.
+    f32 screen_error(const ChunkKey& key, const ChunkBounds& b) const {
+        f32 dist = std::max((b.centre - eye_).length() - b.radius, 1e-4f);
+        return geometric_error(key.level) * pixels_per_unit_ / dist;
+    }
+
+    const Stats& stats() const { return stats_; }
+
+    /// Triangles per drawn chunk, including the two-sided skirts.
+    u32 triangles_per_chunk() const {
+        u32 n = config_.chunk_res;
+        return 2 * n * n + 4 * n * 4;
+    }
+
+    // ─── Mesh Topology ───
+
+    /// Vertices per chunk: the (n+1)² grid followed by four skirt rows.
+    u32 vertices_per_chunk() const {
+        u32 n = config_.chunk_res;
+        return (n + 1) * (n + 1) + 4 * (n + 1);
+    }
+
+    /// Vertex index of boundary vertex k (0 ≤ k ≤ n) on edge e, walking the
+    /// border counter-clockwise seen from outside: bottom, right, top, left.
+    u32 edge_vertex(u32 e, u32 k) const {
+        u32 n = config_.chunk_res, row = n + 1;
+        switch (e) {
+            case 0:  return k;                      // j = 0, i increasing
+            case 1:  return k * row + n;            // i = n, j increasing
+            case 2:  return n * row + (n - k);      // j = n, i decreasing
+            default: return (n - k) * row;          // i = 0, j decreasing
+        }
+    }
+
+    /// Index list shared by every chunk: grid triangles wound counter-clockwise
+    /// from outside, plus skirts drawn both ways so they hide cracks from any side.
+    std::vector<u32> chunk_indices() const {
+        u32 n = config_.chunk_res, row = n + 1;
+        std::vector<u32> indices;
+        indices.reserve(triangles_per_chunk() * 3);
+        for (u32 j = 0; j < n; j++) {
+            for (u32 i = 0; i < n; i++) {
+                u32 a = j * row + i, b = a + 1, c = a + row, d = c + 1;
+                indices.insert(indices.end(), {a, b, d, a, d, c});
+            }
+        }
+        u32 skirt_base = row * row;
+        for (u32 e = 0; e < 4; e++) {
+            for (u32 k = 0; k < n; k++) {
+                u32 a = edge_vertex(e, k), b = edge_vertex(e, k + 1);
+                u32 a2 = skirt_base + e * row + k, b2 = a2 + 1;
+                indices.insert(indices.end(), {a, a2, b, b, a2, b2});
+                indices.insert(indices.end(), {a, b, a2, b, b2, a2});
+            }
+        }
+        return indices;
+    }
+
+    /// Unit directions of a chunk's vertices in chunk_indices() order; skirt
+    /// vertices come back scaled to 1 - skirt_depth.
+    void chunk_positions(const ChunkKey& key, std::vector<Vec3f>& out) const {
+        u32 n = config_.chunk_res, row = n + 1;
+        out.resize(vertices_per_chunk());
+        for (u32 j = 0; j <= n; j++)
+            for (u32 i = 0; i <= n; i++) out[j * row + i] = chunk_point(key, i, j);
+        f32 drop = 1.0f - skirt_depth(key.level);
+        for (u32 e = 0; e < 4; e++)
+            for (u32 k = 0; k <= n; k++)
+                out[row * row + e * row + k] = out[edge_vertex(e, k)] * drop;
+    }
+
+private:
+    void visit(const ChunkKey& key, std::vector<ChunkKey>& out) {
+        stats_.visited++;
+        ChunkBounds b = bounds(key);
+
+        if (key.level > 0) {
+            f32 beta = std::acos(std::clamp(b.dir.dot(eye_dir_), -1.0f, 1.0f));
+            if (beta - b.cap_angle > horizon_) {
+                stats_.culled_horizon++;
+                return;
+            }
+        }
+        if (!in_frustum(b)) {
+            stats_.culled_frustum++;
+            return;
+        }
+
+        if (key.level < config_.max_level && screen_error(key, b) > config_.pixel_error) {
+            for (u32 c = 0; c < 4; c++) visit(key.child(c), out);
+            return;
+        }
+        out.push_back(key);
+        stats_.selected++;
+    }
+
+    /// Gribb–Hartmann plane extraction; planes point inwards, normalised.
+    void extract_planes(const std::array<f32, 16>& m) {
+        auto row = [&](u32 r) {
+            return std::array<f32, 4>{m[r], m[4 + r], m[8 + r], m[12 + r]};
+        };
+        auto r0 = row(0), r1 = row(1), r2 = row(2), r3 = row(3);
+        for (u32 p = 0; p < 6; p++) {
+            const auto& r = p < 2 ? r0 : (p < 4 ? r1 : r2);
+            f32 sign = (p & 1) ? -1.0f : 1.0f;
+            std::array<f32, 4> plane;
+            for (u32 k = 0; k < 4; k++) plane[k] = r3[k] + sign * r[k];
+            f32 len = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+            if (len > 0.0f)
+                for (auto& v : plane) v /= len;
+            planes_[p] = plane;
+        }
+    }
+
+    bool in_frustum(const ChunkBounds& b) const {
+        for (const auto& p : planes_) {
+            f32 d = p[0] * b.centre.x + p[1] * b.centre.y + p[2] * b.centre.z + p[3];
+            if (d < -b.radius) return false;
+        }
+        return true;
+    }
+
+    QuadtreeConfig config_;
+    Stats stats_;
+    std::array<std::array<f32, 4>, 6> planes_{};
+    f32 pixels_per_unit_ = 1.0f;
+    Vec3f eye_, eye_dir_;
+    f32 eye_dist_ = 1.0f;
+    f32 horizon_ = 4.0f;
+};
+
+} // namespace godsim
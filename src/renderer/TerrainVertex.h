@@ -0,0 +1,200 @@
+#pragma once
+
+#include "TerrainQuadtree.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "layers/planetary/Heightmap.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+// ─── Compact Terrain Vertex ───
+
+/// 12-byte terrain vertex with displacement already applied.
+/// Position is quantised to 16 bits inside the chunk's bounding box, the
+/// fourth short carries elevation for shading, and the surface normal is
+/// octahedral-encoded into two signed shorts.
+struct PackedVertex {
+    u16 px, py, pz;
+    u16 elevation;
+    i16 nx, ny;
+};
+static_assert(sizeof(PackedVertex) == 12, "PackedVertex must stay tightly packed");
+
+/// Octahedral normal encoding: project onto the octahedron |x|+|y|+|z| = 1
+/// and fold the lower hemisphere over the upper one.
+inline void oct_encode(const Vec3f& n, i16& ox, i16& oy) {
+    f32 l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+    f32 x = n.x / l1, y = n.y / l1;
+    if (n.z < 0.0f) {
+        f32 fx = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+        f32 fy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    ox = static_cast<i16>(std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f));
+    oy = static_cast<i16>(std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f));
+}
+
+/// Inverse of oct_encode; mirrors the decode in TERRAIN_VERT.
+inline Vec3f oct_decode(i16 ox, i16 oy) {
+    f32 x = std::max(ox / 32767.0f, -1.0f), y = std::max(oy / 32767.0f, -1.0f);
+    Vec3f n{x, y, 1.0f - std::abs(x) - std::abs(y)};
+    f32 t = std::max(-n.z, 0.0f);
+    n.x += n.x >= 0.0f ? -t : t;
+    n.y += n.y >= 0.0f ? -t : t;
+    return n.normalized();
+}
+
+// ─── Chunk Baking ───
+
+/// Dequantisation box for one baked chunk: position = origin + q × extent.
+struct ChunkFrame {
+    Vec3f origin;
+    Vec3f extent;
+};
+
+/// Bakes radial displacement and terrain normals into PackedVertex chunks,
+/// replacing the per-vertex elevation texture fetch in the vertex shader.
+/// Displacement matches what PLANET_VERT used to compute:
+/// r = 1 + max(e − sea, 0) × scale, e sampled like a GL_LINEAR texture.
+class TerrainBaker {
+public:
+    TerrainBaker(const Heightmap& elevation, f32 sea_level, f32 displacement_scale)
+        : elevation_(elevation), sea_level_(sea_level), scale_(displacement_scale) {}
+
+    /// Bilinear elevation at a unit direction. Texel centres sit at
+    /// (i + 0.5) / w like a GL texture; longitude wraps, latitude clamps.
+    f32 elevation_at(const Vec3f& dir) const {
+        f32 u, v;
+        sphere_uv(dir, u, v);
+        u32 w = elevation_.width(), h = elevation_.height();
+        f32 fx = u * w - 0.5f;
+        f32 fy = std::clamp(v * h - 0.5f, 0.0f, static_cast<f32>(h - 1));
+        f32 x0f = std::floor(fx);
+        f32 tx = fx - x0f;
+        i32 xi = static_cast<i32>(x0f);
+        u32 x0 = static_cast<u32>((xi % static_cast<i32>(w) + w) % w);
+        u32 x1 = (x0 + 1) % w;
+        u32 y0 = static_cast<u32>(fy);
+        u32 y1 = std::min(y0 + 1, h - 1);
+        f32 ty = fy - y0;
+        f32 a = elevation_.get(x0, y0) * (1 - tx) + elevation_.get(x1, y0) * tx;
+        f32 b = elevation_.get(x0, y1) * (1 - tx) + elevation_.get(x1, y1) * tx;
+        return a * (1 - ty) + b * ty;
+    }
+
+    f32 radius_for(f32 elevation) const {
+        return 1.0f + std::max(elevation - sea_level_, 0.0f) * scale_;
+    }
+
+    /// Normal of the displaced surface r(dir), from central differences one
+    /// map cell apart along the u and v texture directions. Independent of
+    /// the chunk parameterisation, so normals agree across chunk and face borders.
+    Vec3f normal_at(const Vec3f& dir) const {
+        f32 step = 6.2831853f / std::max(elevation_.width(), 1u);
+        Vec3f tu{-dir.z, 0.0f, dir.x}; // Increasing longitude
+        if (tu.length() < 1e-4f) tu = {1.0f, 0.0f, 0.0f};
+        tu = tu.normalized();
+        Vec3f tv = Vec3f{dir.y * tu.z, dir.z * tu.x - dir.x * tu.z, -dir.y * tu.x}.normalized(); // dir × tu
+
+        auto radius = [&](const Vec3f& d) { return radius_for(elevation_at(d.normalized())); };
+        f32 gu = (radius(dir + tu * step) - radius(dir - tu * step)) / (2.0f * step);
+        f32 gv = (radius(dir + tv * step) - radius(dir - tv * step)) / (2.0f * step);
+        f32 r = radius(dir);
+        return (dir - (tu * gu + tv * gv) * (1.0f / r)).normalized();
+    }
+
+    /// Build a chunk's vertices (TerrainQuadtree::chunk_indices order).
+    void bake(const TerrainQuadtree& tree, const ChunkKey& key,
+              std::vector<PackedVertex>& out, ChunkFrame& frame) const {
+        tree.chunk_positions(key, dirs_);
+        u32 grid = (tree.config().chunk_res + 1) * (tree.config().chunk_res + 1);
+        size_t n = dirs_.size();
+        positions_.resize(n);
+        elevations_.resize(n);
+        normals_.resize(n);
+
+        // Grid vertices; skirts copy their edge vertex, lowered
+        for (size_t i = 0; i < grid; i++) {
+            elevations_[i] = elevation_at(dirs_[i]);
+            positions_[i] = dirs_[i] * radius_for(elevations_[i]);
+            normals_[i] = normal_at(dirs_[i]);
+        }
+        f32 drop = tree.skirt_depth(key.level);
+        u32 row = tree.config().chunk_res + 1;
+        for (size_t i = grid; i < n; i++) {
+            u32 e = static_cast<u32>((i - grid) / row), k = static_cast<u32>((i - grid) % row);
+            u32 src = tree.edge_vertex(e, k);
+            elevations_[i] = elevations_[src];
+            positions_[i] = positions_[src] * (1.0f - drop);
+            normals_[i] = normals_[src];
+        }
+
+        Vec3f lo = positions_[0], hi = positions_[0];
+        for (const auto& p : positions_) {
+            lo = {std::min(lo.x, p.x), std::min(lo.y, p.y), std::min(lo.z, p.z)};
+            hi = {std::max(hi.x, p.x), std::max(hi.y, p.y), std::max(hi.z, p.z)};
+        }
+        frame.origin = lo;
+        frame.extent = {std::max(hi.x - lo.x, 1e-6f), std::max(hi.y - lo.y, 1e-6f),
+                        std::max(hi.z - lo.z, 1e-6f)};
+
+        auto quantise = [](f32 t) {
+            return static_cast<u16>(std::lround(std::clamp(t, 0.0f, 1.0f) * 65535.0f));
+        };
+        out.resize(n);
+        for (size_t i = 0; i < n; i++) {
+            const Vec3f& p = positions_[i];
+            PackedVertex& v = out[i];
+            v.px = quantise((p.x - lo.x) / frame.extent.x);
+            v.py = quantise((p.y - lo.y) / frame.extent.y);
+            v.pz = quantise((p.z - lo.z) / frame.extent.z);
+            v.elevation = quantise(elevations_[i]);
+            oct_encode(normals_[i], v.nx, v.ny);
+        }
+    }
+
+private:
+    const Heightmap& elevation_;
+    f32 sea_level_;
+    f32 scale_;
+
+    // Scratch reused across bakes
+    mutable std::vector<Vec3f> dirs_, positions_, normals_;
+    mutable std::vector<f32> elevations_;
+};
+
+/// Whether any cell of `rect` (on a grid_w × grid_h equirectangular map)
+/// influences `key`'s baked vertices. Conservative: the chunk's spherical
+/// cap is widened by two cells for bilinear taps and normal differences.
+inline bool chunk_touches(const TerrainQuadtree& tree, const ChunkKey& key,
+                          const CellRect& rect, u32 grid_w, u32 grid_h) {
+    constexpr f32 PI = 3.14159265359f;
+    ChunkBounds b = tree.bounds(key);
+    f32 cell = 2.0f * PI / grid_w;
+    f32 cap = b.cap_angle + 2.0f * cell;
+
+    f32 colat = std::acos(std::clamp(b.dir.y, -1.0f, 1.0f));
+    f32 v0 = (colat - cap) / PI * grid_h, v1 = (colat + cap) / PI * grid_h;
+    if (v1 < static_cast<f32>(rect.y0) || v0 > static_cast<f32>(rect.y1)) return false;
+
+    // Caps reaching a pole cover every longitude
+    if (colat - cap <= 0.0f || colat + cap >= PI) return true;
+    f32 half = std::asin(std::min(std::sin(cap) / std::sin(colat), 1.0f));
+    if (half >= PI * 0.5f) return true;
+
+    f32 u, v;
+    sphere_uv(b.dir, u, v);
+    f32 centre = u * grid_w, span = half / (2.0f * PI) * grid_w;
+    // Distance from the chunk's longitude centre to the rect, with wrap
+    f32 mid = 0.5f * (rect.x0 + rect.x1), rect_half = 0.5f * (rect.x1 - rect.x0);
+    f32 d = std::abs(centre - mid);
+    d = std::min(d, static_cast<f32>(grid_w) - d);
+    return d <= span + rect_half;
+}
+
+} // namespace godsim
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "layers/planetary/Biome.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+// ─── Grid Windows ───
+
+/// Read-only view of a rectangular window of a grid_w-wide planet grid.
+/// Cells are addressed in full-grid coordinates.
+template<typename T>
+struct GridView {
+    const T* data = nullptr;
+    CellRect rect;
+
+    const T& at(u32 x, u32 y) const {
+        return data[static_cast<size_t>(y - rect.y0) * rect.width() + (x - rect.x0)];
+    }
+};
+
+/// Owned copy of a grid window: lets a worker thread pack texels while
+/// the live grid keeps being edited.
+template<typename T>
+struct GridWindow {
+    CellRect rect;
+    std::vector<T> values;
+
+    GridView<T> view() const { return {values.data(), rect}; }
+};
+
+template<typename T>
+GridView<T> whole_grid(const T* data, u32 grid_w, u32 grid_h) {
+    return {data, CellRect{0, 0, grid_w, grid_h}};
+}
+
+template<typename T>
+GridWindow<T> copy_window(const T* data, u32 grid_w, const CellRect& rect) {
+    GridWindow<T> window;
+    window.rect = rect;
+    window.values.resize(static_cast<size_t>(rect.width()) * rect.height());
+    for (u32 y = rect.y0; y < rect.y1; y++) {
+        const T* row = data + static_cast<size_t>(y) * grid_w + rect.x0;
+        std::copy(row, row + rect.width(),
+                  window.values.begin() + static_cast<size_t>(y - rect.y0) * rect.width());
+    }
+    return window;
+}
+
+// ─── Texel Packing ───
+// Each packer writes `rect` row-major and tightly packed, ready for
+// TexSubImage2D with GL_UNPACK_ALIGNMENT 1. `rect` must lie inside the view.
+
+/// Map [lo, hi] to R16 unorm texels.
+inline void pack_unorm16(const GridView<f32>& src, const CellRect& rect, f32 lo, f32 hi,
+                         u16* out) {
+    f32 scale = 65535.0f / std::max(hi - lo, 1e-6f);
+    for (u32 y = rect.y0; y < rect.y1; y++) {
+        for (u32 x = rect.x0; x < rect.x1; x++) {
+            f32 v = std::clamp((src.at(x, y) - lo) * scale, 0.0f, 65535.0f);
+            *out++ = static_cast<u16>(v + 0.5f);
+        }
+    }
+}
+
+/// Biome indices as R8 texels.
+inline void pack_biome_indices(const GridView<BiomeType>& src, const CellRect& rect, u8* out) {
+    for (u32 y = rect.y0; y < rect.y1; y++)
+        for (u32 x = rect.x0; x < rect.x1; x++) *out++ = static_cast<u8>(src.at(x, y));
+}
+
+/// Tangent-space normal map texels (RGB8) from elevation differences.
+/// Reads one cell around `rect`, clamped to the grid, so the view must
+/// cover rect.expanded(1, grid_w, grid_h).
+inline void pack_normals(const GridView<f32>& elevation, const CellRect& rect,
+                         u32 grid_w, u32 grid_h, u8* out) {
+    constexpr f32 strength = 4.0f;
+    for (u32 y = rect.y0; y < rect.y1; y++) {
+        u32 yu = (y > 0) ? y - 1 : y;
+        u32 yd = (y < grid_h - 1) ? y + 1 : y;
+        for (u32 x = rect.x0; x < rect.x1; x++) {
+            u32 xl = (x > 0) ? x - 1 : x;
+            u32 xr = (x < grid_w - 1) ? x + 1 : x;
+
+            f32 dx = (elevation.at(xr, y) - elevation.at(xl, y)) * strength;
+            f32 dy = (elevation.at(x, yd) - elevation.at(x, yu)) * strength;
+            f32 len = std::sqrt(dx * dx + dy * dy + 1.0f);
+
+            *out++ = static_cast<u8>((-dx / len * 0.5f + 0.5f) * 255.0f);
+            *out++ = static_cast<u8>((-dy / len * 0.5f + 0.5f) * 255.0f);
+            *out++ = static_cast<u8>((1.0f / len * 0.5f + 0.5f) * 255.0f);
+        }
+    }
+}
+
+} // namespace godsim
@@ -0,0 +1,204 @@
+#pragma once
+
+#include "GL33Loader.h"
+#include "UploadWorker.h"
+#include "layers/planetary/DirtyRegion.h"
+#include "core/util/Log.h"
+#include "core/util/Types.h"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace godsim {
+
+/// Asynchronous texture updates through pixel buffer objects.
+/// A request names a texture rectangle and a fill function. The GL thread
+/// maps a PBO, the fill runs on the UploadWorker thread writing texels
+/// straight into the mapped memory, and a later poll() unmaps it and issues
+/// TexSubImage2D from the buffer, which the driver copies without blocking
+/// the frame. Two buffers by default: one filling while the other uploads.
+class TextureStreamer {
+public:
+    /// Runs on the worker; writes rect.width() × rect.height() texels.
+    using Fill = std::function<void(u8* texels)>;
+
+    struct Stats {
+        u64 uploads = 0;
+        u64 bytes = 0;
+        u32 in_flight = 0;
+        u32 queued = 0;
+    };
+
+    TextureStreamer() = default;
+    TextureStreamer(const TextureStreamer&) = delete;
+    TextureStreamer& operator=(const TextureStreamer&) = delete;
+    ~TextureStreamer() { destroy(); }
+
+    void create(u32 buffers = 2) {
+        worker_ = std::make_unique<UploadWorker>();
+        slots_.resize(std::max(buffers, 1u));
+        for (auto& slot : slots_) gl::GenBuffers(1, &slot.pbo);
+    }
+
+    void destroy() {
+        if (!worker_) return;
+        worker_->wait_all();
+        for (auto& slot : slots_) {
+            if (slot.busy) {
+                gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+                gl::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+            gl::DeleteBuffers(1, &slot.pbo);
+        }
+        gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slots_.clear();
+        queue_.clear();
+        worker_.reset();
+    }
+
+    /// Queue an update of `rect` in `texture`. `format`/`type` describe the
+    /// texels the fill writes (e.g. GL_RED / GL_UNSIGNED_SHORT).
+    void submit(GLuint texture, GLenum format, GLenum type, u32 bytes_per_texel,
+                const CellRect& rect, Fill fill) {
+        if (rect.empty()) return;
+        queue_.push_back({texture, format, type, bytes_per_texel, rect, std::move(fill)});
+        start_queued();
+    }
+
+    /// Call once per frame on the GL thread: upload every finished fill (in
+    /// submission order, so later writes to a texel win) and start queued ones.
+    void poll() {
+        if (!worker_) return;
+        for (;;) {
+            Slot* next = oldest_busy();
+            if (!next || !worker_->done(next->ticket)) break;
+            finish(*next);
+        }
+        start_queued();
+    }
+
+    /// Block until everything submitted so far is on the GPU.
+    void flush() {
+        if (!worker_) return;
+        while (!queue_.empty() || oldest_busy()) {
+            if (Slot* next = oldest_busy()) {
+                worker_->wait(next->ticket);
+                finish(*next);
+            }
+            start_queued();
+        }
+    }
+
+    bool idle() const { return queue_.empty() && std::none_of(slots_.begin(), slots_.end(),
+                                                              [](const Slot& s) { return s.busy; }); }
+
+    Stats stats() const {
+        Stats s = stats_;
+        s.queued = static_cast<u32>(queue_.size());
+        for (const auto& slot : slots_) s.in_flight += slot.busy;
+        return s;
+    }
+
+private:
+    struct Request {
+        GLuint texture;
+        GLenum format, type;
+        u32 bytes_per_texel;
+        CellRect rect;
+        Fill fill;
+    };
+
+    struct Slot {
+        GLuint pbo = 0;
+        bool busy = false;
+        u64 ticket = 0;
+        Request request;
+    };
+
+    static size_t byte_size(const Request& r) {
+        return static_cast<size_t>(r.rect.width()) * r.rect.height() * r.bytes_per_texel;
+    }
+
+    Slot* oldest_busy() {
+        Slot* oldest = nullptr;
+        for (auto& slot : slots_) {
+            if (slot.busy && (!oldest || slot.ticket < oldest->ticket)) oldest = &slot;
+        }
+        return oldest;
+    }
+
+    void start_queued() {
+        while (!queue_.empty()) {
+            auto free = std::find_if(slots_.begin(), slots_.end(),
+                                     [](const Slot& s) { return !s.busy; });
+            if (free == slots_.end()) return;
+            Request request = std::move(queue_.front());
+            queue_.pop_front();
+            start(*free, std::move(request));
+        }
+    }
+
+    void start(Slot& slot, Request request) {
+        size_t bytes = byte_size(request);
+        gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        // Orphan the previous storage so the driver never waits on an old upload
+        gl::BufferData(GL_PIXEL_UNPACK_BUFFER, static_cast<GLsizeiptr>(bytes), nullptr,
+                       GL_STREAM_DRAW);
+        void* mapped = gl::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0,
+                                          static_cast<GLsizeiptr>(bytes),
+                                          GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+        gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+        if (!mapped) {
+            // No mapping available: fill on this thread and upload directly
+            LOG_WARN("PBO map failed; uploading texture rect synchronously");
+            while (Slot* older = oldest_busy()) { // Keep submission order
+                worker_->wait(older->ticket);
+                finish(*older);
+            }
+            std::vector<u8> texels(bytes);
+            request.fill(texels.data());
+            upload(request, texels.data());
+            return;
+        }
+
+        slot.busy = true;
+        slot.request = std::move(request);
+        auto* texels = static_cast<u8*>(mapped);
+        slot.ticket = worker_->submit([fill = slot.request.fill, texels] { fill(texels); });
+    }
+
+    void finish(Slot& slot) {
+        gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.pbo);
+        bool intact = gl::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+        if (intact) {
+            upload(slot.request, nullptr); // Offset 0 into the bound PBO
+        }
+        gl::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        slot.busy = false;
+        if (!intact) {
+            // Contents lost (e.g. display mode change): run the request again
+            LOG_WARN("PBO contents lost during unmap; resubmitting upload");
+            queue_.push_front(std::move(slot.request));
+        }
+    }
+
+    void upload(const Request& r, const void* pixels) {
+        gl::BindTexture(GL_TEXTURE_2D, r.texture);
+        gl::TexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(r.rect.x0),
+                          static_cast<GLint>(r.rect.y0), static_cast<GLsizei>(r.rect.width()),
+                          static_cast<GLsizei>(r.rect.height()), r.format, r.type, pixels);
+        stats_.uploads++;
+        stats_.bytes += byte_size(r);
+    }
+
+    std::unique_ptr<UploadWorker> worker_;
+    std::vector<Slot> slots_;
+    std::deque<Request> queue_;
+    Stats stats_;
+};
+
+} // namespace godsim
@@ -0,0 +1,96 @@
+#pragma once
+
+#include "core/util/Types.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace godsim {
+
+/// Single background thread that prepares texture data off the GL thread.
+/// Jobs run strictly in submission order, so completion is a single
+/// counter: ticket t is done once completed() ≥ t. That ordering is what
+/// lets overlapping uploads of the same texture land newest-last.
+class UploadWorker {
+public:
+    using Job = std::function<void()>;
+
+    UploadWorker() : thread_([this] { run(); }) {}
+
+    ~UploadWorker() {
+        {
+            std::lock_guard lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        thread_.join();
+    }
+
+    UploadWorker(const UploadWorker&) = delete;
+    UploadWorker& operator=(const UploadWorker&) = delete;
+
+    /// Queue a job; returns its ticket (1, 2, 3, ...).
+    u64 submit(Job job) {
+        u64 ticket;
+        {
+            std::lock_guard lock(mutex_);
+            ticket = ++submitted_;
+            jobs_.push_back(std::move(job));
+        }
+        wake_.notify_one();
+        return ticket;
+    }
+
+    bool done(u64 ticket) const { return completed_.load(std::memory_order_acquire) >= ticket; }
+    u64 completed() const { return completed_.load(std::memory_order_acquire); }
+
+    /// Block until `ticket` has finished.
+    void wait(u64 ticket) {
+        std::unique_lock lock(mutex_);
+        finished_.wait(lock, [&] { return done(ticket); });
+    }
+
+    void wait_all() {
+        u64 last;
+        {
+            std::lock_guard lock(mutex_);
+            last = submitted_;
+        }
+        wait(last);
+    }
+
+private:
+    void run() {
+        for (;;) {
+            Job job;
+            {
+                std::unique_lock lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || !jobs_.empty(); });
+                if (jobs_.empty()) return; // Stopping with nothing left
+                job = std::move(jobs_.front());
+                jobs_.pop_front();
+            }
+            job();
+            {
+                std::lock_guard lock(mutex_);
+                completed_.fetch_add(1, std::memory_order_release);
+            }
+            finished_.notify_all();
+        }
+    }
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable finished_;
+    std::deque<Job> jobs_;
+    u64 submitted_ = 0;
+    std::atomic<u64> completed_{0};
+    bool stopping_ = false;
+    std::thread thread_; // Last: starts after the members it uses
+};
+
+} // namespace godsim
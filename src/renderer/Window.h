@@ -15,7 +15,9 @@ namespace godsim {
 
 class Window {
 public:
-    Window(int width = 1280, int height = 720, const std::string& title = "God Simulation") {
+    /// A hidden window only provides the GL context, e.g. for offscreen capture.
+    Window(int width = 1280, int height = 720, const std::string& title = "God Simulation",
+           bool visible = true) {
         if (!glfwInit()) {
             throw std::runtime_error("Failed to initialise GLFW");
         }
@@ -24,6 +26,7 @@ public:
         glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
         glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
         glfwWindowHint(GLFW_SAMPLES, 4); // MSAA
+        glfwWindowHint(GLFW_VISIBLE, visible ? GLFW_TRUE : GLFW_FALSE);
 #ifdef __APPLE__
         glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
@@ -35,7 +38,7 @@ public:
         }
 
         glfwMakeContextCurrent(window_);
-        glfwSwapInterval(1); // VSync
+        glfwSwapInterval(visible ? 1 : 0); // VSync when presenting
 
         // Load OpenGL
         if (!gl::load()) {
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "core/events/EventBus.h"
+#include "core/serialise/BinaryStream.h"
+#include "core/serialise/PagedImage.h"
+#include "core/util/Assert.h"
+#include "core/util/Profiler.h"
+#include "simulation/Simulation.h"
+
+#include <string>
+#include <vector>
+
+namespace godsim {
+
+using BranchID = u32;
+
+/// One line of history. Inactive branches are frozen where they were left.
+struct Branch {
+    BranchID    id = 0;
+    BranchID    parent = 0;    // Itself for the root
+    std::string label;
+    SimTime     branch_point;  // When it split from its parent
+    SimTime     time;          // Where it was last left
+    PagedImage  state;         // Its state then
+    EventLog    log;
+};
+
+/// Timeline branching for "what if" interventions. Only one branch is
+/// simulated at a time (the active one, living in the Simulation); the
+/// others are stored as PagedImages that share every page whose bytes are
+/// unchanged with the image they were built from, and event logs that
+/// share their full chunks. A branch of a large world therefore costs
+/// roughly what its interventions and the steps since the fork changed:
+/// dozens of branches of a mostly untouched 4096² planet fit in the
+/// memory of two.
+///
+/// A Timeline records the history of one branch; restart() it after
+/// switching.
+class BranchManager {
+public:
+    explicit BranchManager(Simulation& sim, std::string label = "main") : sim_(sim) {
+        Branch root;
+        root.label = std::move(label);
+        root.branch_point = sim_.current_time();
+        branches_.push_back(std::move(root));
+        store_active();
+    }
+
+    /// Split a new branch off the active one at the current time. The
+    /// active branch stays active; switch_to() the new one to diverge.
+    BranchID fork(std::string label) {
+        ProfileScope scope("Branches.fork");
+        store_active();
+        Branch branch;
+        branch.id = static_cast<BranchID>(branches_.size());
+        branch.parent = active_;
+        branch.label = std::move(label);
+        branch.branch_point = sim_.current_time();
+        branch.time = sim_.current_time();
+        branch.state = branches_[active_].state;
+        branch.log = branches_[active_].log;
+        branches_.push_back(std::move(branch));
+        return branches_.back().id;
+    }
+
+    /// Freeze the active branch and carry on from where `id` was left.
+    void switch_to(BranchID id) {
+        GODSIM_ASSERT(id < branches_.size(), "No branch {}", id);
+        if (id == active_) return;
+        ProfileScope scope("Branches.switch");
+        store_active();
+        const Branch& target = branches_[id];
+        BinaryReader reader(target.state.assemble());
+        sim_.read_state(reader);
+        sim_.event_bus().log() = target.log;
+        active_ = id;
+    }
+
+    BranchID active() const { return active_; }
+    size_t branch_count() const { return branches_.size(); }
+    const Branch& branch(BranchID id) const { return branches_[id]; }
+
+    /// Bytes held by stored states, each shared page counted once.
+    size_t resident_bytes() const {
+        std::vector<const PagedImage*> images;
+        for (const auto& b : branches_) images.push_back(&b.state);
+        return PagedImage::resident_bytes(images);
+    }
+
+private:
+    /// Page the live state against the active branch's last image, so only
+    /// what changed since then is copied.
+    void store_active() {
+        Branch& branch = branches_[active_];
+        BinaryWriter writer;
+        sim_.write_state(writer);
+        branch.state = PagedImage::build(writer.buffer(), &branch.state);
+        branch.log = sim_.event_bus().log();
+        branch.time = sim_.current_time();
+    }
+
+    Simulation& sim_;
+    std::vector<Branch> branches_;
+    BranchID active_ = 0;
+};
+
+} // namespace godsim
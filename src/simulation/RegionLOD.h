@@ -0,0 +1,188 @@
+#pragma once
+
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Profiler.h"
+#include "core/util/Types.h"
+#include "layers/Layer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+namespace godsim {
+
+/// Who is asking for detail. Each source holds at most one focus.
+enum class FocusSource : u8 {
+    Camera, // The renderer's view
+    Api,    // Scripts, tools and tests
+    COUNT
+};
+
+/// A disc of planet grid cells someone is looking at. Longitude wraps.
+struct RegionFocus {
+    f32 x = 0.0f, y = 0.0f; // Centre, cells
+    f32 radius = 0.0f;      // Cells
+};
+
+/// Resolution on demand: the planet grid is cut into REGION × REGION
+/// regions, each either hydrated (layers run it in full detail) or coarse
+/// (layers keep aggregates and run a simplified model).
+///
+/// Regions a focus covers are hydrated; regions clear of every focus by
+/// HYSTERESIS × its radius are dehydrated, so a camera hovering on a
+/// border doesn't make regions flicker between the two. Transitions are
+/// not made at once: update() carries out at most `budget` of them per
+/// call, nearest hydrations first, so panning spreads the cost over
+/// frames.
+///
+/// Inactive until configure(): every region then starts hydrated, which
+/// is what layers assume before they ever hear from the manager, and only
+/// update() changes that.
+class RegionLOD {
+public:
+    static constexpr u32 REGION = 32;           // Cells per side; matches PopulationGrid::TILE
+    static constexpr f32 HYSTERESIS = 1.5f;
+    static constexpr u32 DEFAULT_BUDGET = 8;    // Transitions per update()
+
+    void register_layer(Layer* layer) { layers_.push_back(layer); }
+
+    /// Cover a width × height grid; all regions start hydrated.
+    void configure(u32 width, u32 height) {
+        width_ = width;
+        height_ = height;
+        regions_x_ = (width + REGION - 1) / REGION;
+        regions_y_ = (height + REGION - 1) / REGION;
+        hydrated_.assign(region_count(), 1);
+        hydrated_count_ = region_count();
+    }
+
+    bool configured() const { return !hydrated_.empty(); }
+    u32 region_count() const { return regions_x_ * regions_y_; }
+    u32 regions_x() const { return regions_x_; }
+    u32 regions_y() const { return regions_y_; }
+    u32 hydrated_count() const { return hydrated_count_; }
+    bool hydrated(u32 region) const { return hydrated_[region] != 0; }
+
+    /// Region containing cell (x, y).
+    u32 region_at(u32 x, u32 y) const { return (y / REGION) * regions_x_ + x / REGION; }
+
+    CellRect bounds(u32 region) const {
+        CellRect b;
+        b.x0 = (region % regions_x_) * REGION;
+        b.y0 = (region / regions_x_) * REGION;
+        b.x1 = std::min(b.x0 + REGION, width_);
+        b.y1 = std::min(b.y0 + REGION, height_);
+        return b;
+    }
+
+    void set_focus(FocusSource source, const RegionFocus& focus) {
+        foci_[static_cast<size_t>(source)] = focus;
+        active_[static_cast<size_t>(source)] = true;
+    }
+
+    void clear_focus(FocusSource source) { active_[static_cast<size_t>(source)] = false; }
+
+    /// Regions whose state differs from what the foci ask for.
+    u32 pending() const {
+        u32 count = 0;
+        for (u32 r = 0; r < region_count(); r++) {
+            Want want = wanted(r);
+            count += (want == Want::Hydrated && !hydrated_[r]) || (want == Want::Coarse && hydrated_[r]);
+        }
+        return count;
+    }
+
+    /// Carry out up to `budget` transitions: hydrations nearest their
+    /// focus first, then dehydrations farthest first. Returns how many.
+    u32 update(u32 budget = DEFAULT_BUDGET) {
+        if (!configured() || budget == 0) return 0;
+        ProfileScope scope("RegionLOD.update");
+
+        std::vector<std::pair<f32, u32>> hydrate, dehydrate;
+        for (u32 r = 0; r < region_count(); r++) {
+            f32 gap;
+            Want want = wanted(r, &gap);
+            if (want == Want::Hydrated && !hydrated_[r]) hydrate.push_back({gap, r});
+            if (want == Want::Coarse && hydrated_[r]) dehydrate.push_back({-gap, r});
+        }
+        std::sort(hydrate.begin(), hydrate.end());
+        std::sort(dehydrate.begin(), dehydrate.end());
+
+        u32 done = 0;
+        for (size_t i = 0; i < hydrate.size() && done < budget; i++, done++) {
+            CellRect b = bounds(hydrate[i].second);
+            for (Layer* layer : layers_) layer->hydrate_region(b);
+            hydrated_[hydrate[i].second] = 1;
+            hydrated_count_++;
+        }
+        for (size_t i = 0; i < dehydrate.size() && done < budget; i++, done++) {
+            CellRect b = bounds(dehydrate[i].second);
+            for (Layer* layer : layers_) layer->dehydrate_region(b);
+            hydrated_[dehydrate[i].second] = 0;
+            hydrated_count_--;
+        }
+        return done;
+    }
+
+    /// Run update() until nothing is pending, e.g. before a headless run.
+    void settle() {
+        while (update(region_count()) > 0) {}
+    }
+
+    // ─── Serialisation ───
+    // Foci are not stored; the camera or caller sets them again.
+
+    void serialise(BinaryWriter& writer) const {
+        writer.write_u32(width_);
+        writer.write_u32(height_);
+        writer.write_bytes(hydrated_.data(), hydrated_.size());
+    }
+
+    /// Layers restore their own coarse state; this only has to agree with it.
+    void deserialise(BinaryReader& reader) {
+        u32 width = reader.read_u32();
+        u32 height = reader.read_u32();
+        configure(width, height);
+        reader.read_bytes(hydrated_.data(), hydrated_.size());
+        hydrated_count_ = static_cast<u32>(std::count(hydrated_.begin(), hydrated_.end(), 1));
+    }
+
+private:
+    enum class Want { Hydrated, Coarse, Either };
+
+    /// What the foci ask of region r. `gap` is the distance from the
+    /// nearest focus edge to the region (negative inside it).
+    Want wanted(u32 r, f32* gap = nullptr) const {
+        CellRect b = bounds(r);
+        f32 cx = 0.5f * static_cast<f32>(b.x0 + b.x1), cy = 0.5f * static_cast<f32>(b.y0 + b.y1);
+        f32 half = 0.5f * std::hypot(static_cast<f32>(b.width()), static_cast<f32>(b.height()));
+        Want want = Want::Coarse;
+        f32 nearest = 1e30f;
+        for (size_t s = 0; s < foci_.size(); s++) {
+            if (!active_[s]) continue;
+            const RegionFocus& f = foci_[s];
+            f32 dx = std::abs(cx - f.x);
+            dx = std::min(dx, static_cast<f32>(width_) - dx);
+            f32 d = std::hypot(dx, cy - f.y) - half;
+            nearest = std::min(nearest, d - f.radius);
+            if (d <= f.radius) {
+                want = Want::Hydrated;
+            } else if (d <= f.radius * HYSTERESIS && want == Want::Coarse) {
+                want = Want::Either;
+            }
+        }
+        if (gap) *gap = nearest;
+        return want;
+    }
+
+    u32 width_ = 0, height_ = 0;
+    u32 regions_x_ = 0, regions_y_ = 0;
+    std::vector<u8> hydrated_;
+    u32 hydrated_count_ = 0;
+    std::array<RegionFocus, static_cast<size_t>(FocusSource::COUNT)> foci_{};
+    std::array<bool, static_cast<size_t>(FocusSource::COUNT)> active_{};
+    std::vector<Layer*> layers_;
+};
+
+} // namespace godsim
@@ -5,8 +5,10 @@
 #include "core/time/TickScheduler.h"
 #include "core/rng/RNG.h"
 #include "core/serialise/BinaryStream.h"
+#include "core/serialise/SnapshotVersion.h"
 #include "core/util/Log.h"
 #include "layers/Layer.h"
+#include "simulation/RegionLOD.h"
 
 #include <vector>
 #include <memory>
@@ -16,7 +18,7 @@ namespace godsim {
 
 /// The Simulation is the top-level orchestrator.
 /// It owns the ECS registry, event bus, tick scheduler, RNG,
-/// and all simulation layers.
+/// region level of detail and all simulation layers.
 class Simulation {
 public:
     explicit Simulation(u64 seed = 42)
@@ -45,6 +47,7 @@ public:
         for (auto& layer : layers_) {
             layer->initialise(registry_, event_bus_, rng_);
             tick_scheduler_.register_layer(layer.get());
+            regions_.register_layer(layer.get());
             LOG_INFO("  Registered layer: {} (ID {})",
                      layer->name(), static_cast<int>(layer->id()));
         }
@@ -67,6 +70,7 @@ public:
         }
         LOG_INFO("Final time: {}", tick_scheduler_.current_time().to_string());
         LOG_INFO("Total events logged: {}", event_bus_.log().size());
+        Profiler::instance().log_report();
         LOG_INFO("═══ Shutdown Complete ═══");
     }
 
@@ -94,19 +98,8 @@ public:
 
         // Header
         writer.write_string("GODSIM");
-        writer.write_u32(1); // version
-
-        // Simulation state
-        writer.write_i64(tick_scheduler_.current_time().ticks);
-        writer.write_u64(rng_.seed());
-        writer.write_u64(static_cast<u64>(tick_scheduler_.active_level()));
-
-        // Layer states
-        writer.write_u32(static_cast<u32>(layers_.size()));
-        for (const auto& layer : layers_) {
-            writer.write_u8(static_cast<u8>(layer->id()));
-            layer->serialise(writer);
-        }
+        writer.write_u32(SNAPSHOT_VERSION);
+        write_state(writer);
 
         writer.save_to_file(path);
         LOG_INFO("Snapshot saved ({} bytes)", writer.buffer().size());
@@ -120,15 +113,45 @@ public:
         auto magic = reader.read_string();
         GODSIM_ASSERT(magic == "GODSIM", "Invalid snapshot file");
         auto version = reader.read_u32();
-        GODSIM_ASSERT(version == 1, "Unsupported snapshot version: {}", version);
+        GODSIM_ASSERT(version >= 1 && version <= SNAPSHOT_VERSION,
+                      "Unsupported snapshot version: {}", version);
+        read_state(reader, version);
+
+        LOG_INFO("Snapshot loaded. Time: {}", current_time().to_string());
+    }
 
+    /// Everything a snapshot holds after its header. Also used for
+    /// in-memory keyframes (see Timeline).
+    void write_state(BinaryWriter& writer) const {
+        // Simulation state
+        writer.write_i64(tick_scheduler_.current_time().ticks);
+        rng_.serialise(writer);
+        writer.write_u64(static_cast<u64>(tick_scheduler_.active_level()));
+        regions_.serialise(writer);
+        event_bus_.serialise(writer);
+        writer.write_u64(registry_.next_id());
+
+        // Layer states
+        writer.write_u32(static_cast<u32>(layers_.size()));
+        for (const auto& layer : layers_) {
+            writer.write_u8(static_cast<u8>(layer->id()));
+            layer->serialise(writer);
+        }
+    }
+
+    void read_state(BinaryReader& reader, u32 version = SNAPSHOT_VERSION) {
         // Simulation state
         SimTime time = {reader.read_i64()};
         tick_scheduler_.set_time(time);
-        // RNG seed (we keep the original — determinism from here)
-        reader.read_u64();
+        // Before version 4 only the seed was kept, so the RNG carries on
+        // from wherever it is
+        if (version >= 4) rng_.deserialise(reader);
+        else reader.read_u64();
         size_t active_level = static_cast<size_t>(reader.read_u64());
         tick_scheduler_.set_active_level(active_level);
+        if (version >= 2) regions_.deserialise(reader);
+        if (version >= 3) event_bus_.deserialise(reader);
+        if (version >= 5) registry_.set_next_id(reader.read_u64());
 
         // Layer states
         u32 layer_count = reader.read_u32();
@@ -137,13 +160,11 @@ public:
             // Find the matching layer and deserialise
             for (auto& layer : layers_) {
                 if (layer->id() == layer_id) {
-                    layer->deserialise(reader);
+                    layer->deserialise(reader, version);
                     break;
                 }
             }
         }
-
-        LOG_INFO("Snapshot loaded. Time: {}", time.to_string());
     }
 
     // ─── Access ───
@@ -152,12 +173,14 @@ public:
     EventBus&           event_bus() { return event_bus_; }
     RNG&                rng()       { return rng_; }
     TickScheduler&      scheduler() { return tick_scheduler_; }
+    RegionLOD&          regions()   { return regions_; }
 
 private:
     RNG            rng_;
     Registry       registry_;
     EventBus       event_bus_;
     TickScheduler  tick_scheduler_;
+    RegionLOD      regions_;
 
     std::vector<std::unique_ptr<Layer>> layers_;
 };
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "core/serialise/BinaryStream.h"
+#include "core/util/Assert.h"
+#include "core/util/Profiler.h"
+#include "core/util/Types.h"
+#include "simulation/Simulation.h"
+
+#include <lz4.h>
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <functional>
+#include <vector>
+
+namespace godsim {
+
+struct TimelineConfig {
+    f64 rewind_budget_ms = 250.0; // Worst-case rewind latency aimed for
+    u32 max_keyframes = 64;
+    std::function<f64()> clock_ms; // Monotonic ms that steps and restores are timed by; steady clock if unset
+};
+
+/// In-memory rewind for a Simulation: LZ4-compressed keyframes of the
+/// full state, plus a journal of every intervention made between steps.
+/// rewind_to() restores the nearest keyframe at or before the target and
+/// replays the steps from there, re-applying the journal, which lands on
+/// exactly the state the simulation had, since stepping is deterministic
+/// given the state and the interventions.
+///
+/// Keyframe spacing adapts to what replay costs: a keyframe is taken once
+/// the measured time of the steps since the last one, plus the time a
+/// restore takes, reaches the rewind budget. Cheap steps get sparse
+/// keyframes, expensive ones dense, and rewinding anywhere takes about the
+/// budget at most. Past max_keyframes the oldest is dropped with the
+/// journal before it, which moves horizon() forward.
+///
+/// Drive the simulation through the timeline: steps and interventions made
+/// on the Simulation directly are not journalled and replay won't see
+/// them. Rewinding discards the future beyond the target; fork a branch
+/// (BranchManager) before rewinding to keep it.
+class Timeline {
+public:
+    /// A change made between steps: player actions, tick level changes,
+    /// events emitted from outside the simulation.
+    using Intervention = std::function<void(Simulation&)>;
+
+    explicit Timeline(Simulation& sim, TimelineConfig config = {}) : sim_(sim), config_(config) {
+        GODSIM_ASSERT(config_.max_keyframes >= 1, "Timeline needs room for a keyframe");
+        if (!config_.clock_ms) config_.clock_ms = steady_ms;
+        restart();
+    }
+
+    /// Forget all history and start recording from the current state, as
+    /// after switching branches.
+    void restart() {
+        keyframes_.clear();
+        journal_.clear();
+        times_.assign(1, sim_.current_time());
+        step_ = 0;
+        capture();
+    }
+
+    // ─── Recording ───
+
+    /// Advance one tick at the active level, taking a keyframe if the
+    /// rewind budget calls for one.
+    SimTime step() {
+        f64 start = config_.clock_ms();
+        sim_.run(1);
+        replay_ms_ += elapsed_ms(start);
+        step_++;
+        times_.push_back(sim_.current_time());
+        if (replay_ms_ + restore_ms_ >= config_.rewind_budget_ms) capture();
+        return sim_.current_time();
+    }
+
+    SimTime run(size_t num_ticks) {
+        for (size_t i = 0; i < num_ticks; i++) step();
+        return sim_.current_time();
+    }
+
+    /// Apply `fn` now and journal it for replay.
+    void intervene(Intervention fn) {
+        fn(sim_);
+        journal_.push_back({step_, std::move(fn)});
+    }
+
+    // ─── Rewind ───
+
+    /// Restore the state as it was after the last step ending at or before
+    /// `time`, before any interventions made there. False if that is before
+    /// horizon().
+    bool rewind_to(SimTime time) {
+        if (time < horizon()) return false;
+        ProfileScope scope("Timeline.rewind");
+
+        u64 target = base_step() + static_cast<u64>(
+            std::upper_bound(times_.begin(), times_.end(), time) - times_.begin()) - 1;
+        auto key = std::upper_bound(keyframes_.begin(), keyframes_.end(), target,
+                                    [](u64 s, const Keyframe& k) { return s < k.step; }) - 1;
+
+        f64 start = config_.clock_ms();
+        restore(*key);
+        f64 restore_ms = elapsed_ms(start);
+        restore_ms_ = restore_measured_ ? 0.75 * restore_ms_ + 0.25 * restore_ms : restore_ms;
+        restore_measured_ = true;
+
+        start = config_.clock_ms();
+        auto next = std::lower_bound(journal_.begin(), journal_.end(), key->step,
+                                     [](const Entry& e, u64 s) { return e.step < s; });
+        for (u64 s = key->step; s < target; s++) {
+            for (; next != journal_.end() && next->step == s; ++next) next->fn(sim_);
+            sim_.run(1);
+        }
+        replay_ms_ = elapsed_ms(start);
+
+        // The future beyond the target is gone
+        keyframes_.erase(key + 1, keyframes_.end());
+        journal_.erase(std::lower_bound(journal_.begin(), journal_.end(), target,
+                                        [](const Entry& e, u64 s) { return e.step < s; }),
+                       journal_.end());
+        times_.resize(static_cast<size_t>(target - base_step() + 1));
+        step_ = target;
+        return true;
+    }
+
+    // ─── Queries ───
+
+    /// Earliest time rewind_to() can reach.
+    SimTime horizon() const { return times_.front(); }
+    u64     step_count() const { return step_; }
+
+    size_t keyframe_count() const { return keyframes_.size(); }
+    size_t journal_size() const { return journal_.size(); }
+
+    /// Compressed bytes held by keyframes.
+    size_t keyframe_bytes() const {
+        size_t total = 0;
+        for (const auto& k : keyframes_) total += k.data.size();
+        return total;
+    }
+
+    /// What rewinding to now would cost, by current measurements.
+    f64 rewind_estimate_ms() const { return restore_ms_ + replay_ms_; }
+
+private:
+    struct Keyframe {
+        u64 step;
+        size_t log_size;  // Events logged by then
+        u32 raw_size;
+        std::vector<u8> data;
+    };
+
+    struct Entry {
+        u64 step; // Applied after this many steps
+        Intervention fn;
+    };
+
+    static f64 steady_ms() {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return std::chrono::duration<f64, std::milli>(now).count();
+    }
+
+    f64 elapsed_ms(f64 start) const { return config_.clock_ms() - start; }
+
+    u64 base_step() const { return keyframes_.front().step; }
+
+    void capture() {
+        ProfileScope scope("Timeline.keyframe");
+        f64 start = config_.clock_ms();
+        BinaryWriter writer;
+        sim_.write_state(writer);
+        const auto& raw = writer.buffer();
+        GODSIM_ASSERT(raw.size() <= static_cast<size_t>(LZ4_MAX_INPUT_SIZE), "Keyframe too large for LZ4");
+
+        Keyframe key;
+        key.step = step_;
+        key.log_size = sim_.event_bus().log().size();
+        key.raw_size = static_cast<u32>(raw.size());
+        key.data.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(raw.size()))));
+        int packed = LZ4_compress_default(reinterpret_cast<const char*>(raw.data()),
+                                          reinterpret_cast<char*>(key.data.data()),
+                                          static_cast<int>(raw.size()), static_cast<int>(key.data.size()));
+        GODSIM_ASSERT(packed > 0, "LZ4 compression failed");
+        key.data.resize(static_cast<size_t>(packed));
+        key.data.shrink_to_fit();
+        keyframes_.push_back(std::move(key));
+        replay_ms_ = 0.0;
+
+        // Until a rewind is measured, assume restoring costs what capturing did
+        if (!restore_measured_) restore_ms_ = elapsed_ms(start);
+
+        if (keyframes_.size() > config_.max_keyframes) {
+            u64 dropped = base_step();
+            keyframes_.pop_front();
+            u64 base = base_step();
+            journal_.erase(journal_.begin(),
+                           std::lower_bound(journal_.begin(), journal_.end(), base,
+                                            [](const Entry& e, u64 s) { return e.step < s; }));
+            times_.erase(times_.begin(), times_.begin() + static_cast<std::ptrdiff_t>(base - dropped));
+        }
+    }
+
+    void restore(const Keyframe& key) {
+        std::vector<u8> raw(key.raw_size);
+        int size = LZ4_decompress_safe(reinterpret_cast<const char*>(key.data.data()),
+                                       reinterpret_cast<char*>(raw.data()),
+                                       static_cast<int>(key.data.size()), static_cast<int>(raw.size()));
+        GODSIM_ASSERT(size == static_cast<int>(key.raw_size), "Corrupt keyframe");
+        BinaryReader reader(raw);
+        sim_.read_state(reader);
+        sim_.event_bus().log().truncate_to(key.log_size);
+    }
+
+    Simulation& sim_;
+    TimelineConfig config_;
+    std::deque<Keyframe> keyframes_;
+    std::deque<Entry> journal_;  // Sorted by step
+    std::deque<SimTime> times_;  // Time after each step from base_step()
+    u64 step_ = 0;
+    f64 replay_ms_ = 0.0;        // Step time since the last keyframe
+    f64 restore_ms_ = 0.0;
+    bool restore_measured_ = false;
+};
+
+} // namespace godsim
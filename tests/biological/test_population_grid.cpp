@@ -0,0 +1,363 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/biological/PopulationGrid.h"
+#include "layers/biological/BiologicalLayer.h"
+#include "simulation/Simulation.h"
+
+#include <cmath>
+
+using namespace godsim;
+
+static SpeciesTraits uniform_species(f32 growth, f32 diffusion, f32 capacity) {
+    SpeciesTraits traits;
+    traits.name = "test";
+    traits.growth_rate = growth;
+    traits.diffusion = diffusion;
+    traits.capacity.fill(capacity);
+    return traits;
+}
+
+static PopulationGrid make_grid(u32 w, u32 h, BiomeType biome = BiomeType::TemperateForest) {
+    PopulationGrid grid;
+    grid.reset(w, h);
+    grid.set_biomes(std::vector<BiomeType>(static_cast<size_t>(w) * h, biome));
+    return grid;
+}
+
+// ═══ Population Grid Tests ═══
+
+TEST_CASE("Diffusion alone conserves population across the seam and poles", "[population]") {
+    auto grid = make_grid(64, 32);
+    u32 s = grid.add_species(uniform_species(0.0f, 0.5f, 1.0f));
+    grid.density(s)[0] = 1.0f;                 // Corner cell: seam and pole at once
+    grid.density(s)[31 * 64 + 40] = 0.5f;
+    f64 before = grid.total(s);
+
+    grid.step(20.0f);
+
+    REQUIRE(std::abs(grid.total(s) - before) < 1e-5 * before);
+    // Spread wrapped west across the seam
+    REQUIRE(grid.at(s, 63, 0) > 0.0f);
+    REQUIRE(std::abs(grid.at(s, 63, 0) - grid.at(s, 1, 0)) < 1e-6f);
+}
+
+TEST_CASE("Growth saturates at the biome carrying capacity", "[population]") {
+    auto grid = make_grid(16, 8);
+    u32 s = grid.add_species(uniform_species(0.5f, 0.0f, 0.7f));
+    for (u32 i = 0; i < grid.cells(); i++) grid.density(s)[i] = 0.01f;
+
+    for (int i = 0; i < 20; i++) grid.step(10.0f);
+
+    for (u32 y = 0; y < 8; y++)
+        for (u32 x = 0; x < 16; x++) REQUIRE(std::abs(grid.at(s, x, y) - 0.7f) < 1e-4f);
+}
+
+TEST_CASE("Species die out in biomes they cannot live in", "[population]") {
+    auto grid = make_grid(32, 8);
+    std::vector<BiomeType> biomes(grid.cells(), BiomeType::TemperateForest);
+    for (u32 y = 0; y < 8; y++)
+        for (u32 x = 16; x < 32; x++) biomes[y * 32 + x] = BiomeType::Ocean;
+    grid.set_biomes(biomes);
+
+    SpeciesTraits traits = uniform_species(0.3f, 0.05f, 1.0f);
+    traits.capacity[static_cast<size_t>(BiomeType::Ocean)] = 0.0f;
+    u32 s = grid.add_species(traits);
+    grid.seed(s, 8, 4, 3);
+
+    for (int i = 0; i < 10; i++) grid.step(100.0f);
+
+    REQUIRE(std::abs(grid.at(s, 8, 4) - 1.0f) < 1e-3f);
+    REQUIRE(grid.at(s, 24, 4) < 1e-6f);
+    REQUIRE(grid.at(s, 0, 4) > 0.5f); // Spread reached the far edge of the land
+}
+
+TEST_CASE("Species evolve independently and match the scalar stencil", "[population]") {
+    auto grid = make_grid(40, 12);
+    u32 a = grid.add_species(uniform_species(0.2f, 0.1f, 1.0f));
+    u32 b = grid.add_species(uniform_species(0.0f, 0.0f, 1.0f));
+    grid.seed(a, 20, 6, 3, 0.5f);
+    grid.seed(b, 5, 5, 1, 0.25f);
+    std::vector<f32> expected(grid.density(a), grid.density(a) + grid.cells());
+    std::vector<f32> untouched(grid.density(b), grid.density(b) + grid.cells());
+
+    // One sub-step by hand (d = 0.1, exact logistic with K = 1)
+    f32 d = 0.1f, e = std::exp(0.2f);
+    std::vector<f32> ref(expected.size());
+    for (u32 y = 0; y < 12; y++) {
+        for (u32 x = 0; x < 40; x++) {
+            auto n = [&](i32 xx, i32 yy) {
+                yy = std::clamp(yy, 0, 11);
+                return expected[yy * 40 + ((xx + 40) % 40)];
+            };
+            i32 xi = static_cast<i32>(x), yi = static_cast<i32>(y);
+            f32 m = n(xi, yi) + d * (n(xi - 1, yi) + n(xi + 1, yi) + n(xi, yi - 1) +
+                                     n(xi, yi + 1) - 4.0f * n(xi, yi));
+            ref[y * 40 + x] = m * e / (1.0f + m * (e - 1.0f));
+        }
+    }
+    grid.step(1.0f);
+    REQUIRE(grid.substeps(1.0f) == 1);
+
+    for (u32 i = 0; i < grid.cells(); i++) {
+        REQUIRE(std::abs(grid.density(a)[i] - ref[i]) < 1e-6f);
+        REQUIRE(grid.density(b)[i] == untouched[i]);
+    }
+}
+
+TEST_CASE("PopulationGrid serialise round-trip", "[population]") {
+    auto grid = make_grid(24, 12, BiomeType::Savanna);
+    SpeciesTraits traits = uniform_species(0.1f, 0.02f, 0.8f);
+    traits.name = "grazer";
+    traits.capacity[static_cast<size_t>(BiomeType::Desert)] = 0.1f;
+    u32 s = grid.add_species(traits);
+    grid.seed(s, 3, 6, 2);
+    grid.step(50.0f);
+
+    BinaryWriter writer;
+    grid.serialise(writer);
+    PopulationGrid restored = make_grid(24, 12, BiomeType::Savanna);
+    BinaryReader reader(writer.buffer());
+    restored.deserialise(reader);
+
+    REQUIRE(restored.species_count() == 1);
+    REQUIRE(restored.traits(0).name == "grazer");
+    REQUIRE(restored.traits(0).capacity[static_cast<size_t>(BiomeType::Desert)] == 0.1f);
+    for (u32 i = 0; i < grid.cells(); i++) REQUIRE(restored.density(0)[i] == grid.density(0)[i]);
+
+    grid.step(50.0f);
+    restored.step(50.0f);
+    REQUIRE(restored.total(0) == grid.total(0));
+}
+
+TEST_CASE("BiologicalLayer steps populations on its tick", "[population]") {
+    Simulation sim(7);
+    auto* bio = sim.add_layer<BiologicalLayer>();
+    sim.initialise();
+
+    PlanetData planet;
+    planet.width = 64;
+    planet.height = 32;
+    planet.biome_map.assign(64 * 32, BiomeType::TemperateGrassland);
+    bio->populate(planet, 4);
+    REQUIRE(bio->populations().species_count() == 4);
+
+    f64 before = 0.0;
+    for (u32 s = 0; s < 4; s++) before += bio->populations().total(s);
+    sim.set_tick_level(2); // Evolution
+    sim.run(3);
+    f64 after = 0.0;
+    for (u32 s = 0; s < 4; s++) after += bio->populations().total(s);
+    REQUIRE(after > before);
+    sim.shutdown();
+}
+
+TEST_CASE("BiologicalLayer reads version 1 snapshots without populations", "[population]") {
+    Simulation sim(7);
+    auto* bio = sim.add_layer<BiologicalLayer>();
+    sim.initialise();
+    PlanetData planet;
+    planet.width = 64;
+    planet.height = 32;
+    planet.biome_map.assign(64 * 32, BiomeType::TemperateGrassland);
+    bio->populate(planet, 2);
+
+    BinaryWriter writer;
+    writer.write_u64(9); // Version 1 kept the tick count alone
+    BinaryReader reader(writer.buffer());
+    bio->deserialise(reader, 1);
+    REQUIRE(reader.at_end());
+    REQUIRE(bio->tick_count() == 9);
+    REQUIRE(bio->populations().species_count() == 2);
+    sim.shutdown();
+}
+
+// ═══ Active Tile Tests ═══
+
+TEST_CASE("Steps visit only occupied tiles and their neighbours", "[population]") {
+    auto grid = make_grid(256, 128); // 8 × 4 tiles
+    u32 s = grid.add_species(uniform_species(0.2f, 0.05f, 1.0f));
+    grid.seed(s, 48, 48, 3); // Inside tile (1, 1)
+
+    grid.step(1.0f);
+    REQUIRE(grid.active_tiles() == 5);
+    REQUIRE(grid.tile_occupied(s, 1, 1));
+    REQUIRE_FALSE(grid.tile_occupied(s, 5, 2));
+
+    for (u32 y = 0; y < 128; y++)
+        for (u32 x = 128; x < 256; x++) REQUIRE(grid.at(s, x, y) == 0.0f);
+}
+
+TEST_CASE("Spread wakes neighbouring tiles across the seam", "[population]") {
+    auto grid = make_grid(128, 64); // 4 × 2 tiles
+    u32 s = grid.add_species(uniform_species(0.5f, 0.2f, 1.0f));
+    grid.seed(s, 2, 28, 2);
+    REQUIRE(grid.tile_occupied(s, 0, 0));
+    REQUIRE_FALSE(grid.tile_occupied(s, 3, 0));
+
+    grid.step(20.0f);
+    REQUIRE(grid.tile_occupied(s, 3, 0)); // West across longitude 0
+    REQUIRE(grid.at(s, 127, 28) > 0.0f);
+    REQUIRE(grid.tile_occupied(s, 0, 1)); // South across the tile row
+    REQUIRE_FALSE(grid.tile_occupied(s, 2, 0));
+}
+
+TEST_CASE("Tiles a species dies out of stop being stepped", "[population]") {
+    auto grid = make_grid(96, 32);
+    std::vector<BiomeType> biomes(grid.cells(), BiomeType::Desert);
+    grid.set_biomes(biomes);
+    SpeciesTraits traits = uniform_species(0.5f, 0.01f, 1.0f);
+    traits.capacity[static_cast<size_t>(BiomeType::Desert)] = 0.0f;
+    u32 s = grid.add_species(traits);
+    for (u32 x = 40; x < 50; x++) grid.density(s)[10 * 96 + x] = 0.5f;
+
+    grid.step(1.0f);
+    grid.step(1.0f);
+    REQUIRE(grid.total(s) == 0.0);
+    grid.step(1.0f);
+    REQUIRE(grid.active_tiles() == 0);
+}
+
+// ═══ Level of Detail Tests ═══
+
+TEST_CASE("Dehydrating and hydrating tiles conserves totals", "[population]") {
+    auto grid = make_grid(128, 64); // 4 × 2 tiles
+    std::vector<BiomeType> biomes(grid.cells(), BiomeType::TemperateForest);
+    for (u32 y = 0; y < 64; y++)
+        for (u32 x = 0; x < 16; x++) biomes[y * 128 + x] = BiomeType::Desert;
+    grid.set_biomes(biomes);
+    SpeciesTraits traits = uniform_species(0.3f, 0.05f, 1.0f);
+    traits.capacity[static_cast<size_t>(BiomeType::Desert)] = 0.25f;
+    u32 a = grid.add_species(traits);
+    u32 b = grid.add_species(uniform_species(0.1f, 0.01f, 0.5f));
+    grid.seed(a, 10, 10, 8, 0.7f);
+    grid.seed(b, 20, 20, 4, 0.3f);
+    f64 tile_a = grid.tile_total(a, 0), tile_b = grid.tile_total(b, 0);
+
+    grid.dehydrate_tile(0);
+    REQUIRE_FALSE(grid.hydrated(0));
+    REQUIRE(grid.coarse_tile_count() == 1);
+    REQUIRE(grid.at(a, 10, 10) == 0.0f);
+    REQUIRE(std::abs(grid.tile_total(a, 0) - tile_a) < 1e-6 * tile_a);
+    REQUIRE(std::abs(grid.tile_total(b, 0) - tile_b) < 1e-6 * tile_b);
+
+    grid.hydrate_tile(0);
+    REQUIRE(grid.hydrated(0));
+    REQUIRE(std::abs(grid.tile_total(a, 0) - tile_a) < 1e-5 * tile_a);
+    REQUIRE(std::abs(grid.tile_total(b, 0) - tile_b) < 1e-5 * tile_b);
+    // Spread by capacity: desert cells get a quarter of a forest cell's share
+    REQUIRE(std::abs(grid.at(a, 5, 30) * 4.0f - grid.at(a, 25, 30)) < 1e-6f);
+}
+
+TEST_CASE("Diffusion conserves population across hydrated and coarse tiles", "[population]") {
+    auto grid = make_grid(128, 96); // 4 × 3 tiles
+    u32 s = grid.add_species(uniform_species(0.0f, 0.5f, 1.0f));
+    grid.seed(s, 48, 48, 6, 0.8f); // Tile (1, 1)
+    grid.density(s)[5 * 128 + 120] = 0.9f; // Tile (3, 0)
+    // Checkerboard of coarse tiles, with the seed's tile hydrated
+    for (u32 t = 0; t < grid.tile_count(); t++) {
+        if ((t % 4 + t / 4) % 2 == 1) grid.dehydrate_tile(t);
+    }
+    REQUIRE(grid.hydrated(5));
+    REQUIRE_FALSE(grid.hydrated(3));
+    f64 before = grid.total(s);
+
+    for (int i = 0; i < 20; i++) grid.step(5.0f);
+
+    REQUIRE(std::abs(grid.total(s) - before) < 1e-4 * before);
+    REQUIRE(grid.tile_total(s, 4) > 0.0);  // Coarse tile (0, 1) filled from (1, 1)
+    REQUIRE(grid.tile_total(s, 7) > 0.0);  // Hydrated (3, 1), across the seam from it
+    REQUIRE(grid.tile_total(s, 8) > 0.0);  // Hydrated (0, 2), fed through coarse ones
+    for (u32 t = 0; t < grid.tile_count(); t++) REQUIRE(grid.tile_total(s, t) >= 0.0);
+}
+
+TEST_CASE("Coarse tiles grow to their total capacity", "[population]") {
+    auto grid = make_grid(64, 32);
+    std::vector<BiomeType> biomes(grid.cells(), BiomeType::TemperateForest);
+    for (u32 y = 0; y < 32; y++)
+        for (u32 x = 0; x < 8; x++) biomes[y * 64 + x] = BiomeType::Ice;
+    grid.set_biomes(biomes);
+    SpeciesTraits traits = uniform_species(0.5f, 0.0f, 0.6f);
+    traits.capacity[static_cast<size_t>(BiomeType::Ice)] = 0.0f;
+    u32 s = grid.add_species(traits);
+    grid.seed(s, 20, 16, 3, 0.1f);
+    grid.dehydrate_tile(0);
+    grid.dehydrate_tile(1);
+
+    grid.step(100.0f);
+    f64 limit = 0.6 * 24 * 32; // Forest cells of tile 0
+    REQUIRE(std::abs(grid.tile_total(s, 0) - limit) < 1e-3 * limit);
+    REQUIRE(grid.tile_total(s, 1) == 0.0); // No dispersal, nobody there
+
+    grid.hydrate_tile(0);
+    REQUIRE(grid.at(s, 3, 3) == 0.0f); // None placed on the ice
+    REQUIRE(std::abs(grid.at(s, 20, 3) - 0.6f) < 1e-3f);
+}
+
+TEST_CASE("Coarse tiles settle where full detail does", "[population]") {
+    auto fine = make_grid(256, 128);
+    std::vector<BiomeType> biomes(fine.cells(), BiomeType::TemperateForest);
+    for (u32 i = 0; i < biomes.size(); i++) {
+        if ((i % 256) / 20 % 3 == 0) biomes[i] = BiomeType::Savanna;
+    }
+    fine.set_biomes(biomes);
+    SpeciesTraits traits = uniform_species(0.2f, 0.3f, 0.8f);
+    traits.capacity[static_cast<size_t>(BiomeType::Savanna)] = 0.3f;
+    u32 s = fine.add_species(traits);
+    fine.seed(s, 40, 60, 10, 0.5f);
+    PopulationGrid coarse = fine;
+    for (u32 t = 0; t < coarse.tile_count(); t++) {
+        if (t != 9) coarse.dehydrate_tile(t); // All but the seed's tile (1, 1)
+    }
+
+    // Well mixed, a coarse tile grows everywhere at once and runs ahead
+    // of a front; once both have filled the planet they agree
+    for (int i = 0; i < 30; i++) {
+        fine.step(50.0f);
+        coarse.step(50.0f);
+    }
+    f64 f = fine.total(s), c = coarse.total(s);
+    REQUIRE(std::abs(c - f) < 0.02 * f);
+}
+
+TEST_CASE("PopulationGrid snapshot keeps coarse tiles coarse", "[population]") {
+    auto grid = make_grid(64, 64);
+    u32 s = grid.add_species(uniform_species(0.1f, 0.05f, 1.0f));
+    grid.seed(s, 10, 10, 5, 0.5f);
+    grid.dehydrate_tile(0);
+    grid.dehydrate_tile(3);
+    grid.step(10.0f);
+
+    BinaryWriter writer;
+    grid.serialise(writer);
+    PopulationGrid restored = make_grid(64, 64);
+    BinaryReader reader(writer.buffer());
+    restored.deserialise(reader);
+    REQUIRE(restored.coarse_tile_count() == 2);
+    REQUIRE_FALSE(restored.hydrated(0));
+    REQUIRE(restored.tile_total(s, 0) == grid.tile_total(s, 0));
+
+    grid.step(10.0f);
+    restored.step(10.0f);
+    REQUIRE(restored.total(s) == grid.total(s));
+}
+
+TEST_CASE("BiologicalLayer samples the planet's seasons", "[population]") {
+    Simulation sim(7);
+    auto* bio = sim.add_layer<BiologicalLayer>();
+    sim.initialise();
+
+    PlanetData planet;
+    planet.width = 64;
+    planet.height = 32;
+    planet.biome_map.assign(64 * 32, BiomeType::TemperateGrassland);
+    planet.temperature = Heightmap(64, 32, 10.0f);
+    planet.moisture = Heightmap(64, 32, 0.5f);
+    planet.seasons = SeasonalClimate(64, 32, 1);
+    planet.seasons.temperature[(8 * 64 + 5) * 2] = -12.0f; // Coldest at the equinox
+    bio->populate(planet, 1);
+
+    REQUIRE(bio->season_at(5, 8, SimTime::from_days(0)).temperature == -2.0f);
+    REQUIRE(std::abs(bio->season_at(5, 8, SimTime::from_days(365 * 3 + 183)).temperature - 22.0f) < 0.1f);
+    REQUIRE(bio->season_at(6, 8, SimTime::from_days(0)).temperature == 10.0f);
+    REQUIRE(bio->season_at(5, 8, SimTime::from_days(90)).moisture == 0.5f);
+    sim.shutdown();
+}
@@ -0,0 +1,165 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/civilisation/CivilisationLayer.h"
+#include "layers/civilisation/SettlementPool.h"
+#include "simulation/Simulation.h"
+#include "support/TestPlanet.h"
+
+#include <chrono>
+
+using namespace godsim;
+
+static EntityID eid(u64 n) { return EntityID::create(LayerID::Civilisation, n); }
+
+// ═══ Settlement Pool Tests ═══
+
+TEST_CASE("SettlementPool swap-remove keeps entity lookup aligned", "[settlement]") {
+    SettlementPool pool;
+    for (u64 i = 1; i <= 4; i++) pool.add(eid(i), static_cast<u32>(i * 10), 100.0f * i, 0.02f);
+
+    pool.remove(1); // eid(2); eid(4) moves into slot 1
+    REQUIRE(pool.size() == 3);
+    REQUIRE(pool.index_of(eid(2)) == -1);
+    REQUIRE(pool.index_of(eid(4)) == 1);
+    REQUIRE(pool.cell[1] == 40);
+    REQUIRE(pool.population[1] == 400.0f);
+
+    pool.remove(2); // Last element
+    REQUIRE(pool.index_of(eid(3)) == -1);
+    REQUIRE(pool.index_of(eid(1)) == 0);
+}
+
+TEST_CASE("Settlements grow towards what their land supports", "[settlement]") {
+    PlanetData planet = make_test_planet(8, 8, {.temperature = 16.0f, .biome = BiomeType::TemperateGrassland});
+    SettlementParams params;
+    SettlementPool pool;
+    pool.add(eid(1), 0, 500.0f, 0.03f);
+
+    for (int year = 0; year < 1000; year++) {
+        sample_environment(pool, planet, params);
+        update_settlements(pool, params, 1.0f);
+    }
+    f32 capacity = 1.0f / pool.inv_capacity[0];
+    REQUIRE(capacity == params.people_per_cell * 0.9f);
+    REQUIRE(pool.population[0] > 0.95f * capacity);
+    REQUIRE(pool.population[0] <= capacity * 1.001f);
+    REQUIRE(pool.food[0] > 0.0f);
+    REQUIRE(pool.wealth[0] > 0.0f);
+}
+
+TEST_CASE("Settlements starve on land that cannot feed them", "[settlement]") {
+    SettlementParams params;
+    SettlementPool pool;
+    pool.add(eid(1), 0, 500.0f, 0.03f);
+    pool.add(eid(2), 1, 500.0f, 0.03f);
+    pool.add(eid(3), 2, 500.0f, 0.03f);
+    PlanetData planet = make_test_planet(8, 8, {.temperature = 16.0f, .biome = BiomeType::TemperateGrassland});
+    planet.biome_map[0] = BiomeType::Desert;
+    planet.temperature.set(1, 0, 50.0f); // Far outside the comfort range
+
+    for (int year = 0; year < 300; year++) {
+        sample_environment(pool, planet, params);
+        update_settlements(pool, params, 1.0f);
+    }
+    REQUIRE(pool.population[0] < CivilisationLayer::ABANDON_POPULATION);
+    REQUIRE(pool.food[0] == 0.0f);
+    REQUIRE(pool.population[1] > 500.0f);
+    REQUIRE(pool.population[1] < 0.6f * pool.population[2]);
+}
+
+// ═══ Civilisation Layer Tests ═══
+
+TEST_CASE("CivilisationLayer founds, grows and spreads settlements", "[settlement]") {
+    PlanetData planet = make_test_planet(64, 32, {.temperature = 16.0f, .biome = BiomeType::TemperateForest});
+    Simulation sim(11);
+    auto* civ = sim.add_layer<CivilisationLayer>();
+    sim.initialise();
+    civ->settle(planet, 8);
+    REQUIRE(civ->settlements().size() == 8);
+    REQUIRE(sim.registry().spatial().size() == 8);
+
+    sim.set_tick_level(1); // One year per tick
+    sim.run(400);
+
+    const auto& pool = civ->settlements();
+    REQUIRE(pool.size() > 8);
+    REQUIRE(sim.registry().spatial().size() == pool.size());
+    for (size_t i = 0; i < pool.size(); i++) {
+        CellLocation loc;
+        REQUIRE(sim.registry().spatial().location(pool.entity[i], loc));
+        REQUIRE(static_cast<u32>(loc.y) * 64 + static_cast<u32>(loc.x) == pool.cell[i]);
+    }
+    REQUIRE(Profiler::instance().section("Civilisation.economy").calls >= 400);
+    sim.shutdown();
+}
+
+TEST_CASE("CivilisationLayer snapshot restores settlements", "[settlement]") {
+    PlanetData planet = make_test_planet(64, 32, {.temperature = 16.0f, .biome = BiomeType::Savanna});
+    Simulation sim(3);
+    auto* civ = sim.add_layer<CivilisationLayer>();
+    sim.initialise();
+    civ->settle(planet, 5);
+    sim.set_tick_level(1);
+    sim.run(20);
+
+    f64 people = civ->settlements().total_population();
+    std::vector<u32> cells = civ->settlements().cell;
+    BinaryWriter writer;
+    civ->serialise(writer);
+    sim.run(20);
+
+    BinaryReader reader(writer.buffer());
+    civ->deserialise(reader, SNAPSHOT_VERSION);
+    REQUIRE(civ->settlements().cell == cells);
+    REQUIRE(civ->settlements().total_population() == people);
+    REQUIRE(sim.registry().spatial().size() == cells.size());
+
+    // Version 1 kept the tick count alone; the settlements stay as they are
+    BinaryWriter old;
+    old.write_u64(4);
+    BinaryReader old_reader(old.buffer());
+    civ->deserialise(old_reader, 1);
+    REQUIRE(old_reader.at_end());
+    REQUIRE(civ->tick_count() == 4);
+    REQUIRE(civ->settlements().cell == cells);
+    sim.shutdown();
+}
+
+TEST_CASE("Settlement systems handle 100k settlements per yearly tick", "[settlement][!benchmark]") {
+    PlanetData planet = make_test_planet(1024, 512, {.temperature = 16.0f, .biome = BiomeType::TemperateGrassland});
+    SettlementParams params;
+    SettlementPool pool;
+    for (u32 i = 0; i < 100000; i++) pool.add(eid(i + 1), (i * 2654435761u) % (1024 * 512), 300.0f, 0.02f);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int year = 0; year < 10; year++) {
+        sample_environment(pool, planet, params);
+        update_settlements(pool, params, 1.0f);
+    }
+    f64 ms = std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now() - start).count();
+    REQUIRE(pool.population[0] > 300.0f);
+    REQUIRE(ms / 10.0 < 50.0); // Generous: a few ms on one core
+}
+
+TEST_CASE("CivilisationLayer routes between its settlements", "[settlement]") {
+    PlanetData planet = make_test_planet(64, 32, {.temperature = 16.0f, .biome = BiomeType::TemperateGrassland});
+    Simulation sim(5);
+    auto* civ = sim.add_layer<CivilisationLayer>();
+    sim.initialise();
+    civ->settle(planet, 2);
+    const auto& pool = civ->settlements();
+    auto path = civ->paths().find_path(pool.cell[0], pool.cell[1]);
+    REQUIRE(path.front() == pool.cell[0]);
+    REQUIRE(path.back() == pool.cell[1]);
+
+    // Flood the second village's surroundings; the route goes with it
+    u32 x = pool.cell[1] % 64, y = pool.cell[1] / 64;
+    for (u32 yy = (y > 2 ? y - 2 : 0); yy < std::min(y + 3, 32u); yy++) {
+        for (u32 dx = 0; dx < 5; dx++) planet.biome_map[yy * 64 + (x + 62 + dx) % 64] = BiomeType::Ocean;
+    }
+    planet.biome_map[pool.cell[1]] = BiomeType::TemperateGrassland;
+    DirtyRegion flood(64, 32);
+    flood.add(static_cast<i32>(x) - 2, static_cast<i32>(y) - 2, static_cast<i32>(x) + 3, static_cast<i32>(y) + 3);
+    civ->terrain_changed(flood);
+    REQUIRE(civ->paths().find_path(pool.cell[0], pool.cell[1]).empty());
+    sim.shutdown();
+}
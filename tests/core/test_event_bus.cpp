@@ -118,6 +118,39 @@ TEST_CASE("EventLog truncate_after", "[events]") {
     REQUIRE(log.size() == 5); // days 100, 200, 300, 400, 500
 }
 
+TEST_CASE("EventLog copies share full chunks", "[events]") {
+    EventLog log;
+    for (size_t i = 0; i < EventLog::CHUNK * 2 + 10; i++) {
+        Event e;
+        e.id = i;
+        e.timestamp = SimTime::from_days(static_cast<i64>(i));
+        e.payload = DebugEvent{"event"};
+        log.append(e);
+    }
+    REQUIRE(log.sealed_chunks().size() == 2);
+
+    EventLog branch = log;
+    Event extra;
+    extra.id = 9999;
+    branch.append(extra);
+    REQUIRE(branch.size() == log.size() + 1);
+    REQUIRE(branch.sealed_chunks()[0] == log.sealed_chunks()[0]);
+    REQUIRE(branch.sealed_chunks()[1] == log.sealed_chunks()[1]);
+    REQUIRE(log.back().id == EventLog::CHUNK * 2 + 9);
+
+    // Truncating into a shared chunk leaves the original alone
+    branch.truncate_to(EventLog::CHUNK + 5);
+    REQUIRE(branch.size() == EventLog::CHUNK + 5);
+    REQUIRE(branch.back().id == EventLog::CHUNK + 4);
+    REQUIRE(branch.sealed_chunks()[0] == log.sealed_chunks()[0]);
+    REQUIRE(log.size() == EventLog::CHUNK * 2 + 10);
+
+    branch.truncate_after(SimTime::from_days(100));
+    REQUIRE(branch.size() == 101);
+    size_t n = 0;
+    for (const auto& e : branch) REQUIRE(e.id == n++);
+}
+
 TEST_CASE("EventBus multiple handlers for same type", "[events]") {
     EventBus bus;
 
@@ -135,3 +168,46 @@ TEST_CASE("EventBus multiple handlers for same type", "[events]") {
     REQUIRE(handler1_count == 1);
     REQUIRE(handler2_count == 1);
 }
+
+TEST_CASE("EventBus scheduled events survive serialisation", "[events]") {
+    EventBus bus;
+    bus.schedule(DebugEvent{"flood"}, SimTime::from_years(40), LAYER_BIT(LayerID::Planetary));
+    bus.schedule(EntityCreatedEvent{EntityID::create(LayerID::Civilisation, 9), LayerID::Civilisation},
+                 SimTime::from_days(3));
+    bus.schedule(LayerTickedEvent{LayerID::Biological, SimTime::from_days(5), SimTime::from_days(1)},
+                 SimTime::from_days(3));
+    bus.release_due(SimTime::from_days(1));
+
+    BinaryWriter writer;
+    bus.serialise(writer);
+    EventBus restored;
+    BinaryReader reader(writer.buffer());
+    restored.deserialise(reader);
+    REQUIRE(restored.scheduled_count() == 3);
+
+    std::vector<std::string> seen;
+    restored.subscribe<EntityCreatedEvent>(LayerID::Civilisation, [&](const Event& e, const EntityCreatedEvent& p) {
+        REQUIRE(p.entity == EntityID::create(LayerID::Civilisation, 9));
+        REQUIRE(e.timestamp == SimTime::from_days(3));
+        seen.push_back("created");
+    });
+    restored.subscribe<LayerTickedEvent>(LayerID::Civilisation, [&](const Event&, const LayerTickedEvent& p) {
+        REQUIRE(p.time == SimTime::from_days(5));
+        seen.push_back("ticked");
+    });
+    restored.subscribe<DebugEvent>(LayerID::Planetary, [&](const Event&, const DebugEvent& p) {
+        seen.push_back(p.message);
+    });
+
+    REQUIRE(restored.release_due(SimTime::from_days(3)) == 2);
+    restored.dispatch();
+    REQUIRE(seen == std::vector<std::string>{"created", "ticked"});
+    REQUIRE(restored.release_due(SimTime::from_years(40)) == 1);
+    restored.dispatch();
+    REQUIRE(seen.back() == "flood");
+
+    // Ids carry on where the original left off
+    restored.emit(DebugEvent{"next"}, SimTime::from_years(40));
+    restored.dispatch();
+    REQUIRE(restored.log().back().id == 3);
+}
@@ -83,3 +83,19 @@ TEST_CASE("RNG split is deterministic", "[rng]") {
         REQUIRE(child1.next_u32() == child2.next_u32());
     }
 }
+
+TEST_CASE("RNG state survives serialisation mid-sequence", "[rng]") {
+    RNG rng(77);
+    for (int i = 0; i < 1234; i++) rng.next_u32();
+
+    BinaryWriter writer;
+    rng.serialise(writer);
+    RNG restored(1);
+    BinaryReader reader(writer.buffer());
+    restored.deserialise(reader);
+
+    REQUIRE(restored.seed() == 77);
+    for (int i = 0; i < 100; i++) {
+        REQUIRE(restored.next_u32() == rng.next_u32());
+    }
+}
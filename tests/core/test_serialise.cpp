@@ -1,6 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include <filesystem>
 #include "core/serialise/BinaryStream.h"
+#include "core/serialise/PagedImage.h"
+#include "core/rng/RNG.h"
 #include <cmath>
 
 using namespace godsim;
@@ -85,3 +87,32 @@ TEST_CASE("BinaryStream raw bytes round-trip", "[serialise]") {
     REQUIRE(out[2] == 0xBE);
     REQUIRE(out[3] == 0xEF);
 }
+
+TEST_CASE("PagedImage shares unchanged pages across edits and shifts", "[serialise]") {
+    RNG rng(3);
+    std::vector<u8> data(4 << 20);
+    for (auto& b : data) b = static_cast<u8>(rng.next_u32());
+
+    PagedImage base = PagedImage::build(data);
+    REQUIRE(base.assemble() == data);
+    REQUIRE(base.page_count() > 16);
+
+    // An edit in place copies the page it lands in (and the next, if it
+    // moved a boundary)
+    std::vector<u8> edited = data;
+    edited[1 << 20] ^= 0xFF;
+    PagedImage edit = PagedImage::build(edited, &base);
+    REQUIRE(edit.assemble() == edited);
+    REQUIRE(edit.shared_pages(base) >= base.page_count() - 2);
+
+    // Bytes inserted near the front move everything after them, yet page
+    // boundaries follow the content and most pages still match
+    std::vector<u8> shifted = data;
+    shifted.insert(shifted.begin() + 1000, 37, u8{7});
+    PagedImage shift = PagedImage::build(shifted, &base);
+    REQUIRE(shift.assemble() == shifted);
+    REQUIRE(shift.shared_pages(base) >= base.page_count() - 3);
+
+    size_t all = PagedImage::resident_bytes({&base, &edit, &shift});
+    REQUIRE(all < data.size() + 5 * PagedImage::MAX_PAGE);
+}
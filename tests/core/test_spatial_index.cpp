@@ -0,0 +1,150 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/ecs/Registry.h"
+#include "core/ecs/SpatialIndex.h"
+#include "core/rng/RNG.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godsim;
+
+static EntityID eid(u64 n) { return EntityID::create(LayerID::Civilisation, n); }
+
+static std::vector<u64> ids(std::vector<EntityID> v) {
+    std::vector<u64> out;
+    for (auto e : v) out.push_back(e.id());
+    std::sort(out.begin(), out.end());
+    return out;
+}
+
+// ═══ Spatial Index Tests ═══
+
+TEST_CASE("SpatialIndex rect query wraps across the seam", "[spatial]") {
+    SpatialIndex index;
+    index.reset(100, 50); // Width not a multiple of the bucket size
+    index.place(eid(1), 99.5f, 10.0f);
+    index.place(eid(2), 1.0f, 10.0f);
+    index.place(eid(3), 50.0f, 10.0f);
+    index.place(eid(4), 1.0f, 30.0f);
+
+    REQUIRE(ids(index.query_rect(-2.0f, 5.0f, 3.0f, 15.0f)) == std::vector<u64>{1, 2});
+    REQUIRE(ids(index.query_rect(98.0f, 5.0f, 103.0f, 15.0f)) == std::vector<u64>{1, 2});
+    REQUIRE(ids(index.query_rect(0.0f, 0.0f, 200.0f, 20.0f)) == std::vector<u64>{1, 2, 3});
+    REQUIRE(index.query_rect(10.0f, 0.0f, 40.0f, 50.0f).empty());
+}
+
+TEST_CASE("SpatialIndex radius query measures distance across the seam", "[spatial]") {
+    SpatialIndex index;
+    index.reset(128, 64, 8);
+    index.place(eid(1), 126.0f, 32.0f);
+    index.place(eid(2), 3.0f, 32.0f);
+    index.place(eid(3), 3.0f, 38.0f);
+
+    REQUIRE(ids(index.query_radius(0.5f, 32.0f, 3.0f)) == std::vector<u64>{1, 2});
+    REQUIRE(ids(index.query_radius(0.5f, 32.0f, 7.0f)) == std::vector<u64>{1, 2, 3});
+    REQUIRE(std::abs(index.distance(126.0f, 0.0f, 3.0f, 0.0f) - 5.0f) < 1e-5f);
+}
+
+TEST_CASE("SpatialIndex moves and removes entries", "[spatial]") {
+    SpatialIndex index;
+    index.reset(64, 64);
+    for (u64 i = 1; i <= 5; i++) index.place(eid(i), 2.0f * i, 2.0f);
+    index.place(eid(2), 60.0f, 60.0f); // Into another bucket
+    index.place(eid(3), 7.0f, 3.0f);   // Within its bucket
+    REQUIRE(index.remove(eid(1)));
+    REQUIRE_FALSE(index.remove(eid(1)));
+
+    REQUIRE(index.size() == 4);
+    REQUIRE(ids(index.query_rect(0.0f, 0.0f, 16.0f, 16.0f)) == std::vector<u64>{3, 4, 5});
+    CellLocation loc;
+    REQUIRE(index.location(eid(3), loc));
+    REQUIRE(loc.x == 7.0f);
+    REQUIRE(index.nearest(62.0f, 62.0f) == eid(2));
+}
+
+TEST_CASE("SpatialIndex nearest matches brute force", "[spatial]") {
+    SpatialIndex index;
+    index.reset(256, 128, 16);
+    RNG rng(7);
+    std::vector<CellLocation> points;
+    for (u64 i = 1; i <= 300; i++) {
+        CellLocation p{rng.next_float(0.0f, 256.0f), rng.next_float(0.0f, 128.0f)};
+        points.push_back(p);
+        index.place(eid(i), p.x, p.y);
+    }
+
+    for (int q = 0; q < 200; q++) {
+        f32 cx = rng.next_float(-10.0f, 266.0f), cy = rng.next_float(0.0f, 128.0f);
+        u64 expected = 0;
+        f32 best = 1e30f;
+        for (u64 i = 0; i < points.size(); i++) {
+            f32 d = index.distance(cx, cy, points[i].x, points[i].y);
+            if (d < best) {
+                best = d;
+                expected = i + 1;
+            }
+        }
+        REQUIRE(index.nearest(cx, cy).id() == expected);
+        REQUIRE_FALSE(index.nearest(cx, cy, best * 0.99f).is_valid());
+    }
+
+    // Filtered: nearest with an even id
+    EntityID even = index.nearest_if(128.0f, 64.0f, 1e9f,
+                                     [](const SpatialIndex::Entry& e) { return e.id.id() % 2 == 0; });
+    REQUIRE(even.id() % 2 == 0);
+}
+
+TEST_CASE("SpatialIndex nearest sees across a narrow seam column", "[spatial]") {
+    // 100 cells in 16-cell buckets: the last column is only 4 wide, so the
+    // far side of the seam is closer than whole buckets suggest
+    SpatialIndex index;
+    index.reset(100, 32, 16);
+    index.place(eid(1), 75.0f, 8.0f);
+    index.place(eid(2), 1.0f, 8.0f);
+    REQUIRE(index.nearest(90.0f, 8.0f).id() == 2);
+
+    RNG rng(13);
+    std::vector<CellLocation> points;
+    index.reset(100, 40, 16);
+    for (u64 i = 1; i <= 40; i++) {
+        CellLocation p{rng.next_float(0.0f, 100.0f), rng.next_float(0.0f, 40.0f)};
+        points.push_back(p);
+        index.place(eid(i), p.x, p.y);
+    }
+    for (int q = 0; q < 300; q++) {
+        f32 cx = rng.next_float(0.0f, 100.0f), cy = rng.next_float(0.0f, 40.0f);
+        u64 expected = 0;
+        f32 best = 1e30f;
+        for (u64 i = 0; i < points.size(); i++) {
+            f32 d = index.distance(cx, cy, points[i].x, points[i].y);
+            if (d < best) {
+                best = d;
+                expected = i + 1;
+            }
+        }
+        REQUIRE(index.nearest(cx, cy).id() == expected);
+    }
+}
+
+TEST_CASE("Registry keeps the spatial index in step with locations", "[spatial]") {
+    Registry registry;
+    auto early = registry.create_entity(LayerID::Biological);
+    registry.set_location(early, 10.0f, 10.0f); // Before the index is sized
+
+    registry.configure_spatial(64, 32);
+    REQUIRE(registry.spatial().nearest(0.0f, 0.0f) == early);
+
+    auto town = registry.create_entity(LayerID::Civilisation);
+    registry.set_location(town, 40.0f, 20.0f);
+    REQUIRE(registry.get_component<CellLocation>(town).x == 40.0f);
+    REQUIRE(registry.spatial().query_radius(40.0f, 20.0f, 1.0f) == std::vector<EntityID>{town});
+
+    registry.set_location(town, 2.0f, 12.0f);
+    REQUIRE(registry.spatial().query_radius(40.0f, 20.0f, 1.0f).empty());
+
+    registry.destroy_entity(early);
+    REQUIRE(registry.spatial().nearest(0.0f, 0.0f) == town);
+    registry.clear_location(town);
+    REQUIRE_FALSE(registry.has_component<CellLocation>(town));
+    REQUIRE(registry.spatial().size() == 0);
+}
@@ -54,7 +54,7 @@ public:
     }
 
     void serialise(BinaryWriter&) const override {}
-    void deserialise(BinaryReader&) override {}
+    void deserialise(BinaryReader&, u32) override {}
 
     SimTime last_time_ = {};
     SimTime last_delta_ = {};
@@ -96,6 +96,21 @@ TEST_CASE("TickScheduler ticks layers at correct level", "[time]") {
     REQUIRE(planet.tick_count() == planet_before); // unchanged
 }
 
+TEST_CASE("TickScheduler profiles each layer's ticks under its name", "[time]") {
+    EventBus bus;
+    TickScheduler scheduler(bus);
+    scheduler.add_level({"coarse", SimTime::from_years(1), LAYER_BIT(LayerID::Cosmological)});
+
+    TestLayer cosmo(LayerID::Cosmological, "ProfiledCosmo");
+    TestLayer planet(LayerID::Planetary, "ProfiledPlanet");
+    scheduler.register_layer(&cosmo);
+    scheduler.register_layer(&planet);
+    scheduler.run(3);
+
+    REQUIRE(Profiler::instance().section("ProfiledCosmo.tick").calls == 3);
+    REQUIRE(Profiler::instance().section("ProfiledPlanet.tick").calls == 0);
+}
+
 TEST_CASE("TickScheduler advances time correctly", "[time]") {
     EventBus bus;
     TickScheduler scheduler(bus);
@@ -153,3 +168,49 @@ TEST_CASE("TickScheduler dispatches events after tick", "[time]") {
     // Each step dispatches events (tick event from scheduler itself)
     REQUIRE(events_received >= 5);
 }
+
+TEST_CASE("TickScheduler releases scheduled events on the tick that reaches them", "[time]") {
+    EventBus bus;
+    TickScheduler scheduler(bus);
+    scheduler.configure_defaults();
+
+    std::vector<std::pair<std::string, SimTime>> received;
+    bus.subscribe<DebugEvent>(LayerID::Divine, [&](const Event& e, const DebugEvent& d) {
+        received.push_back({d.message, scheduler.current_time()});
+        REQUIRE(e.timestamp <= scheduler.current_time());
+    });
+
+    bus.schedule(DebugEvent{"tomorrow"}, SimTime::from_days(1));
+    bus.schedule(DebugEvent{"harvest"}, SimTime::from_days(200));
+    bus.schedule(DebugEvent{"comet"}, SimTime::from_megayears(3) + SimTime::from_days(1));
+    bus.schedule(DebugEvent{"elsewhere"}, SimTime::from_days(1), LAYER_BIT(LayerID::Planetary));
+    REQUIRE(bus.scheduled_count() == 4);
+
+    scheduler.set_active_level(0);
+    scheduler.run(2);
+    REQUIRE(received.size() == 1);
+    REQUIRE(received[0].first == "tomorrow");
+    REQUIRE(received[0].second == SimTime::from_days(1));
+
+    scheduler.set_active_level(1); // A year per tick: released at the tick's end
+    scheduler.run(1);
+    REQUIRE(received.size() == 2);
+    REQUIRE(received[1].second == SimTime::from_days(2) + SimTime::from_years(1));
+
+    scheduler.set_active_level(4);
+    scheduler.run(2);
+    REQUIRE(received.size() == 2);
+    scheduler.run(1);
+    REQUIRE(received.size() == 3);
+    REQUIRE(received[2].first == "comet");
+    REQUIRE(bus.scheduled_count() == 0);
+
+    // Delivered events are logged with the time they were scheduled for
+    bool logged = false;
+    for (const auto& e : bus.log()) {
+        if (auto* d = std::get_if<DebugEvent>(&e.payload); d && d->message == "harvest") {
+            logged = e.timestamp == SimTime::from_days(200);
+        }
+    }
+    REQUIRE(logged);
+}
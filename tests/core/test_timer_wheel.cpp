@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/rng/RNG.h"
+#include "core/time/TimerWheel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace godsim;
+
+// ═══ Timer Wheel Tests ═══
+
+TEST_CASE("TimerWheel releases timers in due order across horizons", "[timer_wheel]") {
+    TimerWheel<u32> wheel;
+    RNG rng(5);
+    std::vector<std::pair<i64, u32>> expected;
+    for (u32 i = 0; i < 5000; i++) {
+        // Days to a few hundred million years
+        i64 due = static_cast<i64>(std::pow(10.0, rng.next_float(0.0f, 11.0f)));
+        wheel.schedule(SimTime{due}, i);
+        expected.push_back({due, i});
+    }
+    std::stable_sort(expected.begin(), expected.end(),
+                     [](const auto& a, const auto& b) { return a.first < b.first; });
+    REQUIRE(wheel.size() == 5000);
+
+    std::vector<std::pair<i64, u32>> fired;
+    auto record = [&](SimTime due, u32 value) {
+        REQUIRE(due <= wheel.now());
+        fired.push_back({due.ticks, value});
+    };
+    // Uneven steps: a day, then ever coarser
+    for (i64 step = 1, t = 0; t < 200'000'000'000; step *= 3) {
+        t += step;
+        wheel.advance(SimTime{t}, record);
+        REQUIRE(wheel.now().ticks == t);
+    }
+    REQUIRE(wheel.empty());
+    REQUIRE(fired == expected);
+}
+
+TEST_CASE("TimerWheel fires each timer exactly on its day", "[timer_wheel]") {
+    TimerWheel<i64> wheel(SimTime{1000});
+    for (i64 d : {1000, 1001, 1063, 1064, 4095, 4096, 262144, 262145}) wheel.schedule(SimTime{d}, d);
+    wheel.schedule(SimTime{10}, 10); // Already past: released at the next advance
+
+    for (i64 day = 1000; day <= 262145; day++) {
+        std::vector<i64> due;
+        wheel.advance(SimTime{day}, [&](SimTime when, i64 v) {
+            REQUIRE(when.ticks == v);
+            due.push_back(v);
+        });
+        for (i64 v : due) REQUIRE((v == day || v == 10));
+    }
+    REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel callbacks may schedule more timers", "[timer_wheel]") {
+    TimerWheel<u32> wheel;
+    wheel.schedule(SimTime{5}, 0);
+    std::vector<i64> days;
+    size_t fired = wheel.advance(SimTime::from_years(2000), [&](SimTime when, u32 n) {
+        days.push_back(when.ticks);
+        if (n < 9) wheel.schedule(when + SimTime{n % 2 ? 0 : 100'000}, n + 1);
+    });
+    REQUIRE(fired == 10);
+    REQUIRE(days == std::vector<i64>{5, 100005, 100005, 200005, 200005, 300005, 300005,
+                                     400005, 400005, 500005});
+
+    // for_each lists what is pending, in release order
+    wheel.reset(SimTime{10});
+    wheel.schedule(SimTime{500}, 2);
+    wheel.schedule(SimTime{20}, 1);
+    wheel.schedule(SimTime{500}, 3);
+    std::vector<u32> order;
+    wheel.for_each([&](SimTime, u32 v) { order.push_back(v); });
+    REQUIRE(order == std::vector<u32>{1, 2, 3});
+    REQUIRE(wheel.next_due().ticks <= 20);
+}
@@ -0,0 +1,222 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/cosmological/CosmologicalLayer.h"
+#include "layers/cosmological/NBodySystem.h"
+#include "simulation/Simulation.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace godsim;
+
+static EntityID eid(u64 n) { return EntityID::create(LayerID::Cosmological, n); }
+
+/// A Plummer-like ball of equal masses in rough virial equilibrium.
+static void add_cluster(NBodySystem& system, u32 n, u64 seed) {
+    RNG rng(seed);
+    const f64 radius = 100.0, m = 1e6 / n;
+    const f64 sigma = std::sqrt(GRAVITY * 1e6 / (6.0 * radius));
+    for (u32 i = 0; i < n; i++) {
+        Vec3d p{rng.next_gaussian(0.0, radius), rng.next_gaussian(0.0, radius), rng.next_gaussian(0.0, radius)};
+        Vec3d v{rng.next_gaussian(0.0, sigma), rng.next_gaussian(0.0, sigma), rng.next_gaussian(0.0, sigma)};
+        system.add_body(eid(i + 1), p, v, m);
+    }
+}
+
+// ═══ Kepler Orbit Tests ═══
+
+TEST_CASE("Kepler orbits close after one period", "[nbody]") {
+    OrbitalRelation orbit;
+    orbit.semi_major_axis = PARSECS_PER_AU;
+    orbit.eccentricity = 0.6;
+    orbit.inclination = 0.4;
+    orbit.ascending_node = 1.1;
+    orbit.argument_of_periapsis = 2.0;
+    orbit.mean_anomaly = 0.3;
+
+    const f64 period = orbital_period(orbit, 1.0);
+    REQUIRE(std::abs(period - 1e-6) < 1e-9); // One year, in Myr
+
+    Vec3d p0, v0, p1, v1;
+    orbit_state(orbit, 1.0, 0.0, p0, v0);
+    orbit_state(orbit, 1.0, period, p1, v1);
+    REQUIRE((p1 - p0).length() < 1e-9 * orbit.semi_major_axis);
+    REQUIRE((v1 - v0).length() < 1e-9 * v0.length());
+
+    // Vis-viva: v² = GM (2/r − 1/a)
+    f64 r = p0.length();
+    f64 expected = GRAVITY * (2.0 / r - 1.0 / orbit.semi_major_axis);
+    REQUIRE(std::abs(v0.dot(v0) - expected) < 1e-9 * expected);
+}
+
+TEST_CASE("Kepler fast path agrees with direct two-body integration", "[nbody]") {
+    OrbitalRelation orbit;
+    orbit.semi_major_axis = 10.0;
+    orbit.eccentricity = 0.3;
+    orbit.inclination = 0.5;
+    Vec3d p, v;
+    orbit_state(orbit, 1e6, 0.0, p, v);
+
+    // A 1 M☉ test particle around 1e6 M☉, leapfrogged with a small step
+    NBodySystem system;
+    system.params().softening = 0.0;
+    system.params().step = orbital_period(orbit, 1e6) / 20000.0;
+    system.add_body(eid(1), {}, {}, 1e6);
+    system.add_body(eid(2), p, v, 1e-9);
+    const f64 t = 0.37 * orbital_period(orbit, 1e6);
+    for (f64 done = 0.0; done + system.params().step <= t; done += system.params().step) {
+        system.step(system.params().step);
+    }
+    f64 elapsed = std::floor(t / system.params().step) * system.params().step;
+    orbit_state(orbit, 1e6, elapsed, p, v);
+    Vec3d integrated{system.x[1] - system.x[0], system.y[1] - system.y[0], system.z[1] - system.z[0]};
+    REQUIRE((integrated - p).length() < 1e-3 * orbit.semi_major_axis);
+}
+
+TEST_CASE("Orbiters follow their parents, moons included", "[nbody]") {
+    NBodySystem system;
+    system.add_body(eid(1), {100.0, 0.0, 0.0}, {0.0, 5.0, 0.0}, 1.0);
+    OrbitalRelation planet;
+    planet.parent_entity = eid(1);
+    planet.semi_major_axis = PARSECS_PER_AU;
+    REQUIRE(system.add_orbiter(eid(2), planet, 3e-6));
+    OrbitalRelation moon;
+    moon.parent_entity = eid(2);
+    moon.semi_major_axis = 0.00257 * PARSECS_PER_AU;
+    REQUIRE(system.add_orbiter(eid(3), moon, 3.7e-8));
+    OrbitalRelation orphan;
+    orphan.parent_entity = eid(99);
+    REQUIRE(!system.add_orbiter(eid(4), orphan, 1.0));
+
+    system.advance(0.25); // Less than a step: the star drifts, orbiters follow
+    Vec3d star, p, m;
+    REQUIRE(system.position_of(eid(1), star));
+    REQUIRE(system.position_of(eid(2), p));
+    REQUIRE(system.position_of(eid(3), m));
+    REQUIRE(std::abs(star.y - 1.25) < 1e-12);
+    REQUIRE(std::abs((p - star).length() - PARSECS_PER_AU) < 1e-3 * PARSECS_PER_AU);
+    REQUIRE(std::abs((m - p).length() - moon.semi_major_axis) < 1e-3 * moon.semi_major_axis);
+}
+
+// ═══ Tree Tests ═══
+
+TEST_CASE("Barnes-Hut forces match direct summation", "[nbody]") {
+    NBodySystem system;
+    add_cluster(system, 3000, 7);
+    system.params().softening = 1.0;
+    system.compute_forces();
+
+    const auto& root = system.tree().nodes()[0];
+    f64 total = 0.0;
+    for (f64 m : system.mass) total += m;
+    REQUIRE(std::abs(root.mass - total) < 1e-9 * total);
+
+    std::vector<f64> errors;
+    const u32 n = static_cast<u32>(system.size());
+    for (u32 i = 0; i < n; i += 10) {
+        f64 a[3] = {};
+        for (u32 j = 0; j < n; j++) {
+            if (j == i) continue;
+            f64 dx = system.x[j] - system.x[i], dy = system.y[j] - system.y[i], dz = system.z[j] - system.z[i];
+            f64 r2 = dx * dx + dy * dy + dz * dz + 1.0;
+            f64 s = GRAVITY * system.mass[j] / (r2 * std::sqrt(r2));
+            a[0] += dx * s; a[1] += dy * s; a[2] += dz * s;
+        }
+        f64 ex = system.ax[i] - a[0], ey = system.ay[i] - a[1], ez = system.az[i] - a[2];
+        errors.push_back(std::sqrt((ex * ex + ey * ey + ez * ez) / (a[0] * a[0] + a[1] * a[1] + a[2] * a[2])));
+    }
+    std::sort(errors.begin(), errors.end());
+    REQUIRE(errors[errors.size() / 2] < 0.01);
+    REQUIRE(errors[errors.size() * 99 / 100] < 0.05);
+}
+
+TEST_CASE("Leapfrog keeps energy bounded", "[nbody]") {
+    NBodySystem system;
+    add_cluster(system, 1000, 3);
+    system.params().softening = 5.0;
+    system.params().theta = 0.5;
+    // Crossing time is ~10 Myr; a step of 0.1 Myr over 20 Myr
+    system.params().step = 0.1;
+    const f64 e0 = system.total_energy();
+    f64 worst = 0.0;
+    for (int i = 0; i < 4; i++) {
+        system.advance(5.0);
+        worst = std::max(worst, std::abs(system.total_energy() - e0));
+    }
+    REQUIRE(std::abs(system.time() - 20.0) < 1e-9);
+    REQUIRE(worst < 0.01 * std::abs(e0));
+}
+
+// ═══ Layer Tests ═══
+
+TEST_CASE("NBodySystem snapshot restores the same trajectory", "[nbody]") {
+    NBodySystem system;
+    add_cluster(system, 500, 11);
+    OrbitalRelation planet;
+    planet.parent_entity = eid(5);
+    planet.semi_major_axis = PARSECS_PER_AU;
+    planet.eccentricity = 0.1;
+    system.add_orbiter(eid(1000), planet, 3e-6);
+    system.advance(2.5);
+
+    BinaryWriter writer;
+    system.serialise(writer);
+    NBodySystem copy;
+    BinaryReader reader(writer.buffer());
+    copy.deserialise(reader, [](u32 kind, u32 index) { return eid(kind == 0 ? index + 1 : 1000 + index); });
+    REQUIRE(copy.size() == system.size());
+    REQUIRE(copy.orbiters().size() == 1);
+
+    system.advance(3.0);
+    copy.advance(3.0);
+    for (u32 i = 0; i < system.size(); i++) {
+        REQUIRE(copy.x[i] == system.x[i]);
+        REQUIRE(copy.vz[i] == system.vz[i]);
+    }
+    Vec3d a, b;
+    REQUIRE(system.position_of(eid(1000), a));
+    REQUIRE(copy.position_of(eid(1000), b));
+    REQUIRE((a - b).length() == 0.0);
+}
+
+TEST_CASE("Cosmological layer integrates the galaxy on cosmic ticks", "[nbody]") {
+    Simulation sim(42);
+    auto* cosmos = sim.add_layer<CosmologicalLayer>();
+    sim.initialise();
+    cosmos->generate_galaxy(2000);
+    REQUIRE(cosmos->system().size() == 2000);
+    REQUIRE(sim.registry().has_component<OrbitalRelation>(cosmos->home_planet()));
+    REQUIRE(sim.registry().has_component<CelestialBody>(cosmos->system().entity[0]));
+
+    Vec3d before;
+    EntityID star = cosmos->system().entity[0];
+    cosmos->system().position_of(star, before);
+    sim.set_tick_level(4);
+    sim.run(3);
+    REQUIRE(std::abs(cosmos->system().time() - 3.0) < 1e-9);
+    Vec3d after;
+    cosmos->system().position_of(star, after);
+    REQUIRE((after - before).length() > 0.0);
+
+    // Home planet stays 1 AU from its star
+    Vec3d home, planet;
+    cosmos->system().position_of(sim.registry().get_component<OrbitalRelation>(cosmos->home_planet()).parent_entity, home);
+    cosmos->system().position_of(cosmos->home_planet(), planet);
+    REQUIRE(std::abs((planet - home).length() - PARSECS_PER_AU) < 0.02 * PARSECS_PER_AU);
+
+    BinaryWriter writer;
+    cosmos->serialise(writer);
+    BinaryReader reader(writer.buffer());
+    cosmos->deserialise(reader, SNAPSHOT_VERSION);
+    REQUIRE(cosmos->system().size() == 2000);
+    REQUIRE(sim.registry().has_component<OrbitalRelation>(cosmos->home_planet()));
+
+    // Version 1 kept the tick count alone; the galaxy stays as it is
+    BinaryWriter old;
+    old.write_u64(1);
+    BinaryReader old_reader(old.buffer());
+    cosmos->deserialise(old_reader, 1);
+    REQUIRE(old_reader.at_end());
+    REQUIRE(cosmos->system().size() == 2000);
+    REQUIRE(cosmos->home_planet().is_valid());
+    sim.shutdown();
+}
@@ -0,0 +1,262 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/divine/DivineLayer.h"
+#include "layers/planetary/PlanetaryLayer.h"
+#include "simulation/Simulation.h"
+#include "support/TestPlanet.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace godsim;
+
+static DivineEffect effect(EffectField field, f32 x, f32 y, f32 radius, f32 rate, SimTime start, SimTime end) {
+    DivineEffect e;
+    e.field = field;
+    e.x = x;
+    e.y = y;
+    e.radius = radius;
+    e.rate = rate;
+    e.start = start;
+    e.end = end;
+    return e;
+}
+
+/// The field change one effect alone should cause at a cell over `years`.
+static f32 expected(const DivineEffect& e, u32 width, u32 x, u32 y, f64 years) {
+    f32 dx = std::abs(static_cast<f32>(x) - e.x);
+    dx = std::min(dx, static_cast<f32>(width) - dx);
+    f32 dy = static_cast<f32>(y) - e.y;
+    f32 t = std::max(0.0f, 1.0f - (dx * dx + dy * dy) / (e.radius * e.radius));
+    return e.rate * static_cast<f32>(years) * t * t;
+}
+
+// ═══ Effect System Tests ═══
+
+TEST_CASE("Effects apply with a smooth falloff and wrap across the seam", "[divine]") {
+    PlanetData planet = make_test_planet(128, 64, {.biome = BiomeType::TemperateForest});
+    EffectSystem effects;
+    effects.resize(128, 64);
+    DivineEffect rain = effect(EffectField::Moisture, 126.0f, 30.0f, 6.0f, 0.2f, {}, SimTime::from_years(10));
+    REQUIRE(effects.add(rain).valid());
+    REQUIRE(effects.bucket_size(0) == 1); // Reaches round to x = 4
+    REQUIRE(effects.bucket_size(3) == 1);
+    REQUIRE(effects.bucket_size(1) == 0);
+    REQUIRE(effects.bucket_size(effects.tiles_x()) == 1);
+
+    EffectTargets targets;
+    targets.planes[static_cast<size_t>(EffectField::Moisture)] = planet.moisture.data_ptr();
+    DirtyRegion dirty(128, 64);
+    SimTime year = SimTime::from_years(1);
+    REQUIRE(effects.apply({}, year, targets, &dirty) == 4); // Two tile rows, both sides of the seam
+
+    for (u32 x : {120u, 123u, 126u, 127u, 0u, 1u, 3u, 5u}) {
+        for (u32 y : {25u, 28u, 30u, 33u, 36u}) {
+            f32 want = 0.5f + expected(rain, 128, x, y, year.years());
+            REQUIRE(std::abs(planet.moisture.get(x, y) - want) < 1e-6f);
+        }
+    }
+    REQUIRE(planet.moisture.get(126, 30) > 0.69f);
+    REQUIRE(planet.moisture.get(4, 30) == 0.5f);
+    REQUIRE(planet.moisture.get(126, 24) == 0.5f);
+    REQUIRE(dirty.bounds().y0 == 0);
+    REQUIRE(dirty.bounds().y1 == 64);
+    REQUIRE(planet.elevation.get(126, 30) == 0.5f); // Other fields untouched
+}
+
+TEST_CASE("Discs nearly as wide as a small planet reach every column", "[divine]") {
+    // 2r + one tile overflows 64 cells, so cells at x = 48..63 are closer to
+    // the centre's wrapped image than to the one nearest their tile
+    PlanetData planet = make_test_planet(64, 32, {.biome = BiomeType::TemperateForest});
+    EffectSystem effects;
+    effects.resize(64, 32);
+    DivineEffect rain = effect(EffectField::Moisture, 16.0f, 16.0f, 31.0f, 0.2f, {}, SimTime::from_years(10));
+    REQUIRE(effects.add(rain).valid());
+
+    EffectTargets targets;
+    targets.planes[static_cast<size_t>(EffectField::Moisture)] = planet.moisture.data_ptr();
+    SimTime year = SimTime::from_years(1);
+    effects.apply({}, year, targets, nullptr);
+
+    for (u32 y = 0; y < 32; y++) {
+        for (u32 x = 0; x < 64; x++) {
+            f32 want = 0.5f + expected(rain, 64, x, y, year.years());
+            REQUIRE(std::abs(planet.moisture.get(x, y) - want) < 1e-6f);
+        }
+    }
+    REQUIRE(planet.moisture.get(56, 16) > 0.5f);
+}
+
+TEST_CASE("Many overlapping effects sum, clamp and count partial ticks", "[divine]") {
+    PlanetData planet = make_test_planet(256, 128, {.biome = BiomeType::TemperateForest});
+    EffectSystem effects;
+    effects.resize(256, 128);
+    RNG rng(3);
+    std::vector<DivineEffect> all;
+    for (int i = 0; i < 300; i++) {
+        SimTime start = SimTime::from_days(rng.next_int(0, 400));
+        SimTime end = start + SimTime::from_days(rng.next_int(1, 800));
+        all.push_back(effect(EffectField::Temperature, rng.next_float(0.0f, 256.0f), rng.next_float(0.0f, 128.0f),
+                             rng.next_float(1.0f, 40.0f), rng.next_float(-3.0f, 3.0f), start, end));
+        effects.add(all.back());
+    }
+    all.push_back(effect(EffectField::Elevation, 50.0f, 50.0f, 10.0f, 100.0f, {}, SimTime::from_years(5)));
+    effects.add(all.back());
+
+    EffectTargets targets;
+    targets.planes = {planet.elevation.data_ptr(), planet.temperature.data_ptr(), planet.moisture.data_ptr()};
+    SimTime from = SimTime::from_days(200), to = SimTime::from_days(565);
+    effects.apply(from, to, targets);
+
+    for (u32 y = 0; y < 128; y += 7) {
+        for (u32 x = 0; x < 256; x += 5) {
+            f32 want = 15.0f;
+            for (const auto& e : all) {
+                if (e.field != EffectField::Temperature) continue;
+                SimTime a = std::max(from, e.start), b = std::min(to, e.end);
+                if (a < b) want += expected(e, 256, x, y, (b - a).years());
+            }
+            REQUIRE(std::abs(planet.temperature.get(x, y) - want) < 1e-3f);
+        }
+    }
+    REQUIRE(planet.elevation.get(50, 50) == 1.0f);
+    REQUIRE(planet.elevation.get(50, 45) == 1.0f);
+    REQUIRE(planet.elevation.get(50, 61) == 0.5f);
+}
+
+TEST_CASE("Effects expire on schedule and stale handles are refused", "[divine]") {
+    EffectSystem effects;
+    effects.resize(512, 256);
+    RNG rng(9);
+    std::vector<EffectHandle> handles;
+    std::vector<SimTime> ends;
+    for (int i = 0; i < 5000; i++) {
+        SimTime end = SimTime::from_days(rng.next_int(1, 50000));
+        handles.push_back(effects.add(effect(EffectField::Moisture, rng.next_float(0.0f, 512.0f),
+                                             rng.next_float(0.0f, 256.0f), 5.0f, 0.1f, {}, end)));
+        ends.push_back(end);
+    }
+    REQUIRE(effects.size() == 5000);
+
+    // Dispel a few early; their timers must not touch the slot's next tenant
+    for (int i = 0; i < 100; i++) REQUIRE(effects.remove(handles[i]));
+    REQUIRE(!effects.remove(handles[0]));
+    EffectHandle reused = effects.add(effect(EffectField::Moisture, 5.0f, 5.0f, 5.0f, 0.1f, {},
+                                             SimTime::from_days(60000)));
+    REQUIRE(reused.slot == handles[0].slot);
+    REQUIRE(!effects.find(handles[0]));
+
+    for (i64 day = 0; day <= 50000; day += 3650) {
+        effects.expire(SimTime::from_days(day));
+        size_t live = 1;
+        for (int i = 100; i < 5000; i++) live += ends[i] > SimTime::from_days(day);
+        REQUIRE(effects.size() == live);
+    }
+    effects.expire(SimTime::from_days(50001));
+    REQUIRE(effects.size() == 1);
+    REQUIRE(effects.find(reused));
+}
+
+TEST_CASE("Blessings and plagues scale fine and coarse populations alike", "[divine]") {
+    PopulationGrid grid;
+    grid.reset(64, 32);
+    grid.set_biomes(std::vector<BiomeType>(grid.cells(), BiomeType::TemperateForest));
+    SpeciesTraits traits;
+    traits.capacity.fill(1.0f);
+    u32 s = grid.add_species(traits);
+    for (size_t i = 0; i < grid.cells(); i++) grid.density(s)[i] = 0.5f;
+    grid.dehydrate_tile(1);
+    const f64 coarse_before = grid.tile_total(s, 1);
+
+    EffectSystem effects;
+    effects.resize(64, 32);
+    DivineEffect blessing = miracle(Miracle::Blessing, 16.0f, 16.0f, 12.0f, {}, SimTime::from_years(10));
+    DivineEffect plague = miracle(Miracle::Plague, 48.0f, 16.0f, 12.0f, {}, SimTime::from_years(10));
+    effects.add(blessing);
+    effects.add(plague);
+    EffectTargets targets;
+    targets.population = [&](u32 tile, const f32* growth) { grid.apply_growth(tile, growth); };
+    SimTime year = SimTime::from_years(1);
+    effects.apply({}, year, targets);
+
+    for (u32 x : {10u, 16u, 20u}) {
+        f32 want = 0.5f * std::exp(expected(blessing, 64, x, 16, year.years()));
+        REQUIRE(std::abs(grid.at(s, x, 16) - want) < 1e-6f);
+    }
+    REQUIRE(grid.at(s, 16, 29) == 0.5f);
+
+    // The coarse tile shrinks by the mean of what its cells would have
+    f64 factor = 0.0;
+    for (u32 y = 0; y < 32; y++)
+        for (u32 x = 32; x < 64; x++) factor += std::exp(expected(plague, 64, x, y, year.years()));
+    factor /= 32.0 * 32.0;
+    REQUIRE(std::abs(grid.tile_total(s, 1) - coarse_before * factor) < 1e-3 * coarse_before);
+    REQUIRE(grid.tile_total(s, 1) < 0.95 * coarse_before);
+}
+
+// ═══ Layer Tests ═══
+
+TEST_CASE("Divine layer applies miracles on ticks and restores from a snapshot", "[divine]") {
+    Simulation sim(7);
+    auto* divine = sim.add_layer<DivineLayer>();
+    sim.initialise();
+    PlanetData planet = make_test_planet(128, 64, {.biome = BiomeType::TemperateForest});
+    divine->bind(planet);
+    EffectHandle rain = divine->cast(Miracle::Rain, 40.0f, 20.0f, 10.0f, {}, SimTime::from_years(3));
+    divine->cast(Miracle::Warmth, 100.0f, 40.0f, 20.0f, {}, SimTime::from_years(20));
+    REQUIRE(!divine->cast(Miracle::Frost, 10.0f, 10.0f, 0.0f, {}, SimTime::from_years(1)).valid());
+
+    sim.set_tick_level(1);
+    sim.run(2);
+    REQUIRE(divine->effects().find(rain));
+    sim.run(2);
+    REQUIRE(!divine->effects().find(rain)); // Ended after its third year
+    REQUIRE(divine->effects().size() == 1);
+    DivineEffect preset = miracle(Miracle::Rain, 40.0f, 20.0f, 10.0f, {}, SimTime::from_years(3));
+    REQUIRE(planet.moisture.get(40, 20) == 1.0f); // Clamped
+    f32 want = 0.5f + expected(preset, 128, 40, 27, SimTime::from_years(3).years());
+    REQUIRE(std::abs(planet.moisture.get(40, 27) - want) < 1e-5f);
+    REQUIRE(!divine->edits().empty());
+
+    BinaryWriter writer;
+    divine->serialise(writer);
+    PlanetData copy_planet = planet;
+    SimTime saved = sim.current_time();
+    sim.run(5);
+
+    Simulation other(7);
+    auto* restored = other.add_layer<DivineLayer>();
+    other.initialise();
+    restored->bind(copy_planet);
+    BinaryReader reader(writer.buffer());
+    restored->deserialise(reader, SNAPSHOT_VERSION);
+    REQUIRE(restored->effects().size() == 1);
+    other.set_tick_level(1);
+    other.scheduler().set_time(saved);
+    other.run(5);
+    for (u32 x = 80; x < 120; x += 3) REQUIRE(copy_planet.temperature.get(x, 40) == planet.temperature.get(x, 40));
+    sim.shutdown();
+    other.shutdown();
+}
+
+TEST_CASE("Planetary layer catches up on cells divine effects changed", "[divine]") {
+    Simulation sim(7);
+    auto* planetary = sim.add_layer<PlanetaryLayer>();
+    auto* divine = sim.add_layer<DivineLayer>();
+    sim.initialise();
+    PlanetData& planet = planetary->planet();
+    planet = make_test_planet(64, 32);
+    REQUIRE(planet.biome_at(20, 16) != BiomeType::Ocean);
+    divine->bind(planet);
+    divine->cast(effect(EffectField::Elevation, 20.0f, 16.0f, 6.0f, -0.2f, {}, SimTime::from_years(1)));
+
+    sim.set_tick_level(1);
+    sim.run(1);
+    REQUIRE(planet.elevation.get(20, 16) < planet.sea_level);
+    REQUIRE(planet.biome_at(20, 16) != BiomeType::Ocean); // Stale until drained
+
+    planetary->terrain_changed(divine->edits());
+    divine->edits().clear();
+    REQUIRE(planet.biome_at(20, 16) == BiomeType::Ocean);
+    REQUIRE(planet.biome_at(40, 16) == classify_biome(0.5f, 15.0f, 0.5f, planet.sea_level));
+    sim.shutdown();
+}
@@ -99,7 +99,7 @@ TEST_CASE("Different tick levels activate correct layers", "[integration]") {
     int cosmo_tick_events = 0;
     int other_tick_events = 0;
 
-    for (const auto& event : log.events()) {
+    for (const auto& event : log) {
         if (auto* lte = std::get_if<LayerTickedEvent>(&event.payload)) {
             if (lte->layer == LayerID::Cosmological) cosmo_tick_events++;
             else if (lte->layer != LayerID::COUNT) other_tick_events++;
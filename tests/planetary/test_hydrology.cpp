@@ -0,0 +1,199 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/Hydrology.h"
+#include "layers/planetary/PlanetData.h"
+#include "layers/planetary/TerrainGenerator.h"
+#include "layers/planetary/PlanetaryLayer.h"
+#include "simulation/Simulation.h"
+#include "support/TestPlanet.h"
+#include "core/rng/RNG.h"
+
+#include <cmath>
+
+using namespace godsim;
+
+/// Follow receivers from `cell`; true if it reaches the sea within the
+/// grid's cell count.
+static bool drains_to_sea(u32 cell, const std::vector<u8>& dirs, const Heightmap& elev, f32 sea) {
+    u32 w = elev.width(), h = elev.height();
+    for (size_t steps = 0; steps <= dirs.size(); steps++) {
+        if (elev.data_ptr()[cell] < sea) return true;
+        cell = Hydrology::receiver(cell, dirs[cell], w, h);
+        if (cell == Hydrology::NO_CELL) return false;
+    }
+    return false;
+}
+
+// ═══ Hydrology Tests ═══
+
+TEST_CASE("Priority-flood fills a crater to its rim and it drains", "[hydrology]") {
+    // A cone rising from the sea with a crater in its top
+    const u32 W = 64, H = 64;
+    Heightmap elev(W, H);
+    for (u32 y = 0; y < H; y++) {
+        for (u32 x = 0; x < W; x++) {
+            f32 r = std::hypot(x - 32.0f, y - 32.0f);
+            f32 cone = 0.9f - r * 0.02f;
+            f32 crater = r < 6.0f ? 0.15f * (1.0f - r / 6.0f) : 0.0f;
+            elev.set(x, y, cone - crater);
+        }
+    }
+    const f32 sea = 0.4f;
+    std::vector<f32> filled = Hydrology::fill_depressions(elev, sea);
+
+    // The crater floor is raised to a flat (to within ε) surface at the
+    // height of the rim, where the cone's slope is 0.9 - 0.02r
+    f32 surface = filled[32 * W + 32];
+    REQUIRE(surface > elev.get(32, 32));
+    REQUIRE(surface > 0.9f - 0.02f * 7.0f);
+    REQUIRE(surface < 0.9f - 0.02f * 6.0f);
+    for (u32 y = 28; y <= 36; y++)
+        for (u32 x = 28; x <= 36; x++)
+            if (std::hypot(x - 32.0f, y - 32.0f) < 4.0f) REQUIRE(std::abs(filled[y * W + x] - surface) < 1e-4f);
+
+    // Nothing outside the crater moves
+    REQUIRE(filled[10 * W + 10] == elev.get(10, 10));
+    REQUIRE(filled[32 * W + 50] == elev.get(50, 32));
+
+    HydrologyConfig config;
+    config.sea_level = sea;
+    auto mask = Hydrology::lake_mask(elev, filled, config);
+    REQUIRE(mask[32 * W + 32] == 1);
+    REQUIRE(mask[32 * W + 45] == 0);
+
+    // Every land cell, lake or not, reaches the sea
+    auto dirs = Hydrology::flow_directions(filled, W, H, elev, sea);
+    for (u32 c = 0; c < W * H; c++) {
+        if (elev.data_ptr()[c] >= sea) {
+            REQUIRE(dirs[c] != Hydrology::NO_FLOW);
+            REQUIRE(drains_to_sea(c, dirs, elev, sea));
+        }
+    }
+}
+
+TEST_CASE("Flow accumulation conserves rain and rivers form a tree", "[hydrology]") {
+    // Two valleys meeting and running to the sea on the east
+    const u32 W = 96, H = 64;
+    Heightmap elev(W, H);
+    Heightmap rain(W, H, 0.5f);
+    for (u32 y = 0; y < H; y++) {
+        for (u32 x = 0; x < W; x++) {
+            f32 valley = x < 48 ? std::min(std::abs(y - 16.0f), std::abs(y - 48.0f)) : std::abs(y - 32.0f);
+            elev.set(x, y, x >= 88 ? 0.2f : 0.45f + (88 - x) * 0.004f + valley * 0.01f);
+        }
+    }
+    const f32 sea = 0.4f;
+    auto filled = Hydrology::fill_depressions(elev, sea);
+    auto dirs = Hydrology::flow_directions(filled, W, H, elev, sea);
+    auto flow = Hydrology::flow_accumulation(dirs, W, H, elev, rain, sea);
+
+    // All rain on land ends up in the sea
+    f64 land_rain = 0.0, into_sea = 0.0;
+    for (u32 c = 0; c < W * H; c++) {
+        if (elev.data_ptr()[c] >= sea) land_rain += 0.5;
+        else into_sea += flow[c];
+    }
+    REQUIRE(std::abs(into_sea - land_rain) < 1e-3);
+
+    // Parallel passes give the same answer every time
+    REQUIRE(Hydrology::flow_accumulation(dirs, W, H, elev, rain, sea) == flow);
+
+    Hydrosphere hydro = Hydrology::generate(elev, rain, {sea, 1.0f / 64.0f, 0.001f});
+    REQUIRE_FALSE(hydro.segments.empty());
+    u32 sources = 0, confluences = 0, mouths = 0;
+    for (const auto& n : hydro.nodes) {
+        sources += n.kind == RiverNodeKind::Source;
+        confluences += n.kind == RiverNodeKind::Confluence;
+        mouths += n.kind == RiverNodeKind::Mouth;
+    }
+    REQUIRE(sources >= 2);
+    REQUIRE(confluences >= 1);
+    REQUIRE(mouths >= 1);
+    REQUIRE(hydro.segments.size() == sources + confluences);
+
+    // Segments are connected chains of neighbouring cells ending at their
+    // nodes, and rivers grow downstream
+    for (const auto& s : hydro.segments) {
+        REQUIRE(hydro.river_cells[s.first] == hydro.nodes[s.from].cell);
+        REQUIRE(hydro.river_cells[s.first + s.count - 1] == hydro.nodes[s.to].cell);
+        for (u32 i = s.first; i + 1 < s.first + s.count; i++) {
+            u32 c = hydro.river_cells[i];
+            REQUIRE(Hydrology::receiver(c, dirs[c], W, H) == hydro.river_cells[i + 1]);
+            REQUIRE(flow[hydro.river_cells[i + 1]] >= flow[c]);
+        }
+        REQUIRE(s.discharge >= hydro.river_threshold);
+    }
+}
+
+TEST_CASE("Hydrology of a generated planet survives serialisation", "[hydrology]") {
+    RNG rng(2024);
+    TerrainGenerator gen(rng);
+    TerrainConfig config;
+    config.width = 128;
+    config.height = 64;
+    config.erosion_iterations = 2000;
+    PlanetData planet;
+    planet.width = config.width;
+    planet.height = config.height;
+    planet.elevation = gen.generate(config);
+    planet.temperature = Heightmap(config.width, config.height, 15.0f);
+    planet.moisture = Heightmap(config.width, config.height, 0.6f);
+    planet.classify_biomes();
+
+    HydrologyConfig hydro_config;
+    hydro_config.sea_level = planet.sea_level;
+    planet.hydrosphere = Hydrology::generate(planet.elevation, planet.moisture, hydro_config);
+    REQUIRE(planet.hydrosphere.lake_mask.size() == 128 * 64);
+    REQUIRE_FALSE(planet.hydrosphere.segments.empty());
+
+    BinaryWriter writer;
+    planet.serialise(writer);
+    PlanetData loaded;
+    BinaryReader reader(writer.buffer());
+    loaded.deserialise(reader);
+    REQUIRE(reader.at_end());
+    REQUIRE(loaded.hydrosphere.lake_mask == planet.hydrosphere.lake_mask);
+    REQUIRE(loaded.hydrosphere.river_cells == planet.hydrosphere.river_cells);
+    REQUIRE(loaded.hydrosphere.segments.size() == planet.hydrosphere.segments.size());
+    REQUIRE(loaded.hydrosphere.nodes.back().cell == planet.hydrosphere.nodes.back().cell);
+
+    // Version 5 planets had no hydrosphere or seasons: the same bytes less
+    // an empty hydrosphere (threshold and four counts) and empty seasons
+    PlanetData dry = planet;
+    dry.hydrosphere = {};
+    dry.seasons = {};
+    BinaryWriter old;
+    dry.serialise(old);
+    std::vector<u8> bytes = old.buffer();
+    const size_t empty_seasons = 4 * sizeof(u32), empty_hydrosphere = sizeof(f32) + 4 * sizeof(u32);
+    bytes.resize(bytes.size() - empty_seasons - empty_hydrosphere);
+    BinaryReader old_reader(bytes);
+    loaded.deserialise(old_reader, 5);
+    REQUIRE(old_reader.at_end());
+    REQUIRE(loaded.hydrosphere.empty());
+    REQUIRE(loaded.elevation.get(70, 20) == planet.elevation.get(70, 20));
+}
+
+TEST_CASE("Terrain edits rerun the planet's hydrology", "[hydrology]") {
+    Simulation sim(11);
+    auto* planetary = sim.add_layer<PlanetaryLayer>();
+    sim.initialise();
+    PlanetData& planet = planetary->planet();
+    planet = make_test_planet(64, 32);
+    for (u32 y = 0; y < 32; y++)
+        for (u32 x = 0; x < 64; x++) planet.elevation.set(x, y, 0.3f + 0.01f * static_cast<f32>(x));
+    HydrologyConfig config;
+    config.sea_level = planet.sea_level;
+    planet.hydrosphere = Hydrology::generate(planet.elevation, planet.moisture, config);
+    const size_t pit = 16 * 64 + 40;
+    REQUIRE(!planet.hydrosphere.is_lake(pit));
+
+    // Dig a pit into the slope
+    DirtyRegion edits(64, 32);
+    for (u32 y = 15; y <= 17; y++)
+        for (u32 x = 39; x <= 41; x++) planet.elevation.set(x, y, 0.45f);
+    edits.add(39, 15, 42, 18);
+    planetary->terrain_changed(edits);
+    REQUIRE(planet.hydrosphere.is_lake(pit));
+    REQUIRE(planet.hydrosphere.lake_mask == Hydrology::generate(planet.elevation, planet.moisture, config).lake_mask);
+    sim.shutdown();
+}
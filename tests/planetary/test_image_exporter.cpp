@@ -0,0 +1,131 @@
+#include <catch2/catch_test_macros.hpp>
+#include "core/serialise/Deflate.h"
+#include "layers/planetary/ImageExporter.h"
+#include "layers/planetary/PlanetData.h"
+#include "support/TestPlanet.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace godsim;
+
+static std::vector<u8> read_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+static u32 read_be32(const std::vector<u8>& b, size_t at) {
+    return (static_cast<u32>(b[at]) << 24) | (static_cast<u32>(b[at + 1]) << 16) |
+           (static_cast<u32>(b[at + 2]) << 8) | b[at + 3];
+}
+
+/// Elevation rising west to east, temperature from -30 °C in the north to
+/// 30 °C in the south, and moisture varying cell to cell so most biomes show.
+static PlanetData banded_planet(u32 w, u32 h) {
+    PlanetData planet = make_test_planet(w, h, {.elevation_ramp = true, .temperature = -30.0f, .temperature_rise = 60.0f});
+    for (u32 y = 0; y < h; y++)
+        for (u32 x = 0; x < w; x++) planet.moisture.set(x, y, static_cast<f32>((x + y) % 17) / 16.0f);
+    planet.classify_biomes();
+    return planet;
+}
+
+// ═══ Deflate Tests ═══
+
+TEST_CASE("Adler-32 matches reference value", "[deflate]") {
+    const char* text = "Wikipedia";
+    REQUIRE(Deflate::adler32(reinterpret_cast<const u8*>(text), 9) == 0x11E60398u);
+}
+
+TEST_CASE("Adler-32 can be continued across pieces", "[deflate]") {
+    std::vector<u8> data(10000);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<u8>(i * 7);
+
+    u32 whole = Deflate::adler32(data.data(), data.size());
+    u32 split = Deflate::adler32(data.data() + 4000, 6000,
+                                 Deflate::adler32(data.data(), 4000));
+    REQUIRE(whole == split);
+}
+
+TEST_CASE("Deflate compresses repetitive data", "[deflate]") {
+    std::vector<u8> data(600 * 1024);
+    for (size_t i = 0; i < data.size(); i++) data[i] = static_cast<u8>((i / 64) % 5);
+
+    auto z = Deflate::zlib_compress(data.data(), data.size());
+    REQUIRE(z.size() < data.size() / 10);
+    REQUIRE(z[0] == 0x78);
+    REQUIRE(((z[0] << 8) | z[1]) % 31 == 0);
+    REQUIRE(read_be32(z, z.size() - 4) == Deflate::adler32(data.data(), data.size()));
+}
+
+// ═══ Image Writer Tests ═══
+
+TEST_CASE("PPM export writes header and every pixel", "[export]") {
+    auto dir = std::filesystem::temp_directory_path() / "godsim_export_ppm";
+    std::filesystem::create_directories(dir);
+    auto planet = banded_planet(40, 30);
+
+    auto path = (dir / "elev.ppm").string();
+    ImageExporter::export_heightmap(planet.elevation, path);
+
+    auto bytes = read_file(path);
+    std::string header = "P6\n40 30\n255\n";
+    REQUIRE(bytes.size() == header.size() + 40 * 30 * 3);
+    REQUIRE(std::string(bytes.begin(), bytes.begin() + header.size()) == header);
+    // Pixel (39, 0) is the brightest in each row
+    size_t px = header.size() + 39 * 3;
+    REQUIRE(bytes[px] == static_cast<u8>(39.0f / 40 * 255));
+}
+
+TEST_CASE("Fused export matches per-map export", "[export]") {
+    auto dir = std::filesystem::temp_directory_path() / "godsim_export_fused";
+    std::filesystem::create_directories(dir);
+    auto planet = banded_planet(64, 48);
+
+    ImageExporter::export_all(planet, dir.string());
+    ImageExporter::export_terrain(planet.elevation, planet.sea_level,
+                                  (dir / "terrain_single.ppm").string());
+    ImageExporter::export_temperature(planet.temperature,
+                                      (dir / "temperature_single.ppm").string());
+
+    REQUIRE(read_file((dir / "terrain.ppm").string()) ==
+            read_file((dir / "terrain_single.ppm").string()));
+    REQUIRE(read_file((dir / "temperature.ppm").string()) ==
+            read_file((dir / "temperature_single.ppm").string()));
+}
+
+TEST_CASE("PNG export produces valid chunk structure", "[export]") {
+    auto dir = std::filesystem::temp_directory_path() / "godsim_export_png";
+    std::filesystem::create_directories(dir);
+    auto planet = banded_planet(300, 200);
+
+    ImageExporter::export_all(planet, dir.string(), ImageFormat::PNG);
+    auto bytes = read_file((dir / "biomes.png").string());
+
+    REQUIRE(bytes.size() > 8);
+    REQUIRE(bytes[0] == 0x89);
+    REQUIRE(bytes[1] == 'P');
+
+    // Walk chunks and verify every CRC
+    size_t pos = 8;
+    bool saw_ihdr = false, saw_iend = false;
+    while (pos + 12 <= bytes.size()) {
+        u32 len = read_be32(bytes, pos);
+        std::string type(bytes.begin() + pos + 4, bytes.begin() + pos + 8);
+        u32 crc = ImageWriter::crc32(&bytes[pos + 4], len + 4);
+        REQUIRE(crc == read_be32(bytes, pos + 8 + len));
+        if (type == "IHDR") {
+            saw_ihdr = true;
+            REQUIRE(read_be32(bytes, pos + 8) == 300);
+            REQUIRE(read_be32(bytes, pos + 12) == 200);
+        }
+        if (type == "IEND") saw_iend = true;
+        pos += 12 + len;
+    }
+    REQUIRE(saw_ihdr);
+    REQUIRE(saw_iend);
+    REQUIRE(pos == bytes.size());
+
+    // Biome maps are flat colour regions, so PNG should beat raw PPM easily
+    REQUIRE(bytes.size() < 300 * 200 * 3 / 4);
+}
@@ -0,0 +1,227 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/Pathfinder.h"
+#include "core/rng/RNG.h"
+#include "support/TestPlanet.h"
+
+#include <cmath>
+
+using namespace godsim;
+
+/// Mixed terrain: forests, mountains and hills on land, with lakes.
+static PlanetData make_rough_planet(u32 w, u32 h, u64 seed) {
+    PlanetData planet = make_test_planet(w, h, {.biome = BiomeType::TemperateGrassland});
+    RNG rng(seed);
+    const BiomeType land[] = {BiomeType::TemperateGrassland, BiomeType::TemperateForest,
+                              BiomeType::Mountain, BiomeType::Desert, BiomeType::Wetland};
+    for (int blob = 0; blob < 120; blob++) {
+        i32 cx = rng.next_int(0, static_cast<i32>(w) - 1), cy = rng.next_int(0, static_cast<i32>(h) - 1);
+        i32 r = rng.next_int(2, 7);
+        BiomeType b = rng.next_float() < 0.3f ? BiomeType::Ocean : land[rng.next_int(0, 4)];
+        f32 rise = rng.next_float(-0.02f, 0.02f);
+        for (i32 dy = -r; dy <= r; dy++) {
+            for (i32 dx = -r; dx <= r; dx++) {
+                i32 y = cy + dy;
+                if (y < 0 || y >= static_cast<i32>(h) || dx * dx + dy * dy > r * r) continue;
+                u32 x = static_cast<u32>((cx + dx + static_cast<i32>(w)) % static_cast<i32>(w));
+                planet.biome_map[y * w + x] = b;
+                planet.elevation.at(x, static_cast<u32>(y)) += rise;
+            }
+        }
+    }
+    return planet;
+}
+
+static void require_connected(const PlanetData& planet, const std::vector<u32>& path) {
+    for (size_t i = 1; i < path.size(); i++) {
+        i32 ax = static_cast<i32>(path[i - 1] % planet.width), ay = static_cast<i32>(path[i - 1] / planet.width);
+        i32 bx = static_cast<i32>(path[i] % planet.width), by = static_cast<i32>(path[i] / planet.width);
+        i32 dx = std::abs(ax - bx);
+        dx = std::min(dx, static_cast<i32>(planet.width) - dx);
+        REQUIRE(dx <= 1);
+        REQUIRE(std::abs(ay - by) <= 1);
+        REQUIRE(path[i] != path[i - 1]);
+    }
+}
+
+// ═══ Path Tests ═══
+
+TEST_CASE("Pathfinder walks straight across open land", "[pathfinder]") {
+    PlanetData planet = make_test_planet(128, 64, {.biome = BiomeType::TemperateGrassland});
+    Pathfinder paths;
+    paths.build(planet);
+    REQUIRE(paths.cluster_count() == 8);
+
+    auto path = paths.find_path(10 * 128 + 5, 10 * 128 + 100);
+    REQUIRE(path.front() == 10 * 128 + 5);
+    REQUIRE(path.back() == 10 * 128 + 100);
+    require_connected(planet, path);
+    // Shorter to go west across the seam: 33 steps, not 95
+    REQUIRE(path.size() == 34);
+    REQUIRE(std::abs(paths.path_cost(path) - 33.0f) < 1e-3f);
+}
+
+TEST_CASE("Pathfinder routes around water and reports no route to islands", "[pathfinder]") {
+    PlanetData planet = make_test_planet(96, 64, {.biome = BiomeType::TemperateGrassland});
+    // Ocean band from pole to pole at x in [40, 44), with one bridge at y = 50
+    for (u32 y = 0; y < 64; y++) {
+        for (u32 x = 40; x < 44; x++) {
+            if (y != 50) planet.biome_map[y * 96 + x] = BiomeType::Ocean;
+        }
+    }
+    // ...a second band at x in [80, 84) with none, so the seam can't be used...
+    for (u32 y = 0; y < 64; y++) {
+        for (u32 x = 80; x < 84; x++) planet.biome_map[y * 96 + x] = BiomeType::Ocean;
+    }
+    // ...and a lake ring around an island at x, y in [60, 66) × [20, 26)
+    for (u32 y = 18; y < 28; y++) {
+        for (u32 x = 58; x < 68; x++) {
+            if (x < 60 || x >= 66 || y < 20 || y >= 26) planet.biome_map[y * 96 + x] = BiomeType::Ocean;
+        }
+    }
+    Pathfinder paths;
+    paths.build(planet);
+
+    auto path = paths.find_path(5 * 96 + 30, 5 * 96 + 60);
+    REQUIRE(!path.empty());
+    require_connected(planet, path);
+    bool used_bridge = false;
+    for (u32 cell : path) {
+        REQUIRE(paths.passable(cell));
+        if (cell / 96 == 50 && cell % 96 >= 40 && cell % 96 < 44) used_bridge = true;
+    }
+    REQUIRE(used_bridge);
+
+    // Past the second band by way of the bridge and the seam
+    REQUIRE(!paths.find_path(5 * 96 + 60, 5 * 96 + 90).empty());
+    // Onto the island, or into the sea, there is no way
+    REQUIRE(paths.find_path(5 * 96 + 60, 22 * 96 + 62).empty());
+    REQUIRE(paths.find_path(5 * 96 + 60, 5 * 96 + 41).empty()); // Into the sea
+}
+
+TEST_CASE("Hierarchical paths stay close to the optimum", "[pathfinder]") {
+    PlanetData planet = make_rough_planet(160, 96, 7);
+    Pathfinder paths;
+    paths.build(planet);
+
+    RNG rng(99);
+    const u32 cells = 160 * 96;
+    int found = 0;
+    f64 total_ratio = 0.0;
+    for (int q = 0; q < 30; q++) {
+        u32 goal = static_cast<u32>(rng.next_int(0, static_cast<i32>(cells) - 1));
+        if (!paths.passable(goal)) continue;
+        Pathfinder::FlowField exact = paths.compute_flow_field(goal);
+        for (int s = 0; s < 5; s++) {
+            u32 from = static_cast<u32>(rng.next_int(0, static_cast<i32>(cells) - 1));
+            if (!paths.passable(from)) continue;
+            auto path = paths.find_path(from, goal);
+            // Same connectivity as the exact search
+            REQUIRE(path.empty() == (!exact.reachable(from)));
+            if (path.empty()) continue;
+            require_connected(planet, path);
+            f32 cost = paths.path_cost(path);
+            REQUIRE(cost >= exact.cost[from] - 1e-2f);
+            REQUIRE(cost <= exact.cost[from] * 1.6f + 1e-2f);
+            total_ratio += exact.cost[from] > 0.0f ? cost / exact.cost[from] : 1.0;
+            found++;
+        }
+    }
+    REQUIRE(found > 50);
+    REQUIRE(total_ratio / found < 1.15);
+}
+
+// ═══ Flow Field Tests ═══
+
+TEST_CASE("Flow field steps downhill in cost to the goal", "[pathfinder]") {
+    PlanetData planet = make_rough_planet(96, 64, 3);
+    u32 goal = 32 * 96 + 2;
+    for (u32 x = 0; x < 96; x++) planet.biome_map[32 * 96 + x] = BiomeType::Savanna; // A road round
+    Pathfinder paths;
+    paths.build(planet);
+    auto field = paths.flow_field(goal);
+
+    REQUIRE(field->cost[goal] == 0.0f);
+    REQUIRE(field->next(goal) == goal);
+    int walked = 0;
+    for (u32 start = 0; start < 96 * 64; start += 37) {
+        if (!field->reachable(start)) {
+            REQUIRE(field->direction[start] == Pathfinder::NO_DIRECTION);
+            continue;
+        }
+        u32 cell = start;
+        for (int step = 0; step < 96 * 64 && cell != goal; step++) {
+            u32 next = field->next(cell);
+            REQUIRE(field->cost[next] < field->cost[cell]);
+            cell = next;
+        }
+        REQUIRE(cell == goal);
+        walked++;
+    }
+    REQUIRE(walked > 50);
+}
+
+TEST_CASE("Flow fields are cached and evicted least recently used", "[pathfinder]") {
+    PlanetData planet = make_test_planet(64, 32, {.biome = BiomeType::TemperateGrassland});
+    Pathfinder paths;
+    paths.build(planet, 2);
+
+    auto a = paths.flow_field(1);
+    auto b = paths.flow_field(2);
+    REQUIRE(paths.flow_field(1) == a); // Hit; 2 is now the oldest
+    auto c = paths.flow_field(3);
+    REQUIRE(paths.cached_flow_fields() == 2);
+    REQUIRE(paths.flow_field(1) == a);
+    REQUIRE(paths.flow_field(2) != b); // Was evicted and recomputed
+}
+
+// ═══ Incremental Update Tests ═══
+
+TEST_CASE("Terraforming updates paths and drops affected flow fields", "[pathfinder]") {
+    PlanetData planet = make_rough_planet(128, 96, 11);
+    Pathfinder paths;
+    paths.build(planet);
+
+    // An island no flow field can reach: edits there keep the field
+    for (u32 y = 80; y < 96; y++) {
+        for (u32 x = 100; x < 128; x++) planet.biome_map[y * 128 + x] = BiomeType::Ocean;
+    }
+    DirtyRegion island(128, 96);
+    island.add(100, 80, 128, 96);
+    paths.update(island);
+    u32 goal = 10 * 128 + 10;
+    planet.biome_map[goal] = BiomeType::TemperateGrassland;
+    island.clear();
+    island.add(10, 10, 11, 11);
+    paths.update(island);
+
+    auto field = paths.flow_field(goal);
+    planet.biome_map[90 * 128 + 115] = BiomeType::Mountain; // Islet inside the sea
+    DirtyRegion far(128, 96);
+    far.add(115, 90, 116, 91);
+    paths.update(far);
+    REQUIRE(paths.flow_field(goal) == field);
+
+    // Raise a sea wall across the middle and compare against a fresh build
+    for (u32 y = 0; y < 96; y++) {
+        for (u32 x = 60; x < 63; x++) planet.biome_map[y * 128 + x] = BiomeType::Ocean;
+    }
+    planet.elevation.at(20, 20) += 0.3f;
+    DirtyRegion wall(128, 96);
+    wall.add(60, 0, 63, 96);
+    wall.add(20, 20, 21, 21);
+    paths.update(wall);
+    REQUIRE(paths.flow_field(goal) != field);
+
+    Pathfinder fresh;
+    fresh.build(planet);
+    REQUIRE(paths.abstract_node_count() == fresh.abstract_node_count());
+    RNG rng(5);
+    for (int q = 0; q < 40; q++) {
+        u32 a = static_cast<u32>(rng.next_int(0, 128 * 96 - 1));
+        u32 b = static_cast<u32>(rng.next_int(0, 128 * 96 - 1));
+        auto p = paths.find_path(a, b);
+        auto f = fresh.find_path(a, b);
+        REQUIRE(p == f);
+        for (u32 cell : p) REQUIRE((cell % 128 < 60 || cell % 128 >= 63));
+    }
+}
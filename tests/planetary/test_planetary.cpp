@@ -233,11 +233,11 @@ TEST_CASE("Temperature is cold at poles, warm at equator", "[climate]") {
 }
 
 TEST_CASE("Moisture decreases inland", "[climate]") {
-    // Create elevation: ocean on left, land on right
+    // Create elevation: ocean at both edges (which wrap), land between
     Heightmap elevation(64, 64);
     for (u32 y = 0; y < 64; y++) {
         for (u32 x = 0; x < 64; x++) {
-            elevation.set(x, y, x < 16 ? 0.2f : 0.6f); // Left=ocean, right=land
+            elevation.set(x, y, x < 16 || x >= 56 ? 0.2f : 0.6f);
         }
     }
 
@@ -247,13 +247,69 @@ TEST_CASE("Moisture decreases inland", "[climate]") {
     auto temp = climate.generate_temperature(elevation, config);
     auto moisture = climate.generate_moisture(elevation, temp, config);
 
-    // Near-coast land should be wetter than far inland
-    f32 coastal = moisture.get(18, 32); // Just past shore
-    f32 inland = moisture.get(60, 32);  // Far from ocean
+    // The trade winds blow west off the eastern ocean: land just past
+    // that shore should be wetter than far inland
+    f32 coastal = moisture.get(53, 32); // Just past shore
+    f32 inland = moisture.get(36, 32);  // Far from ocean
 
     REQUIRE(coastal > inland);
 }
 
+/// Ocean everywhere but a land strip x in [16, 48) with a north-south
+/// ridge peaking at x = 32.
+static Heightmap ridge_world() {
+    Heightmap elevation(128, 64);
+    for (u32 y = 0; y < 64; y++) {
+        for (u32 x = 0; x < 128; x++) {
+            f32 ridge = std::max(0.0f, 0.35f - std::abs(static_cast<f32>(x) - 32.0f) * 0.05f);
+            elevation.set(x, y, x >= 16 && x < 48 ? 0.45f + ridge : 0.2f);
+        }
+    }
+    return elevation;
+}
+
+TEST_CASE("Mountains dry their lee side downwind", "[climate]") {
+    Heightmap elevation = ridge_world();
+    RNG rng(42);
+    ClimateGenerator climate(rng);
+    ClimateConfig config;
+    auto temp = climate.generate_temperature(elevation, config);
+    auto moisture = climate.generate_moisture(elevation, temp, config);
+
+    // Westerlies (row 20, latitude ~0.37): wind from the west, so the
+    // eastern foot of the ridge is in its shadow
+    f32 windward = moisture.get(25, 20);
+    f32 lee = moisture.get(39, 20);
+    REQUIRE(windward > lee + 0.1f);
+
+    // Trade easterlies (row 30, near the equator): the shadow flips west
+    windward = moisture.get(39, 30);
+    lee = moisture.get(25, 30);
+    REQUIRE(windward > lee + 0.1f);
+
+    // Still a valid moisture map everywhere
+    for (u32 y = 0; y < 64; y++) {
+        for (u32 x = 0; x < 128; x++) {
+            f32 m = moisture.get(x, y);
+            REQUIRE(m >= 0.0f);
+            REQUIRE(m <= 1.0f);
+        }
+    }
+}
+
+TEST_CASE("Wind sweeps converge in a couple of laps", "[climate]") {
+    Heightmap elevation = ridge_world();
+    Heightmap temp(128, 64, 15.0f);
+    ClimateConfig two, many;
+    many.wind_laps = 8;
+    RNG rng_a(5), rng_b(5);
+    auto a = ClimateGenerator(rng_a).generate_moisture(elevation, temp, two);
+    auto b = ClimateGenerator(rng_b).generate_moisture(elevation, temp, many);
+    for (u32 i = 0; i < a.size(); i++) {
+        REQUIRE(std::abs(a.data_ptr()[i] - b.data_ptr()[i]) < 1e-3f);
+    }
+}
+
 // ═══ PlanetData Tests ═══
 
 TEST_CASE("PlanetData serialisation round-trip", "[planet]") {
@@ -0,0 +1,114 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/ClimateGenerator.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/rng/RNG.h"
+
+#include <cmath>
+
+using namespace godsim;
+
+/// A 128×64 ocean world with a continent spanning x in [32, 96) and every
+/// latitude but the polar rows.
+static PlanetData seasonal_world(const ClimateConfig& config) {
+    PlanetData planet;
+    planet.width = 128;
+    planet.height = 64;
+    planet.sea_level = config.sea_level;
+    planet.elevation = Heightmap(128, 64, 0.2f);
+    for (u32 y = 4; y < 60; y++)
+        for (u32 x = 32; x < 96; x++) planet.elevation.set(x, y, 0.5f);
+
+    RNG rng(3);
+    ClimateGenerator climate(rng);
+    planet.temperature = climate.generate_temperature(planet.elevation, config);
+    planet.moisture = climate.generate_moisture(planet.elevation, planet.temperature, config);
+    planet.seasons = climate.generate_seasons(planet.elevation, config);
+    planet.classify_biomes();
+    return planet;
+}
+
+// ═══ Seasonal Climate Tests ═══
+
+TEST_CASE("Hemispheres have opposite seasons around the annual mean", "[seasons]") {
+    ClimateConfig config;
+    PlanetData planet = seasonal_world(config);
+    REQUIRE(planet.seasons.harmonics == 2);
+    REQUIRE(planet.seasons.temperature.size() == 128 * 64 * 4);
+
+    // Northern summer solstice is a quarter into the year
+    SeasonPhase july = planet.seasons.phase(0.3f);
+    SeasonPhase january = planet.seasons.phase(0.8f);
+    u32 north = 14, south = 49;
+    REQUIRE(planet.season_at(64, north, july).temperature >
+            planet.season_at(64, north, january).temperature + 10.0f);
+    REQUIRE(planet.season_at(64, south, january).temperature >
+            planet.season_at(64, south, july).temperature + 10.0f);
+
+    // The year averages out to the annual map
+    f64 sum = 0.0;
+    for (u32 day = 0; day < 365; day++) {
+        sum += planet.season_at(64, north, SimTime::from_days(day)).temperature;
+    }
+    REQUIRE(std::abs(sum / 365.0 - planet.temperature.get(64, north)) < 0.1);
+}
+
+TEST_CASE("Continental interiors swing harder than the sea", "[seasons]") {
+    ClimateConfig config;
+    PlanetData planet = seasonal_world(config);
+    auto amplitude = [&](u32 x, u32 y) { return planet.seasons.temperature_amplitude(y * 128 + x); };
+
+    u32 y = 12; // High northern latitude
+    REQUIRE(amplitude(64, y) > amplitude(34, y)); // Interior vs coast
+    REQUIRE(amplitude(34, y) > amplitude(10, y)); // Coast vs open ocean
+    REQUIRE(amplitude(64, y) > amplitude(64, 32) * 3.0f); // Poleward vs equator
+
+    // Ocean moisture has no seasons; the tropics have wet and dry ones
+    REQUIRE(planet.seasons.moisture_anomaly(20 * 128 + 10, planet.seasons.phase(0.25f)) == 0.0f);
+    f32 wet = planet.season_at(64, 26, planet.seasons.phase(0.3f)).moisture;
+    f32 dry = planet.season_at(64, 26, planet.seasons.phase(0.8f)).moisture;
+    REQUIRE(wet > dry);
+}
+
+TEST_CASE("Zero tilt means no seasons", "[seasons]") {
+    ClimateConfig config;
+    config.axial_tilt = 0.0f;
+    PlanetData planet = seasonal_world(config);
+    for (u32 y = 0; y < 64; y += 5) {
+        for (u32 x = 0; x < 128; x += 7) {
+            SeasonSample s = planet.season_at(x, y, SimTime::from_days(100));
+            REQUIRE(std::abs(s.temperature - planet.temperature.get(x, y)) < 1e-3f);
+        }
+    }
+}
+
+TEST_CASE("Seasons survive PlanetData serialisation", "[seasons]") {
+    ClimateConfig config;
+    config.season_harmonics = 3;
+    PlanetData planet = seasonal_world(config);
+
+    BinaryWriter writer;
+    planet.serialise(writer);
+    PlanetData loaded;
+    BinaryReader reader(writer.buffer());
+    loaded.deserialise(reader);
+    REQUIRE(reader.at_end());
+    REQUIRE(loaded.seasons.harmonics == 3);
+    REQUIRE(loaded.seasons.temperature == planet.seasons.temperature);
+    SimTime day = SimTime::from_days(4000);
+    REQUIRE(loaded.season_at(70, 20, day).temperature == planet.season_at(70, 20, day).temperature);
+    REQUIRE(loaded.season_at(70, 20, day).moisture == planet.season_at(70, 20, day).moisture);
+
+    // Version 6 planets end before the seasons (an empty cycle is four
+    // counts) and load without any
+    PlanetData fixed = planet;
+    fixed.seasons = {};
+    BinaryWriter old;
+    fixed.serialise(old);
+    std::vector<u8> bytes = old.buffer();
+    bytes.resize(bytes.size() - 4 * sizeof(u32));
+    BinaryReader old_reader(bytes);
+    loaded.deserialise(old_reader, 6);
+    REQUIRE(old_reader.at_end());
+    REQUIRE(loaded.seasons.empty());
+    REQUIRE(loaded.season_at(70, 20, day).temperature == planet.temperature.get(70, 20));
+}
@@ -0,0 +1,147 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/StreamingGenerator.h"
+#include "layers/planetary/TerrainGenerator.h"
+#include "layers/planetary/ClimateGenerator.h"
+#include "layers/planetary/ImageExporter.h"
+#include "layers/planetary/PlanetData.h"
+#include "core/rng/RNG.h"
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace godsim;
+
+static TerrainConfig small_terrain(i32 erosion) {
+    TerrainConfig config;
+    config.width = 120;
+    config.height = 80;
+    config.num_plates = 9;
+    config.erosion_iterations = erosion;
+    return config;
+}
+
+/// The in-memory pipeline, as PlanetaryLayer::generate_planet runs it.
+static PlanetData generate_in_memory(u64 seed, const TerrainConfig& tc) {
+    RNG rng(seed);
+    ClimateConfig cc;
+    cc.sea_level = tc.sea_level;
+
+    PlanetData planet;
+    planet.width = tc.width;
+    planet.height = tc.height;
+    planet.sea_level = tc.sea_level;
+    TerrainGenerator terrain(rng);
+    planet.elevation = terrain.generate(tc);
+    ClimateGenerator climate(rng);
+    planet.temperature = climate.generate_temperature(planet.elevation, cc);
+    planet.moisture = climate.generate_moisture(planet.elevation, planet.temperature, cc);
+    planet.classify_biomes();
+    return planet;
+}
+
+/// Stream the same seed and reassemble the bands into a PlanetData.
+static PlanetData generate_streamed(u64 seed, const TerrainConfig& tc, u32 band_rows,
+                                    size_t select_limit = size_t(1) << 22) {
+    RNG rng(seed);
+    ClimateConfig cc;
+    cc.sea_level = tc.sea_level;
+
+    StreamingConfig sc;
+    sc.band_rows = band_rows;
+    sc.select_limit = select_limit;
+    StreamingPlanetGenerator generator(rng, sc);
+    generator.prepare(tc, cc);
+
+    PlanetData planet;
+    planet.width = tc.width;
+    planet.height = tc.height;
+    planet.sea_level = tc.sea_level;
+    planet.elevation = Heightmap(tc.width, tc.height);
+    planet.temperature = Heightmap(tc.width, tc.height);
+    planet.moisture = Heightmap(tc.width, tc.height);
+    planet.biome_map.resize(static_cast<size_t>(tc.width) * tc.height);
+
+    generator.emit([&](const PlanetBand& band) {
+        size_t at = static_cast<size_t>(band.y0) * band.width;
+        size_t n = static_cast<size_t>(band.rows) * band.width;
+        std::copy(band.elevation, band.elevation + n, planet.elevation.data_ptr() + at);
+        std::copy(band.temperature, band.temperature + n, planet.temperature.data_ptr() + at);
+        std::copy(band.moisture, band.moisture + n, planet.moisture.data_ptr() + at);
+        std::copy(band.biomes, band.biomes + n, planet.biome_map.begin() + at);
+    });
+    return planet;
+}
+
+static bool same_grid(const Heightmap& a, const Heightmap& b) {
+    return std::equal(a.data_ptr(), a.data_ptr() + a.size(), b.data_ptr());
+}
+
+// ═══ Streaming Generation Tests ═══
+
+TEST_CASE("Streaming matches in-memory generation without erosion", "[streaming]") {
+    auto tc = small_terrain(0);
+    auto full = generate_in_memory(99, tc);
+    auto streamed = generate_streamed(99, tc, 7); // Band size not dividing the height
+
+    REQUIRE(same_grid(full.elevation, streamed.elevation));
+    REQUIRE(same_grid(full.temperature, streamed.temperature));
+    REQUIRE(same_grid(full.moisture, streamed.moisture));
+    REQUIRE(full.biome_map == streamed.biome_map);
+}
+
+TEST_CASE("Streaming with erosion puts the sea level quantile in place", "[streaming]") {
+    auto tc = small_terrain(4000);
+    auto streamed = generate_streamed(5, tc, 16, size_t(1) << 22);
+
+    size_t below = 0;
+    const auto& e = streamed.elevation;
+    for (size_t i = 0; i < e.size(); i++) below += e.data_ptr()[i] < tc.sea_level;
+    f32 fraction = static_cast<f32>(below) / e.size();
+    REQUIRE(fraction > tc.sea_level - 0.002f);
+    REQUIRE(fraction < tc.sea_level + 0.002f);
+    REQUIRE(e.min_value() >= 0.0f);
+    REQUIRE(e.max_value() <= 1.0f);
+}
+
+TEST_CASE("Histogram sea level selection is exact", "[streaming]") {
+    // A tiny gather limit forces several histogram passes over the spill
+    auto tc = small_terrain(4000);
+    auto direct = generate_streamed(8, tc, 16, size_t(1) << 22);
+    auto narrowed = generate_streamed(8, tc, 16, 50);
+
+    REQUIRE(same_grid(direct.elevation, narrowed.elevation));
+}
+
+TEST_CASE("Band writer output matches fused export", "[streaming]") {
+    auto dir = std::filesystem::temp_directory_path() / "godsim_stream_export";
+    std::filesystem::create_directories(dir / "full");
+    std::filesystem::create_directories(dir / "bands");
+
+    auto tc = small_terrain(0);
+    auto planet = generate_in_memory(3, tc);
+    ImageExporter::export_all(planet, (dir / "full").string());
+
+    RNG rng(3);
+    ClimateConfig cc;
+    StreamingConfig sc;
+    sc.band_rows = 32;
+    StreamingPlanetGenerator generator(rng, sc);
+    generator.prepare(tc, cc);
+
+    ImageExporter::BandWriter writer;
+    REQUIRE(writer.open((dir / "bands").string(), tc.width, tc.height, ImageFormat::PPM,
+                        tc.sea_level, generator.summary().temperature_min,
+                        generator.summary().temperature_max));
+    generator.emit([&](const PlanetBand& band) { writer.write_band(band); });
+    writer.close();
+
+    auto read = [](const std::filesystem::path& p) {
+        std::ifstream f(p, std::ios::binary);
+        return std::vector<char>(std::istreambuf_iterator<char>(f), {});
+    };
+    for (const char* name : {"elevation.ppm", "biomes.ppm", "temperature.ppm", "moisture.ppm"}) {
+        REQUIRE(read(dir / "full" / name) == read(dir / "bands" / name));
+    }
+    REQUIRE(generator.summary().land_fraction == planet.land_fraction);
+}
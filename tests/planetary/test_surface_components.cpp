@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/SurfaceComponents.h"
+#include "core/rng/RNG.h"
+#include "support/TestPlanet.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace godsim;
+
+/// Same partition of the grid, whatever the label numbers.
+static bool same_partition(const std::vector<u32>& a, const std::vector<u32>& b) {
+    std::map<u32, u32> ab, ba;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (ab.emplace(a[i], b[i]).first->second != b[i]) return false;
+        if (ba.emplace(b[i], a[i]).first->second != a[i]) return false;
+    }
+    return true;
+}
+
+// ═══ Surface Component Tests ═══
+
+TEST_CASE("Components wrap the seam and enclose inland seas", "[components]") {
+    const u32 W = 64, H = 32;
+    PlanetData planet = make_test_planet(W, H, {.elevation = 0.2f});
+    // An island straddling the seam, and a ring continent with a sea inside
+    for (u32 y = 10; y < 14; y++) {
+        for (u32 x : {62u, 63u, 0u, 1u, 2u}) planet.elevation.set(x, y, 0.6f);
+    }
+    for (u32 y = 15; y < 25; y++) {
+        for (u32 x = 20; x < 35; x++) {
+            bool inner = y >= 18 && y < 22 && x >= 25 && x < 30;
+            planet.elevation.set(x, y, inner ? 0.3f : 0.7f);
+        }
+    }
+
+    SurfaceComponents components;
+    components.build(planet);
+    REQUIRE(components.count() == 4);
+    REQUIRE(components.count(true) == 2);
+    REQUIRE(components.count(false) == 2);
+
+    // Labels run in raster order of each component's first cell
+    REQUIRE(components.label_at(0, 0) == 0);
+    const SurfaceComponent& island = components.component(components.label_at(0, 10));
+    REQUIRE(components.label_at(63, 12) == components.label_at(0, 10));
+    REQUIRE(island.land);
+    REQUIRE(island.cells == 20);
+    REQUIRE(island.bounds.x0 == 62);
+    REQUIRE(island.bounds.x1 == W + 3);
+    REQUIRE(island.bounds.y0 == 10);
+    REQUIRE(island.bounds.y1 == 14);
+    REQUIRE(std::abs(island.centroid_x - 0.0f) < 0.01f);
+    REQUIRE(std::abs(island.centroid_y - 11.5f) < 0.1f); // Area-weighted: nudged poleward
+
+    const SurfaceComponent& inland = components.component(components.label_at(27, 20));
+    REQUIRE_FALSE(inland.land);
+    REQUIRE(inland.cells == 20);
+    REQUIRE(components.label_at(27, 20) != components.label_at(0, 0));
+
+    f64 total = 0.0;
+    for (const auto& c : components.components()) total += c.area;
+    REQUIRE(std::abs(total - 1.0) < 1e-4);
+    REQUIRE(components.component(components.label_at(0, 0)).area > 0.85f);
+}
+
+TEST_CASE("Parallel labelling matches a flood fill on noise", "[components]") {
+    const u32 W = 256, H = 128;
+    PlanetData planet = make_test_planet(W, H, {.elevation = 0.2f});
+    RNG rng(7);
+    for (u32 y = 0; y < H; y++)
+        for (u32 x = 0; x < W; x++) planet.elevation.set(x, y, rng.next_float());
+
+    SurfaceComponents components;
+    components.build(planet);
+
+    // Reference: serial flood fill with wrap
+    std::vector<u32> ref(W * H, SurfaceComponents::NO_LABEL);
+    u32 next = 0;
+    for (u32 start = 0; start < W * H; start++) {
+        if (ref[start] != SurfaceComponents::NO_LABEL) continue;
+        bool land = planet.elevation.data_ptr()[start] >= planet.sea_level;
+        std::vector<u32> stack = {start};
+        ref[start] = next;
+        while (!stack.empty()) {
+            u32 c = stack.back();
+            stack.pop_back();
+            u32 x = c % W, y = c / W;
+            u32 nbrs[4] = {y * W + (x + 1) % W, y * W + (x + W - 1) % W,
+                           y > 0 ? c - W : c, y + 1 < H ? c + W : c};
+            for (u32 n : nbrs) {
+                if (ref[n] == SurfaceComponents::NO_LABEL &&
+                    (planet.elevation.data_ptr()[n] >= planet.sea_level) == land) {
+                    ref[n] = next;
+                    stack.push_back(n);
+                }
+            }
+        }
+        next++;
+    }
+    REQUIRE(components.count() == next);
+    REQUIRE(components.labels() == ref); // Same numbering too: raster order
+}
+
+TEST_CASE("Incremental relabelling matches a full rebuild", "[components]") {
+    const u32 W = 128, H = 64;
+    PlanetData planet = make_test_planet(W, H, {.elevation = 0.2f});
+    RNG rng(11);
+    for (u32 y = 0; y < H; y++)
+        for (u32 x = 0; x < W; x++) planet.elevation.set(x, y, rng.next_float() < 0.55f ? 0.6f : 0.2f);
+
+    SurfaceComponents components;
+    components.build(planet);
+    u32 far_label = components.label_at(64, 60);
+    SurfaceComponent far = components.component(far_label);
+
+    // Raise a land bridge, sink a channel, and paint across the seam
+    for (int round = 0; round < 3; round++) {
+        DirtyRegion dirty(W, H);
+        i32 x0 = round == 2 ? 120 : 10 + round * 20;
+        for (i32 y = 5; y < 15; y++) {
+            for (i32 x = x0; x < x0 + 16; x++) {
+                planet.elevation.set(static_cast<u32>(x) % W, y, round == 1 ? 0.2f : 0.6f);
+            }
+        }
+        dirty.add(x0, 5, x0 + 16, 15);
+        components.update(dirty);
+
+        SurfaceComponents fresh;
+        fresh.build(planet);
+        REQUIRE(components.count() == fresh.count());
+        REQUIRE(same_partition(components.labels(), fresh.labels()));
+        for (u32 i = 0; i < W * H; i += 7) {
+            const auto& a = components.component(components.labels()[i]);
+            const auto& b = fresh.component(fresh.labels()[i]);
+            REQUIRE(a.cells == b.cells);
+            REQUIRE(a.land == b.land);
+            REQUIRE(a.bounds.x0 == b.bounds.x0);
+            REQUIRE(a.bounds.y1 == b.bounds.y1);
+        }
+    }
+
+    // A component nowhere near the edits keeps its label
+    if (far.bounds.y0 > 16) {
+        REQUIRE(components.label_at(64, 60) == far_label);
+        REQUIRE(components.component(far_label).cells == far.cells);
+    }
+}
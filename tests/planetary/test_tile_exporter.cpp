@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "layers/planetary/DirtyRegion.h"
+#include "layers/planetary/TileExporter.h"
+#include "layers/planetary/PlanetData.h"
+#include "support/TestPlanet.h"
+
+#include <filesystem>
+
+using namespace godsim;
+
+/// Elevation rising west to east, temperature from -30 °C in the north to
+/// 30 °C in the south.
+static const TestPlanetConfig BANDED = {.elevation_ramp = true, .temperature = -30.0f, .temperature_rise = 60.0f};
+
+// ═══ Dirty Region Tests ═══
+
+TEST_CASE("DirtyRegion splits rects across the longitude seam", "[dirty]") {
+    DirtyRegion region(100, 50);
+    region.add(-5, 10, 5, 20);
+
+    REQUIRE(region.rects().size() == 2);
+    u32 cells = 0;
+    for (const auto& r : region.rects()) cells += r.width() * r.height();
+    REQUIRE(cells == 10 * 10);
+}
+
+TEST_CASE("DirtyRegion merges overlapping rects and clamps latitude", "[dirty]") {
+    DirtyRegion region(100, 50);
+    region.add(10, -4, 20, 10);
+    region.add(15, 5, 30, 60);
+
+    REQUIRE(region.rects().size() == 1);
+    const auto& r = region.rects()[0];
+    REQUIRE(r.x0 == 10);
+    REQUIRE(r.x1 == 30);
+    REQUIRE(r.y0 == 0);
+    REQUIRE(r.y1 == 50);
+}
+
+// ═══ Tile Pyramid Tests ═══
+
+TEST_CASE("Max zoom covers the grid with tiles", "[tiles]") {
+    REQUIRE(TileExporter::max_zoom_for(256, 128, 256) == 0);
+    REQUIRE(TileExporter::max_zoom_for(512, 256, 256) == 1);
+    REQUIRE(TileExporter::max_zoom_for(1000, 500, 256) == 2);
+}
+
+TEST_CASE("Tile export writes every level", "[tiles]") {
+    auto dir = (std::filesystem::temp_directory_path() / "godsim_tiles_full").string();
+    std::filesystem::remove_all(dir);
+    auto planet = make_test_planet(200, 100, BANDED);
+
+    TileConfig config;
+    config.tile_size = 64;
+    config.layers = {TileLayer::Biome, TileLayer::Temperature};
+    TileExporter tiles(config);
+
+    // z2: 4x2 tiles, z1: 2x1, z0: 1x1 → 11 per layer
+    REQUIRE(tiles.export_all(planet, dir) == 22);
+    REQUIRE(tiles.max_zoom() == 2);
+    REQUIRE(std::filesystem::exists(tiles.tile_path(dir, TileLayer::Biome, 2, 3, 1)));
+    REQUIRE(std::filesystem::exists(tiles.tile_path(dir, TileLayer::Temperature, 0, 0, 0)));
+    REQUIRE(std::filesystem::exists(dir + "/tiles.json"));
+}
+
+TEST_CASE("Dirty export only rewrites tiles under the edit", "[tiles]") {
+    auto dir = (std::filesystem::temp_directory_path() / "godsim_tiles_dirty").string();
+    std::filesystem::remove_all(dir);
+    auto planet = make_test_planet(200, 100, BANDED);
+
+    TileConfig config;
+    config.tile_size = 64;
+    config.layers = {TileLayer::Terrain};
+    TileExporter tiles(config);
+    tiles.export_all(planet, dir);
+
+    REQUIRE(tiles.export_dirty(planet, dir) == 0);
+
+    // Edit inside tile (0, 0) at full resolution
+    planet.elevation.set(10, 10, 1.0f);
+    tiles.mark_dirty(CellRect{8, 8, 12, 12});
+    REQUIRE(tiles.has_dirty());
+
+    // One tile per level
+    REQUIRE(tiles.export_dirty(planet, dir) == 3);
+    REQUIRE_FALSE(tiles.has_dirty());
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/FrameCapture.h"
+#include "support/TestPlanet.h"
+
+#include <cmath>
+#include <filesystem>
+#include <sstream>
+
+using namespace godsim;
+
+// ═══ Frame Capture Tests ═══
+
+TEST_CASE("Camera paths interpolate between keys", "[capture]") {
+    CameraPath path;
+    path.add(2.0f, {1.0f, 0.2f, 4.0f});
+    path.add(0.0f, {0.0f, 0.0f, 2.0f});
+    REQUIRE(path.duration() == 2.0f);
+
+    OrbitPose mid = path.at(1.0f);
+    REQUIRE(std::abs(mid.yaw - 0.5f) < 1e-6f);
+    REQUIRE(std::abs(mid.pitch - 0.1f) < 1e-6f);
+    REQUIRE(std::abs(mid.distance - 3.0f) < 1e-6f);
+    REQUIRE(path.at(-1.0f).distance == 2.0f);
+    REQUIRE(path.at(9.0f).distance == 4.0f);
+
+    // A turntable keeps turning past 2π rather than wrapping back
+    CameraPath spin = CameraPath::turntable(4.0f, 0.3f, 3.0f, 2.0f);
+    REQUIRE(spin.at(3.0f).yaw > 6.2832f);
+}
+
+TEST_CASE("Camera paths parse from text", "[capture]") {
+    std::istringstream text("# time yaw pitch distance\n"
+                            "0   0  10 3.0\n"
+                            "\n"
+                            "5 180 -10 2.5  # halfway round\n");
+    CameraPath path;
+    REQUIRE(CameraPath::parse(text, path));
+    REQUIRE(path.keys().size() == 2);
+    REQUIRE(std::abs(path.at(5.0f).yaw - 3.14159265f) < 1e-5f);
+    REQUIRE(std::abs(path.at(0.0f).pitch - 0.17453293f) < 1e-5f);
+
+    std::istringstream bad("0 0 0\n");
+    REQUIRE_FALSE(CameraPath::parse(bad, path));
+}
+
+TEST_CASE("Software renderer draws the planet centred in frame", "[capture]") {
+    PlanetData planet = make_test_planet(64, 32, {.elevation_ramp = true});
+    SoftwareRenderer renderer(planet);
+    std::vector<u8> rgb;
+    u32 w = 48, h = 32;
+    renderer.render({0.0f, 0.0f, 3.2f}, 45.0f, w, h, rgb);
+    REQUIRE(rgb.size() == w * h * 3);
+
+    auto pixel = [&](u32 x, u32 y) { return &rgb[(y * w + x) * 3]; };
+    const u8* centre = pixel(w / 2, h / 2);
+    REQUIRE(centre[0] + centre[1] + centre[2] > 30);
+    const u8* corner = pixel(0, 0);
+    REQUIRE(corner[0] + corner[1] + corner[2] == 0);
+
+    // The view ray through the centre points at the origin
+    ViewRays view({0.7f, 0.4f, 5.0f}, 45.0f, 1.5f);
+    Vec3f ray = view.ray(50, 50, 101, 101);
+    REQUIRE(ray.dot(view.forward) > 0.9999f);
+    REQUIRE(ray_sphere(view.eye, ray, 1.0f) > 0.0f);
+}
+
+TEST_CASE("Software capture writes one image per frame", "[capture]") {
+    PlanetData planet = make_test_planet(32, 16, {.elevation_ramp = true});
+    CaptureSettings settings;
+    settings.width = 16;
+    settings.height = 12;
+    settings.frames = 3;
+    settings.format = ImageFormat::PPM;
+    settings.output_dir = (std::filesystem::temp_directory_path() / "godsim_capture_test").string();
+    std::filesystem::remove_all(settings.output_dir);
+
+    CaptureReport report = capture_software(planet, settings);
+    REQUIRE(report.frames == 3);
+    for (u32 i = 0; i < 3; i++) {
+        auto path = capture_frame_path(settings, i);
+        REQUIRE(std::filesystem::exists(path));
+        REQUIRE(std::filesystem::file_size(path) == 13 + 16 * 12 * 3); // "P6\n16 12\n255\n"
+    }
+    REQUIRE(capture_frame_path(settings, 42).find("frame_00042.ppm") != std::string::npos);
+    std::filesystem::remove_all(settings.output_dir);
+}
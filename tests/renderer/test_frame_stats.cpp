@@ -0,0 +1,55 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/FrameStats.h"
+
+using namespace godsim;
+
+static FrameSample frame(f32 ms, f32 gpu = -1.0f) {
+    FrameSample s;
+    s.frame_ms = ms;
+    s.gpu_ms = gpu;
+    return s;
+}
+
+static f32 frame_ms(const FrameSample& s) { return s.frame_ms; }
+static f32 gpu_ms(const FrameSample& s) { return s.gpu_ms; }
+
+// ═══ Frame Stats Tests ═══
+
+TEST_CASE("Percentiles use nearest rank over the history", "[frame_stats]") {
+    FrameStats stats;
+    for (int i = 100; i >= 1; i--) stats.record(frame(static_cast<f32>(i)));
+    REQUIRE(stats.size() == 100);
+    REQUIRE(stats.percentile(50.0f, frame_ms) == 50.0f);
+    REQUIRE(stats.percentile(95.0f, frame_ms) == 95.0f);
+    REQUIRE(stats.percentile(99.0f, frame_ms) == 99.0f);
+    REQUIRE(stats.percentile(100.0f, frame_ms) == 100.0f);
+    REQUIRE(stats.percentile(0.0f, frame_ms) == 1.0f);
+}
+
+TEST_CASE("Unavailable GPU times are skipped", "[frame_stats]") {
+    FrameStats stats;
+    stats.record(frame(16.0f));
+    REQUIRE(stats.percentile(50.0f, gpu_ms) == -1.0f);
+    REQUIRE(stats.mean_recent(10, gpu_ms) == -1.0f);
+
+    stats.record(frame(16.0f, 4.0f));
+    stats.record(frame(16.0f, 6.0f));
+    REQUIRE(stats.mean_recent(10, gpu_ms) == 5.0f);
+    REQUIRE(stats.percentile(100.0f, gpu_ms) == 6.0f);
+}
+
+TEST_CASE("History keeps the most recent frames", "[frame_stats]") {
+    FrameStats stats(4);
+    for (int i = 1; i <= 10; i++) {
+        FrameSample s = frame(static_cast<f32>(i));
+        s.upload_bytes = 100;
+        stats.record(s);
+    }
+    REQUIRE(stats.size() == 4);
+    REQUIRE(stats.frames() == 10);
+    REQUIRE(stats.total_upload_bytes() == 1000);
+    REQUIRE(stats.recent().frame_ms == 10.0f);
+    REQUIRE(stats.recent(3).frame_ms == 7.0f);
+    REQUIRE(stats.mean_recent(2, frame_ms) == 9.5f);
+    REQUIRE(stats.percentile(0.0f, frame_ms) == 7.0f);
+}
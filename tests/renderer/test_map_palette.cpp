@@ -0,0 +1,37 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/MapPalette.h"
+
+using namespace godsim;
+
+// ═══ Map Palette Tests ═══
+
+TEST_CASE("Palette biome row matches the biome table", "[palette]") {
+    std::vector<u8> rgb;
+    build_map_palette(0.4f, rgb);
+    REQUIRE(rgb.size() == PALETTE_WIDTH * PALETTE_ROWS * 3);
+    for (size_t i = 0; i < BIOME_INFO.size(); i++) {
+        REQUIRE(rgb[i * 3 + 0] == BIOME_INFO[i].r);
+        REQUIRE(rgb[i * 3 + 1] == BIOME_INFO[i].g);
+        REQUIRE(rgb[i * 3 + 2] == BIOME_INFO[i].b);
+    }
+}
+
+TEST_CASE("Palette ramps sample the colour functions", "[palette]") {
+    std::vector<u8> rgb;
+    build_map_palette(0.4f, rgb);
+    auto entry = [&](MapPaletteRow row, u32 i) {
+        return rgb.data() + (static_cast<size_t>(row) * PALETTE_WIDTH + i) * 3;
+    };
+
+    u8 expected[3];
+    elevation_ramp(0.0f, 0.4f, expected);
+    REQUIRE(entry(MapPaletteRow::Elevation, 0)[2] == expected[2]);
+    elevation_ramp(1.0f, 0.4f, expected);
+    REQUIRE(entry(MapPaletteRow::Elevation, 255)[0] == expected[0]);
+
+    // Cold end is blue, hot end red
+    REQUIRE(entry(MapPaletteRow::Temperature, 0)[2] > entry(MapPaletteRow::Temperature, 0)[0]);
+    REQUIRE(entry(MapPaletteRow::Temperature, 255)[0] > entry(MapPaletteRow::Temperature, 255)[2]);
+    moisture_ramp(0.5f, expected);
+    REQUIRE(entry(MapPaletteRow::Moisture, 128)[1] >= expected[1] - 2);
+}
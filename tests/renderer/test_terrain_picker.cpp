@@ -0,0 +1,126 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/TerrainPicker.h"
+
+#include <cmath>
+#include <random>
+
+using namespace godsim;
+
+static Heightmap rough_map(u32 w, u32 h, u32 seed) {
+    Heightmap map(w, h);
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<f32> jitter(-0.05f, 0.05f);
+    for (u32 y = 0; y < h; y++) {
+        for (u32 x = 0; x < w; x++) {
+            f32 base = 0.5f + 0.3f * std::sin(x * 0.11f) * std::cos(y * 0.17f);
+            map.set(x, y, std::clamp(base + jitter(rng), 0.0f, 1.0f));
+        }
+    }
+    return map;
+}
+
+/// Reference: march in tiny fixed steps and bisect the first crossing.
+static f32 brute_force(const TerrainBaker& baker, const Vec3f& o, const Vec3f& d, f32 step) {
+    auto above = [&](f32 t) {
+        Vec3f p = o + d * t;
+        f32 r = p.length();
+        return r > baker.radius_for(baker.elevation_at(p * (1.0f / r)));
+    };
+    for (f32 t = 0.0f; t < 10.0f; t += step) {
+        if (above(t)) continue;
+        f32 a = t - step, b = t;
+        for (int i = 0; i < 30; i++) {
+            f32 m = 0.5f * (a + b);
+            (above(m) ? a : b) = m;
+        }
+        return b;
+    }
+    return -1.0f;
+}
+
+static Vec3f look_at_ray(const Vec3f& eye, const Vec3f& target) {
+    return (target - eye).normalized();
+}
+
+// ═══ Terrain Picker Tests ═══
+
+TEST_CASE("Picker pyramid bounds the surface", "[picker]") {
+    Heightmap map = rough_map(100, 50, 1);
+    TerrainPicker picker;
+    picker.build(map, 0.4f, 0.2f);
+    REQUIRE(picker.level_count() >= 5);
+    TerrainBaker baker(map, 0.4f, 0.2f);
+    REQUIRE(picker.max_radius() >= baker.radius_for(map.max_value()) - 1e-6f);
+}
+
+TEST_CASE("Picks match a brute-force march of the displaced surface", "[picker]") {
+    Heightmap map = rough_map(128, 64, 7);
+    f32 sea = 0.4f, scale = 0.25f; // Exaggerated relief
+    TerrainPicker picker;
+    picker.build(map, sea, scale);
+    TerrainBaker baker(map, sea, scale);
+
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<f32> unit(-1.0f, 1.0f);
+    int hits = 0;
+    for (int i = 0; i < 200; i++) {
+        Vec3f eye = Vec3f{unit(rng), unit(rng) * 0.6f, unit(rng)}.normalized() * 3.0f;
+        Vec3f target{unit(rng) * 1.1f, unit(rng) * 1.1f, unit(rng) * 1.1f};
+        Vec3f dir = look_at_ray(eye, target);
+
+        TerrainPicker::Hit hit = picker.intersect(eye, dir);
+        f32 expected = brute_force(baker, eye, dir, 0.0005f);
+        INFO("eye " << eye.x << " " << eye.y << " " << eye.z << " dir " << dir.x << " " << dir.y
+             << " " << dir.z << " expected " << expected << " got " << hit.t << " steps " << hit.steps);
+        REQUIRE(hit.hit == (expected >= 0.0f));
+        if (!hit.hit) continue;
+        hits++;
+        REQUIRE(std::abs(hit.t - expected) < 2e-3f);
+        REQUIRE(hit.steps < 600);
+    }
+    REQUIRE(hits > 50);
+}
+
+TEST_CASE("Mountains are picked before the sphere behind them", "[picker]") {
+    Heightmap map(64, 32, 0.0f);
+    for (u32 y = 14; y < 18; y++)
+        for (u32 x = 0; x < 4; x++) map.set(x, y, 1.0f); // Peak near u = 0 on the equator
+    TerrainPicker picker;
+    picker.build(map, 0.0f, 0.2f);
+
+    // Pass beside the sphere, through the peak: sphere picking would miss
+    Vec3f eye{1.15f, 0.0f, -3.0f};
+    TerrainPicker::Hit hit = picker.intersect(eye, {0.0f, 0.0f, 1.0f});
+    REQUIRE(hit.hit);
+    REQUIRE(hit.position.length() > 1.14f);
+    REQUIRE((hit.u < 0.05f || hit.u > 0.95f));
+    REQUIRE(std::abs(hit.v - 0.5f) < 0.05f);
+
+    // Flatten it and refresh: the ray now misses
+    for (u32 y = 14; y < 18; y++)
+        for (u32 x = 0; x < 4; x++) map.set(x, y, 0.0f);
+    DirtyRegion edit(64, 32);
+    edit.add(0, 14, 4, 18);
+    picker.update(edit);
+    REQUIRE_FALSE(picker.intersect(eye, {0.0f, 0.0f, 1.0f}).hit);
+}
+
+TEST_CASE("Edits across the seam refresh the wrapped patch", "[picker]") {
+    Heightmap map(64, 32, 0.0f);
+    TerrainPicker picker;
+    picker.build(map, 0.0f, 0.2f);
+    map.set(0, 16, 1.0f);
+    DirtyRegion edit(64, 32);
+    edit.add(0, 16, 1, 17);
+    picker.update(edit);
+
+    // Patch 63 spans texels 63 and 0: a ray at its centre now hits high
+    TerrainBaker baker(map, 0.0f, 0.2f);
+    f32 u = 63.75f / 64.0f, v = 16.5f / 32.0f;
+    Vec3f dir{std::cos(u * 6.2831853f) * std::sin(v * 3.1415927f), std::cos(v * 3.1415927f),
+              std::sin(u * 6.2831853f) * std::sin(v * 3.1415927f)};
+    TerrainPicker::Hit hit = picker.intersect(dir * 3.0f, dir * -1.0f);
+    REQUIRE(hit.hit);
+    REQUIRE(std::abs(hit.position.length() - baker.radius_for(baker.elevation_at(dir))) < 1e-4f);
+    REQUIRE(hit.position.length() > 1.01f);
+}
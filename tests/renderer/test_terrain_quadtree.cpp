@@ -0,0 +1,173 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/TerrainQuadtree.h"
+
+#include <cmath>
+#include <set>
+
+using namespace godsim;
+
+/// Column-major perspective × look-at-origin, as Camera builds with glm.
+static LodView make_view(Vec3f eye, f32 fov_deg = 45.0f, f32 aspect = 16.0f / 9.0f,
+                         f32 height = 720.0f) {
+    f32 fov = fov_deg * 3.14159265f / 180.0f;
+    f32 near = 0.01f, far = 100.0f;
+    f32 f = 1.0f / std::tan(fov * 0.5f);
+
+    Vec3f fwd = (Vec3f{} - eye).normalized();
+    Vec3f up{0.0f, 1.0f, 0.0f};
+    if (std::abs(fwd.dot(up)) > 0.99f) up = {0.0f, 0.0f, 1.0f};
+    auto cross = [](Vec3f a, Vec3f b) {
+        return Vec3f{a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x};
+    };
+    Vec3f s = cross(fwd, up).normalized();
+    Vec3f u = cross(s, fwd);
+
+    // view rows: s, u, -fwd; translation -R·eye
+    f32 view[4][4] = {
+        { s.x,    s.y,    s.z,    -s.dot(eye)},
+        { u.x,    u.y,    u.z,    -u.dot(eye)},
+        {-fwd.x, -fwd.y, -fwd.z,   fwd.dot(eye)},
+        { 0,      0,      0,       1},
+    };
+    f32 proj[4][4] = {
+        {f / aspect, 0, 0, 0},
+        {0, f, 0, 0},
+        {0, 0, (far + near) / (near - far), 2 * far * near / (near - far)},
+        {0, 0, -1, 0},
+    };
+
+    LodView lv;
+    lv.eye = eye;
+    lv.fov_y = fov;
+    lv.viewport_height = height;
+    for (u32 r = 0; r < 4; r++)
+        for (u32 c = 0; c < 4; c++) {
+            f32 sum = 0.0f;
+            for (u32 k = 0; k < 4; k++) sum += proj[r][k] * view[k][c];
+            lv.view_proj[c * 4 + r] = sum;
+        }
+    return lv;
+}
+
+// ═══ Quadtree LOD Tests ═══
+
+TEST_CASE("Chunk keys round-trip through parent and child", "[lod]") {
+    ChunkKey key{3, 4, 9, 6};
+    for (u32 c = 0; c < 4; c++) REQUIRE(key.child(c).parent() == key);
+    REQUIRE(key.child(3).x == 19);
+    REQUIRE(key.child(3).y == 13);
+    REQUIRE(key.packed() != key.child(0).packed());
+}
+
+TEST_CASE("Chunk vertices lie on the unit sphere", "[lod]") {
+    TerrainQuadtree tree;
+    std::vector<Vec3f> pos;
+    tree.chunk_positions({2, 3, 5, 1}, pos);
+    u32 n = tree.config().chunk_res;
+    for (u32 i = 0; i < (n + 1) * (n + 1); i++) {
+        REQUIRE(std::abs(pos[i].length() - 1.0f) < 1e-5f);
+    }
+    // Skirts hang below the surface
+    REQUIRE(pos.back().length() < 1.0f);
+}
+
+TEST_CASE("Neighbouring chunk edges coincide, across faces too", "[lod]") {
+    TerrainQuadtree tree;
+    u32 n = tree.config().chunk_res;
+
+    // Same face: right edge of (0,0) is the left edge of (1,0)
+    for (u32 j = 0; j <= n; j++) {
+        Vec3f a = tree.chunk_point({4, 1, 0, 0}, n, j);
+        Vec3f b = tree.chunk_point({4, 1, 1, 0}, 0, j);
+        REQUIRE(a.x == b.x);
+        REQUIRE(a.y == b.y);
+        REQUIRE(a.z == b.z);
+    }
+
+    // Across the +X / -Z cube edge every +X edge vertex is a -Z edge vertex
+    for (u32 j = 0; j <= n; j++) {
+        Vec3f a = tree.chunk_point({0, 0, 0, 0}, n, j);
+        Vec3f b = tree.chunk_point({5, 0, 0, 0}, 0, j);
+        REQUIRE(a.x == b.x);
+        REQUIRE(a.y == b.y);
+        REQUIRE(a.z == b.z);
+    }
+}
+
+TEST_CASE("Shared index list references every vertex", "[lod]") {
+    TerrainQuadtree tree;
+    auto indices = tree.chunk_indices();
+    REQUIRE(indices.size() == tree.triangles_per_chunk() * 3);
+    std::set<u32> used(indices.begin(), indices.end());
+    REQUIRE(used.size() == tree.vertices_per_chunk());
+    REQUIRE(*used.rbegin() == tree.vertices_per_chunk() - 1);
+}
+
+TEST_CASE("Max level follows the map resolution", "[lod]") {
+    REQUIRE(TerrainQuadtree::max_level_for(64, 16) == 2);
+    u32 small = TerrainQuadtree::max_level_for(512, 16);
+    u32 large = TerrainQuadtree::max_level_for(4096, 16);
+    REQUIRE(large == small + 3);
+}
+
+TEST_CASE("Distant camera selects coarse chunks", "[lod]") {
+    TerrainQuadtree tree;
+    std::vector<ChunkKey> chunks;
+    tree.select(make_view({0.0f, 0.0f, 20.0f}), chunks);
+
+    REQUIRE(!chunks.empty());
+    REQUIRE(chunks.size() <= 24);
+    for (const auto& c : chunks) REQUIRE(c.level <= 1);
+}
+
+TEST_CASE("Close camera refines under itself and stays bounded", "[lod]") {
+    QuadtreeConfig config;
+    config.max_level = 10;
+    TerrainQuadtree tree(config);
+    std::vector<ChunkKey> chunks;
+    Vec3f eye{0.0f, 0.0f, 1.3f};
+    tree.select(make_view(eye), chunks);
+
+    u32 deepest = 0;
+    ChunkKey finest;
+    for (const auto& c : chunks) {
+        if (c.level > deepest) { deepest = c.level; finest = c; }
+    }
+    REQUIRE(deepest >= 4);
+    // The finest chunk is near the sub-camera point
+    REQUIRE(tree.bounds(finest).dir.dot(eye.normalized()) > 0.95f);
+    REQUIRE(chunks.size() * tree.triangles_per_chunk() < 1'000'000);
+}
+
+TEST_CASE("Selection has no overlapping chunks", "[lod]") {
+    QuadtreeConfig config;
+    config.max_level = 8;
+    TerrainQuadtree tree(config);
+    std::vector<ChunkKey> chunks;
+    tree.select(make_view({0.6f, 0.9f, 1.0f}), chunks);
+
+    std::set<u64> ids;
+    for (const auto& c : chunks) ids.insert(c.packed());
+    for (const auto& c : chunks) {
+        for (ChunkKey p = c; p.level > 0;) {
+            p = p.parent();
+            REQUIRE(ids.count(p.packed()) == 0);
+        }
+    }
+}
+
+TEST_CASE("Far side and off-screen chunks are culled", "[lod]") {
+    QuadtreeConfig config;
+    config.max_level = 8;
+    TerrainQuadtree tree(config);
+    std::vector<ChunkKey> chunks;
+    Vec3f eye{0.0f, 0.0f, 1.5f};
+    tree.select(make_view(eye), chunks);
+
+    REQUIRE(tree.stats().culled_horizon > 0);
+    REQUIRE(tree.stats().culled_frustum > 0);
+    for (const auto& c : chunks) {
+        REQUIRE(c.face != 5); // -Z faces away from the camera
+        REQUIRE(tree.bounds(c).dir.dot(eye.normalized()) > -0.2f);
+    }
+}
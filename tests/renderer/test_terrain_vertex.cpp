@@ -0,0 +1,104 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/TerrainVertex.h"
+
+#include <cmath>
+
+using namespace godsim;
+
+static Heightmap ramp_map(u32 w, u32 h) {
+    Heightmap map(w, h);
+    for (u32 y = 0; y < h; y++)
+        for (u32 x = 0; x < w; x++) map.set(x, y, static_cast<f32>(x) / w);
+    return map;
+}
+
+static Vec3f unpack(const PackedVertex& v, const ChunkFrame& f) {
+    return {f.origin.x + v.px / 65535.0f * f.extent.x,
+            f.origin.y + v.py / 65535.0f * f.extent.y,
+            f.origin.z + v.pz / 65535.0f * f.extent.z};
+}
+
+// ═══ Terrain Vertex Tests ═══
+
+TEST_CASE("Octahedral normals round-trip closely", "[terrain_vertex]") {
+    for (f32 a = 0.05f; a < 6.28f; a += 0.37f) {
+        for (f32 b = -1.5f; b < 1.5f; b += 0.29f) {
+            Vec3f n{std::cos(b) * std::cos(a), std::sin(b), std::cos(b) * std::sin(a)};
+            i16 ox, oy;
+            oct_encode(n, ox, oy);
+            REQUIRE(oct_decode(ox, oy).dot(n) > 0.99999f);
+        }
+    }
+    i16 ox, oy;
+    oct_encode({0.0f, 0.0f, -1.0f}, ox, oy);
+    REQUIRE(oct_decode(ox, oy).z < -0.9999f);
+}
+
+TEST_CASE("Flat sea-level terrain bakes onto the unit sphere", "[terrain_vertex]") {
+    Heightmap flat(64, 32, 0.2f);
+    TerrainBaker baker(flat, 0.4f, 0.035f);
+    TerrainQuadtree tree;
+    std::vector<PackedVertex> verts;
+    ChunkFrame frame;
+    ChunkKey key{1, 2, 3, 1};
+    baker.bake(tree, key, verts, frame);
+
+    std::vector<Vec3f> dirs;
+    tree.chunk_positions(key, dirs);
+    u32 grid = (tree.config().chunk_res + 1) * (tree.config().chunk_res + 1);
+    for (u32 i = 0; i < grid; i++) {
+        Vec3f p = unpack(verts[i], frame);
+        REQUIRE(std::abs(p.length() - 1.0f) < 1e-4f);
+        REQUIRE(oct_decode(verts[i].nx, verts[i].ny).dot(dirs[i]) > 0.9999f);
+    }
+}
+
+TEST_CASE("Baked displacement matches the radial height", "[terrain_vertex]") {
+    Heightmap map = ramp_map(128, 64);
+    TerrainBaker baker(map, 0.0f, 0.1f);
+    TerrainQuadtree tree;
+    std::vector<PackedVertex> verts;
+    ChunkFrame frame;
+    ChunkKey key{4, 1, 1, 0};
+    baker.bake(tree, key, verts, frame);
+
+    std::vector<Vec3f> dirs;
+    tree.chunk_positions(key, dirs);
+    for (u32 i = 0; i < 17 * 17; i++) {
+        f32 expected = baker.radius_for(baker.elevation_at(dirs[i]));
+        REQUIRE(std::abs(unpack(verts[i], frame).length() - expected) < 1e-4f);
+    }
+    // Rising terrain tilts the normal away from the slope
+    Vec3f n = baker.normal_at(dirs[8 * 17 + 8]);
+    REQUIRE(n.dot(dirs[8 * 17 + 8]) < 0.9999f);
+}
+
+TEST_CASE("Elevation sampling wraps across the longitude seam", "[terrain_vertex]") {
+    Heightmap map(8, 4, 0.0f);
+    for (u32 y = 0; y < 4; y++) {
+        map.set(0, y, 1.0f);
+        map.set(7, y, 1.0f);
+    }
+    TerrainBaker baker(map, 0.0f, 0.0f);
+    // u = 0 sits halfway between texel 7 and texel 0
+    REQUIRE(std::abs(baker.elevation_at({1.0f, 0.0f, 0.0f}) - 1.0f) < 1e-5f);
+}
+
+TEST_CASE("Dirty cells map to the chunks they affect", "[terrain_vertex]") {
+    TerrainQuadtree tree;
+    u32 w = 256, h = 128;
+
+    // +X face root centre is at u = 0, v = 0.5
+    CellRect at_seam{0, 62, 2, 66};
+    REQUIRE(chunk_touches(tree, {0, 0, 0, 0}, at_seam, w, h));
+    REQUIRE_FALSE(chunk_touches(tree, {1, 0, 0, 0}, at_seam, w, h));
+
+    // A seam edit on the other side of the wrap still touches it
+    CellRect wrapped{254, 62, 256, 66};
+    REQUIRE(chunk_touches(tree, {0, 0, 0, 0}, wrapped, w, h));
+
+    // Polar caps cover every longitude
+    CellRect north{100, 0, 101, 1};
+    REQUIRE(chunk_touches(tree, {2, 0, 0, 0}, north, w, h));
+    REQUIRE_FALSE(chunk_touches(tree, {3, 0, 0, 0}, north, w, h));
+}
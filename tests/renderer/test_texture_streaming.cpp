@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include "renderer/TexelPacking.h"
+#include "renderer/UploadWorker.h"
+#include "layers/planetary/Heightmap.h"
+
+#include <vector>
+
+using namespace godsim;
+
+static Heightmap bumpy_map(u32 w, u32 h) {
+    Heightmap map(w, h);
+    for (u32 y = 0; y < h; y++)
+        for (u32 x = 0; x < w; x++)
+            map.set(x, y, static_cast<f32>((x * 7 + y * 13) % 17) / 17.0f);
+    return map;
+}
+
+// ═══ Texture Streaming Tests ═══
+
+TEST_CASE("Upload worker runs jobs in submission order", "[streaming_upload]") {
+    UploadWorker worker;
+    std::vector<int> order;
+    u64 last = 0;
+    for (int i = 0; i < 50; i++) last = worker.submit([&order, i] { order.push_back(i); });
+    REQUIRE(last == 50);
+
+    worker.wait(last);
+    REQUIRE(worker.done(last));
+    REQUIRE(worker.completed() == 50);
+    REQUIRE(order.size() == 50);
+    for (int i = 0; i < 50; i++) REQUIRE(order[i] == i);
+
+    worker.wait_all(); // Nothing pending: returns at once
+    REQUIRE_FALSE(worker.done(51));
+}
+
+TEST_CASE("Fields pack to R16 over their range", "[streaming_upload]") {
+    f32 field[] = {-30.0f, 0.0f, 30.0f, 99.0f};
+    u16 out[4];
+    pack_unorm16(whole_grid(field, 4, 1), CellRect{0, 0, 4, 1}, -30.0f, 30.0f, out);
+    REQUIRE(out[0] == 0);
+    REQUIRE(out[1] == 32768);
+    REQUIRE(out[2] == 65535);
+    REQUIRE(out[3] == 65535); // Clamped
+
+    BiomeType biomes[] = {BiomeType::Ocean, BiomeType::Ice};
+    u8 idx[2];
+    pack_biome_indices(whole_grid(biomes, 2, 1), CellRect{0, 0, 2, 1}, idx);
+    REQUIRE(idx[0] == 0);
+    REQUIRE(idx[1] == static_cast<u8>(BiomeType::Ice));
+}
+
+TEST_CASE("Packing a copied window matches the full-grid texels", "[streaming_upload]") {
+    u32 w = 32, h = 16;
+    Heightmap map = bumpy_map(w, h);
+    auto whole = whole_grid(map.data_ptr(), w, h);
+    CellRect all{0, 0, w, h};
+    std::vector<u16> full(w * h);
+    pack_unorm16(whole, all, 0.0f, 1.0f, full.data());
+
+    CellRect rect{5, 3, 12, 9};
+    auto window = copy_window(map.data_ptr(), w, rect);
+    REQUIRE(window.values.size() == rect.width() * rect.height());
+
+    std::vector<u16> part(rect.width() * rect.height());
+    pack_unorm16(window.view(), rect, 0.0f, 1.0f, part.data());
+    for (u32 y = rect.y0; y < rect.y1; y++)
+        for (u32 x = rect.x0; x < rect.x1; x++)
+            REQUIRE(part[(y - rect.y0) * rect.width() + (x - rect.x0)] == full[y * w + x]);
+}
+
+TEST_CASE("Normals over a rect match the full-grid normals", "[streaming_upload]") {
+    u32 w = 24, h = 12;
+    Heightmap map = bumpy_map(w, h);
+    CellRect all{0, 0, w, h};
+    std::vector<u8> full(w * h * 3);
+    pack_normals(whole_grid(map.data_ptr(), w, h), all, w, h, full.data());
+
+    // Touches the grid corner, so the source window is clamped there
+    for (CellRect rect : {CellRect{6, 4, 10, 8}, CellRect{0, 0, 3, 2}}) {
+        auto window = copy_window(map.data_ptr(), w, rect.expanded(1, w, h));
+        std::vector<u8> part(rect.width() * rect.height() * 3);
+        pack_normals(window.view(), rect, w, h, part.data());
+        for (u32 y = rect.y0; y < rect.y1; y++) {
+            for (u32 x = rect.x0; x < rect.x1; x++) {
+                for (u32 c = 0; c < 3; c++) {
+                    REQUIRE(part[((y - rect.y0) * rect.width() + (x - rect.x0)) * 3 + c] ==
+                            full[(y * w + x) * 3 + c]);
+                }
+            }
+        }
+    }
+}
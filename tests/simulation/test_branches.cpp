@@ -0,0 +1,151 @@
+#include <catch2/catch_test_macros.hpp>
+#include "simulation/Branches.h"
+#include "simulation/Timeline.h"
+#include "layers/civilisation/CivilisationLayer.h"
+#include "layers/cosmological/CosmologicalLayer.h"
+#include "layers/planetary/Heightmap.h"
+#include "support/TestPlanet.h"
+
+#include <algorithm>
+
+using namespace godsim;
+
+/// A 1024² elevation plane that miracles raise in patches, and a clock
+/// that logs an event every tick.
+class TerrainLayer : public Layer {
+public:
+    static constexpr u32 SIZE = 1024;
+
+    LayerID id() const override { return LayerID::Planetary; }
+    std::string name() const override { return "Terrain"; }
+    void initialise(Registry&, EventBus& bus, RNG& rng) override {
+        bus_ = &bus;
+        elevation = Heightmap(SIZE, SIZE);
+        for (u32 y = 0; y < SIZE; y++)
+            for (u32 x = 0; x < SIZE; x++) elevation.set(x, y, rng.next_float());
+    }
+    void shutdown() override {}
+
+    void tick(SimTime current_time, SimTime) override {
+        increment_tick();
+        bus_->emit(DebugEvent{"tick"}, current_time);
+    }
+
+    void raise(u32 x0, u32 y0, f32 amount) {
+        for (u32 y = y0; y < y0 + 16; y++)
+            for (u32 x = x0; x < x0 + 16; x++) elevation.at(x, y) += amount;
+    }
+
+    void serialise(BinaryWriter& writer) const override { elevation.serialise(writer); }
+    void deserialise(BinaryReader& reader, u32) override { elevation.deserialise(reader); }
+
+    Heightmap elevation;
+
+private:
+    EventBus* bus_ = nullptr;
+};
+
+// ═══ Branch Tests ═══
+
+TEST_CASE("Branches share unchanged state and switch back exactly", "[branches]") {
+    Simulation sim(21);
+    auto* terrain = sim.add_layer<TerrainLayer>();
+    sim.initialise();
+    sim.run(600); // Over a chunk of events logged
+
+    BranchManager branches(sim);
+    size_t image = branches.branch(0).state.size();
+    REQUIRE(image > TerrainLayer::SIZE * TerrainLayer::SIZE * sizeof(f32));
+
+    // A dozen "what ifs", each raising a different patch and running on
+    constexpr u32 COUNT = 12;
+    std::vector<BranchID> ids;
+    for (u32 i = 0; i < COUNT; i++) {
+        branches.switch_to(0);
+        BranchID id = branches.fork("what if " + std::to_string(i));
+        branches.switch_to(id);
+        terrain->raise(64 * i, 32 * i, 1.0f + i);
+        sim.run(5 + i);
+        ids.push_back(id);
+    }
+    branches.switch_to(0);
+    REQUIRE(branches.branch_count() == COUNT + 1);
+    REQUIRE(branches.branch(ids[3]).parent == 0);
+    REQUIRE(branches.resident_bytes() < 2 * image);
+
+    // The root never saw a miracle
+    REQUIRE(sim.current_time() == SimTime::from_days(600));
+    REQUIRE(terrain->elevation.get(64 * 5, 32 * 5) < 1.0f);
+
+    // Each branch comes back as it was left, with its own log
+    for (u32 i = 0; i < COUNT; i++) {
+        branches.switch_to(ids[i]);
+        REQUIRE(sim.current_time() == SimTime::from_days(600 + 5 + i));
+        REQUIRE(terrain->elevation.get(64 * i + 3, 32 * i + 3) >= 1.0f + i);
+        if (i > 0) REQUIRE(terrain->elevation.get(64 * (i - 1), 32 * (i - 1)) < 1.0f);
+        REQUIRE(sim.event_bus().log().back().timestamp == SimTime::from_days(600 + 5 + i));
+        REQUIRE(sim.event_bus().log().sealed_chunks().front() ==
+                branches.branch(0).log.sealed_chunks().front());
+    }
+
+    // A timeline restarted on a branch rewinds within it
+    Timeline timeline(sim);
+    timeline.intervene([terrain](Simulation&) { terrain->raise(0, 512, 5.0f); });
+    timeline.run(3);
+    REQUIRE(timeline.rewind_to(SimTime::from_days(600 + 5 + COUNT - 1)));
+    REQUIRE(terrain->elevation.get(0, 512) < 1.0f);
+    branches.switch_to(0);
+    timeline.restart();
+    REQUIRE(timeline.horizon() == SimTime::from_days(600));
+    sim.shutdown();
+}
+
+TEST_CASE("Switching branches keeps entity IDs and the entities both share", "[branches]") {
+    PlanetData planet = make_test_planet(64, 32, {.biome = BiomeType::TemperateGrassland});
+    Simulation sim(8);
+    auto* cosmos = sim.add_layer<CosmologicalLayer>();
+    auto* civ = sim.add_layer<CivilisationLayer>();
+    sim.initialise();
+    cosmos->generate_galaxy(500);
+    civ->params().people_per_cell = 400.0f; // Small towns fill up and send settlers soon
+    civ->settle(planet, 6);
+    sim.set_tick_level(1);
+
+    auto star_handles = [&] {
+        std::vector<entt::entity> handles;
+        for (auto h : sim.registry().raw().view<CelestialBody>()) handles.push_back(h);
+        std::sort(handles.begin(), handles.end());
+        return handles;
+    };
+    auto state = [&] {
+        BinaryWriter writer;
+        sim.write_state(writer);
+        return writer.buffer();
+    };
+
+    BranchManager branches(sim);
+    BranchID what_if = branches.fork("what if");
+    branches.switch_to(what_if);
+    sim.run(60);
+    std::vector<EntityID> towns = civ->settlements().entity;
+    u64 next_id = sim.registry().next_id();
+    REQUIRE(towns.size() > 6);
+    auto handles = star_handles();
+    auto branch_state = state();
+
+    // Back on main the branch's towns are gone, and the stars were never
+    // destroyed and recreated
+    branches.switch_to(0);
+    REQUIRE(civ->settlements().size() == 6);
+    REQUIRE(sim.registry().entity_count() == 500 + 2 + 6);
+    REQUIRE(star_handles() == handles);
+
+    // Returning brings the branch's towns back under their own IDs, and
+    // new entities carry on from where the branch's IDs left off
+    branches.switch_to(what_if);
+    REQUIRE(civ->settlements().entity == towns);
+    REQUIRE(sim.registry().next_id() == next_id);
+    REQUIRE(star_handles() == handles);
+    REQUIRE(state() == branch_state);
+    sim.shutdown();
+}
@@ -0,0 +1,149 @@
+#include <catch2/catch_test_macros.hpp>
+#include "simulation/RegionLOD.h"
+#include "simulation/Simulation.h"
+#include "layers/biological/BiologicalLayer.h"
+
+#include <filesystem>
+#include <vector>
+
+using namespace godsim;
+
+/// Records the regions it is asked to hydrate and dehydrate.
+class RecordingLayer : public Layer {
+public:
+    LayerID id() const override { return LayerID::Planetary; }
+    std::string name() const override { return "Recording"; }
+    void initialise(Registry&, EventBus&, RNG&) override {}
+    void shutdown() override {}
+    void tick(SimTime, SimTime) override {}
+    void serialise(BinaryWriter&) const override {}
+    void deserialise(BinaryReader&, u32) override {}
+
+    void hydrate_region(const CellRect& b) override { hydrated.push_back(b); }
+    void dehydrate_region(const CellRect& b) override { dehydrated.push_back(b); }
+
+    std::vector<CellRect> hydrated, dehydrated;
+};
+
+static f64 total_population(const PopulationGrid& grid) {
+    f64 sum = 0.0;
+    for (u32 s = 0; s < grid.species_count(); s++) sum += grid.total(s);
+    return sum;
+}
+
+// ═══ Region LOD Tests ═══
+
+TEST_CASE("RegionLOD starts hydrated and does nothing until asked", "[region_lod]") {
+    RegionLOD regions;
+    RecordingLayer layer;
+    regions.register_layer(&layer);
+    REQUIRE(regions.update() == 0); // Not configured
+
+    regions.configure(256, 100);
+    REQUIRE(regions.region_count() == 8 * 4);
+    REQUIRE(regions.hydrated_count() == 32);
+    CellRect last = regions.bounds(31);
+    REQUIRE(last.x1 == 256);
+    REQUIRE(last.y0 == 96);
+    REQUIRE(last.y1 == 100);
+    REQUIRE(layer.hydrated.empty());
+}
+
+TEST_CASE("RegionLOD follows the focus within its budget", "[region_lod]") {
+    RegionLOD regions;
+    RecordingLayer layer;
+    regions.register_layer(&layer);
+    regions.configure(512, 256); // 16 × 8 regions
+
+    regions.set_focus(FocusSource::Api, {112.0f, 112.0f, 40.0f});
+    u32 pending = regions.pending();
+    REQUIRE(pending > 100);
+    REQUIRE(regions.update(10) == 10);
+    REQUIRE(regions.pending() == pending - 10);
+    REQUIRE(layer.dehydrated.size() == 10);
+    // Farthest first: the first to go is across the planet
+    REQUIRE(layer.dehydrated[0].x0 >= 256);
+    regions.settle();
+    REQUIRE(regions.pending() == 0);
+    REQUIRE(regions.hydrated(regions.region_at(112, 112)));
+    REQUIRE_FALSE(regions.hydrated(regions.region_at(400, 112)));
+
+    // Move the focus to the seam: nearest hydrations come first
+    layer.hydrated.clear();
+    regions.set_focus(FocusSource::Api, {496.0f, 112.0f, 40.0f});
+    REQUIRE(regions.update(1) == 1);
+    REQUIRE(layer.hydrated.size() == 1);
+    REQUIRE(layer.hydrated[0].x0 == 480);
+    REQUIRE(layer.hydrated[0].y0 == 96);
+    regions.settle();
+    REQUIRE(regions.hydrated(regions.region_at(10, 112))); // Wrapped round
+    REQUIRE_FALSE(regions.hydrated(regions.region_at(112, 112)));
+
+    // Two sources add up; clearing one drops only its regions
+    regions.set_focus(FocusSource::Camera, {100.0f, 200.0f, 20.0f});
+    regions.settle();
+    REQUIRE(regions.hydrated(regions.region_at(100, 200)));
+    regions.clear_focus(FocusSource::Camera);
+    regions.settle();
+    REQUIRE_FALSE(regions.hydrated(regions.region_at(100, 200)));
+    REQUIRE(regions.hydrated(regions.region_at(496, 112)));
+}
+
+TEST_CASE("RegionLOD keeps regions in the hysteresis band as they are", "[region_lod]") {
+    RegionLOD regions;
+    regions.configure(512, 256);
+    regions.set_focus(FocusSource::Api, {256.0f, 128.0f, 10.0f});
+    regions.settle();
+    regions.set_focus(FocusSource::Api, {256.0f, 128.0f, 64.0f});
+    regions.settle();
+    u32 hydrated = regions.hydrated_count();
+
+    // Shrinking a little leaves everything in place
+    regions.set_focus(FocusSource::Api, {256.0f, 128.0f, 50.0f});
+    REQUIRE(regions.pending() == 0);
+    REQUIRE(regions.hydrated_count() == hydrated);
+    // Shrinking a lot lets the outer ring go
+    regions.set_focus(FocusSource::Api, {256.0f, 128.0f, 10.0f});
+    regions.settle();
+    REQUIRE(regions.hydrated_count() < hydrated);
+}
+
+TEST_CASE("Hydration through the simulation conserves populations", "[region_lod]") {
+    Simulation sim(11);
+    auto* bio = sim.add_layer<BiologicalLayer>();
+    sim.initialise();
+    PlanetData planet;
+    planet.width = 256;
+    planet.height = 128;
+    planet.biome_map.assign(256 * 128, BiomeType::TemperateGrassland);
+    bio->populate(planet, 6);
+    sim.regions().configure(256, 128);
+    sim.set_tick_level(2);
+    sim.run(2);
+
+    f64 before = total_population(bio->populations());
+    sim.regions().set_focus(FocusSource::Api, {64.0f, 64.0f, 30.0f});
+    sim.regions().settle();
+    REQUIRE(bio->populations().coarse_tile_count() == 32 - sim.regions().hydrated_count());
+    REQUIRE(bio->populations().coarse_tile_count() >= 20);
+    REQUIRE(std::abs(total_population(bio->populations()) - before) < 1e-5 * before);
+
+    sim.run(3);
+    REQUIRE(total_population(bio->populations()) > before);
+
+    // Snapshots carry both sides of the hydration state
+    auto path = (std::filesystem::temp_directory_path() / "godsim_region_lod.snap").string();
+    sim.save_snapshot(path);
+    u32 coarse = bio->populations().coarse_tile_count();
+    f64 saved = total_population(bio->populations());
+    sim.regions().clear_focus(FocusSource::Api);
+    sim.regions().settle();
+    REQUIRE(bio->populations().coarse_tile_count() == 32);
+
+    sim.load_snapshot(path);
+    REQUIRE(bio->populations().coarse_tile_count() == coarse);
+    REQUIRE(sim.regions().hydrated_count() == 32 - coarse);
+    REQUIRE(total_population(bio->populations()) == saved);
+    std::filesystem::remove(path);
+    sim.shutdown();
+}
@@ -0,0 +1,210 @@
+#include <catch2/catch_test_macros.hpp>
+#include "simulation/Timeline.h"
+#include "layers/civilisation/CivilisationLayer.h"
+#include "layers/cosmological/CosmologicalLayer.h"
+#include "support/TestPlanet.h"
+
+#include <vector>
+
+using namespace godsim;
+
+/// Takes a random walk from the simulation RNG every tick, nudged by a
+/// drift that interventions set. Ticks and restores advance a fake clock
+/// by set costs, so timeline measurements are exact.
+class DriftLayer : public Layer {
+public:
+    LayerID id() const override { return LayerID::Biological; }
+    std::string name() const override { return "Drift"; }
+    void initialise(Registry&, EventBus& bus, RNG& rng) override { bus_ = &bus; rng_ = &rng; }
+    void shutdown() override {}
+
+    void tick(SimTime current_time, SimTime) override {
+        increment_tick();
+        position += drift + rng_->next_float(-1.0f, 1.0f);
+        path.push_back(position);
+        if (path.size() % 4 == 0) bus_->emit(DebugEvent{"milestone"}, current_time);
+        clock_ms += tick_cost_ms;
+    }
+
+    void serialise(BinaryWriter& writer) const override {
+        writer.write_f32(position);
+        writer.write_f32(drift);
+        writer.write_u32(static_cast<u32>(path.size()));
+        writer.write_bytes(path.data(), path.size() * sizeof(f32));
+    }
+
+    void deserialise(BinaryReader& reader, u32 /*version*/) override {
+        position = reader.read_f32();
+        drift = reader.read_f32();
+        path.resize(reader.read_u32());
+        reader.read_bytes(path.data(), path.size() * sizeof(f32));
+        clock_ms += restore_cost_ms;
+    }
+
+    f32 position = 0.0f;
+    f32 drift = 0.0f;
+    std::vector<f32> path;
+
+    f64 clock_ms = 0.0;
+    f64 tick_cost_ms = 0.0;
+    f64 restore_cost_ms = 0.0;
+    TimelineConfig timed(f64 budget_ms, u32 max_keyframes) {
+        return {budget_ms, max_keyframes, [this] { return clock_ms; }};
+    }
+
+private:
+    EventBus* bus_ = nullptr;
+    RNG* rng_ = nullptr;
+};
+
+static std::vector<u8> state_of(const Simulation& sim) {
+    BinaryWriter writer;
+    sim.write_state(writer);
+    return writer.buffer();
+}
+
+static std::vector<u8> log_of(const Simulation& sim) {
+    BinaryWriter writer;
+    for (const Event& e : sim.event_bus().log()) write_event(writer, e);
+    return writer.buffer();
+}
+
+// ═══ Timeline Tests ═══
+
+TEST_CASE("Timeline rewinds to the exact state, interventions included", "[timeline]") {
+    Simulation sim(5);
+    auto* drift = sim.add_layer<DriftLayer>();
+    sim.initialise();
+
+    // 2ms steps against a 5ms budget: a keyframe every third step, so most
+    // rewinds replay some
+    drift->tick_cost_ms = 2.0;
+    Timeline timeline(sim, drift->timed(5.0, 64));
+    std::vector<std::vector<u8>> states{state_of(sim)};
+    std::vector<size_t> log_sizes{sim.event_bus().log().size()};
+    for (int i = 0; i < 30; i++) {
+        if (i == 7) timeline.intervene([](Simulation& s) { s.set_tick_level(1); });
+        if (i == 12) timeline.intervene([drift](Simulation&) { drift->drift = 3.0f; });
+        if (i == 20) timeline.intervene([](Simulation& s) {
+            s.event_bus().schedule(DebugEvent{"omen"}, s.current_time() + SimTime::from_years(3));
+        });
+        timeline.step();
+        states.push_back(state_of(sim));
+        log_sizes.push_back(sim.event_bus().log().size());
+    }
+    REQUIRE(timeline.keyframe_count() == 11);
+    REQUIRE(timeline.journal_size() == 3);
+
+    SimTime end = sim.current_time();
+    std::vector<u8> end_state = state_of(sim);
+    REQUIRE(timeline.rewind_to(end));
+    REQUIRE(state_of(sim) == end_state);
+
+    // Each step's state comes back exactly, event log and all
+    for (int step : {29, 21, 13, 8, 3}) {
+        SimTime t = SimTime{0};
+        for (int i = 0; i < step; i++) t += SimTime::from_days(i < 7 ? 1 : 365);
+        REQUIRE(timeline.rewind_to(t));
+        REQUIRE(timeline.step_count() == static_cast<u64>(step));
+        REQUIRE(state_of(sim) == states[step]);
+        REQUIRE(sim.event_bus().log().size() == log_sizes[step]);
+    }
+
+    // Rewinding dropped the interventions after step 3; a new future diverges
+    REQUIRE(timeline.journal_size() == 0);
+    timeline.run(10);
+    REQUIRE(sim.current_time() == SimTime::from_days(13));
+    REQUIRE(drift->drift == 0.0f);
+
+    // A time between steps lands on the step before it
+    timeline.intervene([](Simulation& s) { s.set_tick_level(1); });
+    timeline.run(2);
+    REQUIRE(timeline.rewind_to(SimTime::from_days(500)));
+    REQUIRE(sim.current_time() == SimTime::from_days(13) + SimTime::from_years(1));
+    REQUIRE_FALSE(timeline.rewind_to(SimTime{-1}));
+    sim.shutdown();
+}
+
+TEST_CASE("Timeline spaces keyframes by replay cost and keeps at most its limit", "[timeline]") {
+    Simulation sim(9);
+    auto* drift = sim.add_layer<DriftLayer>();
+    sim.initialise();
+
+    // Free steps: one keyframe holds the whole run
+    Timeline cheap(sim, drift->timed(50.0, 4));
+    cheap.run(40);
+    REQUIRE(cheap.keyframe_count() == 1);
+    REQUIRE(cheap.horizon() == SimTime{0});
+
+    // 2ms steps against a 10ms budget: a keyframe every fifth step, and
+    // only the newest four kept
+    drift->tick_cost_ms = 2.0;
+    Timeline costly(sim, drift->timed(10.0, 4));
+    costly.run(40);
+    REQUIRE(costly.keyframe_count() == 4);
+    REQUIRE(costly.horizon() == SimTime::from_days(65));
+    REQUIRE(costly.rewind_estimate_ms() == 0.0);
+    costly.run(3);
+    REQUIRE(costly.rewind_estimate_ms() == 6.0);
+    REQUIRE_FALSE(costly.rewind_to(SimTime::from_days(64)));
+
+    // A 4ms restore plus one replayed step; from then on keyframes come
+    // every third step, when replay reaches the budget less the restore
+    drift->restore_cost_ms = 4.0;
+    REQUIRE(costly.rewind_to(SimTime::from_days(66)));
+    REQUIRE(sim.current_time() == SimTime::from_days(66));
+    REQUIRE(costly.rewind_estimate_ms() == 6.0);
+    REQUIRE(costly.keyframe_count() == 1);
+    costly.run(2);
+    REQUIRE(costly.keyframe_count() == 2);
+    costly.run(3);
+    REQUIRE(costly.keyframe_count() == 3);
+    REQUIRE(costly.keyframe_bytes() > 0);
+    sim.shutdown();
+}
+
+TEST_CASE("Rewinding restores entity IDs so replay creates the same entities", "[timeline]") {
+    PlanetData planet = make_test_planet(64, 32, {.biome = BiomeType::TemperateGrassland});
+    Simulation sim(21);
+    auto* cosmos = sim.add_layer<CosmologicalLayer>();
+    auto* civ = sim.add_layer<CivilisationLayer>();
+    sim.initialise();
+    cosmos->generate_galaxy(300);
+    civ->params().people_per_cell = 400.0f; // Small towns fill up and send settlers soon
+    civ->settle(planet, 6);
+    sim.set_tick_level(1);
+
+    // A clock that ticks 1ms per reading: steps and restores both cost
+    // 1ms, so a keyframe is taken every seventh step
+    Timeline timeline(sim, {8.0, 64, [t = 0.0]() mutable { return t += 1.0; }});
+    std::vector<std::vector<u8>> states{state_of(sim)}, logs{log_of(sim)};
+    std::vector<EntityID> created;
+    for (int i = 0; i < 60; i++) {
+        timeline.step();
+        states.push_back(state_of(sim));
+        logs.push_back(log_of(sim));
+    }
+    for (const Event& e : sim.event_bus().log()) {
+        if (auto* p = std::get_if<EntityCreatedEvent>(&e.payload)) created.push_back(p->entity);
+    }
+    REQUIRE(created.size() > 6); // Settlers founded new towns along the way
+    EntityID home = cosmos->home_planet();
+
+    // Back to each step: same state and log, home planet and all
+    REQUIRE(timeline.keyframe_count() == 9);
+    for (int step : {40, 25, 10}) {
+        REQUIRE(timeline.rewind_to(SimTime::from_years(step)));
+        REQUIRE(state_of(sim) == states[step]);
+        REQUIRE(log_of(sim) == logs[step]);
+        REQUIRE(cosmos->home_planet() == home);
+        REQUIRE(sim.registry().has_component<OrbitalRelation>(home));
+        for (EntityID e : civ->settlements().entity) REQUIRE(sim.registry().is_alive(e));
+    }
+
+    // Running forward again founds the same towns under the same IDs
+    timeline.run(50);
+    REQUIRE(state_of(sim) == states[60]);
+    REQUIRE(log_of(sim) == logs[60]);
+    REQUIRE(sim.registry().entity_count() == 300 + 2 + civ->settlements().size());
+    sim.shutdown();
+}
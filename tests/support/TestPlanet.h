@@ -0,0 +1,41 @@
+#pragma once
+
+#include "layers/planetary/PlanetData.h"
+
+#include <optional>
+
+namespace godsim {
+
+/// Shape of a synthetic planet for tests. The defaults are a uniform
+/// temperate lowland above sea level.
+struct TestPlanetConfig {
+    f32 elevation = 0.5f;
+    bool elevation_ramp = false;    // x / width instead: sea in the west, peaks in the east
+    f32 temperature = 15.0f;        // °C along the north edge
+    f32 temperature_rise = 0.0f;    // Added towards the south edge
+    f32 moisture = 0.5f;
+    std::optional<BiomeType> biome = std::nullopt; // Every cell this; classified from the grids if unset
+    f32 sea_level = 0.4f;
+};
+
+/// A w×h planet with every grid filled according to `config`.
+inline PlanetData make_test_planet(u32 w, u32 h, const TestPlanetConfig& config = {}) {
+    PlanetData planet;
+    planet.width = w;
+    planet.height = h;
+    planet.sea_level = config.sea_level;
+    planet.elevation = Heightmap(w, h, config.elevation);
+    planet.temperature = Heightmap(w, h, config.temperature);
+    planet.moisture = Heightmap(w, h, config.moisture);
+    for (u32 y = 0; y < h; y++) {
+        for (u32 x = 0; x < w; x++) {
+            if (config.elevation_ramp) planet.elevation.set(x, y, static_cast<f32>(x) / w);
+            planet.temperature.set(x, y, config.temperature + config.temperature_rise * y / h);
+        }
+    }
+    if (config.biome) planet.biome_map.assign(static_cast<size_t>(w) * h, *config.biome);
+    else planet.classify_biomes();
+    return planet;
+}
+
+} // namespace godsim